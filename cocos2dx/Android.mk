@@ -20,6 +20,7 @@ actions/CCActionGrid3D.cpp \
 actions/CCActionInstant.cpp \
 actions/CCActionInterval.cpp \
 actions/CCActionManager.cpp \
+actions/CCActionPool.cpp \
 actions/CCActionPageTurn3D.cpp \
 actions/CCActionProgressTimer.cpp \
 actions/CCActionTiledGrid.cpp \
@@ -32,6 +33,8 @@ cocoa/CCAutoreleasePool.cpp \
 cocoa/CCDictionary.cpp \
 cocoa/CCNS.cpp \
 cocoa/CCObject.cpp \
+cocoa/CCObjectAllocator.cpp \
+cocoa/CCObjectTracker.cpp \
 cocoa/CCSet.cpp \
 cocoa/CCString.cpp \
 cocoa/CCZone.cpp \
@@ -61,6 +64,7 @@ keypad_dispatcher/CCKeypadDispatcher.cpp \
 label_nodes/CCLabelAtlas.cpp \
 label_nodes/CCLabelBMFont.cpp \
 label_nodes/CCLabelTTF.cpp \
+label_nodes/CCGlyphAtlas.cpp \
 layers_scenes_transitions_nodes/CCLayer.cpp \
 layers_scenes_transitions_nodes/CCScene.cpp \
 layers_scenes_transitions_nodes/CCTransitionPageTurn.cpp \
@@ -111,6 +115,10 @@ sprite_nodes/CCSpriteFrameCache.cpp \
 support/ccUTF8.cpp \
 support/CCNotificationCenter.cpp \
 support/CCProfiling.cpp \
+support/CCJobPool.cpp \
+support/CCSpatialGrid.cpp \
+support/CCTracer.cpp \
+support/CCFrameTimeStats.cpp \
 support/CCPointExtension.cpp \
 support/TransformUtils.cpp \
 support/user_default/CCUserDefaultAndroid.cpp \
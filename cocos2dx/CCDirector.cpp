@@ -40,6 +40,7 @@ THE SOFTWARE.
 #include "touch_dispatcher/CCTouchDispatcher.h"
 #include "support/CCPointExtension.h"
 #include "support/CCNotificationCenter.h"
+#include "CCEventType.h"
 #include "layers_scenes_transitions_nodes/CCTransition.h"
 #include "textures/CCTextureCache.h"
 #include "sprite_nodes/CCSpriteFrameCache.h"
@@ -49,11 +50,13 @@ THE SOFTWARE.
 #include "CCApplication.h"
 #include "label_nodes/CCLabelBMFont.h"
 #include "label_nodes/CCLabelAtlas.h"
+#include "label_nodes/CCGlyphAtlas.h"
 #include "actions/CCActionManager.h"
 #include "CCConfiguration.h"
 #include "keypad_dispatcher/CCKeypadDispatcher.h"
 #include "CCAccelerometer.h"
 #include "sprite_nodes/CCAnimationCache.h"
+#include "particle_nodes/CCParticleSystem.h"
 #include "touch_dispatcher/CCTouch.h"
 #include "support/user_default/CCUserDefault.h"
 #include "shaders/ccGLStateCache.h"
@@ -61,6 +64,11 @@ THE SOFTWARE.
 #include "kazmath/kazmath.h"
 #include "kazmath/GL/matrix.h"
 #include "support/CCProfiling.h"
+#include "support/CCJobPool.h"
+#include "actions/CCActionPool.h"
+#include "cocoa/CCObjectTracker.h"
+#include "support/CCTracer.h"
+#include "support/CCFrameTimeStats.h"
 #include "platform/CCImage.h"
 #include "CCEGLView.h"
 #include "CCConfiguration.h"
@@ -89,6 +97,13 @@ static CCDisplayLinkDirector *s_SharedDirector = NULL;
 #define kDefaultFPS        60  // 60 frames per second
 extern const char* cocos2dVersion(void);
 
+static float secondsSince(struct cc_timeval *pStart)
+{
+    struct cc_timeval now;
+    CCTime::gettimeofdayCocos2d(&now, NULL);
+    return (float)(CCTime::timersubCocos2d(pStart, &now) / 1000.0);
+}
+
 CCDirector* CCDirector::sharedDirector(void)
 {
     if (!s_SharedDirector)
@@ -127,10 +142,14 @@ bool CCDirector::init(void)
     m_pFPSLabel = NULL;
     m_pSPFLabel = NULL;
     m_pDrawsLabel = NULL;
+    m_pFrameTimeLabel = NULL;
+    m_pFrameTimeStats = new CCFrameTimeStats();
+    m_bDisplayFrameTimeStats = false;
     m_uTotalFrames = m_uFrames = 0;
     m_pszFPS = new char[10];
     m_pLastUpdate = new struct cc_timeval();
     m_fSecondsPerFrame = 0.0f;
+    m_fFixedDeltaTime = 0.0f;
 
     // paused ?
     m_bPaused = false;
@@ -162,6 +181,9 @@ bool CCDirector::init(void)
     // create autorelease pool
     CCPoolManager::sharedPoolManager()->push();
 
+    // the director runs on the main thread
+    CC_TRACE_THREAD_NAME("main");
+
     return true;
 }
     
@@ -172,6 +194,8 @@ CCDirector::~CCDirector(void)
     CC_SAFE_RELEASE(m_pFPSLabel);
     CC_SAFE_RELEASE(m_pSPFLabel);
     CC_SAFE_RELEASE(m_pDrawsLabel);
+    CC_SAFE_RELEASE(m_pFrameTimeLabel);
+    CC_SAFE_DELETE(m_pFrameTimeStats);
     
     CC_SAFE_RELEASE(m_pRunningScene);
     CC_SAFE_RELEASE(m_pNotificationNode);
@@ -248,13 +272,20 @@ void CCDirector::setGLDefaultValues(void)
 // Draw the Scene
 void CCDirector::drawScene(void)
 {
+    CC_TRACE_SCOPE("CCDirector::drawScene");
+
     // calculate "global" dt
     calculateDeltaTime();
 
+    struct cc_timeval phaseStart;
+
     //tick before glClear: issue #533
     if (! m_bPaused)
     {
+        CC_TRACE_SCOPE("CCScheduler::update");
+        CCTime::gettimeofdayCocos2d(&phaseStart, NULL);
         m_pScheduler->update(m_fDeltaTime);
+        m_pFrameTimeStats->addSample(kCCFramePhaseUpdate, secondsSince(&phaseStart));
     }
 
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -271,7 +302,10 @@ void CCDirector::drawScene(void)
     // draw the scene
     if (m_pRunningScene)
     {
+        CC_TRACE_SCOPE("CCScene::visit");
+        CCTime::gettimeofdayCocos2d(&phaseStart, NULL);
         m_pRunningScene->visit();
+        m_pFrameTimeStats->addSample(kCCFramePhaseVisit, secondsSince(&phaseStart));
     }
 
     // draw the notifications node
@@ -288,11 +322,17 @@ void CCDirector::drawScene(void)
     kmGLPopMatrix();
 
     m_uTotalFrames++;
+#if CC_ENABLE_OBJECT_TRACKER
+    CCObjectTracker::setCurrentFrame(m_uTotalFrames);
+#endif
 
     // swap buffers
     if (m_pobOpenGLView)
     {
+        CC_TRACE_SCOPE("CCEGLView::swapBuffers");
+        CCTime::gettimeofdayCocos2d(&phaseStart, NULL);
         m_pobOpenGLView->swapBuffers();
+        m_pFrameTimeStats->addSample(kCCFramePhaseSwap, secondsSince(&phaseStart));
     }
     
     if (m_bDisplayStats)
@@ -322,6 +362,15 @@ void CCDirector::calculateDeltaTime(void)
     {
         m_fDeltaTime = (now.tv_sec - m_pLastUpdate->tv_sec) + (now.tv_usec - m_pLastUpdate->tv_usec) / 1000000.0f;
         m_fDeltaTime = MAX(0, m_fDeltaTime);
+        // before the debug clamp below, which would hide the hitches
+        m_pFrameTimeStats->addSample(kCCFramePhaseFrame, m_fDeltaTime);
+
+        if (m_fFixedDeltaTime > 0)
+        {
+            *m_pLastUpdate = now;
+            m_fDeltaTime = m_fFixedDeltaTime;
+            return;
+        }
     }
 
 #ifdef DEBUG
@@ -456,6 +505,7 @@ void CCDirector::setProjection(ccDirectorProjection kProjection)
 void CCDirector::purgeCachedData(void)
 {
     CCLabelBMFont::purgeCachedData();
+    CCGlyphAtlas::purgeAtlases();
     if (s_SharedDirector->getOpenGLView())
     {
         CCTextureCache::sharedTextureCache()->removeUnusedTextures();
@@ -721,9 +771,11 @@ void CCDirector::purgeDirector()
     CC_SAFE_RELEASE_NULL(m_pFPSLabel);
     CC_SAFE_RELEASE_NULL(m_pSPFLabel);
     CC_SAFE_RELEASE_NULL(m_pDrawsLabel);
+    CC_SAFE_RELEASE_NULL(m_pFrameTimeLabel);
 
     // purge bitmap cache
     CCLabelBMFont::purgeCachedData();
+    CCGlyphAtlas::purgeAtlases();
 
     // purge all managed caches
     ccDrawFree();
@@ -736,7 +788,12 @@ void CCDirector::purgeDirector()
 
     // cocos2d-x specific data structures
     CCUserDefault::purgeSharedUserDefault();
+    CCNotificationCenter::sharedNotificationCenter()->postNotification(EVENT_DIRECTOR_PURGE);
     CCNotificationCenter::purgeNotificationCenter();
+    // the updater was unscheduled with everything else, and simulates on the job pool
+    CCParticleSystem::purgeParallelUpdater();
+    CCJobPool::purgeSharedJobPool();
+    CCActionPool::purgeAllPools();
 
     ccGLInvalidateStateCache();
     
@@ -844,11 +901,24 @@ void CCDirector::showStats(void)
                 
                 sprintf(m_pszFPS, "%4lu", (unsigned long)g_uNumberOfDraws);
                 m_pDrawsLabel->setString(m_pszFPS);
+
+                if (m_bDisplayFrameTimeStats && m_pFrameTimeLabel)
+                {
+                    // p99/max in milliseconds, then the hitches: the fps font only has '.', '/' and digits
+                    ccFrameTimeSummary frame = m_pFrameTimeStats->getSummary(kCCFramePhaseFrame);
+                    char szFrameTime[48];
+                    sprintf(szFrameTime, "%.1f/%.1f/%u", frame.p99 * 1000, frame.max * 1000, m_pFrameTimeStats->getHitchCount());
+                    m_pFrameTimeLabel->setString(szFrameTime);
+                }
             }
             
             m_pDrawsLabel->visit();
             m_pFPSLabel->visit();
             m_pSPFLabel->visit();
+            if (m_bDisplayFrameTimeStats && m_pFrameTimeLabel)
+            {
+                m_pFrameTimeLabel->visit();
+            }
         }
     }    
     
@@ -881,6 +951,7 @@ void CCDirector::createStatsLabel()
         CC_SAFE_RELEASE_NULL(m_pFPSLabel);
         CC_SAFE_RELEASE_NULL(m_pSPFLabel);
         CC_SAFE_RELEASE_NULL(m_pDrawsLabel);
+        CC_SAFE_RELEASE_NULL(m_pFrameTimeLabel);
         textureCache->removeTextureForKey("cc_fps_images");
         CCFileUtils::sharedFileUtils()->purgeCachedEntries();
     }
@@ -931,8 +1002,14 @@ void CCDirector::createStatsLabel()
     m_pDrawsLabel->initWithString("000", texture, 12, 32, '.');
     m_pDrawsLabel->setScale(factor);
 
+    m_pFrameTimeLabel = new CCLabelAtlas();
+    m_pFrameTimeLabel->setIgnoreContentScaleFactor(true);
+    m_pFrameTimeLabel->initWithString("0.0/0.0/0", texture, 12, 32, '.');
+    m_pFrameTimeLabel->setScale(factor);
+
     CCTexture2D::setDefaultAlphaPixelFormat(currentFormat);
 
+    m_pFrameTimeLabel->setPosition(ccpAdd(ccp(0, 51*factor), CC_DIRECTOR_STATS_POSITION));
     m_pDrawsLabel->setPosition(ccpAdd(ccp(0, 34*factor), CC_DIRECTOR_STATS_POSITION));
     m_pSPFLabel->setPosition(ccpAdd(ccp(0, 17*factor), CC_DIRECTOR_STATS_POSITION));
     m_pFPSLabel->setPosition(CC_DIRECTOR_STATS_POSITION);
@@ -1077,7 +1154,12 @@ void CCDisplayLinkDirector::mainLoop(void)
          drawScene();
      
          // release the objects
-         CCPoolManager::sharedPoolManager()->pop();        
+         {
+             CC_TRACE_SCOPE("CCPoolManager::pop");
+             CCPoolManager::sharedPoolManager()->pop();
+         }
+
+         CCTracer::endFrame();
      }
 }
 
@@ -73,6 +73,7 @@ class CCActionManager;
 class CCTouchDispatcher;
 class CCKeypadDispatcher;
 class CCAccelerometer;
+class CCFrameTimeStats;
 
 /**
 @brief Class that creates and handle the main Window and manages how
@@ -134,6 +135,22 @@ public:
     /** seconds per frame */
     inline float getSecondsPerFrame() { return m_fSecondsPerFrame; }
 
+    /** Durations of the last frames and of their update, visit and swap phases
+     @since v2.2
+     @js NA
+     @lua NA
+     */
+    inline CCFrameTimeStats* getFrameTimeStats(void) { return m_pFrameTimeStats; }
+
+    /** Whether or not the stats also display the 99th percentile and the longest frame time,
+     in milliseconds, and the hitch count. Needs setDisplayStats(true).
+     @since v2.2
+     @js NA
+     @lua NA
+     */
+    inline bool isDisplayFrameTimeStats(void) { return m_bDisplayFrameTimeStats; }
+    inline void setDisplayFrameTimeStats(bool bDisplayFrameTimeStats) { m_bDisplayFrameTimeStats = bDisplayFrameTimeStats; }
+
     /** Get the CCEGLView, where everything is rendered
      * @js NA
      */
@@ -143,6 +160,13 @@ public:
     inline bool isNextDeltaTimeZero(void) { return m_bNextDeltaTimeZero; }
     void setNextDeltaTimeZero(bool bNextDeltaTimeZero);
 
+    /** When positive, the scheduler is ticked with this delta time instead of the measured one,
+     so that frames are reproducible whatever the machine. 0, the default, disables it.
+     @since v2.2
+     */
+    inline float getFixedDeltaTime(void) { return m_fFixedDeltaTime; }
+    inline void setFixedDeltaTime(float fFixedDeltaTime) { m_fFixedDeltaTime = fFixedDeltaTime; }
+
     /** Whether or not the Director is paused */
     inline bool isPaused(void) { return m_bPaused; }
 
@@ -393,6 +417,10 @@ protected:
     CCLabelAtlas *m_pFPSLabel;
     CCLabelAtlas *m_pSPFLabel;
     CCLabelAtlas *m_pDrawsLabel;
+    CCLabelAtlas *m_pFrameTimeLabel;
+
+    CCFrameTimeStats *m_pFrameTimeStats;
+    bool m_bDisplayFrameTimeStats;
     
     /** Whether or not the Director is paused */
     bool m_bPaused;
@@ -420,6 +448,9 @@ protected:
 
     /* whether or not the next delta time will be zero */
     bool m_bNextDeltaTimeZero;
+
+    /* delta time used instead of the measured one when positive */
+    float m_fFixedDeltaTime;
     
     /* projection used */
     ccDirectorProjection m_eProjection;
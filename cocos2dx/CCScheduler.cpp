@@ -61,13 +61,14 @@ typedef struct _hashSelectorEntry
 {
     ccArray             *timers;
     CCObject            *target;    // hash key (retained)
-    unsigned int        timerIndex;
-    CCTimer             *currentTimer;
-    bool                currentTimerSalvaged;
     bool                paused;
     UT_hash_handle      hh;
 } tHashTimerEntry;
 
+// CCTimer::m_uHeapIndex values for the timers that are not in the timer heap
+#define kCCTimerNotQueued   UINT_MAX        // unscheduled, or its target is paused
+#define kCCTimerDue         (UINT_MAX - 1)  // taken out of the heap to be fired during this tick
+
 // implementation CCTimer
 
 CCTimer::CCTimer()
@@ -81,6 +82,10 @@ CCTimer::CCTimer()
 , m_fInterval(0.0f)
 , m_pfnSelector(NULL)
 , m_nScriptHandler(0)
+, m_dFireTime(0)
+, m_dLastTime(0)
+, m_uHeapIndex(kCCTimerNotQueued)
+, m_uSequence(0)
 {
 }
 
@@ -241,6 +246,8 @@ CCScheduler::CCScheduler(void)
 , m_pUpdatesPosList(NULL)
 , m_pHashForUpdates(NULL)
 , m_pHashForTimers(NULL)
+, m_dTime(0)
+, m_uTimerSequence(0)
 , m_pCurrentTarget(NULL)
 , m_bCurrentTargetSalvaged(false)
 , m_bUpdateHashLocked(false)
@@ -260,6 +267,10 @@ void CCScheduler::removeHashElement(_hashSelectorEntry *pElement)
 
 	cocos2d::CCObject *target = pElement->target;
 
+    for (unsigned int i = 0; i < pElement->timers->num; ++i)
+    {
+        unqueueTimer((CCTimer*)pElement->timers->arr[i]);
+    }
     ccArrayFree(pElement->timers);
     HASH_DEL(m_pHashForTimers, pElement);
     free(pElement);
@@ -316,6 +327,12 @@ void CCScheduler::scheduleSelector(SEL_SCHEDULE pfnSelector, CCObject *pTarget,
             {
                 CCLOG("CCScheduler#scheduleSelector. Selector already scheduled. Updating interval from: %.4f to %.4f", timer->getInterval(), fInterval);
                 timer->setInterval(fInterval);
+                // the fire time depends on the interval
+                if (timer->m_uHeapIndex < kCCTimerDue)
+                {
+                    unqueueTimer(timer);
+                    queueTimer(timer);
+                }
                 return;
             }        
         }
@@ -326,6 +343,11 @@ void CCScheduler::scheduleSelector(SEL_SCHEDULE pfnSelector, CCObject *pTarget,
     pTimer->initWithTarget(pTarget, pfnSelector, fInterval, repeat, delay);
     ccArrayAppendObject(pElement->timers, pTimer);
     pTimer->release();    
+
+    if (! pElement->paused)
+    {
+        queueTimer(pTimer);
+    }
 }
 
 void CCScheduler::unscheduleSelector(SEL_SCHEDULE pfnSelector, CCObject *pTarget)
@@ -350,20 +372,10 @@ void CCScheduler::unscheduleSelector(SEL_SCHEDULE pfnSelector, CCObject *pTarget
 
             if (pfnSelector == pTimer->getSelector())
             {
-                if (pTimer == pElement->currentTimer && (! pElement->currentTimerSalvaged))
-                {
-                    pElement->currentTimer->retain();
-                    pElement->currentTimerSalvaged = true;
-                }
-
+                // a timer being fired is retained by update() until its step is done
+                unqueueTimer(pTimer);
                 ccArrayRemoveObjectAtIndex(pElement->timers, i, true);
 
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (pElement->timerIndex >= i)
-                {
-                    pElement->timerIndex--;
-                }
-
                 if (pElement->timers->num == 0)
                 {
                     if (m_pCurrentTarget == pElement)
@@ -603,11 +615,10 @@ void CCScheduler::unscheduleAllForTarget(CCObject *pTarget)
 
     if (pElement)
     {
-        if (ccArrayContainsObject(pElement->timers, pElement->currentTimer)
-            && (! pElement->currentTimerSalvaged))
+        // a timer being fired is retained by update() until its step is done
+        for (unsigned int i = 0; i < pElement->timers->num; ++i)
         {
-            pElement->currentTimer->retain();
-            pElement->currentTimerSalvaged = true;
+            unqueueTimer((CCTimer*)pElement->timers->arr[i]);
         }
         ccArrayRemoveAllObjects(pElement->timers);
 
@@ -659,7 +670,7 @@ void CCScheduler::resumeTarget(CCObject *pTarget)
     HASH_FIND_INT(m_pHashForTimers, &pTarget, pElement);
     if (pElement)
     {
-        pElement->paused = false;
+        resumeTimers(pElement);
     }
 
     // update selector
@@ -681,7 +692,7 @@ void CCScheduler::pauseTarget(CCObject *pTarget)
     HASH_FIND_INT(m_pHashForTimers, &pTarget, pElement);
     if (pElement)
     {
-        pElement->paused = true;
+        pauseTimers(pElement);
     }
 
     // update selector
@@ -731,7 +742,7 @@ CCSet* CCScheduler::pauseAllTargetsWithMinPriority(int nMinPriority)
     for(tHashTimerEntry *element = m_pHashForTimers; element != NULL;
         element = (tHashTimerEntry*)element->hh.next)
     {
-        element->paused = true;
+        pauseTimers(element);
         idsWithSelectors->addObject(element->target);
     }
 
@@ -779,6 +790,143 @@ void CCScheduler::resumeTargets(CCSet* pTargetsToResume)
     }
 }
 
+// custom selectors heap
+
+void CCScheduler::queueTimer(CCTimer *pTimer)
+{
+    if (pTimer->m_fElapsed == -1)
+    {
+        // the first tick only starts the timer
+        pTimer->m_dFireTime = m_dTime;
+    }
+    else
+    {
+        float fThreshold = pTimer->m_bUseDelay ? pTimer->m_fDelay : pTimer->m_fInterval;
+        pTimer->m_dFireTime = pTimer->m_dLastTime + (fThreshold - pTimer->m_fElapsed);
+    }
+    pTimer->m_uSequence = m_uTimerSequence++;
+    pTimer->m_uHeapIndex = (unsigned int)m_obTimerHeap.size();
+    m_obTimerHeap.push_back(pTimer);
+    siftTimerUp(pTimer->m_uHeapIndex);
+}
+
+void CCScheduler::unqueueTimer(CCTimer *pTimer)
+{
+    unsigned int uIndex = pTimer->m_uHeapIndex;
+    pTimer->m_uHeapIndex = kCCTimerNotQueued;
+
+    if (uIndex >= kCCTimerDue)
+    {
+        return;
+    }
+
+    CCTimer *pLast = m_obTimerHeap.back();
+    m_obTimerHeap.pop_back();
+    if (pLast != pTimer)
+    {
+        m_obTimerHeap[uIndex] = pLast;
+        pLast->m_uHeapIndex = uIndex;
+        siftTimerUp(uIndex);
+        siftTimerDown(pLast->m_uHeapIndex);
+    }
+}
+
+bool CCScheduler::isTimerBefore(CCTimer *pTimer1, CCTimer *pTimer2)
+{
+    if (pTimer1->m_dFireTime != pTimer2->m_dFireTime)
+    {
+        return pTimer1->m_dFireTime < pTimer2->m_dFireTime;
+    }
+    // wrap-around safe comparison of the scheduling order
+    return (int)(pTimer1->m_uSequence - pTimer2->m_uSequence) < 0;
+}
+
+void CCScheduler::siftTimerUp(unsigned int uIndex)
+{
+    CCTimer *pTimer = m_obTimerHeap[uIndex];
+    while (uIndex > 0)
+    {
+        unsigned int uParent = (uIndex - 1) / 2;
+        CCTimer *pParent = m_obTimerHeap[uParent];
+        if (! isTimerBefore(pTimer, pParent))
+        {
+            break;
+        }
+        m_obTimerHeap[uIndex] = pParent;
+        pParent->m_uHeapIndex = uIndex;
+        uIndex = uParent;
+    }
+    m_obTimerHeap[uIndex] = pTimer;
+    pTimer->m_uHeapIndex = uIndex;
+}
+
+void CCScheduler::siftTimerDown(unsigned int uIndex)
+{
+    unsigned int uCount = (unsigned int)m_obTimerHeap.size();
+    CCTimer *pTimer = m_obTimerHeap[uIndex];
+    while (true)
+    {
+        unsigned int uChild = uIndex * 2 + 1;
+        if (uChild >= uCount)
+        {
+            break;
+        }
+        if (uChild + 1 < uCount && isTimerBefore(m_obTimerHeap[uChild + 1], m_obTimerHeap[uChild]))
+        {
+            ++uChild;
+        }
+        if (! isTimerBefore(m_obTimerHeap[uChild], pTimer))
+        {
+            break;
+        }
+        m_obTimerHeap[uIndex] = m_obTimerHeap[uChild];
+        m_obTimerHeap[uIndex]->m_uHeapIndex = uIndex;
+        uIndex = uChild;
+    }
+    m_obTimerHeap[uIndex] = pTimer;
+    pTimer->m_uHeapIndex = uIndex;
+}
+
+void CCScheduler::pauseTimers(tHashTimerEntry *pElement)
+{
+    if (pElement->paused)
+    {
+        return;
+    }
+    pElement->paused = true;
+
+    // paused timers don't accumulate time: save what they got so far and leave the heap
+    for (unsigned int i = 0; i < pElement->timers->num; ++i)
+    {
+        CCTimer *pTimer = (CCTimer*)pElement->timers->arr[i];
+        if (pTimer->m_fElapsed != -1)
+        {
+            pTimer->m_fElapsed += (float)(m_dTime - pTimer->m_dLastTime);
+            pTimer->m_dLastTime = m_dTime;
+        }
+        unqueueTimer(pTimer);
+    }
+}
+
+void CCScheduler::resumeTimers(tHashTimerEntry *pElement)
+{
+    if (! pElement->paused)
+    {
+        return;
+    }
+    pElement->paused = false;
+
+    for (unsigned int i = 0; i < pElement->timers->num; ++i)
+    {
+        CCTimer *pTimer = (CCTimer*)pElement->timers->arr[i];
+        if (pTimer->m_uHeapIndex == kCCTimerNotQueued)
+        {
+            pTimer->m_dLastTime = m_dTime;
+            queueTimer(pTimer);
+        }
+    }
+}
+
 // main loop
 void CCScheduler::update(float dt)
 {
@@ -819,44 +967,59 @@ void CCScheduler::update(float dt)
         }
     }
 
-    // Iterate over all the custom selectors
-    for (tHashTimerEntry *elt = m_pHashForTimers; elt != NULL; )
+    // Iterate over the custom selectors that are due
+    m_dTime += dt;
+
+    // Take the due timers out of the heap first: a timer rescheduled during this tick
+    // (interval 0, or an interval shorter than the frame) will only fire again on the next one
+    while (! m_obTimerHeap.empty() && m_obTimerHeap[0]->m_dFireTime <= m_dTime)
+    {
+        CCTimer *pTimer = m_obTimerHeap[0];
+        unqueueTimer(pTimer);
+        pTimer->m_uHeapIndex = kCCTimerDue;
+        // keep it alive until its step is done, even if its selector is unscheduled meanwhile
+        pTimer->retain();
+        m_obDueTimers.push_back(pTimer);
+    }
+
+    for (unsigned int i = 0; i < m_obDueTimers.size(); ++i)
     {
-        m_pCurrentTarget = elt;
-        m_bCurrentTargetSalvaged = false;
+        CCTimer *pTimer = m_obDueTimers[i];
 
-        if (! m_pCurrentTarget->paused)
+        // not unscheduled nor paused by a previous timer of this tick
+        if (pTimer->m_uHeapIndex == kCCTimerDue)
         {
-            // The 'timers' array may change while inside this loop
-            for (elt->timerIndex = 0; elt->timerIndex < elt->timers->num; ++(elt->timerIndex))
-            {
-                elt->currentTimer = (CCTimer*)(elt->timers->arr[elt->timerIndex]);
-                elt->currentTimerSalvaged = false;
+            tHashTimerEntry *elt = NULL;
+            CCObject *pTarget = pTimer->m_pTarget;
+            HASH_FIND_INT(m_pHashForTimers, &pTarget, elt);
+            CCAssert(elt != NULL, "CCScheduler: due timer without target entry");
 
-                elt->currentTimer->update(dt);
+            m_pCurrentTarget = elt;
+            m_bCurrentTargetSalvaged = false;
 
-                if (elt->currentTimerSalvaged)
-                {
-                    // The currentTimer told the remove itself. To prevent the timer from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    elt->currentTimer->release();
-                }
+            float fElapsed = (float)(m_dTime - pTimer->m_dLastTime);
+            pTimer->m_dLastTime = m_dTime;
+            pTimer->update(fElapsed);
+
+            if (pTimer->m_uHeapIndex == kCCTimerDue)
+            {
+                queueTimer(pTimer);
+            }
 
-                elt->currentTimer = NULL;
+            // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
+            if (m_bCurrentTargetSalvaged && m_pCurrentTarget->timers->num == 0)
+            {
+                removeHashElement(m_pCurrentTarget);
             }
+            m_pCurrentTarget = NULL;
         }
 
-        // elt, at this moment, is still valid
-        // so it is safe to ask this here (issue #490)
-        elt = (tHashTimerEntry *)elt->hh.next;
-
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (m_bCurrentTargetSalvaged && m_pCurrentTarget->timers->num == 0)
-        {
-            removeHashElement(m_pCurrentTarget);
-        }
+        // The timer may have been unscheduled during its step. To prevent it from
+        // accidentally deallocating itself before finishing its step, we retained
+        // it. Now that step is done, it's safe to release it.
+        pTimer->release();
     }
+    m_obDueTimers.clear();
 
     // Iterate over all the script callbacks
     if (m_pScriptHandlerEntries)
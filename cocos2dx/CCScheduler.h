@@ -29,6 +29,7 @@ THE SOFTWARE.
 
 #include "cocoa/CCObject.h"
 #include "support/data_support/uthash.h"
+#include <vector>
 
 NS_CC_BEGIN
 
@@ -113,6 +114,18 @@ protected:
     SEL_SCHEDULE m_pfnSelector;
     
     int m_nScriptHandler;
+
+    // Bookkeeping of CCScheduler, which only updates the timers that are due.
+    // scheduler time of the next update of the timer
+    double m_dFireTime;
+    // scheduler time of the last update of the timer
+    double m_dLastTime;
+    // position in the scheduler timer heap, or one of the kCCTimerNotQueued/kCCTimerDue states
+    unsigned int m_uHeapIndex;
+    // breaks the ties between timers due at the same time, in scheduling order
+    unsigned int m_uSequence;
+
+    friend class CCScheduler;
 };
 
 //
@@ -291,6 +304,15 @@ private:
     void priorityIn(struct _listEntry **ppList, CCObject *pTarget, int nPriority, bool bPaused);
     void appendIn(struct _listEntry **ppList, CCObject *pTarget, bool bPaused);
 
+    // custom selectors specific
+    void queueTimer(CCTimer *pTimer);
+    void unqueueTimer(CCTimer *pTimer);
+    void pauseTimers(struct _hashSelectorEntry *pElement);
+    void resumeTimers(struct _hashSelectorEntry *pElement);
+    bool isTimerBefore(CCTimer *pTimer1, CCTimer *pTimer2);
+    void siftTimerUp(unsigned int uIndex);
+    void siftTimerDown(unsigned int uIndex);
+
 protected:
     float m_fTimeScale;
 
@@ -304,6 +326,13 @@ protected:
 
     // Used for "selectors with interval"
     struct _hashSelectorEntry *m_pHashForTimers;
+    // min-heap of the running timers, ordered by fire time, so that a tick only touches the timers that are due
+    std::vector<CCTimer*> m_obTimerHeap;
+    // timers being fired during the current tick
+    std::vector<CCTimer*> m_obDueTimers;
+    // scaled time elapsed since the scheduler was created
+    double m_dTime;
+    unsigned int m_uTimerSequence;
     struct _hashSelectorEntry *m_pCurrentTarget;
     bool m_bCurrentTargetSalvaged;
     // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
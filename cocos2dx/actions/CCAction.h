@@ -122,6 +122,11 @@ protected:
     CCNode    *m_pTarget;
     /** The action tag. An identifier of the action */
     int     m_nTag;
+private:
+    /** Index of the action in the running list of its CCActionManager */
+    unsigned int m_uManagerIndex;
+
+    friend class CCActionManager;
 };
 
 /** 
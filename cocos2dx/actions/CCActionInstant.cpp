@@ -376,6 +376,8 @@ void CCPlace::update(float time) {
 //
 // CallFunc
 //
+CC_IMPLEMENT_ACTION_POOL(CCCallFunc)
+
 CCCallFunc * CCCallFunc::create(CCObject* pSelectorTarget, SEL_CallFunc selector) 
 {
     CCCallFunc *pRet = new CCCallFunc();
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include <string>
 #include "ccTypeInfo.h"
 #include "CCAction.h"
+#include "CCActionPool.h"
 
 NS_CC_BEGIN
 
@@ -372,6 +373,8 @@ protected:
         SEL_CallFuncND    m_pCallFuncND;
         SEL_CallFuncO   m_pCallFuncO;
     };
+
+    CC_DECLARE_ACTION_POOL
 };
 
 /** 
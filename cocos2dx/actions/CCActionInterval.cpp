@@ -190,6 +190,8 @@ CCActionInterval* CCActionInterval::reverse(void)
 // Sequence
 //
 
+CC_IMPLEMENT_ACTION_POOL(CCSequence)
+
 CCSequence* CCSequence::createWithTwoActions(CCFiniteTimeAction *pActionOne, CCFiniteTimeAction *pActionTwo)
 {
     CCSequence *pSequence = new CCSequence();
@@ -1081,6 +1083,8 @@ void CCMoveBy::update(float t)
 // MoveTo
 //
 
+CC_IMPLEMENT_ACTION_POOL(CCMoveTo)
+
 CCMoveTo* CCMoveTo::create(float duration, const CCPoint& position)
 {
     CCMoveTo *pRet = new CCMoveTo();
@@ -2147,6 +2151,8 @@ CCActionInterval* CCTintBy::reverse(void)
 //
 // DelayTime
 //
+CC_IMPLEMENT_ACTION_POOL(CCDelayTime)
+
 CCDelayTime* CCDelayTime::create(float d)
 {
     CCDelayTime* pAction = new CCDelayTime();
@@ -29,6 +29,7 @@ THE SOFTWARE.
 
 #include "base_nodes/CCNode.h"
 #include "CCAction.h"
+#include "CCActionPool.h"
 #include "CCProtocols.h"
 #include "sprite_nodes/CCSpriteFrame.h"
 #include "sprite_nodes/CCAnimation.h"
@@ -152,6 +153,8 @@ protected:
     CCFiniteTimeAction *m_pActions[2];
     float m_split;
     int m_last;
+
+    CC_DECLARE_ACTION_POOL
 };
 
 /** @brief Repeats an action a number of times.
@@ -436,6 +439,8 @@ public:
     static CCMoveTo* create(float duration, const CCPoint& position);
 protected:
     CCPoint m_endPosition;
+
+    CC_DECLARE_ACTION_POOL
 };
 
 /** Skews a CCNode object to given angles by modifying it's skewX and skewY attributes
@@ -837,6 +842,8 @@ public:
 
     /** creates the action */
     static CCDelayTime* create(float d);
+
+    CC_DECLARE_ACTION_POOL
 };
 
 /** @brief Executes an action in reverse order, from time=duration to time=0
@@ -41,17 +41,20 @@ typedef struct _hashElement
 {
     struct _ccArray             *actions;
     CCObject                    *target;
-    unsigned int                actionIndex;
-    CCAction                    *currentAction;
-    bool                        currentActionSalvaged;
     bool                        paused;
     UT_hash_handle                hh;
 } tHashElement;
 
+typedef struct _actionSlot tActionSlot;
+
 CCActionManager::CCActionManager(void)
 : m_pTargets(NULL), 
   m_pCurrentTarget(NULL),
-  m_bCurrentTargetSalvaged(false)
+  m_bCurrentTargetSalvaged(false),
+  m_uDeadActions(0),
+  m_pCurrentAction(NULL),
+  m_bCurrentActionSalvaged(false),
+  m_bUpdating(false)
 {
 
 }
@@ -87,23 +90,78 @@ void CCActionManager::actionAllocWithHashElement(tHashElement *pElement)
 
 }
 
-void CCActionManager::removeActionAtIndex(unsigned int uIndex, tHashElement *pElement)
+void CCActionManager::killRunningAction(CCAction *pAction)
 {
-    CCAction *pAction = (CCAction*)pElement->actions->arr[uIndex];
+    unsigned int uIndex = pAction->m_uManagerIndex;
+    if (uIndex >= m_obRunningActions.size() || m_obRunningActions[uIndex].action != pAction)
+    {
+        // the same action was started twice, fall back to a search
+        for (uIndex = 0; uIndex < m_obRunningActions.size(); ++uIndex)
+        {
+            if (m_obRunningActions[uIndex].action == pAction)
+            {
+                break;
+            }
+        }
+        if (uIndex == m_obRunningActions.size())
+        {
+            return;
+        }
+    }
 
-    if (pAction == pElement->currentAction && (! pElement->currentActionSalvaged))
+    m_obRunningActions[uIndex].action = NULL;
+    pAction->m_uManagerIndex = UINT_MAX;
+    ++m_uDeadActions;
+}
+
+void CCActionManager::compactRunningActions(void)
+{
+    unsigned int uCount = (unsigned int)m_obRunningActions.size();
+    unsigned int uLive = 0;
+    for (unsigned int i = 0; i < uCount; ++i)
     {
-        pElement->currentAction->retain();
-        pElement->currentActionSalvaged = true;
+        tActionSlot &slot = m_obRunningActions[i];
+        if (slot.action != NULL)
+        {
+            // keep the insertion order so that actions of a target are stepped in order
+            slot.action->m_uManagerIndex = uLive;
+            m_obRunningActions[uLive++] = slot;
+        }
     }
+    m_obRunningActions.resize(uLive);
+    m_uDeadActions = 0;
+}
 
-    ccArrayRemoveObjectAtIndex(pElement->actions, uIndex, true);
+void CCActionManager::setTargetActionsPaused(tHashElement *pElement, bool bPaused)
+{
+    pElement->paused = bPaused;
+    if (pElement->actions == NULL)
+    {
+        return;
+    }
 
-    // update actionIndex in case we are in tick. looping over the actions
-    if (pElement->actionIndex >= uIndex)
+    for (unsigned int i = 0; i < pElement->actions->num; ++i)
     {
-        pElement->actionIndex--;
+        unsigned int uIndex = ((CCAction*)pElement->actions->arr[i])->m_uManagerIndex;
+        if (uIndex < m_obRunningActions.size())
+        {
+            m_obRunningActions[uIndex].paused = bPaused;
+        }
     }
+}
+
+void CCActionManager::removeActionAtIndex(unsigned int uIndex, tHashElement *pElement)
+{
+    CCAction *pAction = (CCAction*)pElement->actions->arr[uIndex];
+
+    if (pAction == m_pCurrentAction && (! m_bCurrentActionSalvaged))
+    {
+        m_pCurrentAction->retain();
+        m_bCurrentActionSalvaged = true;
+    }
+
+    killRunningAction(pAction);
+    ccArrayRemoveObjectAtIndex(pElement->actions, uIndex, true);
 
     if (pElement->actions->num == 0)
     {
@@ -126,7 +184,7 @@ void CCActionManager::pauseTarget(CCObject *pTarget)
     HASH_FIND_INT(m_pTargets, &pTarget, pElement);
     if (pElement)
     {
-        pElement->paused = true;
+        setTargetActionsPaused(pElement, true);
     }
 }
 
@@ -136,7 +194,7 @@ void CCActionManager::resumeTarget(CCObject *pTarget)
     HASH_FIND_INT(m_pTargets, &pTarget, pElement);
     if (pElement)
     {
-        pElement->paused = false;
+        setTargetActionsPaused(pElement, false);
     }
 }
 
@@ -149,7 +207,7 @@ CCSet* CCActionManager::pauseAllRunningActions()
     {
         if (! element->paused) 
         {
-            element->paused = true;
+            setTargetActionsPaused(element, true);
             idsWithActions->addObject(element->target);
         }
     }    
@@ -190,6 +248,19 @@ void CCActionManager::addAction(CCAction *pAction, CCNode *pTarget, bool paused)
  
      CCAssert(! ccArrayContainsObject(pElement->actions, pAction), "");
      ccArrayAppendObject(pElement->actions, pAction);
+
+     // reclaim the dead slots left by removals made outside of update()
+     if (! m_bUpdating && m_uDeadActions > 0 && m_uDeadActions * 2 >= m_obRunningActions.size())
+     {
+         compactRunningActions();
+     }
+
+     tActionSlot slot;
+     slot.action = pAction;
+     slot.element = pElement;
+     slot.paused = pElement->paused;
+     pAction->m_uManagerIndex = (unsigned int)m_obRunningActions.size();
+     m_obRunningActions.push_back(slot);
  
      pAction->startWithTarget(pTarget);
 }
@@ -218,12 +289,16 @@ void CCActionManager::removeAllActionsFromTarget(CCObject *pTarget)
     HASH_FIND_INT(m_pTargets, &pTarget, pElement);
     if (pElement)
     {
-        if (ccArrayContainsObject(pElement->actions, pElement->currentAction) && (! pElement->currentActionSalvaged))
+        if (ccArrayContainsObject(pElement->actions, m_pCurrentAction) && (! m_bCurrentActionSalvaged))
         {
-            pElement->currentAction->retain();
-            pElement->currentActionSalvaged = true;
+            m_pCurrentAction->retain();
+            m_bCurrentActionSalvaged = true;
         }
 
+        for (unsigned int i = 0; i < pElement->actions->num; ++i)
+        {
+            killRunningAction((CCAction*)pElement->actions->arr[i]);
+        }
         ccArrayRemoveAllObjects(pElement->actions);
         if (m_pCurrentTarget == pElement)
         {
@@ -338,53 +413,49 @@ unsigned int CCActionManager::numberOfRunningActionsInTarget(CCObject *pTarget)
 // main loop
 void CCActionManager::update(float dt)
 {
-    for (tHashElement *elt = m_pTargets; elt != NULL; )
-    {
-        m_pCurrentTarget = elt;
-        m_bCurrentTargetSalvaged = false;
+    m_bUpdating = true;
 
-        if (! m_pCurrentTarget->paused)
+    // Actions added while stepping are appended and stepped in this same pass.
+    // The vector may grow meanwhile, so slots are read by index and copied.
+    for (unsigned int i = 0; i < m_obRunningActions.size(); ++i)
+    {
+        tActionSlot slot = m_obRunningActions[i];
+        if (slot.action == NULL || slot.paused)
         {
-            // The 'actions' CCMutableArray may change while inside this loop.
-            for (m_pCurrentTarget->actionIndex = 0; m_pCurrentTarget->actionIndex < m_pCurrentTarget->actions->num;
-                m_pCurrentTarget->actionIndex++)
-            {
-                m_pCurrentTarget->currentAction = (CCAction*)m_pCurrentTarget->actions->arr[m_pCurrentTarget->actionIndex];
-                if (m_pCurrentTarget->currentAction == NULL)
-                {
-                    continue;
-                }
-
-                m_pCurrentTarget->currentActionSalvaged = false;
+            continue;
+        }
 
-                m_pCurrentTarget->currentAction->step(dt);
+        m_pCurrentTarget = slot.element;
+        m_bCurrentTargetSalvaged = false;
+        m_pCurrentAction = slot.action;
+        m_bCurrentActionSalvaged = false;
 
-                if (m_pCurrentTarget->currentActionSalvaged)
-                {
-                    // The currentAction told the node to remove it. To prevent the action from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    m_pCurrentTarget->currentAction->release();
-                } else
-                if (m_pCurrentTarget->currentAction->isDone())
-                {
-                    m_pCurrentTarget->currentAction->stop();
+        m_pCurrentAction->step(dt);
 
-                    CCAction *pAction = m_pCurrentTarget->currentAction;
-                    // Make currentAction nil to prevent removeAction from salvaging it.
-                    m_pCurrentTarget->currentAction = NULL;
-                    removeAction(pAction);
-                }
+        if (m_bCurrentActionSalvaged)
+        {
+            // The currentAction told the node to remove it. To prevent the action from
+            // accidentally deallocating itself before finishing its step, we retained
+            // it. Now that step is done, it's safe to release it.
+            m_pCurrentAction->release();
+        } else
+        if (m_pCurrentAction->isDone())
+        {
+            m_pCurrentAction->stop();
 
-                m_pCurrentTarget->currentAction = NULL;
+            CCAction *pAction = m_pCurrentAction;
+            // Make currentAction nil to prevent removeAction from salvaging it.
+            m_pCurrentAction = NULL;
+            unsigned int uIndex = ccArrayGetIndexOfObject(m_pCurrentTarget->actions, pAction);
+            if (UINT_MAX != uIndex)
+            {
+                removeActionAtIndex(uIndex, m_pCurrentTarget);
             }
         }
 
-        // elt, at this moment, is still valid
-        // so it is safe to ask this here (issue #490)
-        elt = (tHashElement*)(elt->hh.next);
+        m_pCurrentAction = NULL;
 
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
+        // only delete currentTarget if no actions were scheduled during the step (issue #481)
         if (m_bCurrentTargetSalvaged && m_pCurrentTarget->actions->num == 0)
         {
             deleteHashElement(m_pCurrentTarget);
@@ -393,6 +464,13 @@ void CCActionManager::update(float dt)
 
     // issue #635
     m_pCurrentTarget = NULL;
+    m_bUpdating = false;
+
+    // deferred removals
+    if (m_uDeadActions > 0)
+    {
+        compactRunningActions();
+    }
 }
 
 NS_CC_END
@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "CCAction.h"
 #include "cocoa/CCArray.h"
 #include "cocoa/CCObject.h"
+#include <vector>
 
 NS_CC_BEGIN
 
@@ -38,6 +39,18 @@ class CCSet;
 
 struct _hashElement;
 
+/** Hot state of a running action, stored contiguously by CCActionManager.
+ A NULL action marks a dead slot waiting to be compacted.
+ @js NA
+ @lua NA
+ */
+struct _actionSlot
+{
+    CCAction            *action;
+    struct _hashElement *element;
+    bool                paused;
+};
+
 /**
  * @addtogroup actions
  * @{
@@ -51,6 +64,10 @@ struct _hashElement;
  Examples:
     - When you want to run an action where the target is different from a CCNode. 
     - When you want to pause / resume the actions
+
+ Running actions are kept in a single contiguous list which is stepped in one linear pass
+ every frame. Actions removed while the list is being stepped are only marked as dead and
+ the list is compacted at the end of the frame.
  
  @since v0.8
  */
@@ -128,10 +145,21 @@ protected:
     void actionAllocWithHashElement(struct _hashElement *pElement);
     void update(float dt);
 
+    /** marks the running slot of pAction as dead, it is reclaimed by compactRunningActions() */
+    void killRunningAction(CCAction *pAction);
+    void setTargetActionsPaused(struct _hashElement *pElement, bool bPaused);
+    void compactRunningActions(void);
+
 protected:
     struct _hashElement    *m_pTargets;
     struct _hashElement    *m_pCurrentTarget;
     bool            m_bCurrentTargetSalvaged;
+    /** every running action in insertion order, see struct _actionSlot */
+    std::vector<struct _actionSlot> m_obRunningActions;
+    unsigned int    m_uDeadActions;
+    CCAction        *m_pCurrentAction;
+    bool            m_bCurrentActionSalvaged;
+    bool            m_bUpdating;
 };
 
 // end of actions group
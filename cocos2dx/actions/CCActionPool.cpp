@@ -0,0 +1,171 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCActionPool.h"
+#include "ccMacros.h"
+#include <new>
+
+NS_CC_BEGIN
+
+// Pools are never destroyed: actions may still be released by static destructors
+// at exit, so the list is only made of plain pointers.
+static CCActionPool *s_pFirstPool = NULL;
+// read by the pools created after setAllPoolsEnabled()
+static bool s_bAllPoolsEnabled = false;
+
+CCActionPool::CCActionPool(const char *pszName, size_t uObjectSize)
+: m_pszName(pszName)
+, m_uObjectSize(uObjectSize)
+, m_bEnabled(s_bAllPoolsEnabled)
+, m_uCapacity(4096)
+, m_pFreeList(NULL)
+, m_uFreeCount(0)
+, m_uLiveCount(0)
+, m_uHits(0)
+, m_uMisses(0)
+, m_uHighWaterMark(0)
+, m_pNextPool(s_pFirstPool)
+{
+    CCAssert(uObjectSize >= sizeof(void*), "CCActionPool: object too small");
+    s_pFirstPool = this;
+}
+
+void* CCActionPool::allocate(size_t uSize)
+{
+    // a subclass which didn't opt in
+    if (uSize != m_uObjectSize)
+    {
+        return ::operator new(uSize);
+    }
+
+    void *p = NULL;
+    if (m_pFreeList)
+    {
+        p = m_pFreeList;
+        m_pFreeList = *(void**)p;
+        --m_uFreeCount;
+        ++m_uHits;
+    }
+    else
+    {
+        p = ::operator new(uSize);
+        if (m_bEnabled)
+        {
+            ++m_uMisses;
+        }
+    }
+
+    if (++m_uLiveCount > m_uHighWaterMark)
+    {
+        m_uHighWaterMark = m_uLiveCount;
+    }
+    return p;
+}
+
+void CCActionPool::deallocate(void *p, size_t uSize)
+{
+    if (p == NULL)
+    {
+        return;
+    }
+
+    if (uSize != m_uObjectSize)
+    {
+        ::operator delete(p);
+        return;
+    }
+
+    --m_uLiveCount;
+    if (m_bEnabled && m_uFreeCount < m_uCapacity)
+    {
+        *(void**)p = m_pFreeList;
+        m_pFreeList = p;
+        ++m_uFreeCount;
+    }
+    else
+    {
+        ::operator delete(p);
+    }
+}
+
+void CCActionPool::setEnabled(bool bEnabled)
+{
+    m_bEnabled = bEnabled;
+    if (! bEnabled)
+    {
+        purge();
+    }
+}
+
+void CCActionPool::purge(void)
+{
+    while (m_pFreeList)
+    {
+        void *p = m_pFreeList;
+        m_pFreeList = *(void**)p;
+        ::operator delete(p);
+    }
+    m_uFreeCount = 0;
+}
+
+void CCActionPool::resetCounters(void)
+{
+    m_uHits = 0;
+    m_uMisses = 0;
+    m_uHighWaterMark = m_uLiveCount;
+}
+
+void CCActionPool::setAllPoolsEnabled(bool bEnabled)
+{
+    s_bAllPoolsEnabled = bEnabled;
+    for (CCActionPool *pPool = s_pFirstPool; pPool; pPool = pPool->m_pNextPool)
+    {
+        pPool->setEnabled(bEnabled);
+    }
+}
+
+void CCActionPool::purgeAllPools(void)
+{
+    for (CCActionPool *pPool = s_pFirstPool; pPool; pPool = pPool->m_pNextPool)
+    {
+        pPool->purge();
+    }
+}
+
+void CCActionPool::dumpAllPools(void)
+{
+    for (CCActionPool *pPool = s_pFirstPool; pPool; pPool = pPool->m_pNextPool)
+    {
+        CCLOG("cocos2d: CCActionPool: \"%s\" %s hits=%u misses=%u live=%u free=%u high water=%u",
+            pPool->m_pszName,
+            pPool->m_bEnabled ? "enabled" : "disabled",
+            pPool->m_uHits,
+            pPool->m_uMisses,
+            pPool->m_uLiveCount,
+            pPool->m_uFreeCount,
+            pPool->m_uHighWaterMark);
+    }
+}
+
+NS_CC_END
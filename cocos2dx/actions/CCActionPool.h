@@ -0,0 +1,135 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __ACTIONS_CCACTION_POOL_H__
+#define __ACTIONS_CCACTION_POOL_H__
+
+#include "platform/CCPlatformMacros.h"
+#include <stddef.h>
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup actions
+ * @{
+ */
+
+/** @brief CCActionPool is a free list recycling the memory of one action class.
+
+ A class opts in with CC_DECLARE_ACTION_POOL in its declaration and CC_IMPLEMENT_ACTION_POOL
+ in its implementation file. Its instances are then allocated through the pool of the class,
+ and once their retain count drops to zero the memory goes back to the pool instead of the heap.
+ Subclasses that don't opt in themselves use the heap as usual.
+
+ Pools are disabled by default, enable the ones you need with setEnabled(), or all of them with
+ setAllPoolsEnabled(). Every pool exists from the time the program is loaded. They are not thread
+ safe: pooled actions must be created and released on the main thread.
+ @since v2.2
+ @js NA
+ @lua NA
+ */
+class CC_DLL CCActionPool
+{
+public:
+    CCActionPool(const char *pszName, size_t uObjectSize);
+
+    void* allocate(size_t uSize);
+    void deallocate(void *p, size_t uSize);
+
+    /** When disabled, the free objects are released and allocations go to the heap */
+    void setEnabled(bool bEnabled);
+    inline bool isEnabled(void) { return m_bEnabled; }
+
+    /** Maximum number of free objects kept by the pool. Default is 4096 */
+    inline void setCapacity(unsigned int uCapacity) { m_uCapacity = uCapacity; }
+    inline unsigned int getCapacity(void) { return m_uCapacity; }
+
+    /** Releases the free objects */
+    void purge(void);
+
+    inline const char* getName(void) { return m_pszName; }
+    /** allocations served by the free list */
+    inline unsigned int getHits(void) { return m_uHits; }
+    /** allocations that went to the heap while the pool was enabled */
+    inline unsigned int getMisses(void) { return m_uMisses; }
+    /** number of objects currently alive */
+    inline unsigned int getLiveCount(void) { return m_uLiveCount; }
+    /** highest number of objects alive at the same time */
+    inline unsigned int getHighWaterMark(void) { return m_uHighWaterMark; }
+    /** number of objects waiting in the free list */
+    inline unsigned int getFreeCount(void) { return m_uFreeCount; }
+    void resetCounters(void);
+
+    /** Enables or disables every pool, including the pools of the classes not used yet */
+    static void setAllPoolsEnabled(bool bEnabled);
+    static void purgeAllPools(void);
+    /** Logs the counters of every pool */
+    static void dumpAllPools(void);
+
+private:
+    const char      *m_pszName;
+    size_t          m_uObjectSize;
+    bool            m_bEnabled;
+    unsigned int    m_uCapacity;
+    void            *m_pFreeList;
+    unsigned int    m_uFreeCount;
+    unsigned int    m_uLiveCount;
+    unsigned int    m_uHits;
+    unsigned int    m_uMisses;
+    unsigned int    m_uHighWaterMark;
+    CCActionPool    *m_pNextPool;
+};
+
+/** Makes the class allocate its instances through its own CCActionPool.
+ Put it at the end of the class declaration, it leaves the access specifier public.
+ */
+#define CC_DECLARE_ACTION_POOL \
+public: \
+    static cocos2d::CCActionPool* sharedActionPool(void); \
+    static void* operator new(size_t uSize); \
+    static void operator delete(void *p, size_t uSize);
+
+#define CC_IMPLEMENT_ACTION_POOL(__CLASS__) \
+cocos2d::CCActionPool* __CLASS__::sharedActionPool(void) \
+{ \
+    static cocos2d::CCActionPool s_actionPool(#__CLASS__, sizeof(__CLASS__)); \
+    return &s_actionPool; \
+} \
+/* creates the pool when the program is loaded, so that the functions on all pools reach it */ \
+static cocos2d::CCActionPool *s_p##__CLASS__##ActionPool = __CLASS__::sharedActionPool(); \
+void* __CLASS__::operator new(size_t uSize) \
+{ \
+    return sharedActionPool()->allocate(uSize); \
+} \
+void __CLASS__::operator delete(void *p, size_t uSize) \
+{ \
+    sharedActionPool()->deallocate(p, uSize); \
+}
+
+// end of actions group
+/// @}
+
+NS_CC_END
+
+#endif // __ACTIONS_CCACTION_POOL_H__
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "CCDirector.h"
 #include "CCScheduler.h"
 #include "touch_dispatcher/CCTouch.h"
+#include "touch_dispatcher/CCTouchDispatcher.h"
 #include "actions/CCActionManager.h"
 #include "script_support/CCScriptSupport.h"
 #include "shaders/CCGLProgram.h"
@@ -40,6 +41,8 @@ THE SOFTWARE.
 #include "kazmath/GL/matrix.h"
 #include "support/component/CCComponent.h"
 #include "support/component/CCComponentContainer.h"
+#include "support/data_support/ccCArray.h"
+#include <map>
 
 #if CC_NODE_RENDER_SUBPIXEL
 #define RENDER_IN_SUBPIXEL
@@ -49,6 +52,29 @@ THE SOFTWARE.
 
 NS_CC_BEGIN
 
+struct _ccChildTagIndex
+{
+    std::multimap<int, CCNode*> children;
+
+    void add(int tag, CCNode *child)
+    {
+        children.insert(std::make_pair(tag, child));
+    }
+
+    void remove(int tag, CCNode *child)
+    {
+        std::pair<std::multimap<int, CCNode*>::iterator, std::multimap<int, CCNode*>::iterator> range = children.equal_range(tag);
+        for (std::multimap<int, CCNode*>::iterator it = range.first; it != range.second; ++it)
+        {
+            if (it->second == child)
+            {
+                children.erase(it);
+                return;
+            }
+        }
+    }
+};
+
 // XXX: Yes, nodes might have a sort problem once every 15 days if the game runs at 60 FPS and each frame sprites are reordered.
 static int s_globalOrderOfArrival = 1;
 
@@ -80,6 +106,9 @@ CCNode::CCNode(void)
 , m_pShaderProgram(NULL)
 , m_eGLServerState(ccGLServerState(0))
 , m_uOrderOfArrival(0)
+, m_uChildIndex(0)
+, m_uValidChildIndices(0)
+, m_pChildTagIndex(NULL)
 , m_bRunning(false)
 , m_bTransformDirty(true)
 , m_bInverseDirty(true)
@@ -87,6 +116,8 @@ CCNode::CCNode(void)
 , m_bVisible(true)
 , m_bIgnoreAnchorPointForPosition(false)
 , m_bReorderChildDirty(false)
+, m_bObservesChildTransforms(false)
+, m_bTouchBoundsObserved(false)
 , m_nScriptHandler(0)
 , m_nUpdateScriptHandler(0)
 , m_pComponentContainer(NULL)
@@ -107,6 +138,11 @@ CCNode::~CCNode(void)
 {
     CCLOGINFO( "cocos2d: deallocing" );
     
+    if (m_bTouchBoundsObserved)
+    {
+        CCDirector::sharedDirector()->getTouchDispatcher()->touchBoundsNodeWillBeDeleted(this);
+    }
+
     unregisterScriptHandler();
     if (m_nUpdateScriptHandler)
     {
@@ -141,6 +177,7 @@ CCNode::~CCNode(void)
 
     // children
     CC_SAFE_RELEASE(m_pChildren);
+    CC_SAFE_DELETE(m_pChildTagIndex);
 }
 
 bool CCNode::init()
@@ -156,7 +193,7 @@ float CCNode::getSkewX()
 void CCNode::setSkewX(float newSkewX)
 {
     m_fSkewX = newSkewX;
-    m_bTransformDirty = m_bInverseDirty = true;
+    markTransformDirty();
 }
 
 float CCNode::getSkewY()
@@ -168,7 +205,7 @@ void CCNode::setSkewY(float newSkewY)
 {
     m_fSkewY = newSkewY;
 
-    m_bTransformDirty = m_bInverseDirty = true;
+    markTransformDirty();
 }
 
 /// zOrder getter
@@ -218,7 +255,7 @@ float CCNode::getRotation()
 void CCNode::setRotation(float newRotation)
 {
     m_fRotationX = m_fRotationY = newRotation;
-    m_bTransformDirty = m_bInverseDirty = true;
+    markTransformDirty();
 }
 
 float CCNode::getRotationX()
@@ -229,7 +266,7 @@ float CCNode::getRotationX()
 void CCNode::setRotationX(float fRotationX)
 {
     m_fRotationX = fRotationX;
-    m_bTransformDirty = m_bInverseDirty = true;
+    markTransformDirty();
 }
 
 float CCNode::getRotationY()
@@ -240,7 +277,7 @@ float CCNode::getRotationY()
 void CCNode::setRotationY(float fRotationY)
 {
     m_fRotationY = fRotationY;
-    m_bTransformDirty = m_bInverseDirty = true;
+    markTransformDirty();
 }
 
 /// scale getter
@@ -254,7 +291,7 @@ float CCNode::getScale(void)
 void CCNode::setScale(float scale)
 {
     m_fScaleX = m_fScaleY = scale;
-    m_bTransformDirty = m_bInverseDirty = true;
+    markTransformDirty();
 }
 
 /// scale setter
@@ -262,7 +299,7 @@ void CCNode::setScale(float fScaleX,float fScaleY)
 {
     m_fScaleX = fScaleX;
     m_fScaleY = fScaleY;
-    m_bTransformDirty = m_bInverseDirty = true;
+    markTransformDirty();
 }
 
 /// scaleX getter
@@ -275,7 +312,7 @@ float CCNode::getScaleX()
 void CCNode::setScaleX(float newScaleX)
 {
     m_fScaleX = newScaleX;
-    m_bTransformDirty = m_bInverseDirty = true;
+    markTransformDirty();
 }
 
 /// scaleY getter
@@ -288,7 +325,7 @@ float CCNode::getScaleY()
 void CCNode::setScaleY(float newScaleY)
 {
     m_fScaleY = newScaleY;
-    m_bTransformDirty = m_bInverseDirty = true;
+    markTransformDirty();
 }
 
 /// position getter
@@ -301,7 +338,7 @@ const CCPoint& CCNode::getPosition()
 void CCNode::setPosition(const CCPoint& newPosition)
 {
     m_obPosition = newPosition;
-    m_bTransformDirty = m_bInverseDirty = true;
+    markTransformDirty();
 }
 
 void CCNode::getPosition(float* x, float* y)
@@ -402,7 +439,7 @@ void CCNode::setAnchorPoint(const CCPoint& point)
     {
         m_obAnchorPoint = point;
         m_obAnchorPointInPoints = ccp(m_obContentSize.width * m_obAnchorPoint.x, m_obContentSize.height * m_obAnchorPoint.y );
-        m_bTransformDirty = m_bInverseDirty = true;
+        markTransformDirty();
     }
 }
 
@@ -419,7 +456,7 @@ void CCNode::setContentSize(const CCSize & size)
         m_obContentSize = size;
 
         m_obAnchorPointInPoints = ccp(m_obContentSize.width * m_obAnchorPoint.x, m_obContentSize.height * m_obAnchorPoint.y );
-        m_bTransformDirty = m_bInverseDirty = true;
+        markTransformDirty();
     }
 }
 
@@ -437,7 +474,21 @@ CCNode * CCNode::getParent()
 /// parent setter
 void CCNode::setParent(CCNode * var)
 {
+    if (m_pParent && m_pParent->m_pChildTagIndex)
+    {
+        m_pParent->m_pChildTagIndex->remove(m_nTag, this);
+    }
     m_pParent = var;
+    if (m_pParent && m_pParent->m_pChildTagIndex)
+    {
+        m_pParent->m_pChildTagIndex->add(m_nTag, this);
+    }
+
+    if (m_bTouchBoundsObserved)
+    {
+        // the ancestors changed
+        CCDirector::sharedDirector()->getTouchDispatcher()->touchBoundsNodeDidChange(this);
+    }
 }
 
 /// isRelativeAnchorPoint getter
@@ -451,7 +502,7 @@ void CCNode::ignoreAnchorPointForPosition(bool newValue)
     if (newValue != m_bIgnoreAnchorPointForPosition) 
     {
 		m_bIgnoreAnchorPointForPosition = newValue;
-		m_bTransformDirty = m_bInverseDirty = true;
+		markTransformDirty();
 	}
 }
 
@@ -464,6 +515,11 @@ int CCNode::getTag() const
 /// tag setter
 void CCNode::setTag(int var)
 {
+    if (m_pParent && m_pParent->m_pChildTagIndex)
+    {
+        m_pParent->m_pChildTagIndex->remove(m_nTag, this);
+        m_pParent->m_pChildTagIndex->add(var, this);
+    }
     m_nTag = var;
 }
 
@@ -575,6 +631,20 @@ CCNode* CCNode::getChildByTag(int aTag)
 {
     CCAssert( aTag != kCCNodeTagInvalid, "Invalid tag");
 
+    if (m_pChildTagIndex)
+    {
+        std::multimap<int, CCNode*>::iterator it = m_pChildTagIndex->children.find(aTag);
+        if (it == m_pChildTagIndex->children.end())
+        {
+            return NULL;
+        }
+        if (m_pChildTagIndex->children.count(aTag) == 1)
+        {
+            return it->second;
+        }
+        // several children share the tag: the first one in the children array wins
+    }
+
     if(m_pChildren && m_pChildren->count() > 0)
     {
         CCObject* child;
@@ -588,6 +658,76 @@ CCNode* CCNode::getChildByTag(int aTag)
     return NULL;
 }
 
+void CCNode::setChildTagIndexEnabled(bool bEnabled)
+{
+    if (bEnabled == (m_pChildTagIndex != NULL))
+    {
+        return;
+    }
+
+    if (bEnabled)
+    {
+        m_pChildTagIndex = new _ccChildTagIndex();
+
+        CCObject* child;
+        CCARRAY_FOREACH(m_pChildren, child)
+        {
+            CCNode* pNode = (CCNode*) child;
+            m_pChildTagIndex->add(pNode->m_nTag, pNode);
+        }
+    }
+    else
+    {
+        CC_SAFE_DELETE(m_pChildTagIndex);
+    }
+}
+
+bool CCNode::isChildTagIndexEnabled()
+{
+    return m_pChildTagIndex != NULL;
+}
+
+unsigned int CCNode::indexOfChild(CCNode *child)
+{
+    if (m_pChildren == NULL)
+    {
+        return CC_INVALID_INDEX;
+    }
+
+    ccArray *arrayData = m_pChildren->data;
+    unsigned int uIndex = child->m_uChildIndex;
+    if (uIndex < arrayData->num && arrayData->arr[uIndex] == child)
+    {
+        return uIndex;
+    }
+
+    // the child is past the valid indices: rewrite them up to the child only
+    for (uIndex = MIN(m_uValidChildIndices, arrayData->num); uIndex < arrayData->num; ++uIndex)
+    {
+        CCNode *pNode = (CCNode*) arrayData->arr[uIndex];
+        pNode->m_uChildIndex = uIndex;
+        if (pNode == child)
+        {
+            m_uValidChildIndices = uIndex + 1;
+            return uIndex;
+        }
+    }
+    m_uValidChildIndices = arrayData->num;
+
+    // the children were moved around by a subclass that didn't invalidate their indices
+    uIndex = ccArrayGetIndexOfObject(arrayData, child);
+    if (uIndex != CC_INVALID_INDEX)
+    {
+        child->m_uChildIndex = uIndex;
+    }
+    return uIndex;
+}
+
+void CCNode::invalidateChildIndices(unsigned int uStart)
+{
+    m_uValidChildIndices = MIN(m_uValidChildIndices, uStart);
+}
+
 /* "add" logic MUST only be on this method
 * If a class want's to extend the 'addChild' behavior it only needs
 * to override this method
@@ -658,7 +798,7 @@ void CCNode::removeChild(CCNode* child, bool cleanup)
         return;
     }
 
-    if ( m_pChildren->containsObject(child) )
+    if ( indexOfChild(child) != CC_INVALID_INDEX )
     {
         this->detachChild(child,cleanup);
     }
@@ -720,6 +860,7 @@ void CCNode::removeAllChildrenWithCleanup(bool cleanup)
         }
         
         m_pChildren->removeAllObjects();
+        m_uValidChildIndices = 0;
     }
     
 }
@@ -745,7 +886,13 @@ void CCNode::detachChild(CCNode *child, bool doCleanup)
     // set parent nil at the end
     child->setParent(NULL);
 
-    m_pChildren->removeObject(child);
+    // onExit() may have changed the children: look the child up again
+    unsigned int uIndex = indexOfChild(child);
+    if (uIndex != CC_INVALID_INDEX)
+    {
+        m_pChildren->removeObjectAtIndex(uIndex);
+        invalidateChildIndices(uIndex);
+    }
 }
 
 
@@ -754,6 +901,11 @@ void CCNode::insertChild(CCNode* child, int z)
 {
     m_bReorderChildDirty = true;
     ccArrayAppendObjectWithResize(m_pChildren->data, child);
+    child->m_uChildIndex = m_pChildren->data->num - 1;
+    if (m_uValidChildIndices == child->m_uChildIndex)
+    {
+        ++m_uValidChildIndices;
+    }
     child->_setZOrder(z);
 }
 
@@ -790,6 +942,7 @@ void CCNode::sortAllChildren()
 
         //don't need to check children recursively, that's done in visit of each child
 
+        invalidateChildIndices(0);
         m_bReorderChildDirty = false;
     }
 }
@@ -1143,6 +1296,21 @@ void CCNode::update(float fDelta)
     }
 }
 
+void CCNode::markTransformDirty()
+{
+    m_bTransformDirty = m_bInverseDirty = true;
+
+    if (m_pParent && m_pParent->m_bObservesChildTransforms)
+    {
+        m_pParent->childTransformDidChange(this);
+    }
+
+    if (m_bTouchBoundsObserved)
+    {
+        CCDirector::sharedDirector()->getTouchDispatcher()->touchBoundsNodeDidChange(this);
+    }
+}
+
 CCAffineTransform CCNode::nodeToParentTransform(void)
 {
     if (m_bTransformDirty) 
@@ -1222,8 +1390,8 @@ CCAffineTransform CCNode::nodeToParentTransform(void)
 void CCNode::setAdditionalTransform(const CCAffineTransform& additionalTransform)
 {
     m_sAdditionalTransform = additionalTransform;
-    m_bTransformDirty = true;
     m_bAdditionalTransformDirty = true;
+    markTransformDirty();
 }
 
 CCAffineTransform CCNode::parentToNodeTransform(void)
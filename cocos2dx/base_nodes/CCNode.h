@@ -52,6 +52,7 @@ class CCActionManager;
 class CCComponent;
 class CCDictionary;
 class CCComponentContainer;
+struct _ccChildTagIndex;
 
 /**
  * @addtogroup base_nodes
@@ -607,6 +608,21 @@ public:
      * @return a CCNode object whose tag equals to the input parameter
      */
     virtual CCNode * getChildByTag(int tag);
+    /**
+     * Keeps the children in a tag to child map, so that getChildByTag() doesn't walk all the children.
+     * Worth it for nodes with thousands of children. Disabled by default.
+     *
+     * @param bEnabled  true to index the children by tag, false to drop the index
+     * @since v2.2
+     */
+    void setChildTagIndexEnabled(bool bEnabled);
+    /**
+     * Returns whether the children are indexed by tag.
+     *
+     * @see setChildTagIndexEnabled(bool)
+     * @since v2.2
+     */
+    bool isChildTagIndexEnabled();
     /**
      * Return an array of children
      *
@@ -1382,6 +1398,19 @@ public:
     virtual void removeAllComponents();
     /// @} end of component functions
 
+    /** Whether the touch dispatcher reads touch bounds from this node or from one of its
+     * descendants, see CCTouchDispatcher::setTouchBoundsNode(). Set by the touch dispatcher.
+     * @since v2.2
+     * @js NA
+     * @lua NA
+     */
+    bool isTouchBoundsObserved() { return m_bTouchBoundsObserved; }
+    /**
+     * @js NA
+     * @lua NA
+     */
+    void setTouchBoundsObserved(bool bObserved) { m_bTouchBoundsObserved = bObserved; }
+
 private:
     /// lazy allocs
     void childrenAlloc(void);
@@ -1391,6 +1420,9 @@ private:
     
     /// Removes a child, call child->onExit(), do cleanup, remove it from children array.
     void detachChild(CCNode *child, bool doCleanup);
+
+    /// Index of a child in m_pChildren, or CC_INVALID_INDEX. O(1) when the index of the child is up to date.
+    unsigned int indexOfChild(CCNode *child);
     
     /** Convert cocos2d coordinates to UI windows coordinate.
      * @js NA
@@ -1399,6 +1431,19 @@ private:
     CCPoint convertToWindowSpace(const CCPoint& nodePoint);
 
 protected:
+    /// Marks the transform as dirty, and tells the parent and the touch dispatcher if they observe it.
+    void markTransformDirty();
+
+    /** Marks the indices of the children from uStart on as out of date. Call it after moving children around.
+     They are rewritten lazily, up to the child looked up, the next time indexOfChild() needs them.
+     */
+    void invalidateChildIndices(unsigned int uStart);
+
+    /** Called when the position, rotation, scale, skew, anchor point or content size of
+     a child changes, if m_bObservesChildTransforms is true. Does nothing by default.
+     */
+    virtual void childTransformDidChange(CCNode *pChild) { CC_UNUSED_PARAM(pChild); }
+
     float m_fRotationX;                 ///< rotation angle on x-axis
     float m_fRotationY;                 ///< rotation angle on y-axis
     
@@ -1442,6 +1487,11 @@ protected:
     
     unsigned int m_uOrderOfArrival;     ///< used to preserve sequence while sorting children with the same zOrder
     
+    unsigned int m_uChildIndex;         ///< index in the children of the parent, a hint checked before use
+    unsigned int m_uValidChildIndices;  ///< the children below this index know their index in m_pChildren
+    
+    struct _ccChildTagIndex *m_pChildTagIndex; ///< children by tag, NULL unless enabled
+    
     CCScheduler *m_pScheduler;          ///< scheduler used to schedule timers and updates
     
     CCActionManager *m_pActionManager;  ///< a pointer to ActionManager singleton, which is used to handle all the actions
@@ -1457,6 +1507,8 @@ protected:
                                           ///< Used by CCLayer and CCScene.
     
     bool m_bReorderChildDirty;          ///< children order dirty flag
+    bool m_bObservesChildTransforms;    ///< if true, childTransformDidChange() is called when a child moves
+    bool m_bTouchBoundsObserved;        ///< if true, the touch dispatcher is told when the node moves or is reparented
     
     int m_nScriptHandler;               ///< script handler for onEnter() & onExit(), used in Javascript binding and Lua binding.
     int m_nUpdateScriptHandler;         ///< script handler for update() callback per frame, which is invoked from lua & javascript.
@@ -28,59 +28,189 @@ NS_CC_BEGIN
 
 static CCPoolManager* s_pPoolManager = NULL;
 
+// number of object pointers per chunk
+#define kCCAutoreleaseChunkSize 1024
+
+struct _autoreleaseIndexEntry
+{
+    CCObject*       object;     // NULL for an empty entry
+    unsigned int    position;
+};
+
+static inline unsigned int hashObject(CCObject *pObject)
+{
+    unsigned long long uKey = (unsigned long long)(intptr_t)pObject;
+    uKey ^= uKey >> 33;
+    uKey *= 0xff51afd7ed558ccdULL;
+    uKey ^= uKey >> 33;
+    return (unsigned int)uKey;
+}
+
 CCAutoreleasePool::CCAutoreleasePool(void)
+: m_uCount(0)
+, m_pIndex(NULL)
+, m_uIndexMask(0)
+, m_uIndexCount(0)
 {
-    m_pManagedObjectArray = new CCArray();
-    m_pManagedObjectArray->init();
 }
 
 CCAutoreleasePool::~CCAutoreleasePool(void)
 {
-    CC_SAFE_DELETE(m_pManagedObjectArray);
+    clear();
+
+    for (unsigned int i = 0; i < m_obChunks.size(); ++i)
+    {
+        free(m_obChunks[i]);
+    }
+}
+
+CCObject*& CCAutoreleasePool::objectAt(unsigned int uPosition)
+{
+    return m_obChunks[uPosition / kCCAutoreleaseChunkSize][uPosition % kCCAutoreleaseChunkSize];
 }
 
 void CCAutoreleasePool::addObject(CCObject* pObject)
 {
-    m_pManagedObjectArray->addObject(pObject);
+    CCAssert(pObject->m_uReference > 0, "reference count should be greater than 0");
+
+    if (m_uCount == m_obChunks.size() * kCCAutoreleaseChunkSize)
+    {
+        m_obChunks.push_back((CCObject**)malloc(sizeof(CCObject*) * kCCAutoreleaseChunkSize));
+    }
 
-    CCAssert(pObject->m_uReference > 1, "reference count should be greater than 1");
+    // the pool takes over the reference of the caller, it doesn't retain
+    objectAt(m_uCount) = pObject;
     ++(pObject->m_uAutoReleaseCount);
-    pObject->release(); // no ref count, in this case autorelease pool added.
+
+    if (m_pIndex)
+    {
+        addToIndex(pObject, m_uCount);
+    }
+    ++m_uCount;
 }
 
 void CCAutoreleasePool::removeObject(CCObject* pObject)
 {
-    for (unsigned int i = 0; i < pObject->m_uAutoReleaseCount; ++i)
+    if (m_pIndex == NULL)
+    {
+        buildIndex(16);
+    }
+
+    // every entry of the object is removed, without releasing it
+    unsigned int i = hashObject(pObject) & m_uIndexMask;
+    while (m_pIndex[i].object != NULL)
     {
-        m_pManagedObjectArray->removeObject(pObject, false);
+        if (m_pIndex[i].object != pObject)
+        {
+            i = (i + 1) & m_uIndexMask;
+            continue;
+        }
+
+        unsigned int uPosition = m_pIndex[i].position;
+        removeFromIndex(i);
+
+        // entries drained by clear() are not removed from the index
+        if (uPosition < m_uCount && objectAt(uPosition) == pObject)
+        {
+            objectAt(uPosition) = NULL;
+        }
+
+        // slot i now holds the next entry of the cluster, if any
     }
 }
 
 void CCAutoreleasePool::clear()
 {
-    if(m_pManagedObjectArray->count() > 0)
+    dropIndex();
+
+    // Released objects may autorelease other objects meanwhile: they are pushed on
+    // top of the stack and released by this same loop.
+    while (m_uCount > 0)
     {
-        //CCAutoreleasePool* pReleasePool;
-#ifdef _DEBUG
-        int nIndex = m_pManagedObjectArray->count() - 1;
-#endif
+        CCObject *pObj = objectAt(--m_uCount);
+        if (pObj)
+        {
+            --(pObj->m_uAutoReleaseCount);
+            pObj->release();
+        }
+    }
 
-        CCObject* pObj = NULL;
-        CCARRAY_FOREACH_REVERSE(m_pManagedObjectArray, pObj)
+    dropIndex();
+}
+
+void CCAutoreleasePool::buildIndex(unsigned int uCapacity)
+{
+    dropIndex();
+
+    while (uCapacity < (m_uCount + 1) * 2)
+    {
+        uCapacity *= 2;
+    }
+    m_pIndex = (_autoreleaseIndexEntry*)calloc(uCapacity, sizeof(_autoreleaseIndexEntry));
+    m_uIndexMask = uCapacity - 1;
+    for (unsigned int i = 0; i < m_uCount; ++i)
+    {
+        CCObject *pObj = objectAt(i);
+        if (pObj)
         {
-            if(!pObj)
-                break;
+            addToIndex(pObj, i);
+        }
+    }
+}
 
-            --(pObj->m_uAutoReleaseCount);
-            //(*it)->release();
-            //delete (*it);
-#ifdef _DEBUG
-            nIndex--;
-#endif
+void CCAutoreleasePool::addToIndex(CCObject *pObject, unsigned int uPosition)
+{
+    // keep the load factor under 1/2
+    if ((m_uIndexCount + 1) * 2 > m_uIndexMask + 1)
+    {
+        // rebuilt from the stack, which also forgets the drained entries
+        buildIndex((m_uIndexMask + 1) * 2);
+        if (uPosition < m_uCount)
+        {
+            return;
         }
+    }
+
+    unsigned int i = hashObject(pObject) & m_uIndexMask;
+    while (m_pIndex[i].object != NULL)
+    {
+        i = (i + 1) & m_uIndexMask;
+    }
+    m_pIndex[i].object = pObject;
+    m_pIndex[i].position = uPosition;
+    ++m_uIndexCount;
+}
 
-        m_pManagedObjectArray->removeAllObjects();
+void CCAutoreleasePool::removeFromIndex(unsigned int uSlot)
+{
+    // backward shift deletion, see CCDictionary
+    unsigned int i = uSlot;
+    unsigned int j = uSlot;
+    for (;;)
+    {
+        j = (j + 1) & m_uIndexMask;
+        if (m_pIndex[j].object == NULL)
+        {
+            break;
+        }
+        unsigned int k = hashObject(m_pIndex[j].object) & m_uIndexMask;
+        if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j))
+        {
+            continue;
+        }
+        m_pIndex[i] = m_pIndex[j];
+        i = j;
     }
+    m_pIndex[i].object = NULL;
+    --m_uIndexCount;
+}
+
+void CCAutoreleasePool::dropIndex()
+{
+    free(m_pIndex);
+    m_pIndex = NULL;
+    m_uIndexMask = 0;
+    m_uIndexCount = 0;
 }
 
 
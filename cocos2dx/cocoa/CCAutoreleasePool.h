@@ -26,6 +26,7 @@ THE SOFTWARE.
 
 #include "CCObject.h"
 #include "CCArray.h"
+#include <vector>
 
 NS_CC_BEGIN
 
@@ -36,9 +37,23 @@ NS_CC_BEGIN
  * @lua NA
  */
 
+/** The managed objects are kept in a stack of fixed size chunks of raw pointers.
+ The chunks are kept between two clear() calls, so a pool in its steady state never allocates.
+ Removing an object builds an index of the pool on demand, removals being rare.
+ */
 class CC_DLL CCAutoreleasePool : public CCObject
 {
-    CCArray*    m_pManagedObjectArray;    
+    std::vector<CCObject**>             m_obChunks;
+    unsigned int                        m_uCount;
+    struct _autoreleaseIndexEntry*      m_pIndex;
+    unsigned int                        m_uIndexMask;
+    unsigned int                        m_uIndexCount;
+
+    CCObject*& objectAt(unsigned int uPosition);
+    void buildIndex(unsigned int uCapacity);
+    void addToIndex(CCObject *pObject, unsigned int uPosition);
+    void removeFromIndex(unsigned int uSlot);
+    void dropIndex();
 public:
     CCAutoreleasePool(void);
     ~CCAutoreleasePool(void);
@@ -47,6 +62,9 @@ public:
     void removeObject(CCObject *pObject);
 
     void clear();
+
+    /** number of objects waiting to be released */
+    inline unsigned int count(void) { return m_uCount; }
 };
 
 /**
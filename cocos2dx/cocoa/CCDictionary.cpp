@@ -38,19 +38,12 @@ CCDictElement::CCDictElement(const char* pszKey, CCObject* pObject)
 {
     CCAssert(pszKey && strlen(pszKey) > 0, "Invalid key value.");
     m_iKey = 0;
-    const char* pStart = pszKey;
-    
-    int len = strlen(pszKey);
-    if (len > MAX_KEY_LEN )
-    {
-        char* pEnd = (char*)&pszKey[len-1];
-        pStart = pEnd - (MAX_KEY_LEN-1);
-    }
-    
-    strcpy(m_szKey, pStart);
-    
+    // the room for the whole key was allocated by operator new
+    strcpy(m_szKey, pszKey);
     m_pObject = pObject;
-    memset(&hh, 0, sizeof(hh));
+    m_uHash = 0;
+    m_pPrev = NULL;
+    m_pNext = NULL;
 }
 
 CCDictElement::CCDictElement(intptr_t iKey, CCObject* pObject)
@@ -58,7 +51,9 @@ CCDictElement::CCDictElement(intptr_t iKey, CCObject* pObject)
     m_szKey[0] = '\0';
     m_iKey = iKey;
     m_pObject = pObject;
-    memset(&hh, 0, sizeof(hh));
+    m_uHash = 0;
+    m_pPrev = NULL;
+    m_pNext = NULL;
 }
 
 CCDictElement::~CCDictElement()
@@ -66,11 +61,59 @@ CCDictElement::~CCDictElement()
 
 }
 
+void* CCDictElement::operator new(size_t uSize, size_t uKeyLength)
+{
+    // m_szKey already holds the terminating '\0'
+    return ::operator new(uSize + uKeyLength);
+}
+
+void CCDictElement::operator delete(void* p, size_t uKeyLength)
+{
+    ::operator delete(p);
+}
+
+void CCDictElement::operator delete(void* p)
+{
+    ::operator delete(p);
+}
+
 // -----------------------------------------------------------------------
 // CCDictionary
 
+struct _ccDictSlot
+{
+    unsigned int    hash;
+    CCDictElement*  element;    // NULL for an empty slot
+};
+
+// FNV-1a
+static inline unsigned int hashStrKey(const char* pszKey)
+{
+    unsigned int uHash = 2166136261u;
+    while (*pszKey)
+    {
+        uHash ^= (unsigned char)*pszKey++;
+        uHash *= 16777619u;
+    }
+    return uHash;
+}
+
+// integer keys are often pointers or small sequential values, mix all their bits
+static inline unsigned int hashIntKey(intptr_t iKey)
+{
+    unsigned long long uKey = (unsigned long long)iKey;
+    uKey ^= uKey >> 33;
+    uKey *= 0xff51afd7ed558ccdULL;
+    uKey ^= uKey >> 33;
+    return (unsigned int)uKey;
+}
+
 CCDictionary::CCDictionary()
 : m_pElements(NULL)
+, m_pLastElement(NULL)
+, m_pSlots(NULL)
+, m_uSlotMask(0)
+, m_uCount(0)
 , m_eDictType(kCCDictUnknown)
 {
 
@@ -79,11 +122,147 @@ CCDictionary::CCDictionary()
 CCDictionary::~CCDictionary()
 {
     removeAllObjects();
+    free(m_pSlots);
+}
+
+CCDictElement* CCDictionary::findElement(const char* pszKey, unsigned int uHash)
+{
+    if (m_pSlots == NULL)
+    {
+        return NULL;
+    }
+
+    for (unsigned int i = uHash & m_uSlotMask; m_pSlots[i].element != NULL; i = (i + 1) & m_uSlotMask)
+    {
+        if (m_pSlots[i].hash == uHash && strcmp(m_pSlots[i].element->m_szKey, pszKey) == 0)
+        {
+            return m_pSlots[i].element;
+        }
+    }
+    return NULL;
+}
+
+CCDictElement* CCDictionary::findElement(intptr_t iKey, unsigned int uHash)
+{
+    if (m_pSlots == NULL)
+    {
+        return NULL;
+    }
+
+    for (unsigned int i = uHash & m_uSlotMask; m_pSlots[i].element != NULL; i = (i + 1) & m_uSlotMask)
+    {
+        if (m_pSlots[i].hash == uHash && m_pSlots[i].element->m_iKey == iKey)
+        {
+            return m_pSlots[i].element;
+        }
+    }
+    return NULL;
+}
+
+void CCDictionary::growSlots()
+{
+    unsigned int uCapacity = m_pSlots ? (m_uSlotMask + 1) * 2 : 8;
+    free(m_pSlots);
+    m_pSlots = (_ccDictSlot*)calloc(uCapacity, sizeof(_ccDictSlot));
+    m_uSlotMask = uCapacity - 1;
+
+    // the hashes are cached, rehashing doesn't touch the keys
+    for (CCDictElement* pElement = m_pElements; pElement != NULL; pElement = pElement->m_pNext)
+    {
+        unsigned int i = pElement->m_uHash & m_uSlotMask;
+        while (m_pSlots[i].element != NULL)
+        {
+            i = (i + 1) & m_uSlotMask;
+        }
+        m_pSlots[i].hash = pElement->m_uHash;
+        m_pSlots[i].element = pElement;
+    }
+}
+
+void CCDictionary::insertElement(CCDictElement* pElement)
+{
+    // keep the load factor under 3/4
+    if (m_pSlots == NULL || (m_uCount + 1) * 4 > (m_uSlotMask + 1) * 3)
+    {
+        growSlots();
+    }
+
+    unsigned int i = pElement->m_uHash & m_uSlotMask;
+    while (m_pSlots[i].element != NULL)
+    {
+        i = (i + 1) & m_uSlotMask;
+    }
+    m_pSlots[i].hash = pElement->m_uHash;
+    m_pSlots[i].element = pElement;
+    ++m_uCount;
+
+    // append, so that traversal follows the insertion order
+    pElement->m_pPrev = m_pLastElement;
+    pElement->m_pNext = NULL;
+    if (m_pLastElement)
+    {
+        m_pLastElement->m_pNext = pElement;
+    }
+    else
+    {
+        m_pElements = pElement;
+    }
+    m_pLastElement = pElement;
+}
+
+void CCDictionary::eraseElement(CCDictElement* pElement)
+{
+    unsigned int i = pElement->m_uHash & m_uSlotMask;
+    while (m_pSlots[i].element != pElement)
+    {
+        CCAssert(m_pSlots[i].element != NULL, "element not in this dictionary");
+        i = (i + 1) & m_uSlotMask;
+    }
+
+    // backward shift deletion: move back the following elements of the cluster
+    // which can't be reached anymore once slot i is empty, so no tombstone is needed
+    unsigned int j = i;
+    for (;;)
+    {
+        j = (j + 1) & m_uSlotMask;
+        if (m_pSlots[j].element == NULL)
+        {
+            break;
+        }
+        unsigned int k = m_pSlots[j].hash & m_uSlotMask;
+        if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j))
+        {
+            continue;
+        }
+        m_pSlots[i] = m_pSlots[j];
+        i = j;
+    }
+    m_pSlots[i].element = NULL;
+    --m_uCount;
+
+    if (pElement->m_pPrev)
+    {
+        pElement->m_pPrev->m_pNext = pElement->m_pNext;
+    }
+    else
+    {
+        m_pElements = pElement->m_pNext;
+    }
+    if (pElement->m_pNext)
+    {
+        pElement->m_pNext->m_pPrev = pElement->m_pPrev;
+    }
+    else
+    {
+        m_pLastElement = pElement->m_pPrev;
+    }
+    pElement->m_pPrev = NULL;
+    pElement->m_pNext = NULL;
 }
 
 unsigned int CCDictionary::count()
 {
-    return HASH_COUNT(m_pElements);
+    return m_uCount;
 }
 
 CCArray* CCDictionary::allKeys()
@@ -93,10 +272,10 @@ CCArray* CCDictionary::allKeys()
 
     CCArray* pArray = CCArray::createWithCapacity(iKeyCount);
 
-    CCDictElement *pElement, *tmp;
+    CCDictElement *pElement = NULL;
     if (m_eDictType == kCCDictStr)
     {
-        HASH_ITER(hh, m_pElements, pElement, tmp) 
+        for (pElement = m_pElements; pElement != NULL; pElement = pElement->m_pNext)
         {
             CCString* pOneKey = new CCString(pElement->m_szKey);
             pArray->addObject(pOneKey);
@@ -105,7 +284,7 @@ CCArray* CCDictionary::allKeys()
     }
     else if (m_eDictType == kCCDictInt)
     {
-        HASH_ITER(hh, m_pElements, pElement, tmp) 
+        for (pElement = m_pElements; pElement != NULL; pElement = pElement->m_pNext)
         {
             CCInteger* pOneKey = new CCInteger(pElement->m_iKey);
             pArray->addObject(pOneKey);
@@ -122,11 +301,11 @@ CCArray* CCDictionary::allKeysForObject(CCObject* object)
     if (iKeyCount <= 0) return NULL;
     CCArray* pArray = CCArray::create();
 
-    CCDictElement *pElement, *tmp;
+    CCDictElement *pElement = NULL;
 
     if (m_eDictType == kCCDictStr)
     {
-        HASH_ITER(hh, m_pElements, pElement, tmp) 
+        for (pElement = m_pElements; pElement != NULL; pElement = pElement->m_pNext)
         {
             if (object == pElement->m_pObject)
             {
@@ -138,7 +317,7 @@ CCArray* CCDictionary::allKeysForObject(CCObject* object)
     }
     else if (m_eDictType == kCCDictInt)
     {
-        HASH_ITER(hh, m_pElements, pElement, tmp) 
+        for (pElement = m_pElements; pElement != NULL; pElement = pElement->m_pNext)
         {
             if (object == pElement->m_pObject)
             {
@@ -160,8 +339,7 @@ CCObject* CCDictionary::objectForKey(const std::string& key)
     CCAssert(m_eDictType == kCCDictStr, "this dictionary does not use string as key.");
 
     CCObject* pRetObject = NULL;
-    CCDictElement *pElement = NULL;
-    HASH_FIND_STR(m_pElements, key.c_str(), pElement);
+    CCDictElement *pElement = findElement(key.c_str(), hashStrKey(key.c_str()));
     if (pElement != NULL)
     {
         pRetObject = pElement->m_pObject;
@@ -178,8 +356,7 @@ CCObject* CCDictionary::objectForKey(intptr_t key)
     CCAssert(m_eDictType == kCCDictInt, "this dictionary does not use integer as key.");
 
     CCObject* pRetObject = NULL;
-    CCDictElement *pElement = NULL;
-    HASH_FIND_PTR(m_pElements, &key, pElement);
+    CCDictElement *pElement = findElement(key, hashIntKey(key));
     if (pElement != NULL)
     {
         pRetObject = pElement->m_pObject;
@@ -217,8 +394,7 @@ void CCDictionary::setObject(CCObject* pObject, const std::string& key)
 
     CCAssert(m_eDictType == kCCDictStr, "this dictionary doesn't use string as key.");
 
-    CCDictElement *pElement = NULL;
-    HASH_FIND_STR(m_pElements, key.c_str(), pElement);
+    CCDictElement *pElement = findElement(key.c_str(), hashStrKey(key.c_str()));
     if (pElement == NULL)
     {
         setObjectUnSafe(pObject, key);
@@ -243,8 +419,7 @@ void CCDictionary::setObject(CCObject* pObject, intptr_t key)
 
     CCAssert(m_eDictType == kCCDictInt, "this dictionary doesn't use integer as key.");
 
-    CCDictElement *pElement = NULL;
-    HASH_FIND_PTR(m_pElements, &key, pElement);
+    CCDictElement *pElement = findElement(key, hashIntKey(key));
     if (pElement == NULL)
     {
         setObjectUnSafe(pObject, key);
@@ -269,8 +444,7 @@ void CCDictionary::removeObjectForKey(const std::string& key)
     
     CCAssert(m_eDictType == kCCDictStr, "this dictionary doesn't use string as its key");
     CCAssert(key.length() > 0, "Invalid Argument!");
-    CCDictElement *pElement = NULL;
-    HASH_FIND_STR(m_pElements, key.c_str(), pElement);
+    CCDictElement *pElement = findElement(key.c_str(), hashStrKey(key.c_str()));
     removeObjectForElememt(pElement);
 }
 
@@ -282,23 +456,24 @@ void CCDictionary::removeObjectForKey(intptr_t key)
     }
     
     CCAssert(m_eDictType == kCCDictInt, "this dictionary doesn't use integer as its key");
-    CCDictElement *pElement = NULL;
-    HASH_FIND_PTR(m_pElements, &key, pElement);
+    CCDictElement *pElement = findElement(key, hashIntKey(key));
     removeObjectForElememt(pElement);
 }
 
 void CCDictionary::setObjectUnSafe(CCObject* pObject, const std::string& key)
 {
     pObject->retain();
-    CCDictElement* pElement = new CCDictElement(key.c_str(), pObject);
-    HASH_ADD_STR(m_pElements, m_szKey, pElement);
+    CCDictElement* pElement = new (key.length()) CCDictElement(key.c_str(), pObject);
+    pElement->m_uHash = hashStrKey(pElement->m_szKey);
+    insertElement(pElement);
 }
 
 void CCDictionary::setObjectUnSafe(CCObject* pObject, const intptr_t key)
 {
     pObject->retain();
-    CCDictElement* pElement = new CCDictElement(key, pObject);
-    HASH_ADD_PTR(m_pElements, m_iKey, pElement);
+    CCDictElement* pElement = new (0) CCDictElement(key, pObject);
+    pElement->m_uHash = hashIntKey(key);
+    insertElement(pElement);
 }
 
 void CCDictionary::removeObjectsForKeys(CCArray* pKeyArray)
@@ -315,7 +490,7 @@ void CCDictionary::removeObjectForElememt(CCDictElement* pElement)
 {
     if (pElement != NULL)
     {
-        HASH_DEL(m_pElements, pElement);
+        eraseElement(pElement);
         pElement->m_pObject->release();
         CC_SAFE_DELETE(pElement);
     }
@@ -323,13 +498,13 @@ void CCDictionary::removeObjectForElememt(CCDictElement* pElement)
 
 void CCDictionary::removeAllObjects()
 {
-    CCDictElement *pElement, *tmp;
-    HASH_ITER(hh, m_pElements, pElement, tmp) 
+    // the objects may remove elements from this dictionary when they are released
+    while (m_pElements != NULL)
     {
-        HASH_DEL(m_pElements, pElement);
+        CCDictElement* pElement = m_pElements;
+        eraseElement(pElement);
         pElement->m_pObject->release();
         CC_SAFE_DELETE(pElement);
-
     }
 }
 
@@ -343,7 +518,7 @@ CCObject* CCDictionary::copyWithZone(CCZone* pZone)
 
     if (m_eDictType == kCCDictInt)
     {
-        CCDICT_FOREACH(this, pElement)
+        for (pElement = m_pElements; pElement != NULL; pElement = pElement->m_pNext)
         {
             pTmpObj = pElement->getObject()->copy();
             pNewDict->setObject(pTmpObj, pElement->getIntKey());
@@ -352,7 +527,7 @@ CCObject* CCDictionary::copyWithZone(CCZone* pZone)
     }
     else if (m_eDictType == kCCDictStr)
     {
-        CCDICT_FOREACH(this, pElement)
+        for (pElement = m_pElements; pElement != NULL; pElement = pElement->m_pNext)
         {
             pTmpObj = pElement->getObject()->copy();
             pNewDict->setObject(pTmpObj, pElement->getStrKey());
@@ -78,6 +78,13 @@ private:
      *  @param  pObject   The object of this element.
      */
     CCDictElement(intptr_t iKey, CCObject* pObject);
+
+    /**
+     *  Allocates an element with room for a string key of uKeyLength characters,
+     *  the key is stored right after the element.
+     */
+    static void* operator new(size_t uSize, size_t uKeyLength);
+    static void operator delete(void* p, size_t uKeyLength);
     
 public:
     /**
@@ -85,6 +92,8 @@ public:
      */
     ~CCDictElement();
 
+    static void operator delete(void* p);
+
     // Inline functions need to be implemented in header file on Android.
     
     /**
@@ -121,15 +130,15 @@ public:
     inline CCObject* getObject() const { return m_pObject; }
 
 private:
-    // The max length of string key.
-    #define   MAX_KEY_LEN   256
-    // char array is needed for HASH_ADD_STR in UT_HASH.
-    // So it's a pain that all elements will allocate 256 bytes for this array.
-    char      m_szKey[MAX_KEY_LEN];     // hash key of string type
-    intptr_t  m_iKey;       // hash key of integer type
-    CCObject* m_pObject;    // hash value
+    intptr_t        m_iKey;     // hash key of integer type
+    CCObject*       m_pObject;  // hash value
+    unsigned int    m_uHash;    // cached hash of the key
 public:
-    UT_hash_handle hh;      // makes this class hashable
+    CCDictElement*  m_pPrev;    // previous element in insertion order
+    CCDictElement*  m_pNext;    // next element in insertion order, used by CCDICT_FOREACH
+private:
+    // hash key of string type, allocated with the element as long as the key needs
+    char            m_szKey[1];
     friend class CCDictionary; // declare CCDictionary as friend class
 };
 
@@ -141,7 +150,9 @@ public:
 #define CCDICT_FOREACH(__dict__, __el__) \
     CCDictElement* pTmp##__dict__##__el__ = NULL; \
     if (__dict__) \
-    HASH_ITER(hh, (__dict__)->m_pElements, __el__, pTmp##__dict__##__el__)
+    for (__el__ = (__dict__)->m_pElements, pTmp##__dict__##__el__ = __el__ ? __el__->m_pNext : NULL; \
+         __el__ != NULL; \
+         __el__ = pTmp##__dict__##__el__, pTmp##__dict__##__el__ = __el__ ? __el__->m_pNext : NULL)
 
 
 
@@ -404,15 +415,31 @@ private:
      */
     void setObjectUnSafe(CCObject* pObject, const std::string& key);
     void setObjectUnSafe(CCObject* pObject, const intptr_t key);
+
+    CCDictElement* findElement(const char* pszKey, unsigned int uHash);
+    CCDictElement* findElement(intptr_t iKey, unsigned int uHash);
+    void insertElement(CCDictElement* pElement);
+    void eraseElement(CCDictElement* pElement);
+    void growSlots();
     
 public:
     /**
-     *  All the elements in dictionary.
+     *  The first element in insertion order, the elements are linked by CCDictElement::m_pNext.
      * 
-     *  @note For internal usage, we need to declare this member variable as public since it's used in UT_HASH.
+     *  @note For internal usage, we need to declare this member variable as public since it's used by CCDICT_FOREACH.
      */
     CCDictElement* m_pElements;
 private:
+    /** The last element in insertion order. */
+    CCDictElement* m_pLastElement;
+
+    /** 
+     *  Open addressing table with linear probing. Each slot caches the hash of its element
+     *  so that most probes never touch the element itself.
+     */
+    struct _ccDictSlot* m_pSlots;
+    unsigned int m_uSlotMask;
+    unsigned int m_uCount;
     
     /** The support type of dictionary, it's confirmed when setObject is invoked. */
     enum CCDictType
@@ -25,6 +25,8 @@ THE SOFTWARE.
 
 #include "CCObject.h"
 #include "CCAutoreleasePool.h"
+#include "CCObjectAllocator.h"
+#include "CCObjectTracker.h"
 #include "ccMacros.h"
 #include "script_support/CCScriptSupport.h"
 
@@ -41,14 +43,32 @@ CCObject::CCObject(void)
 : m_nLuaID(0)
 , m_uReference(1) // when the object is created, the reference count of it is 1
 , m_uAutoReleaseCount(0)
+#if CC_ENABLE_OBJECT_ALLOCATOR
+, m_pClassRecord(NULL)
+#endif
 {
     static unsigned int uObjectCount = 0;
 
     m_uID = ++uObjectCount;
+
+#if CC_ENABLE_OBJECT_TRACKER
+    CCObjectTracker::trackObject(this);
+#endif
 }
 
 CCObject::~CCObject(void)
 {
+#if CC_ENABLE_OBJECT_TRACKER
+    CCObjectTracker::untrackObject(this);
+#endif
+
+#if CC_ENABLE_OBJECT_ALLOCATOR
+    if (m_pClassRecord)
+    {
+        CCObjectAllocator::untrackObject(this);
+    }
+#endif
+
     // if the object is managed, we should remove it
     // from pool manager
     if (m_uAutoReleaseCount > 0)
@@ -71,6 +91,18 @@ CCObject::~CCObject(void)
     }
 }
 
+#if CC_ENABLE_OBJECT_ALLOCATOR
+void* CCObject::operator new(size_t uSize)
+{
+    return CCObjectAllocator::allocate(uSize);
+}
+
+void CCObject::operator delete(void *p, size_t uSize)
+{
+    CCObjectAllocator::deallocate(p, uSize);
+}
+#endif
+
 CCObject* CCObject::copy()
 {
     return copyWithZone(0);
@@ -83,6 +115,12 @@ void CCObject::release(void)
 
     if (m_uReference == 0)
     {
+#if CC_ENABLE_OBJECT_ALLOCATOR
+        if (! m_pClassRecord)
+        {
+            CCObjectAllocator::trackObject(this);
+        }
+#endif
         delete this;
     }
 }
@@ -92,11 +130,23 @@ void CCObject::retain(void)
     CCAssert(m_uReference > 0, "reference count should greater than 0");
 
     ++m_uReference;
+#if CC_ENABLE_OBJECT_ALLOCATOR
+    if (! m_pClassRecord)
+    {
+        CCObjectAllocator::trackObject(this);
+    }
+#endif
 }
 
 CCObject* CCObject::autorelease(void)
 {
     CCPoolManager::sharedPoolManager()->addObject(this);
+#if CC_ENABLE_OBJECT_ALLOCATOR
+    if (! m_pClassRecord)
+    {
+        CCObjectAllocator::trackObject(this);
+    }
+#endif
     return this;
 }
 
@@ -26,6 +26,7 @@ THE SOFTWARE.
 #define __CCOBJECT_H__
 
 #include "CCDataVisitor.h"
+#include "ccConfig.h"
 
 #ifdef EMSCRIPTEN
 #include <GLES2/gl2.h>
@@ -86,6 +87,26 @@ public:
     virtual void acceptVisitor(CCDataVisitor &visitor);
 
     virtual void update(float dt) {CC_UNUSED_PARAM(dt);};
+
+#if CC_ENABLE_OBJECT_ALLOCATOR
+    /** CCObject and its subclasses are allocated by CCObjectAllocator */
+    static void* operator new(size_t uSize);
+    static void operator delete(void *p, size_t uSize);
+
+private:
+    // counters of the class of this object, set once the object has been retained, released or autoreleased
+    struct _ccObjectClassRecord *m_pClassRecord;
+
+    friend class CCObjectAllocator;
+#endif
+
+#if CC_ENABLE_OBJECT_TRACKER
+private:
+    // registry entry of this object, see CCObjectTracker
+    struct _ccTrackedObject *m_pTrackedObject;
+
+    friend class CCObjectTracker;
+#endif
     
     friend class CCAutoreleasePool;
 };
@@ -0,0 +1,617 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCObjectAllocator.h"
+#include "CCObject.h"
+#include "CCObjectTracker.h"
+#include "ccMacros.h"
+#include <algorithm>
+
+#if CC_ENABLE_OBJECT_ALLOCATOR
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include <typeinfo>
+#include <pthread.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+NS_CC_BEGIN
+
+#if CC_ENABLE_OBJECT_ALLOCATOR
+
+static const unsigned int kSizeClassGranularity = 16;
+static const unsigned int kSizeClassCount = 64;
+static const size_t kMaxSmallSize = kSizeClassGranularity * kSizeClassCount;
+static const size_t kSlabSize = 64 * 1024;
+// number of blocks moved at once between a thread cache and the shared free lists
+static const unsigned int kTransferBatch = 32;
+// number of free blocks a thread keeps per size class before giving some back
+static const unsigned int kThreadCacheLimit = 128;
+// entries of the per thread type -> class record cache, must be a power of 2
+static const unsigned int kClassCacheSize = 64;
+
+#if defined(_MSC_VER)
+static inline long atomicAdd(volatile long *p, long lValue)
+{
+    return _InterlockedExchangeAdd(p, lValue) + lValue;
+}
+
+static inline bool atomicCompareAndSwap(volatile long *p, long lOldValue, long lNewValue)
+{
+    return _InterlockedCompareExchange(p, lNewValue, lOldValue) == lOldValue;
+}
+#else
+static inline long atomicAdd(volatile long *p, long lValue)
+{
+    return __sync_add_and_fetch(p, lValue);
+}
+
+static inline bool atomicCompareAndSwap(volatile long *p, long lOldValue, long lNewValue)
+{
+    return __sync_bool_compare_and_swap(p, lOldValue, lNewValue);
+}
+#endif
+
+struct _ccFreeBlock
+{
+    _ccFreeBlock *next;
+};
+
+// free blocks of one size class shared by every thread
+struct _ccSizeClass
+{
+    pthread_mutex_t mutex;
+    _ccFreeBlock    *freeList;
+    unsigned int    freeCount;
+    unsigned int    slabCount;
+};
+
+struct _ccObjectClassRecord
+{
+    const std::type_info    *type;
+    volatile long           live;
+    volatile long           peak;
+    volatile long           total;
+    _ccObjectClassRecord    *next;
+};
+
+struct _ccThreadCache
+{
+    _ccFreeBlock            *freeLists[kSizeClassCount];
+    unsigned int            freeCounts[kSizeClassCount];
+    // blocks allocated and deallocated by this thread, the last slot counts the objects too big for the slabs
+    unsigned int            allocs[kSizeClassCount + 1];
+    unsigned int            frees[kSizeClassCount + 1];
+    const std::type_info    *classCacheTypes[kClassCacheSize];
+    _ccObjectClassRecord    *classCacheRecords[kClassCacheSize];
+    _ccThreadCache          *prev;
+    _ccThreadCache          *next;
+};
+
+// All the state is plain old data and is never destroyed: objects may still be
+// released by static destructors once the application is exiting.
+static pthread_once_t s_initOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t s_threadCacheKey;
+// guards the thread cache list, the retired counters and the class records
+static pthread_mutex_t s_registryMutex;
+static _ccSizeClass s_sizeClasses[kSizeClassCount];
+static _ccThreadCache *s_pThreadCaches = NULL;
+// counters of the threads that exited
+static unsigned int s_retiredAllocs[kSizeClassCount + 1];
+static unsigned int s_retiredFrees[kSizeClassCount + 1];
+static _ccObjectClassRecord *s_pClassRecords = NULL;
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX) && defined(__GNUC__)
+// faster than pthread_getspecific, the key is still used to release the cache when the thread exits
+static __thread _ccThreadCache *s_pCurrentThreadCache = NULL;
+#define CC_OBJECT_ALLOCATOR_NATIVE_TLS 1
+#else
+#define CC_OBJECT_ALLOCATOR_NATIVE_TLS 0
+#endif
+
+static void pushBlocks(_ccSizeClass &sizeClass, _ccFreeBlock *pFirst, _ccFreeBlock *pLast, unsigned int uCount)
+{
+    pthread_mutex_lock(&sizeClass.mutex);
+    pLast->next = sizeClass.freeList;
+    sizeClass.freeList = pFirst;
+    sizeClass.freeCount += uCount;
+    pthread_mutex_unlock(&sizeClass.mutex);
+}
+
+static void releaseThreadCache(void *pCache)
+{
+    _ccThreadCache *cache = (_ccThreadCache*)pCache;
+#if CC_OBJECT_ALLOCATOR_NATIVE_TLS
+    s_pCurrentThreadCache = NULL;
+#endif
+
+    for (unsigned int i = 0; i < kSizeClassCount; ++i)
+    {
+        _ccFreeBlock *pFirst = cache->freeLists[i];
+        if (pFirst)
+        {
+            _ccFreeBlock *pLast = pFirst;
+            while (pLast->next)
+            {
+                pLast = pLast->next;
+            }
+            pushBlocks(s_sizeClasses[i], pFirst, pLast, cache->freeCounts[i]);
+        }
+    }
+
+    pthread_mutex_lock(&s_registryMutex);
+    for (unsigned int i = 0; i <= kSizeClassCount; ++i)
+    {
+        s_retiredAllocs[i] += cache->allocs[i];
+        s_retiredFrees[i] += cache->frees[i];
+    }
+    if (cache->prev)
+    {
+        cache->prev->next = cache->next;
+    }
+    else
+    {
+        s_pThreadCaches = cache->next;
+    }
+    if (cache->next)
+    {
+        cache->next->prev = cache->prev;
+    }
+    pthread_mutex_unlock(&s_registryMutex);
+
+    free(cache);
+}
+
+static void initAllocator(void)
+{
+    pthread_key_create(&s_threadCacheKey, releaseThreadCache);
+    pthread_mutex_init(&s_registryMutex, NULL);
+    for (unsigned int i = 0; i < kSizeClassCount; ++i)
+    {
+        pthread_mutex_init(&s_sizeClasses[i].mutex, NULL);
+    }
+}
+
+static _ccThreadCache* threadCache(void)
+{
+#if CC_OBJECT_ALLOCATOR_NATIVE_TLS
+    if (s_pCurrentThreadCache)
+    {
+        return s_pCurrentThreadCache;
+    }
+#endif
+
+    pthread_once(&s_initOnce, initAllocator);
+
+    _ccThreadCache *cache = (_ccThreadCache*)pthread_getspecific(s_threadCacheKey);
+    if (! cache)
+    {
+        cache = (_ccThreadCache*)calloc(1, sizeof(_ccThreadCache));
+        if (cache)
+        {
+            pthread_mutex_lock(&s_registryMutex);
+            cache->next = s_pThreadCaches;
+            if (s_pThreadCaches)
+            {
+                s_pThreadCaches->prev = cache;
+            }
+            s_pThreadCaches = cache;
+            pthread_mutex_unlock(&s_registryMutex);
+
+            pthread_setspecific(s_threadCacheKey, cache);
+#if CC_OBJECT_ALLOCATOR_NATIVE_TLS
+            s_pCurrentThreadCache = cache;
+#endif
+        }
+    }
+    return cache;
+}
+
+static inline size_t blockSize(unsigned int uIndex)
+{
+    return (uIndex + 1) * kSizeClassGranularity;
+}
+
+// Called with the size class mutex held.
+static void carveSlab(_ccSizeClass &sizeClass, unsigned int uIndex)
+{
+    char *pSlab = (char*)malloc(kSlabSize);
+    if (! pSlab)
+    {
+        return;
+    }
+
+    size_t uBlockSize = blockSize(uIndex);
+    unsigned int uBlockCount = (unsigned int)(kSlabSize / uBlockSize);
+    // the lowest addresses are handed out first
+    for (unsigned int i = uBlockCount; i > 0; --i)
+    {
+        _ccFreeBlock *block = (_ccFreeBlock*)(pSlab + (i - 1) * uBlockSize);
+        block->next = sizeClass.freeList;
+        sizeClass.freeList = block;
+    }
+    sizeClass.freeCount += uBlockCount;
+    ++sizeClass.slabCount;
+}
+
+// Returns a block and moves a batch of free blocks into the empty thread cache.
+static _ccFreeBlock* refill(_ccThreadCache *cache, unsigned int uIndex)
+{
+    _ccSizeClass &sizeClass = s_sizeClasses[uIndex];
+
+    pthread_mutex_lock(&sizeClass.mutex);
+    if (! sizeClass.freeList)
+    {
+        carveSlab(sizeClass, uIndex);
+    }
+
+    _ccFreeBlock *block = sizeClass.freeList;
+    if (block)
+    {
+        unsigned int uCount = 1;
+        _ccFreeBlock *pLast = block;
+        while (uCount <= kTransferBatch && pLast->next)
+        {
+            pLast = pLast->next;
+            ++uCount;
+        }
+        sizeClass.freeList = pLast->next;
+        sizeClass.freeCount -= uCount;
+        pLast->next = NULL;
+
+        cache->freeLists[uIndex] = block->next;
+        cache->freeCounts[uIndex] = uCount - 1;
+    }
+    pthread_mutex_unlock(&sizeClass.mutex);
+
+    if (! block)
+    {
+        // out of slabs, a block of the full size class can still join the free lists later
+        block = (_ccFreeBlock*)::operator new(blockSize(uIndex));
+    }
+    return block;
+}
+
+// Gives a batch of free blocks of the thread cache back to the shared free list.
+static void flush(_ccThreadCache *cache, unsigned int uIndex)
+{
+    _ccFreeBlock *pFirst = cache->freeLists[uIndex];
+    _ccFreeBlock *pLast = pFirst;
+    for (unsigned int i = 1; i < kTransferBatch; ++i)
+    {
+        pLast = pLast->next;
+    }
+    cache->freeLists[uIndex] = pLast->next;
+    cache->freeCounts[uIndex] -= kTransferBatch;
+
+    pushBlocks(s_sizeClasses[uIndex], pFirst, pLast, kTransferBatch);
+}
+
+void* CCObjectAllocator::allocate(size_t uSize)
+{
+    _ccThreadCache *cache = threadCache();
+
+    if (uSize > kMaxSmallSize)
+    {
+        if (cache)
+        {
+            ++cache->allocs[kSizeClassCount];
+        }
+        return ::operator new(uSize);
+    }
+
+    unsigned int uIndex = uSize > 0 ? (unsigned int)((uSize - 1) / kSizeClassGranularity) : 0;
+    if (! cache)
+    {
+        return ::operator new(blockSize(uIndex));
+    }
+
+    _ccFreeBlock *block = cache->freeLists[uIndex];
+    if (block)
+    {
+        cache->freeLists[uIndex] = block->next;
+        --cache->freeCounts[uIndex];
+    }
+    else
+    {
+        block = refill(cache, uIndex);
+    }
+    ++cache->allocs[uIndex];
+    return block;
+}
+
+void CCObjectAllocator::deallocate(void *p, size_t uSize)
+{
+    if (! p)
+    {
+        return;
+    }
+
+    _ccThreadCache *cache = threadCache();
+
+    if (uSize > kMaxSmallSize)
+    {
+        if (cache)
+        {
+            ++cache->frees[kSizeClassCount];
+        }
+        ::operator delete(p);
+        return;
+    }
+
+    unsigned int uIndex = uSize > 0 ? (unsigned int)((uSize - 1) / kSizeClassGranularity) : 0;
+    _ccFreeBlock *block = (_ccFreeBlock*)p;
+    if (! cache)
+    {
+        block->next = NULL;
+        pushBlocks(s_sizeClasses[uIndex], block, block, 1);
+        return;
+    }
+
+    block->next = cache->freeLists[uIndex];
+    cache->freeLists[uIndex] = block;
+    ++cache->frees[uIndex];
+    if (++cache->freeCounts[uIndex] > kThreadCacheLimit)
+    {
+        flush(cache, uIndex);
+    }
+}
+
+static _ccObjectClassRecord* classRecord(const std::type_info &type)
+{
+    _ccThreadCache *cache = threadCache();
+    unsigned int uSlot = (unsigned int)(((size_t)&type >> 4) & (kClassCacheSize - 1));
+    if (cache && cache->classCacheTypes[uSlot] == &type)
+    {
+        return cache->classCacheRecords[uSlot];
+    }
+
+    pthread_mutex_lock(&s_registryMutex);
+    _ccObjectClassRecord *record = s_pClassRecords;
+    while (record && *record->type != type)
+    {
+        record = record->next;
+    }
+    if (! record)
+    {
+        record = (_ccObjectClassRecord*)calloc(1, sizeof(_ccObjectClassRecord));
+        if (record)
+        {
+            record->type = &type;
+            record->next = s_pClassRecords;
+            s_pClassRecords = record;
+        }
+    }
+    pthread_mutex_unlock(&s_registryMutex);
+
+    if (cache && record)
+    {
+        cache->classCacheTypes[uSlot] = &type;
+        cache->classCacheRecords[uSlot] = record;
+    }
+    return record;
+}
+
+void CCObjectAllocator::trackObject(CCObject *pObject)
+{
+    _ccObjectClassRecord *record = classRecord(typeid(*pObject));
+    if (! record)
+    {
+        return;
+    }
+
+    pObject->m_pClassRecord = record;
+    atomicAdd(&record->total, 1);
+    long lLive = atomicAdd(&record->live, 1);
+    long lPeak = record->peak;
+    while (lLive > lPeak && ! atomicCompareAndSwap(&record->peak, lPeak, lLive))
+    {
+        lPeak = record->peak;
+    }
+}
+
+void CCObjectAllocator::untrackObject(CCObject *pObject)
+{
+    atomicAdd(&pObject->m_pClassRecord->live, -1);
+}
+
+bool CCObjectAllocator::isEnabled(void)
+{
+    return true;
+}
+
+void CCObjectAllocator::resetPeaks(void)
+{
+    pthread_once(&s_initOnce, initAllocator);
+    pthread_mutex_lock(&s_registryMutex);
+    for (_ccObjectClassRecord *record = s_pClassRecords; record; record = record->next)
+    {
+        record->peak = record->live;
+    }
+    pthread_mutex_unlock(&s_registryMutex);
+}
+
+static bool compareClassStats(const ccObjectClassStats &a, const ccObjectClassStats &b)
+{
+    if (a.live != b.live)
+    {
+        return a.live > b.live;
+    }
+    return a.total > b.total;
+}
+
+void CCObjectAllocator::getClassStats(std::vector<ccObjectClassStats> &stats)
+{
+    stats.clear();
+
+    pthread_once(&s_initOnce, initAllocator);
+    pthread_mutex_lock(&s_registryMutex);
+    for (_ccObjectClassRecord *record = s_pClassRecords; record; record = record->next)
+    {
+        ccObjectClassStats classStats;
+        classStats.name = CCObjectTracker::getClassName(*record->type);
+        classStats.live = (unsigned int)record->live;
+        classStats.peak = (unsigned int)record->peak;
+        classStats.total = (unsigned int)record->total;
+        stats.push_back(classStats);
+    }
+    pthread_mutex_unlock(&s_registryMutex);
+
+    std::sort(stats.begin(), stats.end(), compareClassStats);
+}
+
+std::string CCObjectAllocator::getReport(void)
+{
+    std::vector<ccObjectClassStats> stats;
+    getClassStats(stats);
+
+    std::string report;
+    char szLine[256];
+
+    sprintf(szLine, "%-48s %10s %10s %10s\n", "class", "live", "peak", "total");
+    report += szLine;
+    for (unsigned int i = 0; i < stats.size(); ++i)
+    {
+        sprintf(szLine, "%-48.160s %10u %10u %10u\n",
+            stats[i].name.c_str(), stats[i].live, stats[i].peak, stats[i].total);
+        report += szLine;
+    }
+
+    // the counters of the running threads are read without their owner knowing, they are only indicative
+    unsigned int allocs[kSizeClassCount + 1];
+    unsigned int frees[kSizeClassCount + 1];
+    pthread_mutex_lock(&s_registryMutex);
+    for (unsigned int i = 0; i <= kSizeClassCount; ++i)
+    {
+        allocs[i] = s_retiredAllocs[i];
+        frees[i] = s_retiredFrees[i];
+        for (_ccThreadCache *cache = s_pThreadCaches; cache; cache = cache->next)
+        {
+            allocs[i] += cache->allocs[i];
+            frees[i] += cache->frees[i];
+        }
+    }
+    pthread_mutex_unlock(&s_registryMutex);
+
+    sprintf(szLine, "\n%-10s %10s %10s %10s %10s\n", "size", "live", "total", "free", "slab KB");
+    report += szLine;
+    unsigned int uSlabCount = 0;
+    for (unsigned int i = 0; i <= kSizeClassCount; ++i)
+    {
+        if (allocs[i] == 0)
+        {
+            continue;
+        }
+
+        unsigned int uFreeCount = 0;
+        unsigned int uClassSlabCount = 0;
+        if (i < kSizeClassCount)
+        {
+            pthread_mutex_lock(&s_sizeClasses[i].mutex);
+            uFreeCount = s_sizeClasses[i].freeCount;
+            uClassSlabCount = s_sizeClasses[i].slabCount;
+            pthread_mutex_unlock(&s_sizeClasses[i].mutex);
+            uSlabCount += uClassSlabCount;
+            sprintf(szLine, "%-10u", (unsigned int)blockSize(i));
+        }
+        else
+        {
+            sprintf(szLine, ">%-9u", (unsigned int)kMaxSmallSize);
+        }
+        report += szLine;
+
+        sprintf(szLine, " %10u %10u %10u %10u\n",
+            allocs[i] - frees[i], allocs[i], uFreeCount, (unsigned int)(uClassSlabCount * kSlabSize / 1024));
+        report += szLine;
+    }
+    sprintf(szLine, "slabs: %u KB\n", (unsigned int)(uSlabCount * kSlabSize / 1024));
+    report += szLine;
+
+    return report;
+}
+
+#else // CC_ENABLE_OBJECT_ALLOCATOR
+
+void* CCObjectAllocator::allocate(size_t uSize)
+{
+    return ::operator new(uSize);
+}
+
+void CCObjectAllocator::deallocate(void *p, size_t uSize)
+{
+    CC_UNUSED_PARAM(uSize);
+    ::operator delete(p);
+}
+
+void CCObjectAllocator::trackObject(CCObject *pObject)
+{
+    CC_UNUSED_PARAM(pObject);
+}
+
+void CCObjectAllocator::untrackObject(CCObject *pObject)
+{
+    CC_UNUSED_PARAM(pObject);
+}
+
+bool CCObjectAllocator::isEnabled(void)
+{
+    return false;
+}
+
+void CCObjectAllocator::resetPeaks(void)
+{
+}
+
+void CCObjectAllocator::getClassStats(std::vector<ccObjectClassStats> &stats)
+{
+    stats.clear();
+}
+
+std::string CCObjectAllocator::getReport(void)
+{
+    return "CCObjectAllocator is disabled, set CC_ENABLE_OBJECT_ALLOCATOR to 1 in ccConfig.h\n";
+}
+
+#endif // CC_ENABLE_OBJECT_ALLOCATOR
+
+void CCObjectAllocator::dumpReport(void)
+{
+    std::string report = getReport();
+    size_t uStart = 0;
+    while (uStart < report.size())
+    {
+        size_t uEnd = report.find('\n', uStart);
+        if (uEnd == std::string::npos)
+        {
+            uEnd = report.size();
+        }
+        CCLOG("cocos2d: %s", report.substr(uStart, uEnd - uStart).c_str());
+        uStart = uEnd + 1;
+    }
+}
+
+NS_CC_END
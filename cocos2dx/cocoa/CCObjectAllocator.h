@@ -0,0 +1,105 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CCOBJECT_ALLOCATOR_H__
+#define __CCOBJECT_ALLOCATOR_H__
+
+#include "platform/CCPlatformMacros.h"
+#include "ccConfig.h"
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup base_nodes
+ * @{
+ */
+
+class CCObject;
+
+/** Allocation counters of one CCObject subclass */
+typedef struct _ccObjectClassStats
+{
+    std::string     name;
+    /** instances currently alive */
+    unsigned int    live;
+    /** highest number of instances alive at the same time */
+    unsigned int    peak;
+    /** instances created since the start of the application */
+    unsigned int    total;
+} ccObjectClassStats;
+
+/** @brief CCObjectAllocator serves the memory of CCObject and its subclasses when
+ CC_ENABLE_OBJECT_ALLOCATOR is set to 1.
+
+ Objects up to 1024 bytes are carved out of 64KB slabs, one free list per 16 bytes
+ size class. Each thread keeps a small cache of free blocks per size class, so most
+ allocations and deallocations don't take any lock; the caches are refilled from and
+ returned to the shared free lists by batches. The slabs are never given back to the system.
+ Classes with their own operator new (see CCActionPool) keep using it.
+
+ Besides, objects are counted per class the first time they are retained, released or
+ autoreleased, since their dynamic type isn't known before their constructors are done.
+ Objects that are only ever deleted directly are not counted per class.
+
+ When CC_ENABLE_OBJECT_ALLOCATOR is 0, objects use the global heap and the reports are empty.
+ The allocator isn't available on WinRT and WP8.
+ @since v2.2
+ @js NA
+ @lua NA
+ */
+class CC_DLL CCObjectAllocator
+{
+public:
+    static void* allocate(size_t uSize);
+    static void deallocate(void *p, size_t uSize);
+
+    /** Returns true if CCObject is allocated by the allocator in this build */
+    static bool isEnabled(void);
+
+    /** Fills stats with the counters of every class seen so far, the most alive first */
+    static void getClassStats(std::vector<ccObjectClassStats> &stats);
+    /** Sets the peak of every class to its current live count */
+    static void resetPeaks(void);
+
+    /** Returns a text report of the class counters and of the size classes */
+    static std::string getReport(void);
+    /** Logs getReport() */
+    static void dumpReport(void);
+
+private:
+    static void trackObject(CCObject *pObject);
+    static void untrackObject(CCObject *pObject);
+
+    friend class CCObject;
+};
+
+// end of base_nodes group
+/// @}
+
+NS_CC_END
+
+#endif // __CCOBJECT_ALLOCATOR_H__
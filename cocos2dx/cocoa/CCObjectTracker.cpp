@@ -0,0 +1,557 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCObjectTracker.h"
+#include "CCObject.h"
+#include "ccMacros.h"
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__GNUC__) && !defined(_MSC_VER)
+#include <cxxabi.h>
+#endif
+
+#if CC_ENABLE_OBJECT_TRACKER
+#include <pthread.h>
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_IOS)
+#include <execinfo.h>
+#define CC_OBJECT_TRACKER_EXECINFO 1
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+#include <unwind.h>
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+#include <windows.h>
+#endif
+#endif
+
+NS_CC_BEGIN
+
+// objects listed per class in the text diffs
+static const unsigned int kMaxListedObjects = 20;
+
+CCObjectSnapshot::CCObjectSnapshot(void)
+: m_uFrame(0)
+{
+}
+
+unsigned int CCObjectSnapshot::getClassCount(const char *pszClassName) const
+{
+    std::map<std::string, unsigned int>::const_iterator it = m_obClassCounts.find(pszClassName);
+    return it != m_obClassCounts.end() ? it->second : 0;
+}
+
+static std::string jsonString(const std::string &value)
+{
+    std::string result = "\"";
+    for (unsigned int i = 0; i < value.size(); ++i)
+    {
+        char c = value[i];
+        if (c == '"' || c == '\\')
+        {
+            result += '\\';
+            result += c;
+        }
+        else if ((unsigned char)c < 0x20)
+        {
+            char szEscape[8];
+            sprintf(szEscape, "\\u%04x", (unsigned int)(unsigned char)c);
+            result += szEscape;
+        }
+        else
+        {
+            result += c;
+        }
+    }
+    result += '"';
+    return result;
+}
+
+typedef std::pair<std::string, unsigned int> ccClassCount;
+
+static bool compareClassCounts(const ccClassCount &a, const ccClassCount &b)
+{
+    if (a.second != b.second)
+    {
+        return a.second > b.second;
+    }
+    return a.first < b.first;
+}
+
+static void sortedClassCounts(const std::map<std::string, unsigned int> &counts, std::vector<ccClassCount> &sorted)
+{
+    sorted.assign(counts.begin(), counts.end());
+    std::sort(sorted.begin(), sorted.end(), compareClassCounts);
+}
+
+static std::string symbolName(void *pAddress);
+
+std::string CCObjectSnapshot::getReport(ccObjectReportFormat eFormat) const
+{
+    std::vector<ccClassCount> classes;
+    sortedClassCounts(m_obClassCounts, classes);
+
+    std::string report;
+    char szLine[256];
+
+    if (eFormat == kCCObjectReportFormatJSON)
+    {
+        sprintf(szLine, "{\"frame\":%u,\"objects\":%u,\"classes\":[", m_uFrame, getObjectCount());
+        report += szLine;
+        for (unsigned int i = 0; i < classes.size(); ++i)
+        {
+            report += i > 0 ? ",{\"class\":" : "{\"class\":";
+            report += jsonString(classes[i].first);
+            sprintf(szLine, ",\"count\":%u}", classes[i].second);
+            report += szLine;
+        }
+        report += "]}\n";
+    }
+    else
+    {
+        sprintf(szLine, "%u live objects at frame %u\n", getObjectCount(), m_uFrame);
+        report += szLine;
+        for (unsigned int i = 0; i < classes.size(); ++i)
+        {
+            sprintf(szLine, "%10u  %.200s\n", classes[i].second, classes[i].first.c_str());
+            report += szLine;
+        }
+    }
+    return report;
+}
+
+std::string CCObjectSnapshot::getDiff(const CCObjectSnapshot &older, ccObjectReportFormat eFormat) const
+{
+    // both lists are sorted by serial number
+    std::map<std::string, std::vector<const Object*> > added;
+    std::map<std::string, unsigned int> addedCounts;
+    unsigned int uAddedCount = 0;
+    std::vector<Object>::const_iterator oldIt = older.m_obObjects.begin();
+    for (std::vector<Object>::const_iterator it = m_obObjects.begin(); it != m_obObjects.end(); ++it)
+    {
+        while (oldIt != older.m_obObjects.end() && oldIt->serial < it->serial)
+        {
+            ++oldIt;
+        }
+        if (oldIt == older.m_obObjects.end() || oldIt->serial != it->serial)
+        {
+            added[it->className].push_back(&*it);
+            ++addedCounts[it->className];
+            ++uAddedCount;
+        }
+    }
+
+    std::vector<ccClassCount> classes;
+    sortedClassCounts(addedCounts, classes);
+
+    std::string report;
+    char szLine[256];
+    bool bJSON = eFormat == kCCObjectReportFormatJSON;
+
+    if (bJSON)
+    {
+        sprintf(szLine, "{\"frame\":%u,\"since\":%u,\"objects\":%u,\"classes\":[", m_uFrame, older.m_uFrame, uAddedCount);
+    }
+    else
+    {
+        sprintf(szLine, "%u objects alive at frame %u that were not alive at frame %u\n", uAddedCount, m_uFrame, older.m_uFrame);
+    }
+    report += szLine;
+
+    for (unsigned int i = 0; i < classes.size(); ++i)
+    {
+        const std::vector<const Object*> &objects = added[classes[i].first];
+        if (bJSON)
+        {
+            report += i > 0 ? ",{\"class\":" : "{\"class\":";
+            report += jsonString(classes[i].first);
+            sprintf(szLine, ",\"count\":%u,\"objects\":[", classes[i].second);
+        }
+        else
+        {
+            sprintf(szLine, "%10u  %.200s\n", classes[i].second, classes[i].first.c_str());
+        }
+        report += szLine;
+
+        for (unsigned int j = 0; j < objects.size(); ++j)
+        {
+            const Object *pObject = objects[j];
+            if (bJSON)
+            {
+                sprintf(szLine, "%s{\"serial\":%u,\"frame\":%u,\"backtrace\":[", j > 0 ? "," : "", pObject->serial, pObject->frame);
+                report += szLine;
+                for (unsigned int k = 0; k < pObject->backtrace.size(); ++k)
+                {
+                    if (k > 0)
+                    {
+                        report += ",";
+                    }
+                    report += jsonString(symbolName(pObject->backtrace[k]));
+                }
+                report += "]}";
+                continue;
+            }
+
+            if (j == kMaxListedObjects)
+            {
+                sprintf(szLine, "            ... and %u more\n", (unsigned int)objects.size() - j);
+                report += szLine;
+                break;
+            }
+            sprintf(szLine, "            #%u created at frame %u\n", pObject->serial, pObject->frame);
+            report += szLine;
+            for (unsigned int k = 0; k < pObject->backtrace.size(); ++k)
+            {
+                report += "                ";
+                report += symbolName(pObject->backtrace[k]);
+                report += "\n";
+            }
+        }
+
+        if (bJSON)
+        {
+            report += "]}";
+        }
+    }
+
+    if (bJSON)
+    {
+        report += "]}\n";
+    }
+    return report;
+}
+
+std::string CCObjectTracker::getClassName(const std::type_info &type)
+{
+    std::string name = type.name();
+#if defined(__GNUC__) && !defined(_MSC_VER)
+    int status = 0;
+    char *pszDemangled = abi::__cxa_demangle(type.name(), NULL, NULL, &status);
+    if (pszDemangled)
+    {
+        if (status == 0)
+        {
+            name = pszDemangled;
+        }
+        free(pszDemangled);
+    }
+#endif
+    return name;
+}
+
+void CCObjectTracker::dumpLiveObjects(void)
+{
+    CCObjectSnapshot snapshot;
+    takeSnapshot(snapshot);
+
+    std::string report = snapshot.getReport();
+    size_t uStart = 0;
+    while (uStart < report.size())
+    {
+        size_t uEnd = report.find('\n', uStart);
+        if (uEnd == std::string::npos)
+        {
+            uEnd = report.size();
+        }
+        CCLOG("cocos2d: %s", report.substr(uStart, uEnd - uStart).c_str());
+        uStart = uEnd + 1;
+    }
+}
+
+#if CC_ENABLE_OBJECT_TRACKER
+
+// deepest backtrace recorded, not counting the tracker itself
+static const unsigned int kMaxBacktraceDepth = 16;
+// captureBacktrace() and trackObject()
+static const unsigned int kSkippedFrames = 2;
+
+struct _ccTrackedObject
+{
+    CCObject            *object;
+    unsigned int        serial;
+    unsigned int        frame;
+    _ccTrackedObject    *prev;
+    _ccTrackedObject    *next;
+    unsigned int        backtraceDepth;
+    void                *backtrace[1];
+};
+
+// never destroyed, objects may still be released by static destructors once the application is exiting
+static pthread_once_t s_initOnce = PTHREAD_ONCE_INIT;
+static pthread_mutex_t s_mutex;
+// newest first
+static _ccTrackedObject *s_pFirstTrackedObject = NULL;
+static unsigned int s_uLiveObjectCount = 0;
+static unsigned int s_uNextSerial = 1;
+static unsigned int s_uCurrentFrame = 0;
+static bool s_bBacktraceEnabled = false;
+
+static void initTracker(void)
+{
+    pthread_mutex_init(&s_mutex, NULL);
+}
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+struct _ccUnwindState
+{
+    void **current;
+    void **end;
+};
+
+static _Unwind_Reason_Code unwindCallback(struct _Unwind_Context *context, void *pState)
+{
+    _ccUnwindState *state = (_ccUnwindState*)pState;
+    void *pAddress = (void*)_Unwind_GetIP(context);
+    if (pAddress)
+    {
+        if (state->current == state->end)
+        {
+            return _URC_END_OF_STACK;
+        }
+        *state->current++ = pAddress;
+    }
+    return _URC_NO_REASON;
+}
+#endif
+
+static unsigned int captureBacktrace(void **pFrames, unsigned int uMaxDepth)
+{
+#if defined(CC_OBJECT_TRACKER_EXECINFO)
+    int depth = backtrace(pFrames, (int)uMaxDepth);
+    return depth > 0 ? (unsigned int)depth : 0;
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+    _ccUnwindState state = { pFrames, pFrames + uMaxDepth };
+    _Unwind_Backtrace(unwindCallback, &state);
+    return (unsigned int)(state.current - pFrames);
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+    return CaptureStackBackTrace(0, uMaxDepth, pFrames, NULL);
+#else
+    CC_UNUSED_PARAM(pFrames);
+    CC_UNUSED_PARAM(uMaxDepth);
+    return 0;
+#endif
+}
+
+static std::string symbolName(void *pAddress)
+{
+    char szAddress[32];
+    sprintf(szAddress, "%p", pAddress);
+    std::string name = szAddress;
+
+#if defined(CC_OBJECT_TRACKER_EXECINFO)
+    char **ppszSymbols = backtrace_symbols(&pAddress, 1);
+    if (ppszSymbols)
+    {
+        name = ppszSymbols[0];
+        free(ppszSymbols);
+    }
+#endif
+    return name;
+}
+
+bool CCObjectTracker::isEnabled(void)
+{
+    return true;
+}
+
+void CCObjectTracker::setBacktraceEnabled(bool bEnabled)
+{
+    s_bBacktraceEnabled = bEnabled;
+}
+
+bool CCObjectTracker::isBacktraceEnabled(void)
+{
+    return s_bBacktraceEnabled;
+}
+
+unsigned int CCObjectTracker::getLiveObjectCount(void)
+{
+    return s_uLiveObjectCount;
+}
+
+void CCObjectTracker::setCurrentFrame(unsigned int uFrame)
+{
+    s_uCurrentFrame = uFrame;
+}
+
+void CCObjectTracker::trackObject(CCObject *pObject)
+{
+    void *frames[kMaxBacktraceDepth + kSkippedFrames];
+    unsigned int uDepth = 0;
+    if (s_bBacktraceEnabled)
+    {
+        uDepth = captureBacktrace(frames, kMaxBacktraceDepth + kSkippedFrames);
+        uDepth = uDepth > kSkippedFrames ? uDepth - kSkippedFrames : 0;
+    }
+
+    _ccTrackedObject *record = (_ccTrackedObject*)malloc(sizeof(_ccTrackedObject) + uDepth * sizeof(void*));
+    if (! record)
+    {
+        pObject->m_pTrackedObject = NULL;
+        return;
+    }
+    record->object = pObject;
+    record->frame = s_uCurrentFrame;
+    record->prev = NULL;
+    record->backtraceDepth = uDepth;
+    for (unsigned int i = 0; i < uDepth; ++i)
+    {
+        record->backtrace[i] = frames[i + kSkippedFrames];
+    }
+
+    pthread_once(&s_initOnce, initTracker);
+    pthread_mutex_lock(&s_mutex);
+    record->serial = s_uNextSerial++;
+    record->next = s_pFirstTrackedObject;
+    if (s_pFirstTrackedObject)
+    {
+        s_pFirstTrackedObject->prev = record;
+    }
+    s_pFirstTrackedObject = record;
+    ++s_uLiveObjectCount;
+    pthread_mutex_unlock(&s_mutex);
+
+    pObject->m_pTrackedObject = record;
+}
+
+void CCObjectTracker::untrackObject(CCObject *pObject)
+{
+    _ccTrackedObject *record = pObject->m_pTrackedObject;
+    if (! record)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&s_mutex);
+    if (record->prev)
+    {
+        record->prev->next = record->next;
+    }
+    else
+    {
+        s_pFirstTrackedObject = record->next;
+    }
+    if (record->next)
+    {
+        record->next->prev = record->prev;
+    }
+    --s_uLiveObjectCount;
+    pthread_mutex_unlock(&s_mutex);
+
+    pObject->m_pTrackedObject = NULL;
+    free(record);
+}
+
+void CCObjectTracker::takeSnapshot(CCObjectSnapshot &snapshot)
+{
+    snapshot.m_uFrame = s_uCurrentFrame;
+    snapshot.m_obObjects.clear();
+    snapshot.m_obClassCounts.clear();
+
+    // demangling is slow, do it once per class
+    std::map<const std::type_info*, std::string> names;
+
+    pthread_once(&s_initOnce, initTracker);
+    pthread_mutex_lock(&s_mutex);
+    snapshot.m_obObjects.resize(s_uLiveObjectCount);
+    unsigned int uIndex = s_uLiveObjectCount;
+    for (_ccTrackedObject *record = s_pFirstTrackedObject; record; record = record->next)
+    {
+        // the lock doesn't protect the vtable of an object that another thread is building or destroying,
+        // hence the main thread only restriction of takeSnapshot()
+        const std::type_info &type = typeid(*record->object);
+        std::map<const std::type_info*, std::string>::iterator it = names.find(&type);
+        if (it == names.end())
+        {
+            it = names.insert(std::make_pair(&type, getClassName(type))).first;
+        }
+
+        // the list is newest first
+        CCObjectSnapshot::Object &object = snapshot.m_obObjects[--uIndex];
+        object.serial = record->serial;
+        object.frame = record->frame;
+        object.className = it->second;
+        object.backtrace.assign(record->backtrace, record->backtrace + record->backtraceDepth);
+    }
+    pthread_mutex_unlock(&s_mutex);
+
+    for (unsigned int i = 0; i < snapshot.m_obObjects.size(); ++i)
+    {
+        ++snapshot.m_obClassCounts[snapshot.m_obObjects[i].className];
+    }
+}
+
+#else // CC_ENABLE_OBJECT_TRACKER
+
+static std::string symbolName(void *pAddress)
+{
+    char szAddress[32];
+    sprintf(szAddress, "%p", pAddress);
+    return szAddress;
+}
+
+bool CCObjectTracker::isEnabled(void)
+{
+    return false;
+}
+
+void CCObjectTracker::setBacktraceEnabled(bool bEnabled)
+{
+    CC_UNUSED_PARAM(bEnabled);
+}
+
+bool CCObjectTracker::isBacktraceEnabled(void)
+{
+    return false;
+}
+
+unsigned int CCObjectTracker::getLiveObjectCount(void)
+{
+    return 0;
+}
+
+void CCObjectTracker::setCurrentFrame(unsigned int uFrame)
+{
+    CC_UNUSED_PARAM(uFrame);
+}
+
+void CCObjectTracker::trackObject(CCObject *pObject)
+{
+    CC_UNUSED_PARAM(pObject);
+}
+
+void CCObjectTracker::untrackObject(CCObject *pObject)
+{
+    CC_UNUSED_PARAM(pObject);
+}
+
+void CCObjectTracker::takeSnapshot(CCObjectSnapshot &snapshot)
+{
+    snapshot.m_uFrame = 0;
+    snapshot.m_obObjects.clear();
+    snapshot.m_obClassCounts.clear();
+}
+
+#endif // CC_ENABLE_OBJECT_TRACKER
+
+NS_CC_END
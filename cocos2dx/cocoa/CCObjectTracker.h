@@ -0,0 +1,160 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CCOBJECT_TRACKER_H__
+#define __CCOBJECT_TRACKER_H__
+
+#include "platform/CCPlatformMacros.h"
+#include "ccConfig.h"
+#include <map>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup base_nodes
+ * @{
+ */
+
+class CCObject;
+
+typedef enum
+{
+    kCCObjectReportFormatText,
+    kCCObjectReportFormatJSON
+} ccObjectReportFormat;
+
+/** @brief The live objects at a given time, see CCObjectTracker::takeSnapshot()
+ @since v2.2
+ @js NA
+ @lua NA
+ */
+class CC_DLL CCObjectSnapshot
+{
+public:
+    CCObjectSnapshot(void);
+
+    /** frame during which the snapshot was taken */
+    inline unsigned int getFrame(void) const { return m_uFrame; }
+    inline unsigned int getObjectCount(void) const { return (unsigned int)m_obObjects.size(); }
+    /** number of live objects per class name */
+    inline const std::map<std::string, unsigned int>& getClassCounts(void) const { return m_obClassCounts; }
+    /** number of live objects of a class, pszClassName is a demangled name such as "cocos2d::CCSprite" */
+    unsigned int getClassCount(const char *pszClassName) const;
+
+    /** Returns the live objects per class */
+    std::string getReport(ccObjectReportFormat eFormat = kCCObjectReportFormatText) const;
+    /** Returns the objects of this snapshot that were not alive in pOlder, per class, with their
+     creation frame and backtrace. Taken before and after replaceScene(), it shows what the old scene leaked.
+     */
+    std::string getDiff(const CCObjectSnapshot &older, ccObjectReportFormat eFormat = kCCObjectReportFormatText) const;
+
+private:
+    struct Object
+    {
+        // serial number of the object, unique for the whole run
+        unsigned int        serial;
+        unsigned int        frame;
+        std::string         className;
+        std::vector<void*>  backtrace;
+    };
+
+    unsigned int                            m_uFrame;
+    // sorted by serial number
+    std::vector<Object>                     m_obObjects;
+    std::map<std::string, unsigned int>     m_obClassCounts;
+
+    friend class CCObjectTracker;
+};
+
+/** @brief CCObjectTracker keeps a registry of the live CCObjects when CC_ENABLE_OBJECT_TRACKER is set to 1.
+
+ Every CCObject registers itself in its constructor with the current frame and, if enabled,
+ the backtrace of its creation, and unregisters itself in its destructor. The classes are
+ resolved when a snapshot is taken, since constructors only know the type being built.
+ This reads the dynamic type of every live object, which changes while an object is being
+ constructed or destroyed: take the snapshots on the main thread, at a time no other thread
+ creates or releases CCObjects (e.g. not while CCTextureCache::addImageAsync() or the
+ armature asynchronous loading is running).
+
+ A typical leak hunt:
+ @code
+ CCObjectSnapshot before;
+ CCObjectTracker::takeSnapshot(before);
+ // replaceScene(), wait for the transition to end, then
+ CCObjectSnapshot after;
+ CCObjectTracker::takeSnapshot(after);
+ CCLog("%s", after.getDiff(before).c_str());
+ @endcode
+
+ When CC_ENABLE_OBJECT_TRACKER is 0 the snapshots are empty.
+ @since v2.2
+ @js NA
+ @lua NA
+ */
+class CC_DLL CCObjectTracker
+{
+public:
+    /** Returns true if the objects are tracked in this build */
+    static bool isEnabled(void);
+
+    /** Records the backtrace of the objects created from now on. Disabled by default, backtraces
+     are slow to capture and only available on Linux, Mac, iOS, Android and Win32.
+     Only Linux, Mac and iOS resolve the symbols, elsewhere the raw addresses are reported.
+     */
+    static void setBacktraceEnabled(bool bEnabled);
+    static bool isBacktraceEnabled(void);
+
+    /** Number of objects currently alive */
+    static unsigned int getLiveObjectCount(void);
+
+    /** Fills snapshot with the objects currently alive.
+     Main thread only, while no other thread creates or destroys CCObjects.
+     */
+    static void takeSnapshot(CCObjectSnapshot &snapshot);
+
+    /** Logs the live objects per class, same restrictions as takeSnapshot() */
+    static void dumpLiveObjects(void);
+
+    /** Called by the director once per frame */
+    static void setCurrentFrame(unsigned int uFrame);
+
+    /** Returns the readable name of a type, such as "cocos2d::CCSprite" */
+    static std::string getClassName(const std::type_info &type);
+
+private:
+    static void trackObject(CCObject *pObject);
+    static void untrackObject(CCObject *pObject);
+
+    friend class CCObject;
+};
+
+// end of base_nodes group
+/// @}
+
+NS_CC_END
+
+#endif // __CCOBJECT_TRACKER_H__
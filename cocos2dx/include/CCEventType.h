@@ -16,4 +16,9 @@
 // This message is posted in cocos2dx/platform/android/jni/MessageJni.cpp.
 #define EVENT_COME_TO_BACKGROUND    "event_come_to_background"
 
+// The director is being purged, after every target was unscheduled.
+// This message is used by the extensions for releasing what the director doesn't know about.
+// This message is posted in CCDirector::purgeDirector().
+#define EVENT_DIRECTOR_PURGE        "event_director_purge"
+
 #endif // __CCEVENT_TYPE_H__
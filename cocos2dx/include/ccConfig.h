@@ -261,6 +261,60 @@ To enable set it to a value different than 0. Disabled by default.
 #define CC_ENABLE_PROFILERS 0
 #endif
 
+/** @def CC_ENABLE_OBJECT_ALLOCATOR
+ If enabled, CCObject and its subclasses are allocated from size-class slabs with per-thread caches
+ instead of the global heap, and live, peak and total instance counters are kept per class.
+ See CCObjectAllocator::dumpReport().
+ 
+ To enable set it to a value different than 0. Disabled by default.
+ Not available on WinRT and WP8.
+ @since v2.2
+ */
+#ifndef CC_ENABLE_OBJECT_ALLOCATOR
+#define CC_ENABLE_OBJECT_ALLOCATOR 0
+#endif
+
+#if CC_ENABLE_OBJECT_ALLOCATOR && ((CC_TARGET_PLATFORM == CC_PLATFORM_WINRT) || (CC_TARGET_PLATFORM == CC_PLATFORM_WP8))
+#undef CC_ENABLE_OBJECT_ALLOCATOR
+#define CC_ENABLE_OBJECT_ALLOCATOR 0
+#endif
+
+/** @def CC_ENABLE_OBJECT_TRACKER
+ If enabled, every CCObject registers itself in CCObjectTracker with its creation frame and,
+ optionally, its creation backtrace. Snapshots of the live objects can then be compared to
+ find what a scene leaked. Useful for debugging purposes only, it slows down object creation.
+ 
+ To enable set it to a value different than 0. Disabled by default.
+ Not available on WinRT and WP8.
+ @since v2.2
+ */
+#ifndef CC_ENABLE_OBJECT_TRACKER
+#define CC_ENABLE_OBJECT_TRACKER 0
+#endif
+
+#if CC_ENABLE_OBJECT_TRACKER && ((CC_TARGET_PLATFORM == CC_PLATFORM_WINRT) || (CC_TARGET_PLATFORM == CC_PLATFORM_WP8))
+#undef CC_ENABLE_OBJECT_TRACKER
+#define CC_ENABLE_OBJECT_TRACKER 0
+#endif
+
+/** @def CC_ENABLE_TRACER
+ If enabled, the CC_TRACE_SCOPE scopes of the engine are compiled in and CCTracer can record them,
+ from every thread, into a Chrome trace. Nothing is recorded until CCTracer::setRecording() or
+ CCTracer::startCapture() is called, a scope then costs two clock reads.
+ 
+ To enable set it to a value different than 0. Disabled by default.
+ Not available on WinRT and WP8.
+ @since v2.2
+ */
+#ifndef CC_ENABLE_TRACER
+#define CC_ENABLE_TRACER 0
+#endif
+
+#if CC_ENABLE_TRACER && ((CC_TARGET_PLATFORM == CC_PLATFORM_WINRT) || (CC_TARGET_PLATFORM == CC_PLATFORM_WP8))
+#undef CC_ENABLE_TRACER
+#define CC_ENABLE_TRACER 0
+#endif
+
 /** Enable Lua engine debug log */
 #ifndef CC_LUA_ENGINE_DEBUG
 #define CC_LUA_ENGINE_DEBUG 0
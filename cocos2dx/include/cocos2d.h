@@ -42,6 +42,7 @@ THE SOFTWARE.
 #include "actions/CCActionInterval.h"
 #include "actions/CCActionCamera.h"
 #include "actions/CCActionManager.h"
+#include "actions/CCActionPool.h"
 #include "actions/CCActionEase.h"
 #include "actions/CCActionPageTurn3D.h"
 #include "actions/CCActionGrid.h"
@@ -60,6 +61,8 @@ THE SOFTWARE.
 #include "cocoa/CCAffineTransform.h"
 #include "cocoa/CCDictionary.h"
 #include "cocoa/CCObject.h"
+#include "cocoa/CCObjectAllocator.h"
+#include "cocoa/CCObjectTracker.h"
 #include "cocoa/CCArray.h"
 #include "cocoa/CCGeometry.h"
 #include "cocoa/CCSet.h"
@@ -99,6 +102,7 @@ THE SOFTWARE.
 #include "label_nodes/CCLabelAtlas.h"
 #include "label_nodes/CCLabelTTF.h"
 #include "label_nodes/CCLabelBMFont.h"
+#include "label_nodes/CCGlyphAtlas.h"
 
 // layers_scenes_transitions_nodes
 #include "layers_scenes_transitions_nodes/CCLayer.h"
@@ -260,6 +264,10 @@ THE SOFTWARE.
 #include "support/CCNotificationCenter.h"
 #include "support/CCPointExtension.h"
 #include "support/CCProfiling.h"
+#include "support/CCJobPool.h"
+#include "support/CCSpatialGrid.h"
+#include "support/CCTracer.h"
+#include "support/CCFrameTimeStats.h"
 #include "support/user_default/CCUserDefault.h"
 #include "support/CCVertex.h"
 #include "support/tinyxml2/tinyxml2.h"
@@ -0,0 +1,291 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCGlyphAtlas.h"
+#include "textures/CCTexture2D.h"
+#include "shaders/ccGLStateCache.h"
+#include "ccMacros.h"
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+#include "platform/linux/CCFontFreeType.h"
+#endif
+
+NS_CC_BEGIN
+
+#define kCCGlyphAtlasPageSize       512
+// keeps linear filtering from sampling the neighbours of a glyph
+#define kCCGlyphAtlasPadding        1
+
+typedef std::map<std::string, CCGlyphAtlas*> GlyphAtlasMap;
+static GlyphAtlasMap s_atlases;
+
+bool CCGlyphAtlas::isSupported()
+{
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+    return true;
+#else
+    return false;
+#endif
+}
+
+CCGlyphAtlas* CCGlyphAtlas::atlasForFont(const char *pszFontName, float fPixelSize)
+{
+    if (! isSupported())
+    {
+        return NULL;
+    }
+
+    // FreeType sizes are whole pixels
+    char szKey[16];
+    sprintf(szKey, "@%d", (int)fPixelSize);
+    std::string key = std::string(pszFontName) + szKey;
+
+    GlyphAtlasMap::iterator it = s_atlases.find(key);
+    if (it != s_atlases.end())
+    {
+        return it->second;
+    }
+
+    CCGlyphAtlas *pAtlas = new CCGlyphAtlas();
+    if (! pAtlas->initWithFont(pszFontName, fPixelSize))
+    {
+        pAtlas->release();
+        return NULL;
+    }
+    s_atlases[key] = pAtlas;
+    return pAtlas;
+}
+
+void CCGlyphAtlas::purgeAtlases()
+{
+    for (GlyphAtlasMap::iterator it = s_atlases.begin(); it != s_atlases.end(); ++it)
+    {
+        it->second->release();
+    }
+    s_atlases.clear();
+}
+
+CCGlyphAtlas::CCGlyphAtlas()
+: m_pFont(NULL)
+, m_pPages(NULL)
+, m_nShelfX(0)
+, m_nShelfY(0)
+, m_nShelfHeight(0)
+{
+}
+
+CCGlyphAtlas::~CCGlyphAtlas()
+{
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+    CC_SAFE_DELETE(m_pFont);
+#endif
+    CC_SAFE_RELEASE(m_pPages);
+}
+
+bool CCGlyphAtlas::initWithFont(const char *pszFontName, float fPixelSize)
+{
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+    m_pFont = new CCFontFreeType();
+    if (! m_pFont->init(pszFontName, fPixelSize))
+    {
+        return false;
+    }
+
+    if (m_pFont->getBoundingHeight() + 2 * kCCGlyphAtlasPadding > kCCGlyphAtlasPageSize)
+    {
+        CCLOG("CCGlyphAtlas: %s at %d pixels doesn't fit into a page", pszFontName, (int)fPixelSize);
+        return false;
+    }
+
+    m_pPages = new CCArray();
+    m_pPages->init();
+    return true;
+#else
+    CC_UNUSED_PARAM(pszFontName);
+    CC_UNUSED_PARAM(fPixelSize);
+    return false;
+#endif
+}
+
+CCTexture2D* CCGlyphAtlas::addPage()
+{
+    std::vector<unsigned char> data(kCCGlyphAtlasPageSize * kCCGlyphAtlasPageSize, 0);
+
+    CCTexture2D *pPage = new CCTexture2D();
+    if (! pPage->initWithData(&data[0], kCCTexture2DPixelFormat_A8, kCCGlyphAtlasPageSize, kCCGlyphAtlasPageSize,
+                              CCSizeMake(kCCGlyphAtlasPageSize, kCCGlyphAtlasPageSize)))
+    {
+        pPage->release();
+        return NULL;
+    }
+    m_pPages->addObject(pPage);
+    pPage->release();
+
+    m_nShelfX = 0;
+    m_nShelfY = 0;
+    m_nShelfHeight = 0;
+    return pPage;
+}
+
+bool CCGlyphAtlas::reserve(int nWidth, int nHeight, unsigned int &uPage, int &x, int &y)
+{
+    int w = nWidth + 2 * kCCGlyphAtlasPadding;
+    int h = nHeight + 2 * kCCGlyphAtlasPadding;
+    if (w > kCCGlyphAtlasPageSize || h > kCCGlyphAtlasPageSize)
+    {
+        return false;
+    }
+
+    if (m_pPages->count() > 0 && m_nShelfX + w > kCCGlyphAtlasPageSize)
+    {
+        // next shelf
+        m_nShelfX = 0;
+        m_nShelfY += m_nShelfHeight;
+        m_nShelfHeight = 0;
+    }
+    if (m_pPages->count() == 0 || m_nShelfY + h > kCCGlyphAtlasPageSize)
+    {
+        if (! addPage())
+        {
+            return false;
+        }
+    }
+
+    uPage = m_pPages->count() - 1;
+    x = m_nShelfX + kCCGlyphAtlasPadding;
+    y = m_nShelfY + kCCGlyphAtlasPadding;
+    m_nShelfX += w;
+    m_nShelfHeight = MAX(m_nShelfHeight, h);
+    return true;
+}
+
+const ccGlyphAtlasGlyph* CCGlyphAtlas::glyphForChar(unsigned short uChar)
+{
+    std::map<unsigned short, ccGlyphAtlasGlyph>::iterator it = m_glyphs.find(uChar);
+    if (it != m_glyphs.end())
+    {
+        return &it->second;
+    }
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+    if (m_failedChars.find(uChar) != m_failedChars.end())
+    {
+        return NULL;
+    }
+
+    ccGlyphAtlasGlyph glyph;
+    memset(&glyph, 0, sizeof(glyph));
+    glyph.glyphIndex = m_pFont->getGlyphIndex(uChar);
+
+    ccFreeTypeGlyphMetrics metrics;
+    FT_Bitmap *pBitmap = m_pFont->renderGlyph(glyph.glyphIndex, metrics);
+    if (! pBitmap)
+    {
+        // FreeType won't render it any better next time
+        m_failedChars.insert(uChar);
+        return NULL;
+    }
+    glyph.bearingX = metrics.bearingX;
+    glyph.bearingY = metrics.bearingY;
+    glyph.advance = metrics.advance;
+    glyph.width = pBitmap->width;
+    glyph.height = pBitmap->rows;
+
+    // blank glyphs, like spaces, only move the pen
+    if (glyph.width > 0 && glyph.height > 0)
+    {
+        if (! reserve(glyph.width, glyph.height, glyph.page, glyph.x, glyph.y))
+        {
+            return NULL;
+        }
+
+        // the rows of the FreeType bitmap may be padded
+        std::vector<unsigned char> pixels(glyph.width * glyph.height);
+        for (int row = 0; row < glyph.height; ++row)
+        {
+            memcpy(&pixels[row * glyph.width], pBitmap->buffer + row * pBitmap->pitch, glyph.width);
+        }
+
+        ccGLBindTexture2D(getPage(glyph.page)->getName());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, glyph.x, glyph.y, glyph.width, glyph.height, GL_ALPHA, GL_UNSIGNED_BYTE, &pixels[0]);
+        CHECK_GL_ERROR_DEBUG();
+    }
+
+    return &(m_glyphs[uChar] = glyph);
+#else
+    return NULL;
+#endif
+}
+
+int CCGlyphAtlas::getKerning(const ccGlyphAtlasGlyph *pLeft, const ccGlyphAtlasGlyph *pRight)
+{
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+    return m_pFont->getKerning(pLeft->glyphIndex, pRight->glyphIndex);
+#else
+    return 0;
+#endif
+}
+
+int CCGlyphAtlas::getLineHeight()
+{
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+    return m_pFont->getLineHeight();
+#else
+    return 0;
+#endif
+}
+
+int CCGlyphAtlas::getAscender()
+{
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+    return m_pFont->getAscender();
+#else
+    return 0;
+#endif
+}
+
+int CCGlyphAtlas::getBoundingHeight()
+{
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+    return m_pFont->getBoundingHeight();
+#else
+    return 0;
+#endif
+}
+
+unsigned int CCGlyphAtlas::getPageCount()
+{
+    return m_pPages ? m_pPages->count() : 0;
+}
+
+CCTexture2D* CCGlyphAtlas::getPage(unsigned int uPage)
+{
+    return (CCTexture2D*)m_pPages->objectAtIndex(uPage);
+}
+
+NS_CC_END
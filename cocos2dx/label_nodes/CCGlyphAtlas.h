@@ -0,0 +1,130 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CCGLYPHATLAS_H__
+#define __CCGLYPHATLAS_H__
+
+#include "cocoa/CCObject.h"
+#include "cocoa/CCArray.h"
+#include <map>
+#include <set>
+#include <string>
+
+NS_CC_BEGIN
+
+class CCTexture2D;
+class CCFontFreeType;
+
+/**
+ * @addtogroup GUI
+ * @{
+ * @addtogroup label
+ * @{
+ */
+
+/** A glyph rasterized into a page of a CCGlyphAtlas, in pixels */
+typedef struct _ccGlyphAtlasGlyph
+{
+    //! index of the glyph in the font, used for kerning
+    unsigned int glyphIndex;
+    //! page holding the glyph
+    unsigned int page;
+    //! rectangle of the glyph in its page
+    int x, y, width, height;
+    //! offset from the pen position to the top left of the glyph, y going up
+    int bearingX, bearingY;
+    //! horizontal distance to the next pen position
+    int advance;
+} ccGlyphAtlasGlyph;
+
+/** @brief CCGlyphAtlas rasterizes the glyphs of a font at a pixel size into shared A8 texture pages.
+
+ Glyphs are rasterized the first time they are asked for, and each one is uploaded with
+ glTexSubImage2D into the current page, so the labels using the atlas only rewrite quads
+ when their text changes. Atlases are shared by font name and size, see atlasForFont().
+
+ Only available on Linux for now, where it uses FreeType directly.
+ @since v2.2
+ @js NA
+ @lua NA
+ */
+class CC_DLL CCGlyphAtlas : public CCObject
+{
+public:
+    CCGlyphAtlas();
+    virtual ~CCGlyphAtlas();
+
+    /** Returns true if glyph atlases are available on this platform */
+    static bool isSupported();
+
+    /** Returns the shared atlas of a font at fPixelSize pixels, or NULL if the font can't be opened */
+    static CCGlyphAtlas* atlasForFont(const char *pszFontName, float fPixelSize);
+
+    /** Releases the shared atlases, labels using them keep them alive */
+    static void purgeAtlases();
+
+    /** Returns the glyph of a character, rasterizing it if needed, or NULL on failure.
+     A character FreeType can't render returns NULL right away after the first try.
+     */
+    const ccGlyphAtlasGlyph* glyphForChar(unsigned short uChar);
+
+    /** Horizontal kerning between two glyphs, in pixels */
+    int getKerning(const ccGlyphAtlasGlyph *pLeft, const ccGlyphAtlasGlyph *pRight);
+
+    /** Distance between two baselines, in pixels */
+    int getLineHeight();
+    /** Distance from the top of a line to its baseline, in pixels */
+    int getAscender();
+    /** Height of a line, in pixels */
+    int getBoundingHeight();
+
+    unsigned int getPageCount();
+    CCTexture2D* getPage(unsigned int uPage);
+
+protected:
+    bool initWithFont(const char *pszFontName, float fPixelSize);
+    // returns false if the glyph doesn't fit into an empty page
+    bool reserve(int nWidth, int nHeight, unsigned int &uPage, int &x, int &y);
+    CCTexture2D* addPage();
+
+    CCFontFreeType *m_pFont;
+    std::map<unsigned short, ccGlyphAtlasGlyph> m_glyphs;
+    //! characters FreeType can't render, not tried again
+    std::set<unsigned short> m_failedChars;
+    //! CCTexture2D pages
+    CCArray *m_pPages;
+
+    //! shelf being filled in the last page
+    int m_nShelfX;
+    int m_nShelfY;
+    int m_nShelfHeight;
+};
+
+// end of label group
+/// @}
+/// @}
+
+NS_CC_END
+
+#endif //__CCGLYPHATLAS_H__
@@ -47,22 +47,28 @@ using namespace std;
 
 NS_CC_BEGIN
 
-// The return value needs to be deleted by CC_SAFE_DELETE_ARRAY.
-static unsigned short* copyUTF16StringN(unsigned short* str)
+// Copies str into *pDest, which needs to be deleted by CC_SAFE_DELETE_ARRAY.
+// The storage of *pDest is reused when it is large enough.
+static void copyUTF16String(unsigned short** pDest, unsigned int* pCapacity, const unsigned short* str)
 {
-    int length = str ? cc_wcslen(str) : 0;
-    unsigned short* ret = new unsigned short[length+1];
-    for (int i = 0; i < length; ++i) {
-        ret[i] = str[i];
+    unsigned int length = str ? cc_wcslen(str) : 0;
+    if (*pDest == NULL || *pCapacity < length + 1)
+    {
+        CC_SAFE_DELETE_ARRAY(*pDest);
+        *pDest = new unsigned short[length+1];
+        *pCapacity = length + 1;
+    }
+    for (unsigned int i = 0; i < length; ++i) {
+        (*pDest)[i] = str[i];
     }
-    ret[length] = 0;
-    return ret;
+    (*pDest)[length] = 0;
 }
 
 //
 //FNTConfig Cache - free functions
 //
 static CCDictionary* s_pConfigurations = NULL;
+static bool s_bDiskCacheEnabled = false;
 
 CCBMFontConfiguration* FNTConfigLoadFile( const char *fntFile)
 {
@@ -95,6 +101,93 @@ void FNTConfigRemoveCache( void )
     }
 }
 
+void FNTConfigSetDiskCacheEnabled( bool bEnabled )
+{
+    s_bDiskCacheEnabled = bEnabled;
+}
+
+bool FNTConfigIsDiskCacheEnabled( void )
+{
+    return s_bDiskCacheEnabled;
+}
+
+static std::string cachePathForFNTFile(const std::string& fullpath);
+
+std::string FNTConfigGetDiskCachePath( const char *file )
+{
+    return cachePathForFNTFile(CCFileUtils::sharedFileUtils()->fullPathForFilename(file));
+}
+
+//
+// Binary FNT files, as written by the AngelCode editor (version 3):
+// "BMF" and the version, then blocks made of a type byte, a 32 bits size and the data.
+// All the numbers are little endian.
+//
+#define kCCBMFontBinaryVersion          3
+#define kCCBMFontBlockInfo              1
+#define kCCBMFontBlockCommon            2
+#define kCCBMFontBlockPages             3
+#define kCCBMFontBlockChars             4
+#define kCCBMFontBlockKerningPairs      5
+#define kCCBMFontInfoBlockSize          14
+#define kCCBMFontCommonBlockSize        15
+#define kCCBMFontCharSize               20
+#define kCCBMFontKerningPairSize        10
+
+// The parsed form of a text FNT file is cached as this header followed by a binary FNT file
+#define kCCBMFontCacheVersion           1
+#define kCCBMFontCacheHeaderSize        16
+
+static inline unsigned int readUInt16(const unsigned char *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static inline short readInt16(const unsigned char *p)
+{
+    return (short)readUInt16(p);
+}
+
+static inline unsigned int readUInt32(const unsigned char *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+static inline void writeUInt16(std::string& out, unsigned int value)
+{
+    out += (char)(value & 0xff);
+    out += (char)((value >> 8) & 0xff);
+}
+
+static inline void writeUInt32(std::string& out, unsigned int value)
+{
+    writeUInt16(out, value & 0xffff);
+    writeUInt16(out, value >> 16);
+}
+
+static inline bool isBinaryFNTFile(const unsigned char *pData, unsigned long uSize)
+{
+    return uSize >= 4 && pData[0] == 'B' && pData[1] == 'M' && pData[2] == 'F';
+}
+
+// FNV-1a
+static unsigned int hashData(const unsigned char *pData, unsigned long uSize)
+{
+    unsigned int hash = 2166136261u;
+    for (unsigned long i = 0; i < uSize; ++i)
+    {
+        hash = (hash ^ pData[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static std::string cachePathForFNTFile(const std::string& fullpath)
+{
+    char name[32];
+    sprintf(name, "fnt-%08x.cache", hashData((const unsigned char*)fullpath.c_str(), fullpath.length()));
+    return CCFileUtils::sharedFileUtils()->getWritablePath() + name;
+}
+
 //
 //BitmapFontConfiguration
 //
@@ -123,9 +216,60 @@ bool CCBMFontConfiguration::initWithFNTfile(const char *FNTfile)
         return false;
     }
 
+    this->buildLookupTables();
     return true;
 }
 
+void CCBMFontConfiguration::buildLookupTables()
+{
+    memset(m_pLatinFontDefs, 0, sizeof(m_pLatinFontDefs));
+    memset(m_bLatinKerningFirsts, 0, sizeof(m_bLatinKerningFirsts));
+
+    tCCFontDefHashElement *fontDef, *tmpFontDef;
+    HASH_ITER(hh, m_pFontDefDictionary, fontDef, tmpFontDef)
+    {
+        if (fontDef->key < kCCBMFontLatinCharCount)
+        {
+            m_pLatinFontDefs[fontDef->key] = &fontDef->fontDef;
+        }
+    }
+
+    tCCKerningHashElement *kerning, *tmpKerning;
+    HASH_ITER(hh, m_pKerningDictionary, kerning, tmpKerning)
+    {
+        unsigned int first = (unsigned int)kerning->key >> 16;
+        if (first < kCCBMFontLatinCharCount)
+        {
+            m_bLatinKerningFirsts[first] = true;
+        }
+    }
+}
+
+const ccBMFontDef* CCBMFontConfiguration::getFontDef(unsigned int uChar) const
+{
+    if (uChar < kCCBMFontLatinCharCount)
+    {
+        return m_pLatinFontDefs[uChar];
+    }
+
+    tCCFontDefHashElement *element = NULL;
+    HASH_FIND_INT(m_pFontDefDictionary, &uChar, element);
+    return element ? &element->fontDef : NULL;
+}
+
+int CCBMFontConfiguration::getKerningAmount(unsigned short first, unsigned short second) const
+{
+    if (! m_pKerningDictionary || (first < kCCBMFontLatinCharCount && ! m_bLatinKerningFirsts[first]))
+    {
+        return 0;
+    }
+
+    int key = (first<<16) | (second & 0xffff);
+    tCCKerningHashElement *element = NULL;
+    HASH_FIND_INT(m_pKerningDictionary, &key, element);
+    return element ? element->amount : 0;
+}
+
 std::set<unsigned int>* CCBMFontConfiguration::getCharacterSet() const
 {
     return m_pCharacterSet;
@@ -136,8 +280,11 @@ CCBMFontConfiguration::CCBMFontConfiguration()
 , m_nCommonHeight(0)
 , m_pKerningDictionary(NULL)
 , m_pCharacterSet(NULL)
+, m_pFontDefElements(NULL)
+, m_pKerningElements(NULL)
 {
-
+    memset(m_pLatinFontDefs, 0, sizeof(m_pLatinFontDefs));
+    memset(m_bLatinKerningFirsts, 0, sizeof(m_bLatinKerningFirsts));
 }
 
 CCBMFontConfiguration::~CCBMFontConfiguration()
@@ -162,6 +309,14 @@ const char* CCBMFontConfiguration::description(void)
 
 void CCBMFontConfiguration::purgeKerningDictionary()
 {
+    if (m_pKerningElements)
+    {
+        HASH_CLEAR(hh, m_pKerningDictionary);
+        free(m_pKerningElements);
+        m_pKerningElements = NULL;
+        return;
+    }
+
     tCCKerningHashElement *current;
     while(m_pKerningDictionary) 
     {
@@ -173,6 +328,14 @@ void CCBMFontConfiguration::purgeKerningDictionary()
 
 void CCBMFontConfiguration::purgeFontDefDictionary()
 {    
+    if (m_pFontDefElements)
+    {
+        HASH_CLEAR(hh, m_pFontDefDictionary);
+        free(m_pFontDefElements);
+        m_pFontDefElements = NULL;
+        return;
+    }
+
     tCCFontDefHashElement *current, *tmp;
 
     HASH_ITER(hh, m_pFontDefDictionary, current, tmp) {
@@ -183,38 +346,77 @@ void CCBMFontConfiguration::purgeFontDefDictionary()
 
 std::set<unsigned int>* CCBMFontConfiguration::parseConfigFile(const char *controlFile)
 {    
-    std::string fullpath = CCFileUtils::sharedFileUtils()->fullPathForFilename(controlFile);
-    CCString *contents = CCString::createWithContentsOfFile(fullpath.c_str());
+    CCFileUtils *fileUtils = CCFileUtils::sharedFileUtils();
+    std::string fullpath = fileUtils->fullPathForFilename(controlFile);
+    unsigned long size = 0;
+    unsigned char *data = fileUtils->getFileData(fullpath.c_str(), "rb", &size);
 
-    CCAssert(contents, "CCBMFontConfiguration::parseConfigFile | Open file error.");
-    
-    set<unsigned int> *validCharsString = new set<unsigned int>();
+    CCAssert(data, "CCBMFontConfiguration::parseConfigFile | Open file error.");
 
-    if (!contents)
+    if (!data)
     {
         CCLOG("cocos2d: Error parsing FNTfile %s", controlFile);
         return NULL;
     }
 
-    // parse spacing / padding
-    std::string line;
-    std::string strLeft = contents->getCString();
-    while (strLeft.length() > 0)
+    set<unsigned int> *validCharsString = NULL;
+    if (isBinaryFNTFile(data, size))
+    {
+        validCharsString = this->parseBinaryConfigFile(data, size, controlFile);
+    }
+    else if (! s_bDiskCacheEnabled)
     {
-        int pos = strLeft.find('\n');
+        validCharsString = this->parseTextConfigFile((const char*)data, size, controlFile);
+    }
+    else
+    {
+        // the cache is valid as long as it was made from the same text
+        std::string cachePath = cachePathForFNTFile(fullpath);
+        unsigned int hash = hashData(data, size);
 
-        if (pos != (int)std::string::npos)
+        if (fileUtils->isFileExist(cachePath))
         {
-            // the data is more than a line.get one line
-            line = strLeft.substr(0, pos);
-            strLeft = strLeft.substr(pos + 1);
+            unsigned long cacheSize = 0;
+            unsigned char *cache = fileUtils->getFileData(cachePath.c_str(), "rb", &cacheSize);
+            if (cache && cacheSize > kCCBMFontCacheHeaderSize
+                && memcmp(cache, "CCFN", 4) == 0
+                && readUInt32(cache + 4) == kCCBMFontCacheVersion
+                && readUInt32(cache + 8) == (unsigned int)size
+                && readUInt32(cache + 12) == hash)
+            {
+                validCharsString = this->parseBinaryConfigFile(cache + kCCBMFontCacheHeaderSize, cacheSize - kCCBMFontCacheHeaderSize, controlFile);
+            }
+            CC_SAFE_DELETE_ARRAY(cache);
         }
-        else
+
+        if (! validCharsString)
         {
-            // get the left data
-            line = strLeft;
-            strLeft.erase();
+            validCharsString = this->parseTextConfigFile((const char*)data, size, controlFile);
+            if (validCharsString && ! this->writeCacheFile(cachePath.c_str(), size, hash, *validCharsString))
+            {
+                CCLOG("cocos2d: Couldn't write the FNT cache file %s", cachePath.c_str());
+            }
         }
+    }
+
+    CC_SAFE_DELETE_ARRAY(data);
+    return validCharsString;
+}
+
+std::set<unsigned int>* CCBMFontConfiguration::parseTextConfigFile(const char *pData, unsigned long uSize, const char *controlFile)
+{
+    set<unsigned int> *validCharsString = new set<unsigned int>();
+
+    // parse spacing / padding
+    std::string line;
+    unsigned long lineStart = 0;
+    while (lineStart < uSize)
+    {
+        // get one line, without copying the rest of the file
+        const char *lineEnd = (const char*)memchr(pData + lineStart, '\n', uSize - lineStart);
+        unsigned long lineLength = lineEnd ? lineEnd - (pData + lineStart) : uSize - lineStart;
+        line.assign(pData + lineStart, lineLength);
+        lineStart += lineLength + 1;
 
         if(line.substr(0,strlen("info face")) == "info face") 
         {
@@ -245,7 +447,7 @@ std::set<unsigned int>* CCBMFontConfiguration::parseConfigFile(const char *contr
             element->key = element->fontDef.charID;
             HASH_ADD_INT(m_pFontDefDictionary, key, element);
             
-            validCharsString->insert(element->fontDef.charID);
+            validCharsString->insert(validCharsString->end(), element->fontDef.charID);
         }
 //        else if(line.substr(0,strlen("kernings count")) == "kernings count")
 //        {
@@ -277,9 +479,198 @@ void CCBMFontConfiguration::parseImageFileName(std::string line, const char *fnt
     index2 = line.find('"', index);
     value = line.substr(index, index2-index);
 
+    m_sPageFileName = value;
     m_sAtlasName = CCFileUtils::sharedFileUtils()->fullPathFromRelativeFile(value.c_str(), fntFile);
 }
 
+std::set<unsigned int>* CCBMFontConfiguration::parseBinaryConfigFile(const unsigned char *pData, unsigned long uSize, const char *controlFile)
+{
+    if (uSize < 4 || pData[3] != kCCBMFontBinaryVersion)
+    {
+        CCLOG("cocos2d: FNT file %s: only version %d of the binary format is supported", controlFile, kCCBMFontBinaryVersion);
+        return NULL;
+    }
+
+    const unsigned char *blocks[kCCBMFontBlockKerningPairs + 1] = { NULL };
+    unsigned int blockSizes[kCCBMFontBlockKerningPairs + 1] = { 0 };
+
+    unsigned long offset = 4;
+    while (offset + 5 <= uSize)
+    {
+        unsigned int type = pData[offset];
+        unsigned int blockSize = readUInt32(pData + offset + 1);
+        offset += 5;
+        if (blockSize > uSize - offset)
+        {
+            CCLOG("cocos2d: FNT file %s is truncated", controlFile);
+            return NULL;
+        }
+        if (type <= kCCBMFontBlockKerningPairs)
+        {
+            blocks[type] = pData + offset;
+            blockSizes[type] = blockSize;
+        }
+        offset += blockSize;
+    }
+
+    if (blockSizes[kCCBMFontBlockCommon] < kCCBMFontCommonBlockSize || blockSizes[kCCBMFontBlockPages] == 0)
+    {
+        CCLOG("cocos2d: FNT file %s has no common or pages block", controlFile);
+        return NULL;
+    }
+
+    if (blockSizes[kCCBMFontBlockInfo] >= kCCBMFontInfoBlockSize)
+    {
+        const unsigned char *info = blocks[kCCBMFontBlockInfo];
+        m_tPadding.top = info[7];
+        m_tPadding.right = info[8];
+        m_tPadding.bottom = info[9];
+        m_tPadding.left = info[10];
+    }
+
+    const unsigned char *common = blocks[kCCBMFontBlockCommon];
+    m_nCommonHeight = readUInt16(common);
+    CCAssert((int)readUInt16(common + 4) <= CCConfiguration::sharedConfiguration()->getMaxTextureSize(), "CCLabelBMFont: page can't be larger than supported");
+    CCAssert((int)readUInt16(common + 6) <= CCConfiguration::sharedConfiguration()->getMaxTextureSize(), "CCLabelBMFont: page can't be larger than supported");
+    CCAssert(readUInt16(common + 8) == 1, "CCBitfontAtlas: only supports 1 page");
+
+    // the names of the pages all have the same length, the first one ends at the first 0
+    const char *pages = (const char*)blocks[kCCBMFontBlockPages];
+    const char *pageEnd = (const char*)memchr(pages, 0, blockSizes[kCCBMFontBlockPages]);
+    m_sPageFileName.assign(pages, pageEnd ? pageEnd - pages : blockSizes[kCCBMFontBlockPages]);
+    m_sAtlasName = CCFileUtils::sharedFileUtils()->fullPathFromRelativeFile(m_sPageFileName.c_str(), controlFile);
+
+    set<unsigned int> *validCharsString = new set<unsigned int>();
+
+    // the hash elements of all the characters are allocated at once
+    unsigned int charCount = blockSizes[kCCBMFontBlockChars] / kCCBMFontCharSize;
+    if (charCount > 0)
+    {
+        m_pFontDefElements = (tCCFontDefHashElement*)calloc(charCount, sizeof(tCCFontDefHashElement));
+        const unsigned char *chars = blocks[kCCBMFontBlockChars];
+        for (unsigned int i = 0; i < charCount; ++i, chars += kCCBMFontCharSize)
+        {
+            tCCFontDefHashElement *element = &m_pFontDefElements[i];
+            ccBMFontDef& fontDef = element->fontDef;
+            fontDef.charID = readUInt32(chars);
+            fontDef.rect.origin.x = readUInt16(chars + 4);
+            fontDef.rect.origin.y = readUInt16(chars + 6);
+            fontDef.rect.size.width = readUInt16(chars + 8);
+            fontDef.rect.size.height = readUInt16(chars + 10);
+            fontDef.xOffset = readInt16(chars + 12);
+            fontDef.yOffset = readInt16(chars + 14);
+            fontDef.xAdvance = readInt16(chars + 16);
+
+            element->key = fontDef.charID;
+            HASH_ADD_INT(m_pFontDefDictionary, key, element);
+
+            // the characters are sorted by the editors, which makes the insertion constant time
+            validCharsString->insert(validCharsString->end(), fontDef.charID);
+        }
+    }
+
+    unsigned int kerningCount = blockSizes[kCCBMFontBlockKerningPairs] / kCCBMFontKerningPairSize;
+    if (kerningCount > 0)
+    {
+        m_pKerningElements = (tCCKerningHashElement*)calloc(kerningCount, sizeof(tCCKerningHashElement));
+        const unsigned char *pairs = blocks[kCCBMFontBlockKerningPairs];
+        for (unsigned int i = 0; i < kerningCount; ++i, pairs += kCCBMFontKerningPairSize)
+        {
+            tCCKerningHashElement *element = &m_pKerningElements[i];
+            int first = readUInt32(pairs);
+            int second = readUInt32(pairs + 4);
+            element->amount = readInt16(pairs + 8);
+            element->key = (first<<16) | (second&0xffff);
+            HASH_ADD_INT(m_pKerningDictionary, key, element);
+        }
+    }
+
+    return validCharsString;
+}
+
+bool CCBMFontConfiguration::writeCacheFile(const char *pszPath, unsigned long uSourceSize, unsigned int uSourceHash, const std::set<unsigned int>& charSet)
+{
+    std::string out;
+    out.append("CCFN", 4);
+    writeUInt32(out, kCCBMFontCacheVersion);
+    writeUInt32(out, (unsigned int)uSourceSize);
+    writeUInt32(out, uSourceHash);
+
+    out.append("BMF", 3);
+    out += (char)kCCBMFontBinaryVersion;
+
+    // only the padding of the info block is used
+    out += (char)kCCBMFontBlockInfo;
+    writeUInt32(out, kCCBMFontInfoBlockSize + 1);
+    out.append(7, '\0');
+    out += (char)m_tPadding.top;
+    out += (char)m_tPadding.right;
+    out += (char)m_tPadding.bottom;
+    out += (char)m_tPadding.left;
+    out.append(4, '\0');
+
+    // the size of the page was checked while parsing the text, it is left out
+    out += (char)kCCBMFontBlockCommon;
+    writeUInt32(out, kCCBMFontCommonBlockSize);
+    writeUInt16(out, m_nCommonHeight);
+    writeUInt16(out, 0);
+    writeUInt16(out, 0);
+    writeUInt16(out, 0);
+    writeUInt16(out, 1);
+    out.append(5, '\0');
+
+    out += (char)kCCBMFontBlockPages;
+    writeUInt32(out, m_sPageFileName.length() + 1);
+    out.append(m_sPageFileName.c_str(), m_sPageFileName.length() + 1);
+
+    // in the order of the character set, so that it is rebuilt in constant time per character
+    std::string chars;
+    std::set<unsigned int>::const_iterator it;
+    for (it = charSet.begin(); it != charSet.end(); ++it)
+    {
+        unsigned int key = *it;
+        tCCFontDefHashElement *element = NULL;
+        HASH_FIND_INT(m_pFontDefDictionary, &key, element);
+        if (! element)
+        {
+            continue;
+        }
+        const ccBMFontDef& fontDef = element->fontDef;
+        writeUInt32(chars, fontDef.charID);
+        writeUInt16(chars, (unsigned int)fontDef.rect.origin.x);
+        writeUInt16(chars, (unsigned int)fontDef.rect.origin.y);
+        writeUInt16(chars, (unsigned int)fontDef.rect.size.width);
+        writeUInt16(chars, (unsigned int)fontDef.rect.size.height);
+        writeUInt16(chars, (unsigned short)fontDef.xOffset);
+        writeUInt16(chars, (unsigned short)fontDef.yOffset);
+        writeUInt16(chars, (unsigned short)fontDef.xAdvance);
+        chars.append(2, '\0');
+    }
+
+    out += (char)kCCBMFontBlockChars;
+    writeUInt32(out, chars.length());
+    out += chars;
+
+    out += (char)kCCBMFontBlockKerningPairs;
+    writeUInt32(out, HASH_COUNT(m_pKerningDictionary) * kCCBMFontKerningPairSize);
+    tCCKerningHashElement *kerning, *tmpKerning;
+    HASH_ITER(hh, m_pKerningDictionary, kerning, tmpKerning)
+    {
+        writeUInt32(out, (unsigned int)kerning->key >> 16);
+        writeUInt32(out, kerning->key & 0xffff);
+        writeUInt16(out, (unsigned short)kerning->amount);
+    }
+
+    FILE *fp = fopen(pszPath, "wb");
+    if (! fp)
+    {
+        return false;
+    }
+    bool bRet = fwrite(out.data(), 1, out.length(), fp) == out.length();
+    fclose(fp);
+    return bRet;
+}
+
 void CCBMFontConfiguration::parseInfoArguments(std::string line)
 {
     //////////////////////////////////////////////////////////////////////////
@@ -545,6 +936,11 @@ CCLabelBMFont::CCLabelBMFont()
 , m_bCascadeColorEnabled(true)
 , m_bCascadeOpacityEnabled(true)
 , m_bIsOpacityModifyRGB(false)
+, m_uStringCapacity(0)
+, m_uInitialStringCapacity(0)
+, m_uLaidOutLines(0)
+, m_uLaidOutChildren(0)
+, m_bCharPositionsAdjusted(false)
 {
 
 }
@@ -560,86 +956,133 @@ CCLabelBMFont::~CCLabelBMFont()
 // LabelBMFont - Atlas generation
 int CCLabelBMFont::kerningAmountForFirst(unsigned short first, unsigned short second)
 {
-    int ret = 0;
-    unsigned int key = (first<<16) | (second & 0xffff);
-
-    if( m_pConfiguration->m_pKerningDictionary ) {
-        tCCKerningHashElement *element = NULL;
-        HASH_FIND_INT(m_pConfiguration->m_pKerningDictionary, &key, element);        
-        if(element)
-            ret = element->amount;
-    }
-    return ret;
+    return m_pConfiguration->getKerningAmount(first, second);
 }
 
 void CCLabelBMFont::createFontChars()
 {
-    int nextFontPositionX = 0;
-    int nextFontPositionY = 0;
-    unsigned short prev = -1;
-    int kerningAmount = 0;
-
     CCSize tmpSize = CCSizeZero;
 
-    int longestLine = 0;
-    unsigned int totalHeight = 0;
-
     unsigned int quantityOfLines = 1;
     unsigned int stringLen = m_sString ? cc_wcslen(m_sString) : 0;
+    unsigned int laidOutLen = m_laidOutString.size();
+
+    for (unsigned int i = 0; i + 1 < stringLen; ++i)
+    {
+        if (m_sString[i] == '\n')
+        {
+            quantityOfLines++;
+        }
+    }
+
+    // the characters in front of the first change keep their sprite, as long as the lines
+    // don't move, the first line being placed from the number of lines, and the sprites
+    // were not removed
+    unsigned int unchanged = 0;
+    unsigned int childrenCount = m_pChildren ? m_pChildren->count() : 0;
+    if (quantityOfLines == m_uLaidOutLines && childrenCount == m_uLaidOutChildren)
+    {
+        unsigned int maxUnchanged = MIN(stringLen, laidOutLen);
+        while (unchanged < maxUnchanged && m_sString[unchanged] == m_laidOutString[unchanged])
+        {
+            unchanged++;
+        }
+    }
+
+    // hide the characters which are not used anymore
+    for (unsigned int i = stringLen; i < laidOutLen; ++i)
+    {
+        CCNode *pNode = this->getChildByTag(i);
+        if (pNode)
+        {
+            pNode->setVisible(false);
+        }
+    }
+
+    m_laidOutString.assign(m_sString, m_sString + stringLen);
+    m_uLaidOutLines = quantityOfLines;
+
     if (stringLen == 0)
     {
+        m_charLayouts.clear();
+        m_uLaidOutChildren = childrenCount;
+        m_bCharPositionsAdjusted = false;
         this->setContentSize(CC_SIZE_PIXELS_TO_POINTS(tmpSize));
         return;
     }
 
-    set<unsigned int> *charSet = m_pConfiguration->getCharacterSet();
+    m_charLayouts.resize(stringLen + 1);
 
-    for (unsigned int i = 0; i < stringLen - 1; ++i)
+    if (m_bCharPositionsAdjusted)
     {
-        unsigned short c = m_sString[i];
-        if (c == '\n')
+        // undo the alignment of the unchanged characters, updateLabel aligns them again
+        for (unsigned int i = 0; i < unchanged; ++i)
         {
-            quantityOfLines++;
+            CCNode *pNode = this->getChildByTag(i);
+            if (pNode && pNode->isVisible())
+            {
+                pNode->setPosition(m_charLayouts[i].position);
+            }
         }
+        m_bCharPositionsAdjusted = false;
+    }
+
+    int nextFontPositionX = 0;
+    int nextFontPositionY = 0-(m_pConfiguration->m_nCommonHeight - m_pConfiguration->m_nCommonHeight * quantityOfLines);
+    unsigned short prev = -1;
+    int kerningAmount = 0;
+    int longestLine = 0;
+    unsigned int totalHeight = m_pConfiguration->m_nCommonHeight * quantityOfLines;
+    const ccBMFontDef *pLastFontDef = NULL;
+
+    if (unchanged > 0)
+    {
+        const ccBMFontCharLayout& layout = m_charLayouts[unchanged];
+        nextFontPositionX = layout.penX;
+        nextFontPositionY = layout.penY;
+        longestLine = layout.longestLine;
+        prev = layout.previous;
+        pLastFontDef = layout.lastFontDef;
     }
 
-    totalHeight = m_pConfiguration->m_nCommonHeight * quantityOfLines;
-    nextFontPositionY = 0-(m_pConfiguration->m_nCommonHeight - m_pConfiguration->m_nCommonHeight * quantityOfLines);
-    
     CCRect rect;
-    ccBMFontDef fontDef;
 
-    for (unsigned int i= 0; i < stringLen; i++)
+    for (unsigned int i = unchanged; i < stringLen; i++)
     {
+        ccBMFontCharLayout& layout = m_charLayouts[i];
+        layout.penX = nextFontPositionX;
+        layout.penY = nextFontPositionY;
+        layout.longestLine = longestLine;
+        layout.previous = prev;
+        layout.lastFontDef = pLastFontDef;
+
         unsigned short c = m_sString[i];
 
         if (c == '\n')
         {
             nextFontPositionX = 0;
             nextFontPositionY -= m_pConfiguration->m_nCommonHeight;
-            continue;
-        }
-        
-        if (charSet->find(c) == charSet->end())
-        {
-            CCLOGWARN("cocos2d::CCLabelBMFont: Attempted to use character not defined in this bitmap: %d", c);
-            continue;      
         }
 
-        kerningAmount = this->kerningAmountForFirst(prev, c);
-        
-        tCCFontDefHashElement *element = NULL;
-
-        // unichar is a short, and an int is needed on HASH_FIND_INT
-        unsigned int key = c;
-        HASH_FIND_INT(m_pConfiguration->m_pFontDefDictionary, &key, element);
-        if (! element)
+        const ccBMFontDef *pFontDef = c == '\n' ? NULL : m_pConfiguration->getFontDef(c);
+        if (! pFontDef)
         {
-            CCLOGWARN("cocos2d::CCLabelBMFont: characer not found %d", c);
+            if (c != '\n')
+            {
+                CCLOGWARN("cocos2d::CCLabelBMFont: Attempted to use character not defined in this bitmap: %d", c);
+            }
+
+            CCNode *pNode = this->getChildByTag(i);
+            if (pNode)
+            {
+                pNode->setVisible(false);
+            }
             continue;
         }
 
-        fontDef = element->fontDef;
+        kerningAmount = this->kerningAmountForFirst(prev, c);
+
+        const ccBMFontDef& fontDef = *pFontDef;
 
         rect = fontDef.rect;
         rect = CC_RECT_PIXELS_TO_POINTS(rect);
@@ -692,11 +1135,13 @@ void CCLabelBMFont::createFontChars()
         int yOffset = m_pConfiguration->m_nCommonHeight - fontDef.yOffset;
         CCPoint fontPos = ccp( (float)nextFontPositionX + fontDef.xOffset + fontDef.rect.size.width*0.5f + kerningAmount,
             (float)nextFontPositionY + yOffset - rect.size.height*0.5f * CC_CONTENT_SCALE_FACTOR() );
-        fontChar->setPosition(CC_POINT_PIXELS_TO_POINTS(fontPos));
+        layout.position = CC_POINT_PIXELS_TO_POINTS(fontPos);
+        fontChar->setPosition(layout.position);
 
         // update kerning
         nextFontPositionX += fontDef.xAdvance + kerningAmount;
         prev = c;
+        pLastFontDef = pFontDef;
 
         if (longestLine < nextFontPositionX)
         {
@@ -709,12 +1154,21 @@ void CCLabelBMFont::createFontChars()
         }
     }
 
+    m_uLaidOutChildren = m_pChildren ? m_pChildren->count() : 0;
+
+    ccBMFontCharLayout& end = m_charLayouts[stringLen];
+    end.penX = nextFontPositionX;
+    end.penY = nextFontPositionY;
+    end.longestLine = longestLine;
+    end.previous = prev;
+    end.lastFontDef = pLastFontDef;
+
     // If the last character processed has an xAdvance which is less that the width of the characters image, then we need
     // to adjust the width of the string to take this into account, or the character will overlap the end of the bounding
     // box
-    if (fontDef.xAdvance < fontDef.rect.size.width)
+    if (pLastFontDef && pLastFontDef->xAdvance < pLastFontDef->rect.size.width)
     {
-        tmpSize.width = longestLine + fontDef.rect.size.width - fontDef.xAdvance;
+        tmpSize.width = longestLine + pLastFontDef->rect.size.width - pLastFontDef->xAdvance;
     }
     else
     {
@@ -739,38 +1193,22 @@ void CCLabelBMFont::setString(const char *newString, bool needUpdateLabel)
     if (needUpdateLabel) {
         m_sInitialStringUTF8 = newString;
     }
-    unsigned short* utf16String = cc_utf8_to_utf16(newString);
-    setString(utf16String, needUpdateLabel);
-    CC_SAFE_DELETE_ARRAY(utf16String);
+    cc_utf8_to_utf16_vec(newString, m_utf16Buffer);
+    setString(&m_utf16Buffer[0], needUpdateLabel);
  }
 
 void CCLabelBMFont::setString(unsigned short *newString, bool needUpdateLabel)
 {
     if (!needUpdateLabel)
     {
-        unsigned short* tmp = m_sString;
-        m_sString = copyUTF16StringN(newString);
-        CC_SAFE_DELETE_ARRAY(tmp);
+        copyUTF16String(&m_sString, &m_uStringCapacity, newString);
     }
     else
     {
-        unsigned short* tmp = m_sInitialString;
-        m_sInitialString = copyUTF16StringN(newString);
-        CC_SAFE_DELETE_ARRAY(tmp);
+        copyUTF16String(&m_sInitialString, &m_uInitialStringCapacity, newString);
     }
     
-    if (m_pChildren && m_pChildren->count() != 0)
-    {
-        CCObject* child;
-        CCARRAY_FOREACH(m_pChildren, child)
-        {
-            CCNode* pNode = (CCNode*) child;
-            if (pNode)
-            {
-                pNode->setVisible(false);
-            }
-        }
-    }
+    // createFontChars hides the characters it doesn't use
     this->createFontChars();
     
     if (needUpdateLabel) {
@@ -1140,6 +1578,7 @@ void CCLabelBMFont::updateLabel()
 
                 if (shift != 0)
                 {
+                    m_bCharPositionsAdjusted = true;
                     for (unsigned j = 0; j < line_length; j++)
                     {
                         index = i + j + lineNumber;
@@ -1228,6 +1667,8 @@ void CCLabelBMFont::setFntFile(const char* fntFile)
         m_pConfiguration = newConf;
 
         this->setTexture(CCTextureCache::sharedTextureCache()->addImage(m_pConfiguration->getAtlasName()));
+        // every character changes
+        m_laidOutString.clear();
         this->createFontChars();
     }
 }
@@ -94,6 +94,9 @@ typedef struct _FontDefHashElement
 	UT_hash_handle	hh;
 } tCCFontDefHashElement;
 
+// characters looked up without hashing
+#define kCCBMFontLatinCharCount 256
+
 // Equal function for targetSet.
 typedef struct _KerningHashElement
 {
@@ -148,8 +151,23 @@ public:
     inline void setAtlasName(const char* atlasName) { m_sAtlasName = atlasName; }
     
     std::set<unsigned int>* getCharacterSet() const;
+
+    /** Returns the definition of a character, or NULL if the font doesn't define it.
+     Latin-1 characters are found in an array instead of the hash.
+     @since v2.2
+     */
+    const ccBMFontDef* getFontDef(unsigned int uChar) const;
+
+    /** Returns the kerning between two characters, in pixels
+     @since v2.2
+     */
+    int getKerningAmount(unsigned short first, unsigned short second) const;
 private:
+    void buildLookupTables();
     std::set<unsigned int>* parseConfigFile(const char *controlFile);
+    std::set<unsigned int>* parseTextConfigFile(const char *pData, unsigned long uSize, const char *controlFile);
+    std::set<unsigned int>* parseBinaryConfigFile(const unsigned char *pData, unsigned long uSize, const char *controlFile);
+    bool writeCacheFile(const char *pszPath, unsigned long uSourceSize, unsigned int uSourceHash, const std::set<unsigned int>& charSet);
     void parseCharacterDefinition(std::string line, ccBMFontDef *characterDefinition);
     void parseInfoArguments(std::string line);
     void parseCommonArguments(std::string line);
@@ -157,8 +175,36 @@ private:
     void parseKerningEntry(std::string line);
     void purgeKerningDictionary();
     void purgeFontDefDictionary();
+
+    // definitions of the Latin-1 characters, owned by m_pFontDefDictionary
+    ccBMFontDef *m_pLatinFontDefs[kCCBMFontLatinCharCount];
+    // Latin-1 characters which are the first one of a kerning pair
+    bool m_bLatinKerningFirsts[kCCBMFontLatinCharCount];
+    // file of the page as written in the .fnt, relative to it
+    std::string m_sPageFileName;
+    // hash elements allocated in one block by parseBinaryConfigFile, NULL when allocated one by one
+    tCCFontDefHashElement *m_pFontDefElements;
+    tCCKerningHashElement *m_pKerningElements;
 };
 
+/** @struct ccBMFontCharLayout
+Layout state of a CCLabelBMFont before one of its characters, in pixels
+@since v2.2
+*/
+typedef struct _BMFontCharLayout {
+    //! position of the pen
+    int penX;
+    int penY;
+    //! widest line so far
+    int longestLine;
+    //! previous character, for kerning
+    unsigned short previous;
+    //! last character drawn
+    const ccBMFontDef *lastFontDef;
+    //! position given to the sprite of the character
+    CCPoint position;
+} ccBMFontCharLayout;
+
 /** @brief CCLabelBMFont is a subclass of CCSpriteBatchNode.
 
 Features:
@@ -175,6 +221,8 @@ Features:
 Limitations:
 - All inner characters are using an anchorPoint of (0.5f, 0.5f) and it is not recommend to change it
 because it might affect the rendering
+- When the string changes, the characters in front of the first changed one keep their sprite as it is,
+only their position is restored when the alignment moved them
 
 CCLabelBMFont implements the protocol CCLabelProtocol, like CCLabel and CCLabelAtlas.
 CCLabelBMFont has the flexibility of CCLabel, the speed of CCLabelAtlas and all the features of CCSprite.
@@ -224,7 +272,9 @@ public:
     /** init a bitmap font atlas with an initial string and the FNT file */
     bool initWithString(const char *str, const char *fntFile, float width = kCCLabelAutomaticWidth, CCTextAlignment alignment = kCCTextAlignmentLeft, CCPoint imageOffset = CCPointZero);
 
-    /** updates the font chars based on the string to render */
+    /** updates the font chars based on the string to render.
+     Only the characters from the first one that changed since the last call are laid out again.
+     */
     void createFontChars();
     // super method
     virtual void setString(const char *newString);
@@ -304,6 +354,19 @@ protected:
     /** conforms to CCRGBAProtocol protocol */
     bool        m_bIsOpacityModifyRGB;
 
+    // storage size of m_sString and m_sInitialString, reused while large enough
+    unsigned int m_uStringCapacity;
+    unsigned int m_uInitialStringCapacity;
+    // UTF-16 conversion of the string being set
+    std::vector<unsigned short> m_utf16Buffer;
+
+    // string laid out by createFontChars, with the layout state before each character and after the last one
+    std::vector<unsigned short> m_laidOutString;
+    std::vector<ccBMFontCharLayout> m_charLayouts;
+    unsigned int m_uLaidOutLines;
+    unsigned int m_uLaidOutChildren;
+    // true when updateLabel moved characters after createFontChars placed them
+    bool m_bCharPositionsAdjusted;
 };
 
 /** Free function that parses a FNT file a place it on the cache
@@ -312,6 +375,17 @@ CC_DLL CCBMFontConfiguration * FNTConfigLoadFile( const char *file );
 /** Purges the FNT config cache
 */
 CC_DLL void FNTConfigRemoveCache( void );
+/** Enables the parsed form cache of the text FNT files, disabled by default.
+ When enabled, a text FNT file is parsed once, then saved in binary form in the writable path
+ and loaded from there until the FNT file changes. Binary FNT files are always loaded directly.
+ @since v2.2
+*/
+CC_DLL void FNTConfigSetDiskCacheEnabled( bool bEnabled );
+CC_DLL bool FNTConfigIsDiskCacheEnabled( void );
+/** Returns the path of the parsed form cache of a text FNT file, see FNTConfigSetDiskCacheEnabled()
+ @since v2.2
+*/
+CC_DLL std::string FNTConfigGetDiskCachePath( const char *file );
 
 // end of GUI group
 /// @}
@@ -27,6 +27,10 @@ THE SOFTWARE.
 #include "shaders/CCGLProgram.h"
 #include "shaders/CCShaderCache.h"
 #include "CCApplication.h"
+#include "CCGlyphAtlas.h"
+#include "textures/CCTextureAtlas.h"
+#include "support/ccUTF8.h"
+#include <vector>
 
 NS_CC_BEGIN
 
@@ -48,12 +52,17 @@ CCLabelTTF::CCLabelTTF()
 , m_shadowEnabled(false)
 , m_strokeEnabled(false)
 , m_textFillColor(ccWHITE)
+, m_bGlyphAtlasEnabled(false)
+, m_pGlyphAtlas(NULL)
+, m_pGlyphPages(NULL)
 {
 }
 
 CCLabelTTF::~CCLabelTTF()
 {
     CC_SAFE_DELETE(m_pFontName);
+    CC_SAFE_RELEASE(m_pGlyphAtlas);
+    CC_SAFE_RELEASE(m_pGlyphPages);
 }
 
 CCLabelTTF * CCLabelTTF::create()
@@ -289,9 +298,297 @@ void CCLabelTTF::setFontName(const char *fontName)
     }
 }
 
+void CCLabelTTF::setGlyphAtlasEnabled(bool bEnabled)
+{
+    if (m_bGlyphAtlasEnabled != bEnabled)
+    {
+        m_bGlyphAtlasEnabled = bEnabled;
+        this->updateTexture();
+    }
+}
+
+bool CCLabelTTF::isGlyphAtlasEnabled()
+{
+    return m_bGlyphAtlasEnabled;
+}
+
+void CCLabelTTF::draw()
+{
+    if (! m_pGlyphAtlas)
+    {
+        CCSprite::draw();
+        return;
+    }
+
+    // CCSprite::updateColor isn't virtual, the quads catch up with the color here
+    updateGlyphQuadColors();
+
+    CC_NODE_DRAW_SETUP();
+
+    ccGLBlendFunc(m_sBlendFunc.src, m_sBlendFunc.dst);
+
+    CCObject *pObject = NULL;
+    CCARRAY_FOREACH(m_pGlyphPages, pObject)
+    {
+        ((CCTextureAtlas*)pObject)->drawQuads();
+    }
+}
+
+// a glyph placed on a line, x is the pen position in pixels
+struct GlyphPlacement
+{
+    const ccGlyphAtlasGlyph *glyph;
+    int x;
+};
+typedef std::vector<GlyphPlacement> GlyphLine;
+
+bool CCLabelTTF::updateGlyphQuads()
+{
+    if (! m_bGlyphAtlasEnabled || ! CCGlyphAtlas::isSupported())
+    {
+        return false;
+    }
+
+    float fScale = CC_CONTENT_SCALE_FACTOR();
+    CCGlyphAtlas *pAtlas = CCGlyphAtlas::atlasForFont(m_pFontName->c_str(), m_fFontSize * fScale);
+    if (! pAtlas)
+    {
+        return false;
+    }
+
+    if (pAtlas != m_pGlyphAtlas)
+    {
+        pAtlas->retain();
+        CC_SAFE_RELEASE(m_pGlyphAtlas);
+        m_pGlyphAtlas = pAtlas;
+
+        if (! m_pGlyphPages)
+        {
+            m_pGlyphPages = new CCArray();
+            m_pGlyphPages->init();
+        }
+        m_pGlyphPages->removeAllObjects();
+        this->setShaderProgram(CCShaderCache::sharedShaderCache()->programForKey(kCCShader_PositionTextureA8Color));
+    }
+
+    // break the string into lines, in pixels
+    int nMaxWidth = (int)(m_tDimensions.width * fScale);
+    std::vector<GlyphLine> lines(1);
+
+    int nLength = 0;
+    unsigned short *pUTF16 = cc_utf8_to_utf16(m_string.c_str(), -1, &nLength);
+    int nPen = 0;
+    int nLastSpace = -1;
+    const ccGlyphAtlasGlyph *pPrevious = NULL;
+    for (int i = 0; pUTF16 && i < nLength; ++i)
+    {
+        unsigned short c = pUTF16[i];
+        if (c == '\n')
+        {
+            lines.push_back(GlyphLine());
+            nLastSpace = -1;
+            pPrevious = NULL;
+            continue;
+        }
+
+        const ccGlyphAtlasGlyph *pGlyph = pAtlas->glyphForChar(c);
+        if (! pGlyph)
+        {
+            continue;
+        }
+
+        GlyphLine *pLine = &lines.back();
+        // the first glyph of a line starts on the left edge, like CCImage does
+        nPen = pLine->empty() ? -pGlyph->bearingX : nPen + pAtlas->getKerning(pPrevious, pGlyph);
+
+        if (nMaxWidth > 0 && c != ' ' && ! pLine->empty() && nPen + pGlyph->bearingX + pGlyph->width > nMaxWidth)
+        {
+            // wrap the word being written, or the glyph if the word is longer than the line
+            GlyphLine next;
+            if (nLastSpace >= 0)
+            {
+                next.assign(pLine->begin() + nLastSpace + 1, pLine->end());
+                pLine->erase(pLine->begin() + nLastSpace, pLine->end());
+            }
+            lines.push_back(next);
+            pLine = &lines.back();
+
+            int nShift = pLine->empty() ? nPen + pGlyph->bearingX : pLine->front().x + pLine->front().glyph->bearingX;
+            for (GlyphLine::iterator it = pLine->begin(); it != pLine->end(); ++it)
+            {
+                it->x -= nShift;
+            }
+            nPen -= nShift;
+            nLastSpace = -1;
+        }
+
+        if (c == ' ')
+        {
+            nLastSpace = pLine->size();
+        }
+        GlyphPlacement placement = { pGlyph, nPen };
+        pLine->push_back(placement);
+        nPen += pGlyph->advance;
+        pPrevious = pGlyph;
+    }
+    CC_SAFE_DELETE_ARRAY(pUTF16);
+
+    std::vector<int> lineWidths(lines.size(), 0);
+    int nTextWidth = 0;
+    for (unsigned int i = 0; i < lines.size(); ++i)
+    {
+        for (GlyphLine::iterator it = lines[i].begin(); it != lines[i].end(); ++it)
+        {
+            lineWidths[i] = MAX(lineWidths[i], it->x + it->glyph->bearingX + it->glyph->width);
+        }
+        nTextWidth = MAX(nTextWidth, lineWidths[i]);
+    }
+
+    int nLineHeight = pAtlas->getLineHeight();
+    int nTextHeight = pAtlas->getBoundingHeight() + nLineHeight * (lines.size() - 1);
+    int nBoxWidth = nMaxWidth > 0 ? nMaxWidth : nTextWidth;
+    int nBoxHeight = m_tDimensions.height > 0 ? (int)(m_tDimensions.height * fScale) : nTextHeight;
+
+    int nBaseline = pAtlas->getAscender();
+    if (m_vAlignment == kCCVerticalTextAlignmentCenter)
+    {
+        nBaseline += (nBoxHeight - nTextHeight) / 2;
+    }
+    else if (m_vAlignment == kCCVerticalTextAlignmentBottom)
+    {
+        nBaseline += nBoxHeight - nTextHeight;
+    }
+
+    // write the quads, in points with y going up
+    for (unsigned int i = m_pGlyphPages->count(); i < pAtlas->getPageCount(); ++i)
+    {
+        m_pGlyphPages->addObject(CCTextureAtlas::createWithTexture(pAtlas->getPage(i), 16));
+    }
+    CCObject *pObject = NULL;
+    CCARRAY_FOREACH(m_pGlyphPages, pObject)
+    {
+        ((CCTextureAtlas*)pObject)->removeAllQuads();
+    }
+
+    m_tGlyphQuadColor = glyphQuadColor();
+    for (unsigned int i = 0; i < lines.size(); ++i)
+    {
+        int nLineX = 0;
+        if (m_hAlignment == kCCTextAlignmentCenter)
+        {
+            nLineX = (nBoxWidth - lineWidths[i]) / 2;
+        }
+        else if (m_hAlignment == kCCTextAlignmentRight)
+        {
+            nLineX = nBoxWidth - lineWidths[i];
+        }
+
+        for (GlyphLine::iterator it = lines[i].begin(); it != lines[i].end(); ++it)
+        {
+            const ccGlyphAtlasGlyph *pGlyph = it->glyph;
+            if (pGlyph->width == 0 || pGlyph->height == 0)
+            {
+                continue;
+            }
+
+            CCTextureAtlas *pPage = (CCTextureAtlas*)m_pGlyphPages->objectAtIndex(pGlyph->page);
+            float fPageWidth = (float)pPage->getTexture()->getPixelsWide();
+            float fPageHeight = (float)pPage->getTexture()->getPixelsHigh();
+
+            float fLeft = (nLineX + it->x + pGlyph->bearingX) / fScale;
+            float fRight = fLeft + pGlyph->width / fScale;
+            float fTop = (nBoxHeight - (nBaseline + nLineHeight * (int)i - pGlyph->bearingY)) / fScale;
+            float fBottom = fTop - pGlyph->height / fScale;
+
+            float u0 = pGlyph->x / fPageWidth;
+            float u1 = (pGlyph->x + pGlyph->width) / fPageWidth;
+            float v0 = pGlyph->y / fPageHeight;
+            float v1 = (pGlyph->y + pGlyph->height) / fPageHeight;
+
+            ccV3F_C4B_T2F_Quad quad;
+            quad.bl.vertices = vertex3(fLeft, fBottom, 0);
+            quad.br.vertices = vertex3(fRight, fBottom, 0);
+            quad.tl.vertices = vertex3(fLeft, fTop, 0);
+            quad.tr.vertices = vertex3(fRight, fTop, 0);
+            quad.bl.texCoords = tex2(u0, v1);
+            quad.br.texCoords = tex2(u1, v1);
+            quad.tl.texCoords = tex2(u0, v0);
+            quad.tr.texCoords = tex2(u1, v0);
+            quad.bl.colors = quad.br.colors = quad.tl.colors = quad.tr.colors = m_tGlyphQuadColor;
+
+            unsigned int uIndex = pPage->getTotalQuads();
+            if (uIndex == pPage->getCapacity())
+            {
+                pPage->resizeCapacity(uIndex * 2);
+            }
+            pPage->updateQuad(&quad, uIndex);
+        }
+    }
+
+    // blending follows the texture like any sprite
+    if (pAtlas->getPageCount() > 0)
+    {
+        this->setTexture(pAtlas->getPage(0));
+    }
+    this->setContentSize(CCSizeMake(nBoxWidth / fScale, nBoxHeight / fScale));
+
+    return true;
+}
+
+ccColor4B CCLabelTTF::glyphQuadColor()
+{
+    ccColor4B color = ccc4(_displayedColor.r, _displayedColor.g, _displayedColor.b, _displayedOpacity);
+    if (m_bOpacityModifyRGB)
+    {
+        color.r = color.r * _displayedOpacity / 255;
+        color.g = color.g * _displayedOpacity / 255;
+        color.b = color.b * _displayedOpacity / 255;
+    }
+    return color;
+}
+
+void CCLabelTTF::updateGlyphQuadColors()
+{
+    ccColor4B color = glyphQuadColor();
+    if (color.r == m_tGlyphQuadColor.r && color.g == m_tGlyphQuadColor.g
+        && color.b == m_tGlyphQuadColor.b && color.a == m_tGlyphQuadColor.a)
+    {
+        return;
+    }
+    m_tGlyphQuadColor = color;
+
+    CCObject *pObject = NULL;
+    CCARRAY_FOREACH(m_pGlyphPages, pObject)
+    {
+        CCTextureAtlas *pPage = (CCTextureAtlas*)pObject;
+        ccV3F_C4B_T2F_Quad *pQuads = pPage->getQuads();
+        for (unsigned int i = 0; i < pPage->getTotalQuads(); ++i)
+        {
+            pQuads[i].bl.colors = pQuads[i].br.colors = pQuads[i].tl.colors = pQuads[i].tr.colors = color;
+        }
+        pPage->setDirty(true);
+    }
+}
+
+void CCLabelTTF::releaseGlyphAtlas()
+{
+    if (m_pGlyphAtlas)
+    {
+        CC_SAFE_RELEASE_NULL(m_pGlyphAtlas);
+        m_pGlyphPages->removeAllObjects();
+        this->setShaderProgram(CCShaderCache::sharedShaderCache()->programForKey(SHADER_PROGRAM));
+    }
+}
+
 // Helper
 bool CCLabelTTF::updateTexture()
 {
+    if (updateGlyphQuads())
+    {
+        return true;
+    }
+    releaseGlyphAtlas();
+
     CCTexture2D *tex;
     tex = new CCTexture2D();
     
@@ -30,6 +30,8 @@ THE SOFTWARE.
 
 NS_CC_BEGIN
 
+class CCGlyphAtlas;
+
 /**
  * @addtogroup GUI
  * @{
@@ -142,7 +144,8 @@ public:
     static CCLabelTTF * create();
 
     /** changes the string to render
-    * @warning Changing the string is as expensive as creating a new CCLabelTTF. To obtain better performance use CCLabelAtlas
+    * @warning Changing the string is as expensive as creating a new CCLabelTTF. To obtain better performance use CCLabelAtlas,
+    * or enable the glyph atlas where it is supported
     */
     virtual void setString(const char *label);
     virtual const char* getString(void);
@@ -161,9 +164,29 @@ public:
     
     const char* getFontName();
     void setFontName(const char *fontName);
+
+    /** Draws the label with quads taken from a CCGlyphAtlas shared by the labels using the same
+     font and size, instead of a texture of its own: changing the string then only rewrites quads.
+     Where glyph atlases are not supported the label keeps using a texture, see CCGlyphAtlas::isSupported().
+     Shadow and stroke are not drawn from a glyph atlas.
+     @since v2.2
+     */
+    void setGlyphAtlasEnabled(bool bEnabled);
+    bool isGlyphAtlasEnabled();
+
+    /**
+     *  @js NA
+     *  @lua NA
+     */
+    virtual void draw(void);
     
 private:
     bool updateTexture();
+    // returns false if the label can't be drawn from a glyph atlas
+    bool updateGlyphQuads();
+    void updateGlyphQuadColors();
+    void releaseGlyphAtlas();
+    ccColor4B glyphQuadColor();
 protected:
     
     /** set the text definition for this label */
@@ -198,6 +221,15 @@ protected:
     /** font tint */
     ccColor3B   m_textFillColor;
 
+    /** glyph atlas mode */
+    bool            m_bGlyphAtlasEnabled;
+    /** atlas the quads are taken from, NULL when the label uses a texture */
+    CCGlyphAtlas    *m_pGlyphAtlas;
+    /** one CCTextureAtlas per page of the glyph atlas */
+    CCArray         *m_pGlyphPages;
+    /** color of the quads */
+    ccColor4B       m_tGlyphQuadColor;
+
     
 };
 
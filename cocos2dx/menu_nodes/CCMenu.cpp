@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include "CCDirector.h"
 #include "CCApplication.h"
 #include "support/CCPointExtension.h"
+#include "support/CCSpatialGrid.h"
 #include "touch_dispatcher/CCTouchDispatcher.h"
 #include "touch_dispatcher/CCTouch.h"
 #include "CCStdC.h"
@@ -113,6 +114,11 @@ CCMenu* CCMenu::createWithItem(CCMenuItem* item)
     return CCMenu::create(item, NULL);
 }
 
+CCMenu::~CCMenu()
+{
+    CC_SAFE_DELETE(m_pSpatialIndex);
+}
+
 bool CCMenu::init()
 {
     return initWithArray(NULL);
@@ -178,6 +184,11 @@ void CCMenu::addChild(CCNode * child, int zOrder, int tag)
 {
     CCAssert( dynamic_cast<CCMenuItem*>(child) != NULL, "Menu only supports MenuItem objects as children");
     CCLayer::addChild(child, zOrder, tag);
+
+    if (m_pSpatialIndex)
+    {
+        m_movedItems.insert(child);
+    }
 }
 
 void CCMenu::onExit()
@@ -206,9 +217,80 @@ void CCMenu::removeChild(CCNode* child, bool cleanup)
         m_pSelectedItem = NULL;
     }
     
+    if (m_pSpatialIndex)
+    {
+        m_pSpatialIndex->removeItem(child);
+        m_movedItems.erase(child);
+    }
+
     CCNode::removeChild(child, cleanup);
 }
 
+void CCMenu::removeAllChildrenWithCleanup(bool cleanup)
+{
+    m_pSelectedItem = NULL;
+
+    if (m_pSpatialIndex)
+    {
+        m_pSpatialIndex->removeAllItems();
+        m_movedItems.clear();
+    }
+
+    CCLayer::removeAllChildrenWithCleanup(cleanup);
+}
+
+//Menu - Spatial index
+
+void CCMenu::setSpatialIndexEnabled(bool bEnabled)
+{
+    if (bEnabled == (m_pSpatialIndex != NULL))
+    {
+        return;
+    }
+
+    m_bObservesChildTransforms = bEnabled;
+    m_movedItems.clear();
+    if (bEnabled)
+    {
+        m_pSpatialIndex = new CCSpatialGrid();
+
+        CCObject* pObject = NULL;
+        CCARRAY_FOREACH(m_pChildren, pObject)
+        {
+            m_movedItems.insert((CCNode*)pObject);
+        }
+    }
+    else
+    {
+        CC_SAFE_DELETE(m_pSpatialIndex);
+    }
+}
+
+bool CCMenu::isSpatialIndexEnabled()
+{
+    return m_pSpatialIndex != NULL;
+}
+
+void CCMenu::childTransformDidChange(CCNode *pChild)
+{
+    if (m_pSpatialIndex)
+    {
+        m_movedItems.insert(pChild);
+    }
+}
+
+void CCMenu::updateSpatialIndex()
+{
+    for (std::set<CCNode*>::iterator it = m_movedItems.begin(); it != m_movedItems.end(); ++it)
+    {
+        CCNode *pChild = *it;
+        CCSize size = pChild->getContentSize();
+        CCRect bounds = CCRectApplyAffineTransform(CCRectMake(0, 0, size.width, size.height), pChild->nodeToParentTransform());
+        m_pSpatialIndex->setItemBounds(pChild, bounds);
+    }
+    m_movedItems.clear();
+}
+
 //Menu - Events
 
 void CCMenu::setHandlerPriority(int newPriority)
@@ -604,6 +686,36 @@ CCMenuItem* CCMenu::itemForTouch(CCTouch *touch)
 {
     CCPoint touchLocation = touch->getLocation();
 
+    if (m_pSpatialIndex)
+    {
+        updateSpatialIndex();
+
+        std::vector<void*> candidates;
+        m_pSpatialIndex->itemsAtPoint(convertToNodeSpace(touchLocation), candidates);
+
+        // the first child in drawing order wins, as when walking m_pChildren
+        CCMenuItem *pFound = NULL;
+        for (unsigned int i = 0; i < candidates.size(); ++i)
+        {
+            CCMenuItem* pChild = dynamic_cast<CCMenuItem*>((CCNode*)candidates[i]);
+            if (pChild && pChild->isVisible() && pChild->isEnabled()
+                && (!pFound
+                    || pChild->getZOrder() < pFound->getZOrder()
+                    || (pChild->getZOrder() == pFound->getZOrder() && pChild->getOrderOfArrival() < pFound->getOrderOfArrival())))
+            {
+                CCPoint local = pChild->convertToNodeSpace(touchLocation);
+                CCRect r = pChild->rect();
+                r.origin = CCPointZero;
+
+                if (r.containsPoint(local))
+                {
+                    pFound = pChild;
+                }
+            }
+        }
+        return pFound;
+    }
+
     if (m_pChildren && m_pChildren->count() > 0)
     {
         CCObject* pObject = NULL;
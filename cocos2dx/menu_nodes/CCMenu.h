@@ -27,9 +27,12 @@ THE SOFTWARE.
 
 #include "CCMenuItem.h"
 #include "layers_scenes_transitions_nodes/CCLayer.h"
+#include <set>
 
 NS_CC_BEGIN
 
+class CCSpatialGrid;
+
 /**
  * @addtogroup GUI
  * @{
@@ -62,12 +65,12 @@ public:
     /**
      *  @js ctor
      */
-    CCMenu() : m_pSelectedItem(NULL) {}
+    CCMenu() : m_pSelectedItem(NULL), m_pSpatialIndex(NULL) {}
     /**
      *  @js NA
      *  @lua NA
      */
-    virtual ~CCMenu(){}
+    virtual ~CCMenu();
 
     /** creates an empty CCMenu */
     static CCMenu* create();
@@ -156,12 +159,21 @@ public:
     /** set event handler priority. By default it is: kCCMenuTouchPriority */
     void setHandlerPriority(int newPriority);
 
+    /** Indexes the items in a grid, so that a touch only tests the items under it
+     instead of all of them. Worth it for menus with hundreds of items.
+     The index follows the items as they move. Disabled by default.
+     @since v2.2
+     */
+    void setSpatialIndexEnabled(bool bEnabled);
+    bool isSpatialIndexEnabled();
+
     //super methods
     virtual void addChild(CCNode * child);
     virtual void addChild(CCNode * child, int zOrder);
     virtual void addChild(CCNode * child, int zOrder, int tag);
     virtual void registerWithTouchDispatcher();
     virtual void removeChild(CCNode* child, bool cleanup);
+    virtual void removeAllChildrenWithCleanup(bool cleanup);
 
     /**
     @brief For phone event handle functions
@@ -187,8 +199,14 @@ public:
 
 protected:
     CCMenuItem* itemForTouch(CCTouch * touch);
+    virtual void childTransformDidChange(CCNode *pChild);
+    void updateSpatialIndex();
     tCCMenuState m_eState;
     CCMenuItem *m_pSelectedItem;
+    // items in menu space, NULL when the index is disabled
+    CCSpatialGrid *m_pSpatialIndex;
+    // items that moved since the index was last updated
+    std::set<CCNode*> m_movedItems;
 };
 
 // end of GUI group
@@ -222,6 +222,7 @@ unsigned int CCParticleBatchNode::addChildHelper(CCParticleSystem* child, int z,
     unsigned int pos = searchNewPositionInChildrenForZ(z);
 
     m_pChildren->insertObject(child, pos);
+    invalidateChildIndices(pos);
 
     child->setTag(aTag);
     child->_setZOrder(z);
@@ -265,6 +266,7 @@ void CCParticleBatchNode::reorderChild(CCNode * child, int zOrder)
             m_pChildren->removeObjectAtIndex(oldIndex);
             m_pChildren->insertObject(pChild, newIndex);
             pChild->release();
+            invalidateChildIndices(MIN(oldIndex, newIndex));
 
             // save old altasIndex
             unsigned int oldAtlasIndex = pChild->getAtlasIndex();
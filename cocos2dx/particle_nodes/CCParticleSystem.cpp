@@ -54,10 +54,13 @@ THE SOFTWARE.
 #include "support/zip_support/ZipUtils.h"
 #include "CCDirector.h"
 #include "support/CCProfiling.h"
+#include "support/CCJobPool.h"
+#include "CCScheduler.h"
 // opengl
 #include "CCGL.h"
 
 #include <string>
+#include <climits>
 
 using namespace std;
 
@@ -90,6 +93,11 @@ CCParticleSystem::CCParticleSystem()
 , m_pBatchNode(NULL)
 , m_uAtlasIndex(0)
 , m_bTransformSystemDirty(false)
+, m_tEmitterPosition(CCPointZero)
+, m_uRandomSeed(0)
+, m_bPendingAutoRemove(false)
+, m_bPendingParallelUpdate(false)
+, m_fPendingDelta(0)
 , m_uAllocatedParticles(0)
 , m_bIsActive(true)
 , m_uParticleCount(0)
@@ -436,6 +444,8 @@ bool CCParticleSystem::initWithTotalParticles(unsigned int numberOfParticles)
     //updateParticleImp = (CC_UPDATE_PARTICLE_IMP) [self methodForSelector:updateParticleSel];
     //for batchNode
     m_bTransformSystemDirty = false;
+    // each system owns its random state, see setRandomSeed()
+    m_uRandomSeed = (unsigned int)rand();
     // update after action in run!
     this->scheduleUpdateWithPriority(1);
 
@@ -458,6 +468,9 @@ bool CCParticleSystem::addParticle()
         return false;
     }
 
+    // may be called outside of update(), so refresh the emitter position first
+    this->updateEmitterPosition();
+
     tCCParticle * particle = &m_pParticles[ m_uParticleCount ];
     this->initParticle(particle);
     ++m_uParticleCount;
@@ -469,27 +482,27 @@ void CCParticleSystem::initParticle(tCCParticle* particle)
 {
     // timeToLive
     // no negative life. prevent division by 0
-    particle->timeToLive = m_fLife + m_fLifeVar * CCRANDOM_MINUS1_1();
+    particle->timeToLive = m_fLife + m_fLifeVar * randomMinus1To1();
     particle->timeToLive = MAX(0, particle->timeToLive);
 
     // position
-    particle->pos.x = m_tSourcePosition.x + m_tPosVar.x * CCRANDOM_MINUS1_1();
+    particle->pos.x = m_tSourcePosition.x + m_tPosVar.x * randomMinus1To1();
 
-    particle->pos.y = m_tSourcePosition.y + m_tPosVar.y * CCRANDOM_MINUS1_1();
+    particle->pos.y = m_tSourcePosition.y + m_tPosVar.y * randomMinus1To1();
 
 
     // Color
     ccColor4F start;
-    start.r = clampf(m_tStartColor.r + m_tStartColorVar.r * CCRANDOM_MINUS1_1(), 0, 1);
-    start.g = clampf(m_tStartColor.g + m_tStartColorVar.g * CCRANDOM_MINUS1_1(), 0, 1);
-    start.b = clampf(m_tStartColor.b + m_tStartColorVar.b * CCRANDOM_MINUS1_1(), 0, 1);
-    start.a = clampf(m_tStartColor.a + m_tStartColorVar.a * CCRANDOM_MINUS1_1(), 0, 1);
+    start.r = clampf(m_tStartColor.r + m_tStartColorVar.r * randomMinus1To1(), 0, 1);
+    start.g = clampf(m_tStartColor.g + m_tStartColorVar.g * randomMinus1To1(), 0, 1);
+    start.b = clampf(m_tStartColor.b + m_tStartColorVar.b * randomMinus1To1(), 0, 1);
+    start.a = clampf(m_tStartColor.a + m_tStartColorVar.a * randomMinus1To1(), 0, 1);
 
     ccColor4F end;
-    end.r = clampf(m_tEndColor.r + m_tEndColorVar.r * CCRANDOM_MINUS1_1(), 0, 1);
-    end.g = clampf(m_tEndColor.g + m_tEndColorVar.g * CCRANDOM_MINUS1_1(), 0, 1);
-    end.b = clampf(m_tEndColor.b + m_tEndColorVar.b * CCRANDOM_MINUS1_1(), 0, 1);
-    end.a = clampf(m_tEndColor.a + m_tEndColorVar.a * CCRANDOM_MINUS1_1(), 0, 1);
+    end.r = clampf(m_tEndColor.r + m_tEndColorVar.r * randomMinus1To1(), 0, 1);
+    end.g = clampf(m_tEndColor.g + m_tEndColorVar.g * randomMinus1To1(), 0, 1);
+    end.b = clampf(m_tEndColor.b + m_tEndColorVar.b * randomMinus1To1(), 0, 1);
+    end.a = clampf(m_tEndColor.a + m_tEndColorVar.a * randomMinus1To1(), 0, 1);
 
     particle->color = start;
     particle->deltaColor.r = (end.r - start.r) / particle->timeToLive;
@@ -498,7 +511,7 @@ void CCParticleSystem::initParticle(tCCParticle* particle)
     particle->deltaColor.a = (end.a - start.a) / particle->timeToLive;
 
     // size
-    float startS = m_fStartSize + m_fStartSizeVar * CCRANDOM_MINUS1_1();
+    float startS = m_fStartSize + m_fStartSizeVar * randomMinus1To1();
     startS = MAX(0, startS); // No negative value
 
     particle->size = startS;
@@ -509,45 +522,41 @@ void CCParticleSystem::initParticle(tCCParticle* particle)
     }
     else
     {
-        float endS = m_fEndSize + m_fEndSizeVar * CCRANDOM_MINUS1_1();
+        float endS = m_fEndSize + m_fEndSizeVar * randomMinus1To1();
         endS = MAX(0, endS); // No negative values
         particle->deltaSize = (endS - startS) / particle->timeToLive;
     }
 
     // rotation
-    float startA = m_fStartSpin + m_fStartSpinVar * CCRANDOM_MINUS1_1();
-    float endA = m_fEndSpin + m_fEndSpinVar * CCRANDOM_MINUS1_1();
+    float startA = m_fStartSpin + m_fStartSpinVar * randomMinus1To1();
+    float endA = m_fEndSpin + m_fEndSpinVar * randomMinus1To1();
     particle->rotation = startA;
     particle->deltaRotation = (endA - startA) / particle->timeToLive;
 
     // position
-    if( m_ePositionType == kCCPositionTypeFree )
-    {
-        particle->startPos = this->convertToWorldSpace(CCPointZero);
-    }
-    else if ( m_ePositionType == kCCPositionTypeRelative )
+    if( m_ePositionType == kCCPositionTypeFree || m_ePositionType == kCCPositionTypeRelative )
     {
-        particle->startPos = m_obPosition;
+        particle->startPos = m_tEmitterPosition;
     }
 
     // direction
-    float a = CC_DEGREES_TO_RADIANS( m_fAngle + m_fAngleVar * CCRANDOM_MINUS1_1() );    
+    float a = CC_DEGREES_TO_RADIANS( m_fAngle + m_fAngleVar * randomMinus1To1() );    
 
     // Mode Gravity: A
     if (m_nEmitterMode == kCCParticleModeGravity) 
     {
         CCPoint v(cosf( a ), sinf( a ));
-        float s = modeA.speed + modeA.speedVar * CCRANDOM_MINUS1_1();
+        float s = modeA.speed + modeA.speedVar * randomMinus1To1();
 
         // direction
         particle->modeA.dir = ccpMult( v, s );
 
         // radial accel
-        particle->modeA.radialAccel = modeA.radialAccel + modeA.radialAccelVar * CCRANDOM_MINUS1_1();
+        particle->modeA.radialAccel = modeA.radialAccel + modeA.radialAccelVar * randomMinus1To1();
  
 
         // tangential accel
-        particle->modeA.tangentialAccel = modeA.tangentialAccel + modeA.tangentialAccelVar * CCRANDOM_MINUS1_1();
+        particle->modeA.tangentialAccel = modeA.tangentialAccel + modeA.tangentialAccelVar * randomMinus1To1();
 
         // rotation is dir
         if(modeA.rotationIsDir)
@@ -558,8 +567,8 @@ void CCParticleSystem::initParticle(tCCParticle* particle)
     else 
     {
         // Set the default diameter of the particle from the source position
-        float startRadius = modeB.startRadius + modeB.startRadiusVar * CCRANDOM_MINUS1_1();
-        float endRadius = modeB.endRadius + modeB.endRadiusVar * CCRANDOM_MINUS1_1();
+        float startRadius = modeB.startRadius + modeB.startRadiusVar * randomMinus1To1();
+        float endRadius = modeB.endRadius + modeB.endRadiusVar * randomMinus1To1();
 
         particle->modeB.radius = startRadius;
 
@@ -573,7 +582,7 @@ void CCParticleSystem::initParticle(tCCParticle* particle)
         }
 
         particle->modeB.angle = a;
-        particle->modeB.degreesPerSecond = CC_DEGREES_TO_RADIANS(modeB.rotatePerSecond + modeB.rotatePerSecondVar * CCRANDOM_MINUS1_1());
+        particle->modeB.degreesPerSecond = CC_DEGREES_TO_RADIANS(modeB.rotatePerSecond + modeB.rotatePerSecondVar * randomMinus1To1());
     }    
 }
 
@@ -599,11 +608,183 @@ bool CCParticleSystem::isFull()
     return (m_uParticleCount == m_uTotalParticles);
 }
 
+// ParticleSystem - Parallel update
+
+static bool s_bParallelUpdateEnabled = false;
+
+/** Collects the particle systems updated during a scheduler tick, simulates them
+ on the job pool once every other target has been updated, then writes their quads
+ on the main thread.
+ It stays scheduled while the parallel update is enabled: scheduling it from a system's
+ update would append it to the list the scheduler is walking, and it would then miss
+ the ticks where that system is the last target. Only after CCDirector::purgeDirector()
+ is it scheduled again from a system's update, whose simulation may then wait one tick.
+ */
+class CCParticleSystemUpdater : public CCObject
+{
+public:
+    static CCParticleSystemUpdater* sharedUpdater();
+    static void purgeSharedUpdater();
+
+    void addSystem(CCParticleSystem *pSystem, float dt);
+    virtual void update(float dt);
+
+private:
+    static void stepSystem(void *pContext, unsigned int uIndex);
+
+    std::vector<CCParticleSystem*> m_obSystems;
+};
+
+static CCParticleSystemUpdater *s_pSharedUpdater = NULL;
+
+CCParticleSystemUpdater* CCParticleSystemUpdater::sharedUpdater()
+{
+    if (! s_pSharedUpdater)
+    {
+        s_pSharedUpdater = new CCParticleSystemUpdater();
+        // run after every other target of each tick
+        CCDirector::sharedDirector()->getScheduler()->scheduleUpdateForTarget(s_pSharedUpdater, INT_MAX, false);
+    }
+    return s_pSharedUpdater;
+}
+
+void CCParticleSystemUpdater::purgeSharedUpdater()
+{
+    if (s_pSharedUpdater)
+    {
+        // simulate what is still pending, so that no system is left retained
+        s_pSharedUpdater->update(0);
+        CCDirector::sharedDirector()->getScheduler()->unscheduleUpdateForTarget(s_pSharedUpdater);
+        CC_SAFE_RELEASE_NULL(s_pSharedUpdater);
+    }
+}
+
+void CCParticleSystemUpdater::addSystem(CCParticleSystem *pSystem, float dt)
+{
+    if (pSystem->m_bPendingParallelUpdate)
+    {
+        pSystem->m_fPendingDelta += dt;
+        return;
+    }
+
+    pSystem->retain();
+    pSystem->m_bPendingParallelUpdate = true;
+    pSystem->m_fPendingDelta = dt;
+    // the parent transforms can't be read from the worker threads
+    pSystem->updateEmitterPosition();
+    m_obSystems.push_back(pSystem);
+}
+
+void CCParticleSystemUpdater::stepSystem(void *pContext, unsigned int uIndex)
+{
+    CCParticleSystem *pSystem = ((CCParticleSystemUpdater*)pContext)->m_obSystems[uIndex];
+    float dt = pSystem->m_fPendingDelta;
+    pSystem->m_fPendingDelta = 0;
+    pSystem->stepParticles(dt);
+}
+
+void CCParticleSystemUpdater::update(float dt)
+{
+    CC_UNUSED_PARAM(dt);
+
+    if (m_obSystems.empty())
+    {
+        return;
+    }
+
+    CC_PROFILER_START_CATEGORY(kCCProfilerCategoryParticles , "CCParticleSystem - parallel update");
+
+    CCJobPool::sharedJobPool()->dispatchApply((unsigned int)m_obSystems.size(), &CCParticleSystemUpdater::stepSystem, this);
+
+    // systems updated while writing the quads (removeChild, updateWithNoTime...) are simulated on the next tick
+    std::vector<CCParticleSystem*> systems;
+    systems.swap(m_obSystems);
+    for (unsigned int i = 0; i < systems.size(); ++i)
+    {
+        CCParticleSystem *pSystem = systems[i];
+        pSystem->m_bPendingParallelUpdate = false;
+        pSystem->updateParticleQuads();
+        pSystem->release();
+    }
+
+    CC_PROFILER_STOP_CATEGORY(kCCProfilerCategoryParticles , "CCParticleSystem - parallel update");
+}
+
+void CCParticleSystem::setParallelUpdateEnabled(bool bEnabled)
+{
+    if (s_bParallelUpdateEnabled && ! bEnabled)
+    {
+        CCParticleSystemUpdater::purgeSharedUpdater();
+    }
+    else if (! s_bParallelUpdateEnabled && bEnabled)
+    {
+        // schedule the updater before the systems get updated
+        CCParticleSystemUpdater::sharedUpdater();
+    }
+    s_bParallelUpdateEnabled = bEnabled;
+}
+
+bool CCParticleSystem::isParallelUpdateEnabled()
+{
+    return s_bParallelUpdateEnabled;
+}
+
+void CCParticleSystem::purgeParallelUpdater()
+{
+    CCParticleSystemUpdater::purgeSharedUpdater();
+}
+
 // ParticleSystem - MainLoop
 void CCParticleSystem::update(float dt)
 {
+    if (s_bParallelUpdateEnabled)
+    {
+        CCParticleSystemUpdater::sharedUpdater()->addSystem(this, dt);
+        return;
+    }
+
     CC_PROFILER_START_CATEGORY(kCCProfilerCategoryParticles , "CCParticleSystem - update");
 
+    this->updateEmitterPosition();
+    this->stepParticles(dt);
+    this->updateParticleQuads();
+
+    CC_PROFILER_STOP_CATEGORY(kCCProfilerCategoryParticles , "CCParticleSystem - update");
+}
+
+void CCParticleSystem::updateWithNoTime(void)
+{
+    this->update(0.0f);
+}
+
+void CCParticleSystem::updateEmitterPosition()
+{
+    if (m_ePositionType == kCCPositionTypeFree)
+    {
+        m_tEmitterPosition = this->convertToWorldSpace(CCPointZero);
+    }
+    else if (m_ePositionType == kCCPositionTypeRelative)
+    {
+        m_tEmitterPosition = m_obPosition;
+    }
+    else
+    {
+        m_tEmitterPosition = CCPointZero;
+    }
+}
+
+void CCParticleSystem::stepParticles(float dt)
+{
+    this->emitParticles(dt);
+
+    if (m_bVisible)
+    {
+        this->moveParticles(dt);
+    }
+}
+
+void CCParticleSystem::emitParticles(float dt)
+{
     if (m_bIsActive && m_fEmissionRate)
     {
         float rate = 1.0f / m_fEmissionRate;
@@ -615,7 +796,9 @@ void CCParticleSystem::update(float dt)
         
         while (m_uParticleCount < m_uTotalParticles && m_fEmitCounter > rate) 
         {
-            this->addParticle();
+            // same as addParticle(), without refreshing the emitter position
+            this->initParticle(&m_pParticles[m_uParticleCount]);
+            ++m_uParticleCount;
             m_fEmitCounter -= rate;
         }
 
@@ -625,153 +808,248 @@ void CCParticleSystem::update(float dt)
             this->stopSystem();
         }
     }
+}
 
-    m_uParticleIdx = 0;
-
-    CCPoint currentPosition = CCPointZero;
-    if (m_ePositionType == kCCPositionTypeFree)
-    {
-        currentPosition = this->convertToWorldSpace(CCPointZero);
-    }
-    else if (m_ePositionType == kCCPositionTypeRelative)
-    {
-        currentPosition = m_obPosition;
-    }
-
-    if (m_bVisible)
+void CCParticleSystem::moveParticles(float dt)
+{
+    unsigned int uParticleIdx = 0;
+    while (uParticleIdx < m_uParticleCount)
     {
-        while (m_uParticleIdx < m_uParticleCount)
-        {
-            tCCParticle *p = &m_pParticles[m_uParticleIdx];
+        tCCParticle *p = &m_pParticles[uParticleIdx];
 
-            // life
-            p->timeToLive -= dt;
+        // life
+        p->timeToLive -= dt;
 
-            if (p->timeToLive > 0) 
+        if (p->timeToLive > 0) 
+        {
+            // Mode A: gravity, direction, tangential accel & radial accel
+            if (m_nEmitterMode == kCCParticleModeGravity) 
             {
-                // Mode A: gravity, direction, tangential accel & radial accel
-                if (m_nEmitterMode == kCCParticleModeGravity) 
-                {
-                    CCPoint tmp, radial, tangential;
+                CCPoint tmp, radial, tangential;
 
-                    radial = CCPointZero;
-                    // radial acceleration
-                    if (p->pos.x || p->pos.y)
-                    {
-                        radial = ccpNormalize(p->pos);
-                    }
-                    tangential = radial;
-                    radial = ccpMult(radial, p->modeA.radialAccel);
-
-                    // tangential acceleration
-                    float newy = tangential.x;
-                    tangential.x = -tangential.y;
-                    tangential.y = newy;
-                    tangential = ccpMult(tangential, p->modeA.tangentialAccel);
-
-                    // (gravity + radial + tangential) * dt
-                    tmp = ccpAdd( ccpAdd( radial, tangential), modeA.gravity);
-                    tmp = ccpMult( tmp, dt);
-                    p->modeA.dir = ccpAdd( p->modeA.dir, tmp);
-                    tmp = ccpMult(p->modeA.dir, dt);
-                    p->pos = ccpAdd( p->pos, tmp );
+                radial = CCPointZero;
+                // radial acceleration
+                if (p->pos.x || p->pos.y)
+                {
+                    radial = ccpNormalize(p->pos);
                 }
+                tangential = radial;
+                radial = ccpMult(radial, p->modeA.radialAccel);
 
-                // Mode B: radius movement
-                else 
-                {                
-                    // Update the angle and radius of the particle.
-                    p->modeB.angle += p->modeB.degreesPerSecond * dt;
-                    p->modeB.radius += p->modeB.deltaRadius * dt;
+                // tangential acceleration
+                float newy = tangential.x;
+                tangential.x = -tangential.y;
+                tangential.y = newy;
+                tangential = ccpMult(tangential, p->modeA.tangentialAccel);
+
+                // (gravity + radial + tangential) * dt
+                tmp = ccpAdd( ccpAdd( radial, tangential), modeA.gravity);
+                tmp = ccpMult( tmp, dt);
+                p->modeA.dir = ccpAdd( p->modeA.dir, tmp);
+                tmp = ccpMult(p->modeA.dir, dt);
+                p->pos = ccpAdd( p->pos, tmp );
+            }
 
-                    p->pos.x = - cosf(p->modeB.angle) * p->modeB.radius;
-                    p->pos.y = - sinf(p->modeB.angle) * p->modeB.radius;
-                }
+            // Mode B: radius movement
+            else 
+            {                
+                // Update the angle and radius of the particle.
+                p->modeB.angle += p->modeB.degreesPerSecond * dt;
+                p->modeB.radius += p->modeB.deltaRadius * dt;
 
-                // color
-                p->color.r += (p->deltaColor.r * dt);
-                p->color.g += (p->deltaColor.g * dt);
-                p->color.b += (p->deltaColor.b * dt);
-                p->color.a += (p->deltaColor.a * dt);
+                p->pos.x = - cosf(p->modeB.angle) * p->modeB.radius;
+                p->pos.y = - sinf(p->modeB.angle) * p->modeB.radius;
+            }
 
-                // size
-                p->size += (p->deltaSize * dt);
-                p->size = MAX( 0, p->size );
+            // color
+            p->color.r += (p->deltaColor.r * dt);
+            p->color.g += (p->deltaColor.g * dt);
+            p->color.b += (p->deltaColor.b * dt);
+            p->color.a += (p->deltaColor.a * dt);
 
-                // angle
-                p->rotation += (p->deltaRotation * dt);
+            // size
+            p->size += (p->deltaSize * dt);
+            p->size = MAX( 0, p->size );
 
-                //
-                // update values in quad
-                //
+            // angle
+            p->rotation += (p->deltaRotation * dt);
 
-                CCPoint    newPos;
+            // update particle counter
+            ++uParticleIdx;
+        } 
+        else 
+        {
+            // life < 0
+            int currentIndex = p->atlasIndex;
+            if( uParticleIdx != m_uParticleCount-1 )
+            {
+                m_pParticles[uParticleIdx] = m_pParticles[m_uParticleCount-1];
+            }
+            if (m_pBatchNode)
+            {
+                //disable the switched particle, see updateParticleQuads()
+                m_obDeadAtlasIndexes.push_back(currentIndex);
 
-                if (m_ePositionType == kCCPositionTypeFree || m_ePositionType == kCCPositionTypeRelative) 
-                {
-                    CCPoint diff = ccpSub( currentPosition, p->startPos );
-                    newPos = ccpSub(p->pos, diff);
-                } 
-                else
-                {
-                    newPos = p->pos;
-                }
+                //switch indexes
+                m_pParticles[m_uParticleCount-1].atlasIndex = currentIndex;
+            }
 
-                // translate newPos to correct position, since matrix transform isn't performed in batchnode
-                // don't update the particle with the new position information, it will interfere with the radius and tangential calculations
-                if (m_pBatchNode)
-                {
-                    newPos.x+=m_obPosition.x;
-                    newPos.y+=m_obPosition.y;
-                }
 
-                updateQuadWithParticle(p, newPos);
-                //updateParticleImp(self, updateParticleSel, p, newPos);
+            --m_uParticleCount;
 
-                // update particle counter
-                ++m_uParticleIdx;
-            } 
-            else 
+            if( m_uParticleCount == 0 && m_bIsAutoRemoveOnFinish )
             {
-                // life < 0
-                int currentIndex = p->atlasIndex;
-                if( m_uParticleIdx != m_uParticleCount-1 )
-                {
-                    m_pParticles[m_uParticleIdx] = m_pParticles[m_uParticleCount-1];
-                }
-                if (m_pBatchNode)
-                {
-                    //disable the switched particle
-                    m_pBatchNode->disableParticle(m_uAtlasIndex+currentIndex);
+                m_bPendingAutoRemove = true;
+                break;
+            }
+        }
+    } //while
+    m_bTransformSystemDirty = false;
+}
 
-                    //switch indexes
-                    m_pParticles[m_uParticleCount-1].atlasIndex = currentIndex;
-                }
+void CCParticleSystem::updateParticleQuads()
+{
+    if (m_pBatchNode)
+    {
+        for (unsigned int i = 0; i < m_obDeadAtlasIndexes.size(); ++i)
+        {
+            m_pBatchNode->disableParticle(m_uAtlasIndex + m_obDeadAtlasIndexes[i]);
+        }
+    }
+    m_obDeadAtlasIndexes.clear();
 
+    if (m_bPendingAutoRemove)
+    {
+        m_bPendingAutoRemove = false;
+        this->unscheduleUpdate();
+        if (m_pParent)
+        {
+            m_pParent->removeChild(this, true);
+        }
+        return;
+    }
 
-                --m_uParticleCount;
+    m_uParticleIdx = 0;
 
-                if( m_uParticleCount == 0 && m_bIsAutoRemoveOnFinish )
-                {
-                    this->unscheduleUpdate();
-                    m_pParent->removeChild(this, true);
-                    return;
-                }
+    if (m_bVisible)
+    {
+        for (m_uParticleIdx = 0; m_uParticleIdx < m_uParticleCount; ++m_uParticleIdx)
+        {
+            tCCParticle *p = &m_pParticles[m_uParticleIdx];
+            CCPoint    newPos;
+
+            if (m_ePositionType == kCCPositionTypeFree || m_ePositionType == kCCPositionTypeRelative) 
+            {
+                CCPoint diff = ccpSub( m_tEmitterPosition, p->startPos );
+                newPos = ccpSub(p->pos, diff);
+            } 
+            else
+            {
+                newPos = p->pos;
             }
-        } //while
-        m_bTransformSystemDirty = false;
+
+            // translate newPos to correct position, since matrix transform isn't performed in batchnode
+            // don't update the particle with the new position information, it will interfere with the radius and tangential calculations
+            if (m_pBatchNode)
+            {
+                newPos.x+=m_obPosition.x;
+                newPos.y+=m_obPosition.y;
+            }
+
+            updateQuadWithParticle(p, newPos);
+            //updateParticleImp(self, updateParticleSel, p, newPos);
+        }
     }
     if (! m_pBatchNode)
     {
         postStep();
     }
+}
 
-    CC_PROFILER_STOP_CATEGORY(kCCProfilerCategoryParticles , "CCParticleSystem - update");
+// ParticleSystem - Prewarm
+
+void CCParticleSystem::prewarmParticles(float fSeconds, float fStep)
+{
+    CCAssert(fStep > 0, "CCParticleSystem: prewarm step must be positive");
+    if (! (fStep > 0) || ! (fSeconds > 0))
+    {
+        return;
+    }
+
+    // a step count, subtracting a step too small for fSeconds would never reach 0
+    float fSteps = ceilf(fSeconds / fStep);
+    unsigned int uSteps = fSteps < (float)UINT_MAX ? (unsigned int)fSteps : UINT_MAX;
+    for (unsigned int i = 0; i < uSteps && ! m_bPendingAutoRemove; ++i)
+    {
+        float dt = (i + 1 < uSteps) ? fStep : fSeconds - fStep * (uSteps - 1);
+        if (dt > 0)
+        {
+            this->emitParticles(dt);
+            this->moveParticles(dt);
+        }
+    }
 }
 
-void CCParticleSystem::updateWithNoTime(void)
+void CCParticleSystem::prewarm(float fSeconds, float fStep)
 {
-    this->update(0.0f);
+    this->updateEmitterPosition();
+    this->prewarmParticles(fSeconds, fStep);
+    this->updateParticleQuads();
+}
+
+typedef struct _PrewarmContext
+{
+    std::vector<CCParticleSystem*> systems;
+    float seconds;
+    float step;
+} PrewarmContext;
+
+void CCParticleSystem::prewarmJob(void *pContext, unsigned int uIndex)
+{
+    PrewarmContext *pPrewarm = (PrewarmContext*)pContext;
+    pPrewarm->systems[uIndex]->prewarmParticles(pPrewarm->seconds, pPrewarm->step);
+}
+
+void CCParticleSystem::prewarm(CCArray *pSystems, float fSeconds, float fStep)
+{
+    PrewarmContext context;
+    context.seconds = fSeconds;
+    context.step = fStep;
+
+    CCObject *pObj = NULL;
+    CCARRAY_FOREACH(pSystems, pObj)
+    {
+        CCParticleSystem *pSystem = dynamic_cast<CCParticleSystem*>(pObj);
+        if (pSystem)
+        {
+            pSystem->updateEmitterPosition();
+            context.systems.push_back(pSystem);
+        }
+    }
+
+    CCJobPool::sharedJobPool()->dispatchApply((unsigned int)context.systems.size(), &CCParticleSystem::prewarmJob, &context);
+
+    for (unsigned int i = 0; i < context.systems.size(); ++i)
+    {
+        context.systems[i]->updateParticleQuads();
+    }
+}
+
+void CCParticleSystem::setRandomSeed(unsigned int uSeed)
+{
+    m_uRandomSeed = uSeed;
+}
+
+unsigned int CCParticleSystem::getRandomSeed()
+{
+    return m_uRandomSeed;
+}
+
+float CCParticleSystem::randomMinus1To1()
+{
+    // LCG (Numerical Recipes constants), the high 24 bits are enough for a float
+    m_uRandomSeed = m_uRandomSeed * 1664525u + 1013904223u;
+    return (float)(m_uRandomSeed >> 8) * (2.0f / 16777215.0f) - 1.0f;
 }
 
 void CCParticleSystem::updateQuadWithParticle(tCCParticle* particle, const CCPoint& newPosition)
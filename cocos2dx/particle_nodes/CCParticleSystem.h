@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "base_nodes/CCNode.h"
 #include "cocoa/CCDictionary.h"
 #include "cocoa/CCString.h"
+#include <vector>
 
 NS_CC_BEGIN
 
@@ -39,6 +40,7 @@ NS_CC_BEGIN
  */
 
 class CCParticleBatchNode;
+class CCParticleSystemUpdater;
 
 //* @enum
 enum {
@@ -240,6 +242,19 @@ protected:
 
     //true if scaled or rotated
     bool m_bTransformSystemDirty;
+
+    //! emitter position the particles are relative to: world position in Free mode, parent position in Relative mode
+    CCPoint m_tEmitterPosition;
+    //! state of the random generator used to initialize particles
+    unsigned int m_uRandomSeed;
+    //! atlas indexes of the batched particles that died since the last quad update
+    std::vector<unsigned int> m_obDeadAtlasIndexes;
+    //! true when the last particle died and the system has to be removed from its parent
+    bool m_bPendingAutoRemove;
+    //! true while the system waits for the parallel updater, see setParallelUpdateEnabled()
+    bool m_bPendingParallelUpdate;
+    //! time accumulated while waiting for the parallel updater
+    float m_fPendingDelta;
     // Number of allocated particles
     unsigned int m_uAllocatedParticles;
 
@@ -429,8 +444,74 @@ public:
     virtual void update(float dt);
     virtual void updateWithNoTime(void);
 
+    /** Seeds the random generator used to initialize the particles of this system.
+     Each system owns its random state, so two systems with the same seed and
+     configuration emit the same particles whatever the update order is.
+     By default the seed is taken from rand() when the system is initialized.
+     @since v2.2
+     */
+    void setRandomSeed(unsigned int uSeed);
+    unsigned int getRandomSeed();
+
+    /** Fast-forwards the simulation by fSeconds, as if the system had been running for that long.
+     The particles are simulated with fixed steps of fStep seconds and no quad is
+     written until the last step, so it is cheap enough to be called while loading a scene.
+     Useful for effects that look wrong when they start empty (smoke, dust, rain...).
+     Nothing is simulated if fStep or fSeconds isn't positive.
+     @since v2.2
+     */
+    void prewarm(float fSeconds, float fStep = 1.0f / 30);
+
+    /** Fast-forwards every CCParticleSystem of pSystems, splitting the simulation
+     across the CCJobPool threads. The quads are written on the calling thread.
+     @since v2.2
+     */
+    static void prewarm(CCArray *pSystems, float fSeconds, float fStep = 1.0f / 30);
+
+    /** Enables or disables the parallel update of particle systems.
+     When enabled, the particle systems updated during a scheduler tick are simulated
+     in parallel on the CCJobPool at the end of the tick, and their quads are then
+     written to their CCTextureAtlas/CCParticleBatchNode on the main thread.
+     update() of subclasses is still called on the main thread but the simulation
+     itself is deferred. Disabled by default.
+     @since v2.2
+     */
+    static void setParallelUpdateEnabled(bool bEnabled);
+    static bool isParallelUpdateEnabled();
+
+    /** Simulates the systems waiting for the parallel update and drops its updater.
+     Called by CCDirector::purgeDirector(), which unschedules everything: if the
+     parallel update is still enabled, the updater is scheduled again by the next
+     particle system update.
+     @since v2.2
+     */
+    static void purgeParallelUpdater();
+
 protected:
     virtual void updateBlendFunc();
+
+    /** refreshes the cached emitter position. Must be called on the main thread. */
+    void updateEmitterPosition();
+    /** Emits and moves the particles. It doesn't touch any quad nor any other node,
+     so it may run on a worker thread.
+     */
+    void stepParticles(float dt);
+    /** emits the new particles, part of stepParticles() */
+    void emitParticles(float dt);
+    /** moves the living particles and collects the dead ones, part of stepParticles() */
+    void moveParticles(float dt);
+    /** runs stepParticles() with fixed steps, without writing any quad */
+    void prewarmParticles(float fSeconds, float fStep);
+    /** Writes the quads of the living particles and disables the quads of the dead ones.
+     Must be called on the main thread after stepParticles().
+     */
+    void updateParticleQuads();
+
+private:
+    float randomMinus1To1();
+    static void prewarmJob(void *pContext, unsigned int uIndex);
+
+    friend class CCParticleSystemUpdater;
 };
 
 // end of particle_nodes group
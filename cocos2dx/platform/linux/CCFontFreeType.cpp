@@ -0,0 +1,282 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCFontFreeType.h"
+#include "platform/CCFileUtils.h"
+#include "ccMacros.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
+#include <list>
+#include <map>
+#include <fontconfig/fontconfig.h>
+
+NS_CC_BEGIN
+
+// used when the requested font can't be opened
+static const char *s_pszFallbackFont = "/usr/share/fonts/truetype/freefont/FreeSerif.ttf";
+
+// number of faces sharedFont() keeps open
+#define kCCFontFreeTypeSharedFonts  8
+
+// most recently used first
+typedef std::list<std::pair<std::string, CCFontFreeType*> > SharedFontList;
+static SharedFontList s_sharedFonts;
+
+static FT_Library sharedLibrary()
+{
+	static FT_Library s_library = NULL;
+	static bool s_bInitialized = false;
+	if (! s_bInitialized)
+	{
+		s_bInitialized = true;
+		if (FT_Init_FreeType(&s_library))
+		{
+			CCLOG("CCFontFreeType: can't initialize FreeType");
+			s_library = NULL;
+		}
+	}
+	return s_library;
+}
+
+std::string CCFontFreeType::fontFilePath(const char *pszFontName)
+{
+	// as FcFontMatch is quite an expensive call, cache the results
+	static std::map<std::string, std::string> s_fontFiles;
+
+	std::map<std::string, std::string>::iterator it = s_fontFiles.find(pszFontName);
+	if (it != s_fontFiles.end())
+	{
+		return it->second;
+	}
+
+	// check if the parameter is a font file shipped with the application
+	std::string fontPath = pszFontName;
+	std::string lowerCasePath = fontPath;
+	std::transform(lowerCasePath.begin(), lowerCasePath.end(), lowerCasePath.begin(), ::tolower);
+	if (lowerCasePath.find(".ttf") != std::string::npos)
+	{
+		fontPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(fontPath.c_str());
+
+		FILE *f = fopen(fontPath.c_str(), "r");
+		if (f)
+		{
+			fclose(f);
+			s_fontFiles.insert(std::pair<std::string, std::string>(pszFontName, fontPath));
+			return fontPath;
+		}
+	}
+
+	// use fontconfig to match the parameter against the fonts installed on the system
+	FcPattern *pattern = FcPatternBuild(0, FC_FAMILY, FcTypeString, pszFontName, (char *) 0);
+	FcConfigSubstitute(0, pattern, FcMatchPattern);
+	FcDefaultSubstitute(pattern);
+
+	FcResult result;
+	FcPattern *font = FcFontMatch(0, pattern, &result);
+	if (font)
+	{
+		FcChar8 *s = NULL;
+		if (FcPatternGetString(font, FC_FILE, 0, &s) == FcResultMatch)
+		{
+			fontPath = (const char*)s;
+
+			FcPatternDestroy(font);
+			FcPatternDestroy(pattern);
+
+			s_fontFiles.insert(std::pair<std::string, std::string>(pszFontName, fontPath));
+			return fontPath;
+		}
+		FcPatternDestroy(font);
+	}
+	FcPatternDestroy(pattern);
+
+	return pszFontName;
+}
+
+CCFontFreeType* CCFontFreeType::sharedFont(const char *pszFontName, float fFontSize)
+{
+	// FreeType sizes are whole pixels
+	char szKey[16];
+	sprintf(szKey, "@%d", (int)fFontSize);
+	std::string key = std::string(pszFontName) + szKey;
+
+	for (SharedFontList::iterator it = s_sharedFonts.begin(); it != s_sharedFonts.end(); ++it)
+	{
+		if (it->first == key)
+		{
+			s_sharedFonts.splice(s_sharedFonts.begin(), s_sharedFonts, it);
+			return it->second;
+		}
+	}
+
+	CCFontFreeType *pFont = new CCFontFreeType();
+	if (! pFont->init(pszFontName, fFontSize))
+	{
+		delete pFont;
+		return NULL;
+	}
+
+	if (s_sharedFonts.size() >= kCCFontFreeTypeSharedFonts)
+	{
+		delete s_sharedFonts.back().second;
+		s_sharedFonts.pop_back();
+	}
+	s_sharedFonts.push_front(std::make_pair(key, pFont));
+	return pFont;
+}
+
+CCFontFreeType::CCFontFreeType()
+: m_face(NULL)
+, m_bHasKerning(false)
+{
+}
+
+CCFontFreeType::~CCFontFreeType()
+{
+	if (m_face)
+	{
+		FT_Done_Face(m_face);
+	}
+}
+
+bool CCFontFreeType::init(const char *pszFontName, float fFontSize)
+{
+	CCAssert(! m_face, "CCFontFreeType: already initialized");
+
+	FT_Library library = sharedLibrary();
+	if (! library)
+	{
+		return false;
+	}
+
+	std::string fontFile = fontFilePath(pszFontName);
+	if (FT_New_Face(library, fontFile.c_str(), 0, &m_face))
+	{
+		//no valid font found use default
+		if (FT_New_Face(library, s_pszFallbackFont, 0, &m_face))
+		{
+			m_face = NULL;
+			return false;
+		}
+	}
+
+	//select utf8 charmap
+	if (FT_Select_Charmap(m_face, FT_ENCODING_UNICODE) || FT_Set_Pixel_Sizes(m_face, fFontSize, fFontSize))
+	{
+		FT_Done_Face(m_face);
+		m_face = NULL;
+		return false;
+	}
+
+	m_bHasKerning = FT_HAS_KERNING(m_face);
+	return true;
+}
+
+unsigned int CCFontFreeType::getGlyphIndex(unsigned int uCharCode)
+{
+	return FT_Get_Char_Index(m_face, uCharCode);
+}
+
+void CCFontFreeType::fillMetrics(FT_GlyphSlot slot, ccFreeTypeGlyphMetrics &metrics)
+{
+	metrics.width = slot->metrics.width >> 6;
+	metrics.height = slot->metrics.height >> 6;
+	metrics.bearingX = slot->metrics.horiBearingX >> 6;
+	metrics.bearingY = slot->metrics.horiBearingY >> 6;
+	metrics.advance = slot->metrics.horiAdvance >> 6;
+}
+
+bool CCFontFreeType::getGlyphMetrics(unsigned int uGlyphIndex, ccFreeTypeGlyphMetrics &metrics)
+{
+	std::map<unsigned int, ccFreeTypeGlyphMetrics>::iterator it = m_metrics.find(uGlyphIndex);
+	if (it != m_metrics.end())
+	{
+		metrics = it->second;
+		return true;
+	}
+
+	if (FT_Load_Glyph(m_face, uGlyphIndex, FT_LOAD_DEFAULT))
+	{
+		return false;
+	}
+
+	fillMetrics(m_face->glyph, metrics);
+	m_metrics[uGlyphIndex] = metrics;
+	return true;
+}
+
+int CCFontFreeType::getKerning(unsigned int uLeftGlyphIndex, unsigned int uRightGlyphIndex)
+{
+	if (! m_bHasKerning || uLeftGlyphIndex == 0)
+	{
+		return 0;
+	}
+
+	unsigned long long key = ((unsigned long long)uLeftGlyphIndex << 32) | uRightGlyphIndex;
+	std::map<unsigned long long, int>::iterator it = m_kerning.find(key);
+	if (it != m_kerning.end())
+	{
+		return it->second;
+	}
+
+	FT_Vector delta;
+	int kerning = 0;
+	if (! FT_Get_Kerning(m_face, uLeftGlyphIndex, uRightGlyphIndex, FT_KERNING_DEFAULT, &delta))
+	{
+		kerning = delta.x >> 6;
+	}
+	m_kerning[key] = kerning;
+	return kerning;
+}
+
+FT_Bitmap* CCFontFreeType::renderGlyph(unsigned int uGlyphIndex, ccFreeTypeGlyphMetrics &metrics)
+{
+	if (FT_Load_Glyph(m_face, uGlyphIndex, FT_LOAD_RENDER))
+	{
+		return NULL;
+	}
+
+	fillMetrics(m_face->glyph, metrics);
+	m_metrics[uGlyphIndex] = metrics;
+	return &m_face->glyph->bitmap;
+}
+
+int CCFontFreeType::getLineHeight()
+{
+	return m_face->size->metrics.height >> 6;
+}
+
+int CCFontFreeType::getAscender()
+{
+	return ceilf(FT_MulFix(m_face->bbox.yMax, m_face->size->metrics.y_scale) / 64.0f);
+}
+
+int CCFontFreeType::getBoundingHeight()
+{
+	return ceilf(FT_MulFix(m_face->bbox.yMax - m_face->bbox.yMin, m_face->size->metrics.y_scale) / 64.0f);
+}
+
+NS_CC_END
@@ -0,0 +1,108 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CC_FONT_FREETYPE_LINUX_H__
+#define __CC_FONT_FREETYPE_LINUX_H__
+
+#include "platform/CCPlatformMacros.h"
+#include <map>
+#include <string>
+
+#include "ft2build.h"
+#include FT_FREETYPE_H
+
+NS_CC_BEGIN
+
+/** Metrics of a glyph, in pixels */
+typedef struct _ccFreeTypeGlyphMetrics
+{
+	int width;
+	int height;
+	int bearingX;
+	int bearingY;
+	int advance;
+} ccFreeTypeGlyphMetrics;
+
+/**
+ @brief A FreeType face opened at a pixel size, used by the Linux text renderers:
+ CCImage::initWithString and the glyph atlas of CCLabelTTF.
+
+ The metrics and kerning of the glyphs are cached, so that laying out text only loads
+ a glyph the first time it is measured.
+ @since v2.2
+ @js NA
+ @lua NA
+ */
+class CC_DLL CCFontFreeType
+{
+public:
+	/** Returns the file of a font: a ttf file shipped with the application,
+	 or the system font fontconfig matches with the family name. Results are cached.
+	 */
+	static std::string fontFilePath(const char *pszFontName);
+
+	/** Returns the font opened at fFontSize pixels, shared by the callers using the same name and size.
+	 The fonts used last stay open, the others are closed: don't keep the returned font,
+	 it may be closed by the next call.
+	 */
+	static CCFontFreeType* sharedFont(const char *pszFontName, float fFontSize);
+
+	CCFontFreeType();
+	~CCFontFreeType();
+
+	/** Opens the font at fFontSize pixels, or FreeSerif when it can't be opened */
+	bool init(const char *pszFontName, float fFontSize);
+
+	inline FT_Face getFace() { return m_face; }
+
+	unsigned int getGlyphIndex(unsigned int uCharCode);
+	/** Metrics of a glyph, loaded the first time they are asked for */
+	bool getGlyphMetrics(unsigned int uGlyphIndex, ccFreeTypeGlyphMetrics &metrics);
+	/** Horizontal kerning between two glyphs, in pixels */
+	int getKerning(unsigned int uLeftGlyphIndex, unsigned int uRightGlyphIndex);
+	/** Renders a glyph in 8 bit gray levels. The bitmap belongs to the face and is
+	 overwritten by the next glyph loaded.
+	 */
+	FT_Bitmap* renderGlyph(unsigned int uGlyphIndex, ccFreeTypeGlyphMetrics &metrics);
+
+	/** Distance between two baselines */
+	int getLineHeight();
+	/** Distance from the top of the bounding box of the face to the baseline */
+	int getAscender();
+	/** Height of the bounding box of the face */
+	int getBoundingHeight();
+
+private:
+	static void fillMetrics(FT_GlyphSlot slot, ccFreeTypeGlyphMetrics &metrics);
+
+	FT_Face m_face;
+	bool m_bHasKerning;
+	std::map<unsigned int, ccFreeTypeGlyphMetrics> m_metrics;
+	//! kerning by pair of glyph indices, left one in the high bits
+	std::map<unsigned long long, int> m_kerning;
+};
+
+NS_CC_END
+
+#endif // __CC_FONT_FREETYPE_LINUX_H__
@@ -12,6 +12,7 @@
 #include "platform/CCImageCommon_cpp.h"
 #include "platform/CCImage.h"
 #include "platform/linux/CCApplication.h"
+#include "platform/linux/CCFontFreeType.h"
 
 #include "ft2build.h"
 #include "CCStdC.h"
@@ -20,9 +21,6 @@
 
 using namespace std;
 
-// as FcFontMatch is quite an expensive call, cache the results of getFontFile
-static std::map<std::string, std::string> fontCache;
-
 struct LineBreakGlyph {
 	FT_UInt glyphIndex;
 	int paintPosition;
@@ -57,14 +55,12 @@ class BitmapDC
 {
 public:
 	BitmapDC() {
-		libError = FT_Init_FreeType( &library );
 		FcInit();
 		m_pData = NULL;
 		reset();
 	}
 
 	~BitmapDC() {
-		FT_Done_FreeType(library);
 		FcFini();
 		//data will be deleted by CCImage
 //		if (m_pData) {
@@ -122,7 +118,7 @@ public:
     	return false;
     }
 
-	bool divideString(FT_Face face, const char* sText, int iMaxWidth, int iMaxHeight) {
+	bool divideString(CCFontFreeType *pFont, const char* sText, int iMaxWidth, int iMaxHeight) {
 		const char* pText = sText;
 		textLines.clear();
 		iMaxLineWidth = 0;
@@ -131,12 +127,11 @@ public:
 		FT_UInt prevCharacter = 0;
 		FT_UInt glyphIndex = 0;
 		FT_UInt prevGlyphIndex = 0;
-		FT_Vector delta;
+		ccFreeTypeGlyphMetrics metrics;
 		LineBreakLine currentLine;
 
 		int currentPaintPosition = 0;
 		int lastBreakIndex = -1;
-		bool hasKerning = FT_HAS_KERNING( face );
         while ((unicode=utf8((char**)&pText))) {
             if (unicode == '\n') {
 				currentLine.calculateWidth();
@@ -154,13 +149,14 @@ public:
             	lastBreakIndex = currentLine.glyphs.size() - 1;
             }
 
-			glyphIndex = FT_Get_Char_Index(face, unicode);
-			if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_DEFAULT)) {
+			// metrics come from the cache of the font, glyphs are only loaded to be rendered
+			glyphIndex = pFont->getGlyphIndex(unicode);
+			if (! pFont->getGlyphMetrics(glyphIndex, metrics)) {
 				return false;
 			}
 
 			if (isspace(unicode)) {
-				currentPaintPosition += face->glyph->metrics.horiAdvance >> 6;
+				currentPaintPosition += metrics.advance;
 				prevGlyphIndex = glyphIndex;
 				prevCharacter = unicode;
 				lastBreakIndex = currentLine.glyphs.size();
@@ -169,15 +165,10 @@ public:
 
 			LineBreakGlyph glyph;
 			glyph.glyphIndex = glyphIndex;
-			glyph.glyphWidth = face->glyph->metrics.width >> 6;
-			glyph.bearingX = face->glyph->metrics.horiBearingX >> 6;
-			glyph.horizAdvance = face->glyph->metrics.horiAdvance >> 6;
-			glyph.kerning = 0;
-
-			if (prevGlyphIndex != 0 && hasKerning) {
-				FT_Get_Kerning(face, prevGlyphIndex, glyphIndex, FT_KERNING_DEFAULT, &delta);
-				glyph.kerning = delta.x >> 6;
-			}
+			glyph.glyphWidth = metrics.width;
+			glyph.bearingX = metrics.bearingX;
+			glyph.horizAdvance = metrics.advance;
+			glyph.kerning = pFont->getKerning(prevGlyphIndex, glyphIndex);
 
 			if (iMaxWidth > 0 && currentPaintPosition + glyph.bearingX + glyph.kerning + glyph.glyphWidth > iMaxWidth) {
 
@@ -240,7 +231,7 @@ public:
 	/**
 	 * compute the start pos of every line
 	 */
-	int computeLineStart(FT_Face face, CCImage::ETextAlign eAlignMask, int line) {
+	int computeLineStart(CCImage::ETextAlign eAlignMask, int line) {
 				int lineWidth = textLines.at(line).lineWidth;
 		if (eAlignMask == CCImage::kAlignCenter || eAlignMask == CCImage::kAlignTop || eAlignMask == CCImage::kAlignBottom) {
 			return (iMaxLineWidth - lineWidth) / 2;
@@ -252,8 +243,8 @@ public:
 		return 0;
 	}
 
-	int computeLineStartY( FT_Face face, CCImage::ETextAlign eAlignMask, int txtHeight, int borderHeight ){
-		int baseLinePos = ceilf(FT_MulFix( face->bbox.yMax, face->size->metrics.y_scale )/64.0f);
+	int computeLineStartY( CCFontFreeType *pFont, CCImage::ETextAlign eAlignMask, int txtHeight, int borderHeight ){
+		int baseLinePos = pFont->getAscender();
 		if (eAlignMask == CCImage::kAlignCenter || eAlignMask == CCImage::kAlignLeft || eAlignMask == CCImage::kAlignRight) {
 			//vertical center
 			return (borderHeight - txtHeight) / 2 + baseLinePos;
@@ -266,80 +257,14 @@ public:
 		return baseLinePos;
 	}
 
-    std::string getFontFile(const char* family_name) {
-    	std::string fontPath = family_name;
-
-    	std::map<std::string, std::string>::iterator it = fontCache.find(family_name);
-    	if ( it != fontCache.end() ) {
-    		return it->second;
-    	}
-
-    	// check if the parameter is a font file shipped with the application
-    	std::string lowerCasePath = fontPath;
-    	std::transform(lowerCasePath.begin(), lowerCasePath.end(), lowerCasePath.begin(), ::tolower);
-    	if ( lowerCasePath.find(".ttf") != std::string::npos ) {
-    		fontPath = cocos2d::CCFileUtils::sharedFileUtils()->fullPathForFilename(fontPath.c_str());
-
-    		FILE *f = fopen(fontPath.c_str(), "r");
-    		if ( f ) {
-    			fclose(f);
-    			fontCache.insert(std::pair<std::string, std::string>(family_name, fontPath));
-    			return fontPath;
-    		}
-    	}
-
-    	// use fontconfig to match the parameter against the fonts installed on the system
-    	FcPattern *pattern = FcPatternBuild (0, FC_FAMILY, FcTypeString, family_name, (char *) 0);
-    	FcConfigSubstitute(0, pattern, FcMatchPattern);
-    	FcDefaultSubstitute(pattern);
-
-    	FcResult result;
-    	FcPattern *font = FcFontMatch(0, pattern, &result);
-    	if ( font ) {
-    		FcChar8 *s = NULL;
-    		if ( FcPatternGetString(font, FC_FILE, 0, &s) == FcResultMatch ) {
-    			fontPath = (const char*)s;
-
-    			FcPatternDestroy(font);
-    			FcPatternDestroy(pattern);
-
-    			fontCache.insert(std::pair<std::string, std::string>(family_name, fontPath));
-    			return fontPath;
-    		}
-    		FcPatternDestroy(font);
-    	}
-    	FcPatternDestroy(pattern);
-
-    	return family_name;
-    }
-
 	bool getBitmap(const char *text, int nWidth, int nHeight, CCImage::ETextAlign eAlignMask, const char * pFontName, float fontSize) {
-		if (libError) {
+		// the recently used faces stay open, with the metrics of their glyphs
+		CCFontFreeType *pFont = CCFontFreeType::sharedFont(pFontName, fontSize);
+		if ( ! pFont ) {
 			return false;
 		}
 
-		FT_Face face;
-		std::string fontfile = getFontFile(pFontName);
-		if ( FT_New_Face(library, fontfile.c_str(), 0, &face) ) {
-			//no valid font found use default
-			if ( FT_New_Face(library, "/usr/share/fonts/truetype/freefont/FreeSerif.ttf", 0, &face) ) {
-				return false;
-			}
-		}
-
-		//select utf8 charmap
-		if ( FT_Select_Charmap(face, FT_ENCODING_UNICODE) ) {
-			FT_Done_Face(face);
-			return false;
-		}
-
-		if ( FT_Set_Pixel_Sizes(face, fontSize, fontSize) ) {
-			FT_Done_Face(face);
-			return false;
-		}
-
-		if ( divideString(face, text, nWidth, nHeight) == false ) {
-			FT_Done_Face(face);
+		if ( divideString(pFont, text, nWidth, nHeight) == false ) {
 			return false;
 		}
 
@@ -347,8 +272,8 @@ public:
 		iMaxLineWidth = MAX(iMaxLineWidth, nWidth);
 
 		//compute the final line height
-		iMaxLineHeight = ceilf(FT_MulFix( face->bbox.yMax - face->bbox.yMin, face->size->metrics.y_scale )/64.0f);
-		int lineHeight = face->size->metrics.height>>6;
+		iMaxLineHeight = pFont->getBoundingHeight();
+		int lineHeight = pFont->getLineHeight();
 		if ( textLines.size() > 0 ) {
 			iMaxLineHeight += (lineHeight * (textLines.size() -1));
 		}
@@ -358,22 +283,24 @@ public:
 		m_pData = new unsigned char[iMaxLineWidth * iMaxLineHeight * 4];
 		memset(m_pData,0, iMaxLineWidth * iMaxLineHeight*4);
 
-		int iCurYCursor = computeLineStartY(face, eAlignMask, txtHeight, iMaxLineHeight);
+		int iCurYCursor = computeLineStartY(pFont, eAlignMask, txtHeight, iMaxLineHeight);
 
 		int lineCount = textLines.size();
 		for (int line = 0; line < lineCount; line++) {
-			int iCurXCursor = computeLineStart(face, eAlignMask, line);
+			int iCurXCursor = computeLineStart(eAlignMask, line);
 
 			int glyphCount = textLines.at(line).glyphs.size();
 			for (int i = 0; i < glyphCount; i++) {
 				LineBreakGlyph glyph = textLines.at(line).glyphs.at(i);
 
-				if (FT_Load_Glyph(face, glyph.glyphIndex, FT_LOAD_RENDER)) {
+				ccFreeTypeGlyphMetrics metrics;
+				FT_Bitmap *pBitmap = pFont->renderGlyph(glyph.glyphIndex, metrics);
+				if (! pBitmap) {
 					continue;
 				}
 
-				FT_Bitmap& bitmap = face->glyph->bitmap;
-				int yoffset = iCurYCursor - (face->glyph->metrics.horiBearingY >> 6);
+				FT_Bitmap& bitmap = *pBitmap;
+				int yoffset = iCurYCursor - metrics.bearingY;
 				int xoffset = iCurXCursor + glyph.paintPosition;
 
 				for (int y = 0; y < bitmap.rows; ++y) {
@@ -403,16 +330,11 @@ public:
 			iCurYCursor += lineHeight;
 		}
 
-		//  free face
-		FT_Done_Face(face);
 		return true;
 	}
 
 public:
-	FT_Library library;
-
 	unsigned char *m_pData;
-	int libError;
 	std::vector<LineBreakLine> textLines;
 	int iMaxLineWidth;
 	int iMaxLineHeight;
@@ -721,6 +721,7 @@ void CCSprite::sortAllChildren()
             arrayMakeObjectsPerformSelector(m_pChildren, sortAllChildren, CCSprite*);
         }
 
+        invalidateChildIndices(0);
         m_bReorderChildDirty = false;
     }
 }
@@ -285,6 +285,7 @@ void CCSpriteBatchNode::sortAllChildren()
             }
         }
 
+        invalidateChildIndices(0);
         m_bReorderChildDirty=false;
     }
 }
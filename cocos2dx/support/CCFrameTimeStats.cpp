@@ -0,0 +1,165 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include "CCFrameTimeStats.h"
+#include "ccMacros.h"
+#include <algorithm>
+
+NS_CC_BEGIN
+
+CCFrameTimeStats::CCFrameTimeStats(unsigned int uWindowSize)
+: m_uWindowSize(uWindowSize)
+, m_fHitchThreshold(1.0f / 30)
+, m_uHitchCount(0)
+{
+    CCAssert(uWindowSize > 0, "CCFrameTimeStats: the window can't be empty");
+
+    for (unsigned int i = 0; i < kCCFramePhaseCount; ++i)
+    {
+        m_samples[i].values.reserve(uWindowSize);
+        m_samples[i].next = 0;
+    }
+}
+
+CCFrameTimeStats::~CCFrameTimeStats(void)
+{
+}
+
+void CCFrameTimeStats::addSample(ccFramePhase ePhase, float fSeconds)
+{
+    CCAssert(ePhase < kCCFramePhaseCount, "CCFrameTimeStats: invalid phase");
+
+    _Samples &samples = m_samples[ePhase];
+    if (samples.values.size() < m_uWindowSize)
+    {
+        samples.values.push_back(fSeconds);
+    }
+    else
+    {
+        samples.values[samples.next] = fSeconds;
+        samples.next = (samples.next + 1) % m_uWindowSize;
+    }
+
+    if (ePhase == kCCFramePhaseFrame && fSeconds > m_fHitchThreshold)
+    {
+        ++m_uHitchCount;
+    }
+}
+
+void CCFrameTimeStats::reset(void)
+{
+    for (unsigned int i = 0; i < kCCFramePhaseCount; ++i)
+    {
+        m_samples[i].values.clear();
+        m_samples[i].next = 0;
+    }
+    m_uHitchCount = 0;
+}
+
+void CCFrameTimeStats::setWindowSize(unsigned int uWindowSize)
+{
+    CCAssert(uWindowSize > 0, "CCFrameTimeStats: the window can't be empty");
+
+    m_uWindowSize = uWindowSize;
+    for (unsigned int i = 0; i < kCCFramePhaseCount; ++i)
+    {
+        m_samples[i].values.clear();
+        m_samples[i].values.reserve(uWindowSize);
+        m_samples[i].next = 0;
+    }
+}
+
+// sorted must be sorted and not empty
+static float percentileOfSorted(const std::vector<float> &sorted, float fPercent)
+{
+    // nearest rank
+    float fRank = fPercent / 100.0f * sorted.size();
+    unsigned int uRank = (unsigned int)fRank;
+    if (uRank < fRank)
+    {
+        ++uRank;
+    }
+    uRank = MAX(uRank, 1u);
+    uRank = MIN(uRank, (unsigned int)sorted.size());
+    return sorted[uRank - 1];
+}
+
+ccFrameTimeSummary CCFrameTimeStats::getSummary(ccFramePhase ePhase) const
+{
+    CCAssert(ePhase < kCCFramePhaseCount, "CCFrameTimeStats: invalid phase");
+
+    ccFrameTimeSummary summary = { 0, 0, 0, 0, 0, 0 };
+    std::vector<float> sorted(m_samples[ePhase].values);
+    if (sorted.empty())
+    {
+        return summary;
+    }
+
+    std::sort(sorted.begin(), sorted.end());
+    float fTotal = 0;
+    for (unsigned int i = 0; i < sorted.size(); ++i)
+    {
+        fTotal += sorted[i];
+    }
+
+    summary.samples = sorted.size();
+    summary.average = fTotal / sorted.size();
+    summary.p50 = percentileOfSorted(sorted, 50);
+    summary.p95 = percentileOfSorted(sorted, 95);
+    summary.p99 = percentileOfSorted(sorted, 99);
+    summary.max = sorted.back();
+    return summary;
+}
+
+float CCFrameTimeStats::getPercentile(ccFramePhase ePhase, float fPercent) const
+{
+    CCAssert(ePhase < kCCFramePhaseCount, "CCFrameTimeStats: invalid phase");
+
+    std::vector<float> sorted(m_samples[ePhase].values);
+    if (sorted.empty())
+    {
+        return 0;
+    }
+
+    std::sort(sorted.begin(), sorted.end());
+    return percentileOfSorted(sorted, fPercent);
+}
+
+void CCFrameTimeStats::getHistogram(ccFramePhase ePhase, float fBinSize, unsigned int uBinCount, std::vector<unsigned int> &histogram) const
+{
+    CCAssert(ePhase < kCCFramePhaseCount, "CCFrameTimeStats: invalid phase");
+    CCAssert(fBinSize > 0 && uBinCount > 0, "CCFrameTimeStats: invalid histogram");
+
+    histogram.assign(uBinCount, 0);
+    const std::vector<float> &values = m_samples[ePhase].values;
+    for (unsigned int i = 0; i < values.size(); ++i)
+    {
+        float fBin = values[i] / fBinSize;
+        unsigned int uBin = fBin < uBinCount ? (unsigned int)MAX(fBin, 0.0f) : uBinCount - 1;
+        ++histogram[uBin];
+    }
+}
+
+NS_CC_END
@@ -0,0 +1,132 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#ifndef __SUPPORT_CCFRAMETIMESTATS_H__
+#define __SUPPORT_CCFRAMETIMESTATS_H__
+
+#include "platform/CCPlatformMacros.h"
+#include <vector>
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup global
+ * @{
+ */
+
+/** The durations tracked by CCFrameTimeStats */
+typedef enum
+{
+    /** time between two frames, as seen by the scheduler */
+    kCCFramePhaseFrame,
+    /** CCScheduler::update */
+    kCCFramePhaseUpdate,
+    /** visit of the running scene */
+    kCCFramePhaseVisit,
+    /** CCEGLView::swapBuffers */
+    kCCFramePhaseSwap,
+    kCCFramePhaseCount
+} ccFramePhase;
+
+/** Distribution of the samples of a phase, in seconds */
+typedef struct _ccFrameTimeSummary
+{
+    unsigned int samples;
+    float average;
+    float p50;
+    float p95;
+    float p99;
+    float max;
+} ccFrameTimeSummary;
+
+/** @brief CCFrameTimeStats keeps the durations of the last frames and of their phases,
+ so that hitches hidden by an average frame rate can be measured.
+
+ The director feeds it every frame, see CCDirector::getFrameTimeStats(). The percentiles
+ are computed over a rolling window of the last frames, the hitch counter counts the
+ frames longer than the hitch threshold since the last reset().
+ @code
+ ccFrameTimeSummary frame = CCDirector::sharedDirector()->getFrameTimeStats()->getSummary(kCCFramePhaseFrame);
+ CCAssert(frame.p99 < 1.0f / 30, "too many slow frames");
+ @endcode
+ @since v2.2
+ @js NA
+ @lua NA
+ */
+class CC_DLL CCFrameTimeStats
+{
+public:
+    /** uWindowSize is the number of frames the percentiles are computed over */
+    explicit CCFrameTimeStats(unsigned int uWindowSize = 300);
+    ~CCFrameTimeStats(void);
+
+    /** Records the duration of a phase of the current frame */
+    void addSample(ccFramePhase ePhase, float fSeconds);
+
+    /** Forgets every sample and resets the hitch counter */
+    void reset(void);
+
+    /** Returns the distribution of the samples of ePhase in the window */
+    ccFrameTimeSummary getSummary(ccFramePhase ePhase) const;
+
+    /** Returns the duration fPercent percent of the samples of ePhase in the window are under, 0 without samples */
+    float getPercentile(ccFramePhase ePhase, float fPercent) const;
+
+    /** Counts the samples of ePhase in the window per bin of fBinSize seconds into histogram.
+     The last bin also counts the longer samples.
+     */
+    void getHistogram(ccFramePhase ePhase, float fBinSize, unsigned int uBinCount, std::vector<unsigned int> &histogram) const;
+
+    /** Frames longer than this are hitches, 1/30 second by default */
+    inline float getHitchThreshold(void) const { return m_fHitchThreshold; }
+    inline void setHitchThreshold(float fSeconds) { m_fHitchThreshold = fSeconds; }
+
+    /** Number of frames longer than the hitch threshold since the last reset() */
+    inline unsigned int getHitchCount(void) const { return m_uHitchCount; }
+
+    inline unsigned int getWindowSize(void) const { return m_uWindowSize; }
+    /** Changes the number of frames the percentiles are computed over, and forgets every sample */
+    void setWindowSize(unsigned int uWindowSize);
+
+private:
+    struct _Samples
+    {
+        std::vector<float> values;
+        // index of the oldest sample once the window is full
+        unsigned int next;
+    };
+
+    unsigned int m_uWindowSize;
+    _Samples m_samples[kCCFramePhaseCount];
+    float m_fHitchThreshold;
+    unsigned int m_uHitchCount;
+};
+
+// end of global group
+/// @}
+
+NS_CC_END
+
+#endif // __SUPPORT_CCFRAMETIMESTATS_H__
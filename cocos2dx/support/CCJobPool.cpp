@@ -0,0 +1,286 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCJobPool.h"
+#include "ccMacros.h"
+#include "CCTracer.h"
+#include <vector>
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WINRT) || (CC_TARGET_PLATFORM == CC_PLATFORM_WP8) || defined(EMSCRIPTEN)
+#define CC_JOB_POOL_SERIAL 1
+#else
+#define CC_JOB_POOL_SERIAL 0
+#include <pthread.h>
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32)
+#include <unistd.h>
+#endif
+#endif
+
+NS_CC_BEGIN
+
+struct _JobPoolImpl
+{
+#if !CC_JOB_POOL_SERIAL
+    pthread_mutex_t         mutex;
+    // signaled when a new batch of jobs is available or when the workers must quit
+    pthread_cond_t          workCondition;
+    // signaled when the last job of a batch is done
+    pthread_cond_t          doneCondition;
+    std::vector<pthread_t>  threads;
+#endif
+    CC_JOB_FUNC             func;
+    void                    *context;
+    unsigned int            count;
+    unsigned int            next;
+    unsigned int            done;
+    bool                    quit;
+    bool                    dispatching;
+};
+
+static CCJobPool *s_pSharedJobPool = NULL;
+
+static unsigned int defaultThreadCount()
+{
+    int processors = 1;
+#if CC_JOB_POOL_SERIAL
+    processors = 1;
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+    processors = pthread_num_processors_np();
+#elif defined(_SC_NPROCESSORS_ONLN)
+    processors = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return processors > 1 ? (unsigned int)(processors - 1) : 0;
+}
+
+CCJobPool* CCJobPool::sharedJobPool(void)
+{
+    if (! s_pSharedJobPool)
+    {
+        s_pSharedJobPool = new CCJobPool();
+    }
+    return s_pSharedJobPool;
+}
+
+void CCJobPool::purgeSharedJobPool(void)
+{
+    CC_SAFE_DELETE(s_pSharedJobPool);
+}
+
+CCJobPool::CCJobPool(void)
+: m_pImpl(new _JobPoolImpl())
+, m_uThreadCount(defaultThreadCount())
+{
+    m_pImpl->func = NULL;
+    m_pImpl->context = NULL;
+    m_pImpl->count = 0;
+    m_pImpl->next = 0;
+    m_pImpl->done = 0;
+    m_pImpl->quit = false;
+    m_pImpl->dispatching = false;
+#if !CC_JOB_POOL_SERIAL
+    pthread_mutex_init(&m_pImpl->mutex, NULL);
+    pthread_cond_init(&m_pImpl->workCondition, NULL);
+    pthread_cond_init(&m_pImpl->doneCondition, NULL);
+#endif
+}
+
+CCJobPool::~CCJobPool(void)
+{
+    stopThreads();
+#if !CC_JOB_POOL_SERIAL
+    pthread_cond_destroy(&m_pImpl->doneCondition);
+    pthread_cond_destroy(&m_pImpl->workCondition);
+    pthread_mutex_destroy(&m_pImpl->mutex);
+#endif
+    CC_SAFE_DELETE(m_pImpl);
+}
+
+unsigned int CCJobPool::getThreadCount(void)
+{
+    return m_uThreadCount;
+}
+
+void CCJobPool::setThreadCount(unsigned int uThreadCount)
+{
+    CCAssert(! m_pImpl->dispatching, "CCJobPool: can't change the thread count while dispatching");
+    if (m_uThreadCount != uThreadCount)
+    {
+        // workers are started lazily by the next dispatch
+        stopThreads();
+        m_uThreadCount = uThreadCount;
+    }
+}
+
+void CCJobPool::startThreads(void)
+{
+#if !CC_JOB_POOL_SERIAL
+    m_pImpl->quit = false;
+    while (m_pImpl->threads.size() < m_uThreadCount)
+    {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, &CCJobPool::workerMain, this) != 0)
+        {
+            CCLOG("cocos2d: CCJobPool: could not create a worker thread");
+            break;
+        }
+        m_pImpl->threads.push_back(thread);
+    }
+#endif
+}
+
+void CCJobPool::stopThreads(void)
+{
+#if !CC_JOB_POOL_SERIAL
+    if (m_pImpl->threads.empty())
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&m_pImpl->mutex);
+    m_pImpl->quit = true;
+    pthread_cond_broadcast(&m_pImpl->workCondition);
+    pthread_mutex_unlock(&m_pImpl->mutex);
+
+    for (unsigned int i = 0; i < m_pImpl->threads.size(); ++i)
+    {
+        pthread_join(m_pImpl->threads[i], NULL);
+    }
+    m_pImpl->threads.clear();
+    m_pImpl->quit = false;
+#endif
+}
+
+// Called with the mutex held. Returns false when there is no pending job left.
+bool CCJobPool::runNextJob(void)
+{
+    if (m_pImpl->next >= m_pImpl->count)
+    {
+        return false;
+    }
+
+    unsigned int index = m_pImpl->next++;
+#if !CC_JOB_POOL_SERIAL
+    pthread_mutex_unlock(&m_pImpl->mutex);
+#endif
+
+    {
+        CC_TRACE_SCOPE("CCJobPool job");
+        m_pImpl->func(m_pImpl->context, index);
+    }
+
+#if !CC_JOB_POOL_SERIAL
+    pthread_mutex_lock(&m_pImpl->mutex);
+    if (++m_pImpl->done == m_pImpl->count)
+    {
+        pthread_cond_signal(&m_pImpl->doneCondition);
+    }
+#else
+    ++m_pImpl->done;
+#endif
+    return true;
+}
+
+void* CCJobPool::workerMain(void *pPool)
+{
+#if !CC_JOB_POOL_SERIAL
+    CCJobPool *pJobPool = (CCJobPool*)pPool;
+    _JobPoolImpl *pImpl = pJobPool->m_pImpl;
+
+    CC_TRACE_THREAD_NAME("CCJobPool worker");
+
+    pthread_mutex_lock(&pImpl->mutex);
+    while (! pImpl->quit)
+    {
+        if (! pJobPool->runNextJob())
+        {
+            pthread_cond_wait(&pImpl->workCondition, &pImpl->mutex);
+        }
+    }
+    pthread_mutex_unlock(&pImpl->mutex);
+#else
+    CC_UNUSED_PARAM(pPool);
+#endif
+    return NULL;
+}
+
+void CCJobPool::dispatchApply(unsigned int uCount, CC_JOB_FUNC pFunc, void *pContext)
+{
+    CCAssert(pFunc != NULL, "CCJobPool: invalid job function");
+    CCAssert(! m_pImpl->dispatching, "CCJobPool: dispatchApply can't be nested");
+
+    if (uCount == 0)
+    {
+        return;
+    }
+
+    // not worth waking up the workers for a single job
+    if (uCount == 1 || m_uThreadCount == 0)
+    {
+        for (unsigned int i = 0; i < uCount; ++i)
+        {
+            pFunc(pContext, i);
+        }
+        return;
+    }
+
+    CC_TRACE_SCOPE("CCJobPool::dispatchApply");
+
+#if !CC_JOB_POOL_SERIAL
+    startThreads();
+
+    pthread_mutex_lock(&m_pImpl->mutex);
+#endif
+    m_pImpl->dispatching = true;
+    m_pImpl->func = pFunc;
+    m_pImpl->context = pContext;
+    m_pImpl->count = uCount;
+    m_pImpl->next = 0;
+    m_pImpl->done = 0;
+#if !CC_JOB_POOL_SERIAL
+    pthread_cond_broadcast(&m_pImpl->workCondition);
+#endif
+
+    // the calling thread works too
+    while (runNextJob())
+    {
+    }
+
+#if !CC_JOB_POOL_SERIAL
+    while (m_pImpl->done < m_pImpl->count)
+    {
+        pthread_cond_wait(&m_pImpl->doneCondition, &m_pImpl->mutex);
+    }
+#endif
+
+    m_pImpl->func = NULL;
+    m_pImpl->context = NULL;
+    m_pImpl->count = 0;
+    m_pImpl->next = 0;
+    m_pImpl->dispatching = false;
+#if !CC_JOB_POOL_SERIAL
+    pthread_mutex_unlock(&m_pImpl->mutex);
+#endif
+}
+
+NS_CC_END
@@ -0,0 +1,94 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __SUPPORT_CCJOBPOOL_H__
+#define __SUPPORT_CCJOBPOOL_H__
+
+#include "platform/CCPlatformMacros.h"
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup global
+ * @{
+ */
+
+/** Job function: called once per job index, possibly from a worker thread. */
+typedef void (*CC_JOB_FUNC)(void *pContext, unsigned int uIndex);
+
+/** @brief CCJobPool is a small pool of worker threads used by the engine to
+ split independent per-frame work (particle systems, armatures...) across cores.
+
+ Jobs must not touch OpenGL, the scheduler, the autorelease pool or any other
+ engine singleton. The calling thread takes part in the work and dispatchApply()
+ only returns once every job has finished, so results can be consumed right away
+ on the main thread.
+
+ On platforms without pthread condition variables (WinRT, WP8, emscripten) the
+ jobs are run serially on the calling thread.
+ @since v2.2
+ @js NA
+ @lua NA
+ */
+class CC_DLL CCJobPool
+{
+public:
+    /** returns the shared job pool */
+    static CCJobPool* sharedJobPool(void);
+
+    /** stops the worker threads and releases the shared job pool */
+    static void purgeSharedJobPool(void);
+
+    ~CCJobPool(void);
+
+    /** Runs pFunc(pContext, i) for every i in [0, uCount) and waits for them to finish.
+     It must not be called from inside a job.
+     */
+    void dispatchApply(unsigned int uCount, CC_JOB_FUNC pFunc, void *pContext);
+
+    /** Number of worker threads, not counting the calling thread.
+     Defaults to the number of online processors minus one.
+     Setting it to 0 runs every job on the calling thread.
+     */
+    unsigned int getThreadCount(void);
+    void setThreadCount(unsigned int uThreadCount);
+
+private:
+    CCJobPool(void);
+
+    void startThreads(void);
+    void stopThreads(void);
+    bool runNextJob(void);
+    static void* workerMain(void *pPool);
+
+    struct _JobPoolImpl *m_pImpl;
+    unsigned int m_uThreadCount;
+};
+
+// end of global group
+/// @}
+
+NS_CC_END
+
+#endif // __SUPPORT_CCJOBPOOL_H__
@@ -33,16 +33,43 @@ NS_CC_BEGIN
 
 static CCNotificationCenter *s_sharedNotifCenter = NULL;
 
+struct _ccNotificationBucket
+{
+    char            *name;
+    unsigned int    hash;
+    // shared with the postNotification() calls iterating over it, see mutableObservers()
+    CCArray         *observers;
+};
+
+// FNV-1a
+static unsigned int notificationNameHash(const char *name)
+{
+    unsigned int hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char*)name; *p; ++p)
+    {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    return hash;
+}
+
 CCNotificationCenter::CCNotificationCenter()
-: m_scriptHandler(0)
+: m_bucketCount(0)
+, m_scriptHandler(0)
 {
-    m_observers = CCArray::createWithCapacity(3);
-    m_observers->retain();
 }
 
 CCNotificationCenter::~CCNotificationCenter()
 {
-    m_observers->release();
+    for (unsigned int i = 0; i < m_buckets.size(); ++i)
+    {
+        _ccNotificationBucket *bucket = m_buckets[i];
+        if (bucket)
+        {
+            bucket->observers->release();
+            CC_SAFE_DELETE_ARRAY(bucket->name);
+            delete bucket;
+        }
+    }
 }
 
 CCNotificationCenter *CCNotificationCenter::sharedNotificationCenter(void)
@@ -62,16 +89,84 @@ void CCNotificationCenter::purgeNotificationCenter(void)
 //
 // internal functions
 //
+_ccNotificationBucket* CCNotificationCenter::bucketForName(const char *name, bool bCreate)
+{
+    unsigned int hash = notificationNameHash(name);
+
+    if (!m_buckets.empty())
+    {
+        unsigned int mask = m_buckets.size() - 1;
+        for (unsigned int i = hash & mask; m_buckets[i]; i = (i + 1) & mask)
+        {
+            _ccNotificationBucket *bucket = m_buckets[i];
+            if (bucket->hash == hash && !strcmp(bucket->name, name))
+                return bucket;
+        }
+    }
+
+    if (!bCreate)
+        return NULL;
+
+    // keep the table at most 3/4 full
+    if ((m_bucketCount + 1) * 4 > m_buckets.size() * 3)
+    {
+        std::vector<_ccNotificationBucket*> oldBuckets;
+        oldBuckets.swap(m_buckets);
+        m_buckets.resize(oldBuckets.empty() ? 16 : oldBuckets.size() * 2, NULL);
+        for (unsigned int i = 0; i < oldBuckets.size(); ++i)
+        {
+            if (oldBuckets[i])
+                insertBucket(oldBuckets[i]);
+        }
+    }
+
+    _ccNotificationBucket *bucket = new _ccNotificationBucket();
+    bucket->name = new char[strlen(name) + 1];
+    strcpy(bucket->name, name);
+    bucket->hash = hash;
+    bucket->observers = new CCArray();
+    bucket->observers->init();
+    insertBucket(bucket);
+    ++m_bucketCount;
+    return bucket;
+}
+
+void CCNotificationCenter::insertBucket(_ccNotificationBucket *bucket)
+{
+    unsigned int mask = m_buckets.size() - 1;
+    unsigned int i = bucket->hash & mask;
+    while (m_buckets[i])
+    {
+        i = (i + 1) & mask;
+    }
+    m_buckets[i] = bucket;
+}
+
+CCArray* CCNotificationCenter::mutableObservers(_ccNotificationBucket *bucket)
+{
+    // Copy on write: a postNotification() holding the array keeps iterating over
+    // the observers as they were when it started.
+    if (!bucket->observers->isSingleReference())
+    {
+        CCArray *observers = new CCArray();
+        observers->initWithArray(bucket->observers);
+        bucket->observers->release();
+        bucket->observers = observers;
+    }
+    return bucket->observers;
+}
+
 bool CCNotificationCenter::observerExisted(CCObject *target,const char *name)
 {
+    _ccNotificationBucket *bucket = bucketForName(name, false);
+    if (!bucket)
+        return false;
+
     CCObject* obj = NULL;
-    CCARRAY_FOREACH(m_observers, obj)
+    CCARRAY_FOREACH(bucket->observers, obj)
     {
         CCNotificationObserver* observer = (CCNotificationObserver*) obj;
-        if (!observer)
-            continue;
-        
-        if (!strcmp(observer->getName(),name) && observer->getTarget() == target)
+        if (observer->getTarget() == target)
             return true;
     }
     return false;
@@ -93,21 +188,21 @@ void CCNotificationCenter::addObserver(CCObject *target,
         return;
     
     observer->autorelease();
-    m_observers->addObject(observer);
+    mutableObservers(bucketForName(name, true))->addObject(observer);
 }
 
 void CCNotificationCenter::removeObserver(CCObject *target,const char *name)
 {
-    CCObject* obj = NULL;
-    CCARRAY_FOREACH(m_observers, obj)
+    _ccNotificationBucket *bucket = bucketForName(name, false);
+    if (!bucket)
+        return;
+
+    for (unsigned int i = 0; i < bucket->observers->count(); ++i)
     {
-        CCNotificationObserver* observer = (CCNotificationObserver*) obj;
-        if (!observer)
-            continue;
-        
-        if (!strcmp(observer->getName(),name) && observer->getTarget() == target)
+        CCNotificationObserver* observer = (CCNotificationObserver*) bucket->observers->objectAtIndex(i);
+        if (observer->getTarget() == target)
         {
-            m_observers->removeObject(observer);
+            mutableObservers(bucket)->removeObjectAtIndex(i);
             return;
         }
     }
@@ -115,23 +210,26 @@ void CCNotificationCenter::removeObserver(CCObject *target,const char *name)
 
 int CCNotificationCenter::removeAllObservers(CCObject *target)
 {
-    CCObject *obj = NULL;
-    CCArray *toRemove = CCArray::create();
+    int removed = 0;
 
-    CCARRAY_FOREACH(m_observers, obj)
+    for (unsigned int i = 0; i < m_buckets.size(); ++i)
     {
-        CCNotificationObserver *observer = (CCNotificationObserver *)obj;
-        if (!observer)
+        _ccNotificationBucket *bucket = m_buckets[i];
+        if (!bucket)
             continue;
 
-        if (observer->getTarget() == target)
+        for (unsigned int j = bucket->observers->count(); j > 0; --j)
         {
-            toRemove->addObject(observer);
+            CCNotificationObserver *observer = (CCNotificationObserver *) bucket->observers->objectAtIndex(j - 1);
+            if (observer->getTarget() == target)
+            {
+                mutableObservers(bucket)->removeObjectAtIndex(j - 1);
+                ++removed;
+            }
         }
     }
 
-    m_observers->removeObjectsInArray(toRemove);
-    return toRemove->count();
+    return removed;
 }
 
 void CCNotificationCenter::registerScriptObserver( CCObject *target, int handler,const char* name)
@@ -146,37 +244,42 @@ void CCNotificationCenter::registerScriptObserver( CCObject *target, int handler
     
     observer->setHandler(handler);
     observer->autorelease();
-    m_observers->addObject(observer);
+    mutableObservers(bucketForName(name, true))->addObject(observer);
 }
 
 void CCNotificationCenter::unregisterScriptObserver(CCObject *target,const char* name)
 {        
-    CCObject* obj = NULL;
-    CCARRAY_FOREACH(m_observers, obj)
+    _ccNotificationBucket *bucket = bucketForName(name, false);
+    if (!bucket)
+        return;
+
+    for (unsigned int i = bucket->observers->count(); i > 0; --i)
     {
-        CCNotificationObserver* observer = (CCNotificationObserver*) obj;
-        if (!observer)
-            continue;
-            
-        if ( !strcmp(observer->getName(),name) && observer->getTarget() == target)
+        CCNotificationObserver* observer = (CCNotificationObserver*) bucket->observers->objectAtIndex(i - 1);
+        if (observer->getTarget() == target)
         {
-            m_observers->removeObject(observer);
+            mutableObservers(bucket)->removeObjectAtIndex(i - 1);
         }
     }
 }
 
 void CCNotificationCenter::postNotification(const char *name, CCObject *object)
 {
-    CCArray* ObserversCopy = CCArray::createWithCapacity(m_observers->count());
-    ObserversCopy->addObjectsFromArray(m_observers);
+    _ccNotificationBucket *bucket = bucketForName(name, false);
+    if (!bucket || bucket->observers->count() == 0)
+        return;
+
+    // Hold the observers: if a callback adds or removes an observer of this name,
+    // mutableObservers() gives the bucket a copy and this array stays untouched.
+    CCArray* observers = bucket->observers;
+    observers->retain();
+
     CCObject* obj = NULL;
-    CCARRAY_FOREACH(ObserversCopy, obj)
+    CCARRAY_FOREACH(observers, obj)
     {
         CCNotificationObserver* observer = (CCNotificationObserver*) obj;
-        if (!observer)
-            continue;
         
-        if (!strcmp(name,observer->getName()) && (observer->getObject() == object || observer->getObject() == NULL || object == NULL))
+        if (observer->getObject() == object || observer->getObject() == NULL || object == NULL)
         {
             if (0 != observer->getHandler())
             {
@@ -189,6 +292,8 @@ void CCNotificationCenter::postNotification(const char *name, CCObject *object)
             }
         }
     }
+
+    observers->release();
 }
 
 void CCNotificationCenter::postNotification(const char *name)
@@ -203,21 +308,13 @@ int CCNotificationCenter::getObserverHandlerByName(const char* name)
         return -1;
     }
     
-    CCObject* obj = NULL;
-    CCARRAY_FOREACH(m_observers, obj)
+    _ccNotificationBucket *bucket = bucketForName(name, false);
+    if (!bucket || bucket->observers->count() == 0)
     {
-        CCNotificationObserver* observer = (CCNotificationObserver*) obj;
-        if (NULL == observer)
-            continue;
-        
-        if ( 0 == strcmp(observer->getName(),name) )
-        {
-            return observer->getHandler();
-            break;
-        }
+        return -1;
     }
-    
-    return -1;
+
+    return ((CCNotificationObserver*) bucket->observers->objectAtIndex(0))->getHandler();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -27,6 +27,7 @@ THE SOFTWARE.
 
 #include "cocoa/CCObject.h"
 #include "cocoa/CCArray.h"
+#include <vector>
 
 NS_CC_BEGIN
 /**
@@ -106,10 +107,20 @@ private:
 
     // Check whether the observer exists by the specified target and name.
     bool observerExisted(CCObject *target,const char *name);
+
+    // Returns the bucket of the observers of name, creating it if bCreate is true.
+    struct _ccNotificationBucket* bucketForName(const char *name, bool bCreate);
+    void insertBucket(struct _ccNotificationBucket *bucket);
+
+    // Returns the observers of bucket ready to be modified.
+    CCArray* mutableObservers(struct _ccNotificationBucket *bucket);
     
     // variables
     //
-    CCArray *m_observers;
+    // Observers are bucketed by notification name, in registration order. The names are
+    // interned in an open addressing table that never shrinks.
+    std::vector<struct _ccNotificationBucket*> m_buckets;
+    unsigned int m_bucketCount;
     int     m_scriptHandler;
 };
 
@@ -0,0 +1,197 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCSpatialGrid.h"
+#include "ccMacros.h"
+#include <math.h>
+#include <algorithm>
+
+NS_CC_BEGIN
+
+// items covering more cells than this are tested on every query
+#define kCCSpatialGridMaxCellsPerItem   64
+// keeps cell coordinates of far away or infinite rectangles in range
+#define kCCSpatialGridMaxCoordinate     (1 << 30)
+
+static inline long long cellKey(int x, int y)
+{
+    return ((long long)x << 32) | (unsigned int)y;
+}
+
+static inline bool boundsContainPoint(const CCRect& bounds, const CCPoint& point)
+{
+    return point.x >= bounds.getMinX() && point.x <= bounds.getMaxX()
+        && point.y >= bounds.getMinY() && point.y <= bounds.getMaxY();
+}
+
+CCSpatialGrid::CCSpatialGrid(float fCellSize)
+: m_fCellSize(fCellSize)
+{
+    CCAssert(fCellSize > 0, "CCSpatialGrid: cell size must be positive");
+}
+
+CCSpatialGrid::~CCSpatialGrid(void)
+{
+}
+
+int CCSpatialGrid::cellCoordinate(float f) const
+{
+    float cell = floorf(f / m_fCellSize);
+    if (!(cell > -kCCSpatialGridMaxCoordinate))
+    {
+        // also catches NaN
+        return -kCCSpatialGridMaxCoordinate;
+    }
+    if (cell > kCCSpatialGridMaxCoordinate)
+    {
+        return kCCSpatialGridMaxCoordinate;
+    }
+    return (int)cell;
+}
+
+void CCSpatialGrid::link(void *pItem, _Entry& entry)
+{
+    entry.minX = cellCoordinate(entry.bounds.getMinX());
+    entry.minY = cellCoordinate(entry.bounds.getMinY());
+    entry.maxX = cellCoordinate(entry.bounds.getMaxX());
+    entry.maxY = cellCoordinate(entry.bounds.getMaxY());
+
+    long long cells = (long long)(entry.maxX - entry.minX + 1) * (entry.maxY - entry.minY + 1);
+    entry.oversized = cells > kCCSpatialGridMaxCellsPerItem;
+    if (entry.oversized)
+    {
+        m_oversized.push_back(pItem);
+        return;
+    }
+
+    for (int x = entry.minX; x <= entry.maxX; ++x)
+    {
+        for (int y = entry.minY; y <= entry.maxY; ++y)
+        {
+            m_cells[cellKey(x, y)].push_back(pItem);
+        }
+    }
+}
+
+void CCSpatialGrid::unlink(void *pItem, const _Entry& entry)
+{
+    if (entry.oversized)
+    {
+        m_oversized.erase(std::find(m_oversized.begin(), m_oversized.end(), pItem));
+        return;
+    }
+
+    for (int x = entry.minX; x <= entry.maxX; ++x)
+    {
+        for (int y = entry.minY; y <= entry.maxY; ++y)
+        {
+            CellMap::iterator cell = m_cells.find(cellKey(x, y));
+            std::vector<void*>& items = cell->second;
+            // order inside a cell doesn't matter: swap with the last one
+            *std::find(items.begin(), items.end(), pItem) = items.back();
+            items.pop_back();
+            if (items.empty())
+            {
+                m_cells.erase(cell);
+            }
+        }
+    }
+}
+
+void CCSpatialGrid::setItemBounds(void *pItem, const CCRect& bounds)
+{
+    EntryMap::iterator it = m_entries.find(pItem);
+    if (it != m_entries.end())
+    {
+        _Entry& entry = it->second;
+        entry.bounds = bounds;
+        if (!entry.oversized
+            && cellCoordinate(bounds.getMinX()) == entry.minX && cellCoordinate(bounds.getMinY()) == entry.minY
+            && cellCoordinate(bounds.getMaxX()) == entry.maxX && cellCoordinate(bounds.getMaxY()) == entry.maxY)
+        {
+            // still in the same cells
+            return;
+        }
+        unlink(pItem, entry);
+        link(pItem, entry);
+        return;
+    }
+
+    _Entry& entry = m_entries[pItem];
+    entry.bounds = bounds;
+    link(pItem, entry);
+}
+
+void CCSpatialGrid::removeItem(void *pItem)
+{
+    EntryMap::iterator it = m_entries.find(pItem);
+    if (it != m_entries.end())
+    {
+        unlink(pItem, it->second);
+        m_entries.erase(it);
+    }
+}
+
+void CCSpatialGrid::removeAllItems(void)
+{
+    m_entries.clear();
+    m_cells.clear();
+    m_oversized.clear();
+}
+
+bool CCSpatialGrid::containsItem(void *pItem) const
+{
+    return m_entries.find(pItem) != m_entries.end();
+}
+
+unsigned int CCSpatialGrid::count(void) const
+{
+    return m_entries.size();
+}
+
+void CCSpatialGrid::itemsAtPoint(const CCPoint& point, std::vector<void*>& items) const
+{
+    CellMap::const_iterator cell = m_cells.find(cellKey(cellCoordinate(point.x), cellCoordinate(point.y)));
+    if (cell != m_cells.end())
+    {
+        const std::vector<void*>& cellItems = cell->second;
+        for (unsigned int i = 0; i < cellItems.size(); ++i)
+        {
+            if (boundsContainPoint(m_entries.find(cellItems[i])->second.bounds, point))
+            {
+                items.push_back(cellItems[i]);
+            }
+        }
+    }
+
+    for (unsigned int i = 0; i < m_oversized.size(); ++i)
+    {
+        if (boundsContainPoint(m_entries.find(m_oversized[i])->second.bounds, point))
+        {
+            items.push_back(m_oversized[i]);
+        }
+    }
+}
+
+NS_CC_END
@@ -0,0 +1,99 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __SUPPORT_CCSPATIALGRID_H__
+#define __SUPPORT_CCSPATIALGRID_H__
+
+#include "platform/CCPlatformMacros.h"
+#include "cocoa/CCGeometry.h"
+#include <map>
+#include <vector>
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup global
+ * @{
+ */
+
+/** @brief CCSpatialGrid is a uniform grid of square cells indexing axis aligned
+ rectangles, used to find the few touch targets under a point without testing
+ all of them.
+
+ Items are opaque pointers owned by the caller. An item is stored in every cell
+ its rectangle overlaps; items spanning more than a few dozen cells are kept
+ aside and tested on every query instead. The grid is unbounded: cells are only
+ allocated when an item overlaps them.
+ @since v2.2
+ @js NA
+ @lua NA
+ */
+class CC_DLL CCSpatialGrid
+{
+public:
+    /** fCellSize is the side of a cell, in the units of the indexed rectangles */
+    explicit CCSpatialGrid(float fCellSize = 64.0f);
+    ~CCSpatialGrid(void);
+
+    /** Adds pItem with the given bounds, or moves it if it is already indexed. */
+    void setItemBounds(void *pItem, const CCRect& bounds);
+
+    /** Removes pItem. Does nothing if it is not indexed. */
+    void removeItem(void *pItem);
+
+    void removeAllItems(void);
+
+    bool containsItem(void *pItem) const;
+
+    unsigned int count(void) const;
+
+    /** Appends to items the items whose bounds contain point, in no particular order. */
+    void itemsAtPoint(const CCPoint& point, std::vector<void*>& items) const;
+
+private:
+    struct _Entry
+    {
+        CCRect bounds;
+        int minX, minY, maxX, maxY;
+        bool oversized;
+    };
+    typedef std::map<void*, _Entry> EntryMap;
+    typedef std::map<long long, std::vector<void*> > CellMap;
+
+    int cellCoordinate(float f) const;
+    void link(void *pItem, _Entry& entry);
+    void unlink(void *pItem, const _Entry& entry);
+
+    float m_fCellSize;
+    EntryMap m_entries;
+    CellMap m_cells;
+    std::vector<void*> m_oversized;
+};
+
+// end of global group
+/// @}
+
+NS_CC_END
+
+#endif // __SUPPORT_CCSPATIALGRID_H__
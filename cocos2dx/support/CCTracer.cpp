@@ -0,0 +1,505 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCTracer.h"
+#include "ccMacros.h"
+
+#if CC_ENABLE_TRACER
+#include "platform/CCFileUtils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <set>
+#include <vector>
+#include <pthread.h>
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_IOS) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC)
+#include <mach/mach_time.h>
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+#endif
+
+NS_CC_BEGIN
+
+volatile bool CCTracer::s_bRecording = false;
+
+#if CC_ENABLE_TRACER
+
+// scopes kept per thread, must be a power of 2
+static const unsigned int kEventsPerThread = 1 << 16;
+// deeper scopes are not recorded
+static const unsigned int kMaxDepth = 64;
+
+struct _ccTraceEvent
+{
+    const char          *name;
+    unsigned long long  begin;
+    unsigned long long  end;
+};
+
+struct _ccTraceOpenScope
+{
+    const char          *name;
+    unsigned long long  begin;
+};
+
+// Written by its thread only. The reader copies the slots below head and drops
+// the ones the writer may have overwritten meanwhile.
+struct _ccTraceBuffer
+{
+    _ccTraceEvent       *events;
+    volatile unsigned int head;
+    // first slot to export, moved by clear()
+    unsigned int        start;
+    unsigned int        depth;
+    _ccTraceOpenScope   stack[kMaxDepth];
+    const char          *threadName;
+    unsigned int        threadId;
+    bool                exited;
+    _ccTraceBuffer      *next;
+};
+
+// Never destroyed: threads may still be tracing while the application exits.
+static pthread_once_t s_initOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t s_bufferKey;
+// guards the buffer list, the interned names and the capture
+static pthread_mutex_t s_registryMutex;
+static _ccTraceBuffer *s_pBuffers = NULL;
+static unsigned int s_uNextThreadId = 1;
+static std::set<std::string> *s_pInternedNames = NULL;
+static unsigned int s_uCaptureFramesLeft = 0;
+static std::string *s_pCaptureFile = NULL;
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX) && defined(__GNUC__)
+static __thread _ccTraceBuffer *s_pCurrentBuffer = NULL;
+#define CC_TRACER_NATIVE_TLS 1
+#else
+#define CC_TRACER_NATIVE_TLS 0
+#endif
+
+static inline void memoryBarrier(void)
+{
+#if defined(_MSC_VER)
+    MemoryBarrier();
+#else
+    __sync_synchronize();
+#endif
+}
+
+static unsigned long long now(void)
+{
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_IOS) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC)
+    static mach_timebase_info_data_t s_timebase;
+    if (s_timebase.denom == 0)
+    {
+        mach_timebase_info(&s_timebase);
+    }
+    return mach_absolute_time() * s_timebase.numer / s_timebase.denom;
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+    static LARGE_INTEGER s_frequency;
+    if (s_frequency.QuadPart == 0)
+    {
+        QueryPerformanceFrequency(&s_frequency);
+    }
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (unsigned long long)(counter.QuadPart / s_frequency.QuadPart) * 1000000000ULL
+        + (unsigned long long)(counter.QuadPart % s_frequency.QuadPart) * 1000000000ULL / s_frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+static void retireBuffer(void *pBuffer)
+{
+#if CC_TRACER_NATIVE_TLS
+    s_pCurrentBuffer = NULL;
+#endif
+    // kept until the next clear(), its scopes are still exported
+    pthread_mutex_lock(&s_registryMutex);
+    ((_ccTraceBuffer*)pBuffer)->exited = true;
+    pthread_mutex_unlock(&s_registryMutex);
+}
+
+static void initTracer(void)
+{
+    pthread_key_create(&s_bufferKey, retireBuffer);
+    pthread_mutex_init(&s_registryMutex, NULL);
+    s_pInternedNames = new std::set<std::string>();
+    s_pCaptureFile = new std::string();
+}
+
+static _ccTraceBuffer* threadBuffer(void)
+{
+#if CC_TRACER_NATIVE_TLS
+    if (s_pCurrentBuffer)
+    {
+        return s_pCurrentBuffer;
+    }
+#endif
+
+    pthread_once(&s_initOnce, initTracer);
+
+    _ccTraceBuffer *buffer = (_ccTraceBuffer*)pthread_getspecific(s_bufferKey);
+    if (! buffer)
+    {
+        buffer = (_ccTraceBuffer*)calloc(1, sizeof(_ccTraceBuffer));
+        if (! buffer)
+        {
+            return NULL;
+        }
+
+        pthread_mutex_lock(&s_registryMutex);
+        buffer->threadId = s_uNextThreadId++;
+        buffer->next = s_pBuffers;
+        s_pBuffers = buffer;
+        pthread_mutex_unlock(&s_registryMutex);
+
+        pthread_setspecific(s_bufferKey, buffer);
+#if CC_TRACER_NATIVE_TLS
+        s_pCurrentBuffer = buffer;
+#endif
+    }
+    return buffer;
+}
+
+bool CCTracer::isEnabled(void)
+{
+    return true;
+}
+
+void CCTracer::setRecording(bool bRecording)
+{
+    pthread_once(&s_initOnce, initTracer);
+    s_bRecording = bRecording;
+}
+
+void CCTracer::clear(void)
+{
+    pthread_once(&s_initOnce, initTracer);
+    pthread_mutex_lock(&s_registryMutex);
+    _ccTraceBuffer **ppBuffer = &s_pBuffers;
+    while (*ppBuffer)
+    {
+        _ccTraceBuffer *buffer = *ppBuffer;
+        if (buffer->exited)
+        {
+            *ppBuffer = buffer->next;
+            free(buffer->events);
+            free(buffer);
+        }
+        else
+        {
+            buffer->start = buffer->head;
+            ppBuffer = &buffer->next;
+        }
+    }
+    pthread_mutex_unlock(&s_registryMutex);
+}
+
+void CCTracer::startCapture(unsigned int uFrames, const char *pszFileName)
+{
+    CCAssert(uFrames > 0 && pszFileName, "CCTracer: invalid capture");
+
+    clear();
+    pthread_mutex_lock(&s_registryMutex);
+    s_uCaptureFramesLeft = uFrames;
+    *s_pCaptureFile = pszFileName;
+    pthread_mutex_unlock(&s_registryMutex);
+    setRecording(true);
+}
+
+void CCTracer::endFrame(void)
+{
+    if (! s_bRecording || s_uCaptureFramesLeft == 0)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&s_registryMutex);
+    bool bDone = s_uCaptureFramesLeft > 0 && --s_uCaptureFramesLeft == 0;
+    std::string file = *s_pCaptureFile;
+    pthread_mutex_unlock(&s_registryMutex);
+
+    if (bDone)
+    {
+        setRecording(false);
+        writeTrace(file.c_str());
+    }
+}
+
+void CCTracer::setThreadName(const char *pszName)
+{
+    _ccTraceBuffer *buffer = threadBuffer();
+    if (buffer)
+    {
+        buffer->threadName = pszName;
+    }
+}
+
+const char* CCTracer::internName(const char *pszName)
+{
+    pthread_once(&s_initOnce, initTracer);
+    pthread_mutex_lock(&s_registryMutex);
+    // set nodes never move, the returned string stays valid
+    const char *pszInterned = s_pInternedNames->insert(pszName).first->c_str();
+    pthread_mutex_unlock(&s_registryMutex);
+    return pszInterned;
+}
+
+void CCTracer::beginScope(const char *pszName)
+{
+    _ccTraceBuffer *buffer = threadBuffer();
+    if (! buffer)
+    {
+        return;
+    }
+
+    if (buffer->depth < kMaxDepth)
+    {
+        _ccTraceOpenScope &scope = buffer->stack[buffer->depth];
+        scope.name = pszName;
+        scope.begin = now();
+    }
+    ++buffer->depth;
+}
+
+void CCTracer::endScope(void)
+{
+    unsigned long long end = now();
+    _ccTraceBuffer *buffer = threadBuffer();
+    if (! buffer || buffer->depth == 0)
+    {
+        return;
+    }
+
+    --buffer->depth;
+    if (buffer->depth >= kMaxDepth)
+    {
+        return;
+    }
+
+    if (! buffer->events)
+    {
+        // allocated on the first scope, most threads never trace
+        buffer->events = (_ccTraceEvent*)malloc(sizeof(_ccTraceEvent) * kEventsPerThread);
+        if (! buffer->events)
+        {
+            return;
+        }
+    }
+
+    unsigned int uHead = buffer->head;
+    _ccTraceEvent &event = buffer->events[uHead & (kEventsPerThread - 1)];
+    event.name = buffer->stack[buffer->depth].name;
+    event.begin = buffer->stack[buffer->depth].begin;
+    event.end = end;
+    // the slot must be complete before the reader can see it
+    memoryBarrier();
+    buffer->head = uHead + 1;
+}
+
+static void writeJSONString(FILE *fp, const char *psz)
+{
+    fputc('"', fp);
+    for (; *psz; ++psz)
+    {
+        unsigned char c = (unsigned char)*psz;
+        if (c == '"' || c == '\\')
+        {
+            fputc('\\', fp);
+            fputc(c, fp);
+        }
+        else if (c < 0x20)
+        {
+            fprintf(fp, "\\u%04x", c);
+        }
+        else
+        {
+            fputc(c, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+bool CCTracer::writeTrace(const char *pszFileName)
+{
+    CCAssert(pszFileName, "CCTracer: invalid file name");
+
+    std::string path = pszFileName;
+    CCFileUtils *pFileUtils = CCFileUtils::sharedFileUtils();
+    if (! pFileUtils->isAbsolutePath(path))
+    {
+        path = pFileUtils->getWritablePath() + path;
+    }
+
+    FILE *fp = fopen(path.c_str(), "w");
+    if (! fp)
+    {
+        CCLOG("CCTracer: can't write %s", path.c_str());
+        return false;
+    }
+
+    pthread_once(&s_initOnce, initTracer);
+    pthread_mutex_lock(&s_registryMutex);
+
+    struct _ThreadEvents
+    {
+        _ccTraceBuffer *buffer;
+        std::vector<_ccTraceEvent> events;
+    };
+    std::vector<_ThreadEvents> threads;
+    unsigned long long origin = 0;
+    for (_ccTraceBuffer *buffer = s_pBuffers; buffer; buffer = buffer->next)
+    {
+        threads.push_back(_ThreadEvents());
+        _ThreadEvents &thread = threads.back();
+        thread.buffer = buffer;
+
+        unsigned int uHead = buffer->head;
+        memoryBarrier();
+        if (! buffer->events || uHead == buffer->start)
+        {
+            continue;
+        }
+
+        unsigned int uFirst = uHead - buffer->start > kEventsPerThread ? uHead - kEventsPerThread : buffer->start;
+        for (unsigned int i = uFirst; i != uHead; ++i)
+        {
+            thread.events.push_back(buffer->events[i & (kEventsPerThread - 1)]);
+        }
+
+        // the writer kept going while copying: drop the slots it may have reused, plus the
+        // one it may be writing right now, which only counts once head has moved past it
+        memoryBarrier();
+        unsigned int uOverwritten = buffer->head - kEventsPerThread + 1 - uFirst;
+        if ((int)uOverwritten > 0)
+        {
+            thread.events.erase(thread.events.begin(),
+                thread.events.begin() + (uOverwritten < thread.events.size() ? uOverwritten : thread.events.size()));
+        }
+
+        for (unsigned int i = 0; i < thread.events.size(); ++i)
+        {
+            if (origin == 0 || thread.events[i].begin < origin)
+            {
+                origin = thread.events[i].begin;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&s_registryMutex);
+
+    fprintf(fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool bFirst = true;
+    for (unsigned int t = 0; t < threads.size(); ++t)
+    {
+        const _ThreadEvents &thread = threads[t];
+        if (thread.buffer->threadName)
+        {
+            fprintf(fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                bFirst ? "" : ",\n", thread.buffer->threadId);
+            writeJSONString(fp, thread.buffer->threadName);
+            fprintf(fp, "}}");
+            bFirst = false;
+        }
+
+        for (unsigned int i = 0; i < thread.events.size(); ++i)
+        {
+            const _ccTraceEvent &event = thread.events[i];
+            fprintf(fp, "%s{\"name\":", bFirst ? "" : ",\n");
+            writeJSONString(fp, event.name);
+            // Chrome trace timestamps are in microseconds
+            fprintf(fp, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                thread.buffer->threadId, (event.begin - origin) / 1000.0, (event.end - event.begin) / 1000.0);
+            bFirst = false;
+        }
+    }
+    fprintf(fp, "\n]}\n");
+
+    bool bSuccess = ferror(fp) == 0;
+    fclose(fp);
+    CCLOG("CCTracer: wrote %s", path.c_str());
+    return bSuccess;
+}
+
+#else // CC_ENABLE_TRACER
+
+bool CCTracer::isEnabled(void)
+{
+    return false;
+}
+
+void CCTracer::setRecording(bool bRecording)
+{
+    CC_UNUSED_PARAM(bRecording);
+}
+
+void CCTracer::clear(void)
+{
+}
+
+void CCTracer::startCapture(unsigned int uFrames, const char *pszFileName)
+{
+    CC_UNUSED_PARAM(uFrames);
+    CC_UNUSED_PARAM(pszFileName);
+    CCLOG("CCTracer: CC_ENABLE_TRACER is 0, nothing is recorded");
+}
+
+bool CCTracer::writeTrace(const char *pszFileName)
+{
+    CC_UNUSED_PARAM(pszFileName);
+    return false;
+}
+
+void CCTracer::setThreadName(const char *pszName)
+{
+    CC_UNUSED_PARAM(pszName);
+}
+
+const char* CCTracer::internName(const char *pszName)
+{
+    return pszName;
+}
+
+void CCTracer::endFrame(void)
+{
+}
+
+void CCTracer::beginScope(const char *pszName)
+{
+    CC_UNUSED_PARAM(pszName);
+}
+
+void CCTracer::endScope(void)
+{
+}
+
+#endif // CC_ENABLE_TRACER
+
+NS_CC_END
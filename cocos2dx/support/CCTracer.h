@@ -0,0 +1,143 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __SUPPORT_CCTRACER_H__
+#define __SUPPORT_CCTRACER_H__
+
+#include "platform/CCPlatformMacros.h"
+#include "ccConfig.h"
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup global
+ * @{
+ */
+
+/** @brief CCTracer records nested timing scopes from any thread and writes them as a
+ Chrome trace, to be opened in chrome://tracing or Perfetto.
+
+ Scopes are marked with CC_TRACE_SCOPE. Their names must be string literals or strings
+ returned by internName(): only the pointer is stored, so no lookup happens while recording.
+ Each thread writes its scopes into a ring buffer of its own without locking, with
+ monotonic nanosecond timestamps. When a buffer is full the oldest scopes are overwritten.
+
+ A typical capture:
+ @code
+ // records the next 120 frames then writes them into the writable path
+ CCTracer::startCapture(120, "trace.json");
+ @endcode
+
+ CCDirector traces its frame phases, and the async loaders and CCJobPool trace their threads.
+ When CC_ENABLE_TRACER is 0 the macros compile to nothing and nothing is recorded.
+ @since v2.2
+ @js NA
+ @lua NA
+ */
+class CC_DLL CCTracer
+{
+public:
+    /** Returns true if the scopes are recorded in this build */
+    static bool isEnabled(void);
+
+    /** Starts or stops recording. Recorded scopes are kept until clear() or until they are overwritten. */
+    static void setRecording(bool bRecording);
+    static inline bool isRecording(void) { return s_bRecording; }
+
+    /** Drops the scopes recorded so far */
+    static void clear(void);
+
+    /** Clears, records uFrames frames, then writes the trace to pszFileName.
+     A relative file name is resolved against CCFileUtils::getWritablePath().
+     */
+    static void startCapture(unsigned int uFrames, const char *pszFileName);
+
+    /** Writes the recorded scopes of every thread to pszFileName as Chrome trace JSON */
+    static bool writeTrace(const char *pszFileName);
+
+    /** Names the calling thread in the trace, pszName must outlive the tracer */
+    static void setThreadName(const char *pszName);
+
+    /** Returns a copy of pszName that lives until the end of the program, for scope names built at runtime.
+     It takes a lock: call it once and keep the result.
+     */
+    static const char* internName(const char *pszName);
+
+    /** Called by the director at the end of every frame */
+    static void endFrame(void);
+
+    /** Records the start of a scope on the calling thread, prefer CC_TRACE_SCOPE */
+    static void beginScope(const char *pszName);
+    /** Records the end of the innermost scope of the calling thread */
+    static void endScope(void);
+
+private:
+    static volatile bool s_bRecording;
+};
+
+/** @brief Records a scope from its construction to its destruction, see CC_TRACE_SCOPE */
+class CC_DLL CCTraceScope
+{
+public:
+    explicit inline CCTraceScope(const char *pszName)
+    : m_bActive(CCTracer::isRecording())
+    {
+        if (m_bActive)
+        {
+            CCTracer::beginScope(pszName);
+        }
+    }
+
+    inline ~CCTraceScope(void)
+    {
+        if (m_bActive)
+        {
+            CCTracer::endScope();
+        }
+    }
+
+private:
+    // recording may stop inside the scope, the end must still match the beginning
+    bool m_bActive;
+};
+
+#define CC_TRACE_CONCAT_(__a__, __b__) __a__##__b__
+#define CC_TRACE_CONCAT(__a__, __b__) CC_TRACE_CONCAT_(__a__, __b__)
+
+#if CC_ENABLE_TRACER
+/** Records the enclosing block as a scope named __name__, a string literal */
+#define CC_TRACE_SCOPE(__name__) cocos2d::CCTraceScope CC_TRACE_CONCAT(__ccTraceScope, __LINE__)(__name__)
+/** Names the calling thread in the trace */
+#define CC_TRACE_THREAD_NAME(__name__) cocos2d::CCTracer::setThreadName(__name__)
+#else
+#define CC_TRACE_SCOPE(__name__) do {} while (0)
+#define CC_TRACE_THREAD_NAME(__name__) do {} while (0)
+#endif
+
+// end of global group
+/// @}
+
+NS_CC_END
+
+#endif // __SUPPORT_CCTRACER_H__
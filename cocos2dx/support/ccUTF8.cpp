@@ -294,6 +294,17 @@ unsigned short* cc_utf8_to_utf16(const char* str_old, int length/* = -1 */, int*
     return str_new;
 }
 
+void cc_utf8_to_utf16_vec(const char* str_old, std::vector<unsigned short>& str_new)
+{
+    str_new.clear();
+    while (*str_old)
+    {
+        str_new.push_back(cc_utf8_get_char(str_old));
+        str_old = cc_utf8_next_char(str_old);
+    }
+    str_new.push_back(0);
+}
+
 std::vector<unsigned short> cc_utf16_vec_from_utf16_str(const unsigned short* str)
 {
     int len = cc_wcslen(str);
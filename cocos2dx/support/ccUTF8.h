@@ -61,6 +61,15 @@ CC_DLL std::vector<unsigned short> cc_utf16_vec_from_utf16_str(const unsigned sh
  * */
 CC_DLL unsigned short* cc_utf8_to_utf16(const char* str_old, int length = -1, int* rUtf16Size = NULL);
 
+/*
+ * cc_utf8_to_utf16_vec:
+ * @str_old: pointer to the start of a null-terminated UTF-8 string.
+ * @str_new: receives the characters, followed by a 0.
+ *
+ * Same as cc_utf8_to_utf16, without allocating when str_new is already large enough.
+ * */
+CC_DLL void cc_utf8_to_utf16_vec(const char* str_old, std::vector<unsigned short>& str_new);
+
 /**
  * cc_utf16_to_utf8:
  * @str: a UTF-16 encoded string
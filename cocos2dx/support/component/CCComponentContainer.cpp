@@ -84,20 +84,11 @@ bool CCComponentContainer::remove(const char *pName)
     do 
     {        
         CC_BREAK_IF(!m_pComponents);
-        CCObject* pRetObject = NULL;
-        CCDictElement *pElement = NULL;
-        HASH_FIND_PTR(m_pComponents->m_pElements, pName, pElement);
-        if (pElement != NULL)
-        {
-           pRetObject = pElement->getObject();
-        }
-        CCComponent *com = dynamic_cast<CCComponent*>(pRetObject);
+        CCComponent *com = dynamic_cast<CCComponent*>(m_pComponents->objectForKey(pName));
         CC_BREAK_IF(!com);
         com->onExit();
         com->setOwner(NULL);
-        HASH_DEL(m_pComponents->m_pElements, pElement);
-        pElement->getObject()->release();
-        CC_SAFE_DELETE(pElement);
+        m_pComponents->removeObjectForKey(pName);
         bRet = true;
     } while(0);
     return bRet;
@@ -110,16 +101,13 @@ bool CCComponentContainer::remove(CCComponent *pCom)
     { 
         CC_BREAK_IF(!m_pComponents);
         CCDictElement *pElement = NULL;
-        CCDictElement *tmp = NULL;
-        HASH_ITER(hh, m_pComponents->m_pElements, pElement, tmp)
+        CCDICT_FOREACH(m_pComponents, pElement)
         {
             if (pElement->getObject() == pCom)
             {
                 pCom->onExit();
                 pCom->setOwner(NULL);
-                HASH_DEL(m_pComponents->m_pElements, pElement);
-                pElement->getObject()->release();
-                CC_SAFE_DELETE(pElement);
+                m_pComponents->removeObjectForElememt(pElement);
                 break;
             }
         }
@@ -132,14 +120,12 @@ void CCComponentContainer::removeAll()
 {
     if (m_pComponents != NULL)
     {
-        CCDictElement *pElement, *tmp;
-        HASH_ITER(hh, m_pComponents->m_pElements, pElement, tmp)
+        CCDictElement *pElement = NULL;
+        CCDICT_FOREACH(m_pComponents, pElement)
         {
-            HASH_DEL(m_pComponents->m_pElements, pElement);
             ((CCComponent*)pElement->getObject())->onExit();
             ((CCComponent*)pElement->getObject())->setOwner(NULL);
-            pElement->getObject()->release();
-            CC_SAFE_DELETE(pElement);
+            m_pComponents->removeObjectForElememt(pElement);
         }
         m_pOwner->unscheduleUpdate();
     }
@@ -155,8 +141,8 @@ void CCComponentContainer::visit(float fDelta)
 {
     if (m_pComponents != NULL)
     {
-        CCDictElement *pElement, *tmp;
-        HASH_ITER(hh, m_pComponents->m_pElements, pElement, tmp)
+        CCDictElement *pElement = NULL;
+        CCDICT_FOREACH(m_pComponents, pElement)
         {
             ((CCComponent*)pElement->getObject())->update(fDelta);
         }
@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "platform/CCThread.h"
 #include "platform/CCImage.h"
 #include "support/ccUtils.h"
+#include "support/CCTracer.h"
 #include "CCScheduler.h"
 #include "cocoa/CCString.h"
 #include <errno.h>
@@ -61,6 +62,7 @@ typedef struct _AsyncStruct
     std::string            filename;
     CCObject    *target;
     SEL_CallFuncO        selector;
+    bool                 notifyFailure;
 } AsyncStruct;
 
 typedef struct _ImageInfo
@@ -120,27 +122,28 @@ static CCImage::EImageFormat computeImageFormatType(string& filename)
 
 static void loadImageData(AsyncStruct *pAsyncStruct)
 {
+    CC_TRACE_SCOPE("CCTextureCache::loadImageData");
     const char *filename = pAsyncStruct->filename.c_str();
 
     // compute image type
     CCImage::EImageFormat imageType = computeImageFormatType(pAsyncStruct->filename);
+    CCImage *pImage = NULL;
     if (imageType == CCImage::kFmtUnKnown)
     {
         CCLOG("unsupported format %s",filename);
-        delete pAsyncStruct;
-        return;
     }
-        
-    // generate image            
-    CCImage *pImage = new CCImage();
-    if (pImage && !pImage->initWithImageFileThreadSafe(filename, imageType))
+    else
     {
-        CC_SAFE_RELEASE(pImage);
-        CCLOG("can not load %s", filename);
-        return;
+        // generate image
+        pImage = new CCImage();
+        if (pImage && !pImage->initWithImageFileThreadSafe(filename, imageType))
+        {
+            CC_SAFE_RELEASE_NULL(pImage);
+            CCLOG("can not load %s", filename);
+        }
     }
 
-    // generate image info
+    // generate image info, without image when it failed so that the target is released
     ImageInfo *pImageInfo = new ImageInfo();
     pImageInfo->asyncStruct = pAsyncStruct;
     pImageInfo->image = pImage;
@@ -155,6 +158,8 @@ static void* loadImage(void* data)
 {
     AsyncStruct *pAsyncStruct = NULL;
 
+    CC_TRACE_THREAD_NAME("CCTextureCache loader");
+
     while (true)
     {
         // create autorelease pool for iOS
@@ -252,9 +257,18 @@ CCDictionary* CCTextureCache::snapshotTextures()
 }
 
 void CCTextureCache::addImageAsync(const char *path, CCObject *target, SEL_CallFuncO selector)
+{
+    addImageAsync(path, target, selector, false);
+}
+
+void CCTextureCache::addImageAsync(const char *path, CCObject *target, SEL_CallFuncO selector, bool bNotifyFailure)
 {
 #ifdef EMSCRIPTEN
     CCLOGWARN("Cannot load image %s asynchronously in Emscripten builds.", path);
+    if (bNotifyFailure && target && selector)
+    {
+        (target->*selector)(NULL);
+    }
     return;
 #endif // EMSCRIPTEN
 
@@ -317,6 +331,7 @@ void CCTextureCache::addImageAsync(const char *path, CCObject *target, SEL_CallF
     data->filename = fullpath.c_str();
     data->target = target;
     data->selector = selector;
+    data->notifyFailure = bNotifyFailure;
 
 #if (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT) && (CC_TARGET_PLATFORM != CC_PLATFORM_WP8)
     // add async struct into queue
@@ -349,6 +364,8 @@ void CCTextureCache::addImageAsyncCallBack(float dt)
         imagesQueue->pop();
         pthread_mutex_unlock(&s_ImageInfoMutex);
 
+        CC_TRACE_SCOPE("CCTextureCache::addImageAsyncCallBack");
+
         AsyncStruct *pAsyncStruct = pImageInfo->asyncStruct;
         CCImage *pImage = pImageInfo->image;
 
@@ -356,30 +373,34 @@ void CCTextureCache::addImageAsyncCallBack(float dt)
         SEL_CallFuncO selector = pAsyncStruct->selector;
         const char* filename = pAsyncStruct->filename.c_str();
 
-        // generate texture in render thread
-        CCTexture2D *texture = new CCTexture2D();
+        CCTexture2D *texture = NULL;
+        if (pImage)
+        {
+            // generate texture in render thread
+            texture = new CCTexture2D();
 #if 0 //TODO: (CC_TARGET_PLATFORM == CC_PLATFORM_IOS)
-        texture->initWithImage(pImage, kCCResolutioniPhone);
+            texture->initWithImage(pImage, kCCResolutioniPhone);
 #else
-        texture->initWithImage(pImage);
+            texture->initWithImage(pImage);
 #endif
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
-       // cache the texture file name
-       VolatileTexture::addImageTexture(texture, filename, pImageInfo->imageType);
+            // cache the texture file name
+            VolatileTexture::addImageTexture(texture, filename, pImageInfo->imageType);
 #endif
 
-        // cache the texture
-        m_pTextures->setObject(texture, filename);
-        texture->autorelease();
+            // cache the texture
+            m_pTextures->setObject(texture, filename);
+            texture->autorelease();
+        }
 
-        if (target && selector)
+        if (target && selector && (texture || pAsyncStruct->notifyFailure))
         {
             (target->*selector)(texture);
-            target->release();
-        }        
+        }
+        CC_SAFE_RELEASE(target);
 
-        pImage->release();
+        CC_SAFE_RELEASE(pImage);
         delete pAsyncStruct;
         delete pImageInfo;
 
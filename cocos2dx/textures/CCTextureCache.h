@@ -113,6 +113,13 @@ public:
     
     void addImageAsync(const char *path, CCObject *target, SEL_CallFuncO selector);
 
+    /* Like addImageAsync(const char*, CCObject*, SEL_CallFuncO), but if bNotifyFailure is true,
+    * the callback is also called, with NULL, when the image can't be loaded.
+    * @since v2.2
+    * @lua NA
+    */
+    void addImageAsync(const char *path, CCObject *target, SEL_CallFuncO selector, bool bNotifyFailure);
+
     /* Returns a Texture2D object given an CGImageRef image
     * If the image was not previously loaded, it will create a new CCTexture2D object and it will return it.
     * Otherwise it will return a reference of a previously loaded image
@@ -30,8 +30,14 @@ THE SOFTWARE.
 #include "CCTouch.h"
 #include "textures/CCTexture2D.h"
 #include "support/data_support/ccCArray.h"
+#include "support/CCSpatialGrid.h"
+#include "cocoa/CCAffineTransform.h"
+#include "base_nodes/CCNode.h"
 #include "ccMacros.h"
 #include <algorithm>
+#include <map>
+#include <vector>
+#include <limits.h>
 
 NS_CC_BEGIN
 
@@ -43,6 +49,35 @@ static int less(const CCObject* p1, const CCObject* p2)
     return ((CCTouchHandler*)p1)->getPriority() < ((CCTouchHandler*)p2)->getPriority();
 }
 
+static bool lessDispatchOrder(CCTargetedTouchHandler *p1, CCTargetedTouchHandler *p2)
+{
+    return p1->getDispatchOrder() < p2->getDispatchOrder();
+}
+
+template <typename T>
+static void eraseValue(std::vector<T>& values, T value)
+{
+    typename std::vector<T>::iterator it = std::find(values.begin(), values.end(), value);
+    if (it != values.end())
+    {
+        values.erase(it);
+    }
+}
+
+struct _ccTouchBoundsData
+{
+    // handlers reading their bounds from a node, by node and by ancestor of the node
+    std::map<CCNode*, std::vector<CCTargetedTouchHandler*> > observers;
+    // nodes each of these handlers is registered for in observers
+    std::map<CCTargetedTouchHandler*, std::vector<CCNode*> > observedNodes;
+    // handlers whose bounds must be read again from their node
+    std::vector<CCTargetedTouchHandler*> dirtyHandlers;
+    // targeted handlers without bounds, in dispatch order
+    std::vector<CCTargetedTouchHandler*> unboundedHandlers;
+    // targeted handlers with bounds which claimed touches
+    std::vector<CCTargetedTouchHandler*> claimingHandlers;
+};
+
 bool CCTouchDispatcher::isDispatchEvents(void)
 {
     return m_bDispatchEvents;
@@ -74,6 +109,9 @@ bool CCTouchDispatcher::init(void)
     m_pHandlersToAdd = CCArray::createWithCapacity(8);
     m_pHandlersToAdd->retain();
     m_pHandlersToRemove = ccCArrayNew(8);
+    m_pTouchBounds = new CCSpatialGrid();
+    m_pTouchBoundsData = new _ccTouchBoundsData();
+    m_bDispatchOrderDirty = true;
 
     m_bToRemove = false;
     m_bToAdd = false;
@@ -90,12 +128,19 @@ bool CCTouchDispatcher::init(void)
 
 CCTouchDispatcher::~CCTouchDispatcher(void)
 {
+    if (m_pTouchBoundsData)
+    {
+        forgetAllTouchBounds();
+    }
+
      CC_SAFE_RELEASE(m_pTargetedHandlers);
      CC_SAFE_RELEASE(m_pStandardHandlers);
      CC_SAFE_RELEASE(m_pHandlersToAdd);
  
      ccCArrayFree(m_pHandlersToRemove);
     m_pHandlersToRemove = NULL;    
+    CC_SAFE_DELETE(m_pTouchBounds);
+    CC_SAFE_DELETE(m_pTouchBoundsData);
 }
 
 //
@@ -125,6 +170,11 @@ void CCTouchDispatcher::forceAddHandler(CCTouchHandler *pHandler, CCArray *pArra
      }
 
     pArray->insertObject(pHandler, u);
+
+    if (pArray == m_pTargetedHandlers)
+    {
+        m_bDispatchOrderDirty = true;
+    }
 }
 
 void CCTouchDispatcher::addStandardDelegate(CCTouchDelegate *pDelegate, int nPriority)
@@ -197,7 +247,9 @@ void CCTouchDispatcher::forceRemoveDelegate(CCTouchDelegate *pDelegate)
         pHandler = (CCTouchHandler*)pObj;
         if (pHandler && pHandler->getDelegate() == pDelegate)
         {
+            forgetTouchBounds((CCTargetedTouchHandler*)pHandler);
             m_pTargetedHandlers->removeObject(pHandler);
+            m_bDispatchOrderDirty = true;
             break;
         }
     }
@@ -222,6 +274,11 @@ void CCTouchDispatcher::removeDelegate(CCTouchDelegate *pDelegate)
         CCTouchHandler *pHandler = findHandler(m_pHandlersToAdd, pDelegate);
         if (pHandler)
         {
+            CCTargetedTouchHandler *pTargetedHandler = dynamic_cast<CCTargetedTouchHandler*>(pHandler);
+            if (pTargetedHandler)
+            {
+                forgetTouchBounds(pTargetedHandler);
+            }
             m_pHandlersToAdd->removeObject(pHandler);
             return;
         }
@@ -234,7 +291,9 @@ void CCTouchDispatcher::removeDelegate(CCTouchDelegate *pDelegate)
 void CCTouchDispatcher::forceRemoveAllDelegates(void)
 {
      m_pStandardHandlers->removeAllObjects();
+     forgetAllTouchBounds();
      m_pTargetedHandlers->removeAllObjects();
+     m_bDispatchOrderDirty = true;
 }
 
 void CCTouchDispatcher::removeAllDelegates(void)
@@ -290,6 +349,234 @@ CCTouchHandler* CCTouchDispatcher::findHandler(CCArray* pArray, CCTouchDelegate
     return NULL;
 }
 
+CCTargetedTouchHandler* CCTouchDispatcher::findTargetedHandler(CCTouchDelegate *pDelegate)
+{
+    CCTargetedTouchHandler *pHandler = dynamic_cast<CCTargetedTouchHandler*>(findHandler(m_pTargetedHandlers, pDelegate));
+    if (! pHandler)
+    {
+        // not added yet if it was added during a dispatch
+        pHandler = dynamic_cast<CCTargetedTouchHandler*>(findHandler(m_pHandlersToAdd, pDelegate));
+    }
+
+    return pHandler;
+}
+
+void CCTouchDispatcher::setTouchBounds(CCTouchDelegate *pDelegate, const CCRect& bounds)
+{
+    CCTargetedTouchHandler *pHandler = findTargetedHandler(pDelegate);
+    CCAssert(pHandler != NULL, "setTouchBounds: the delegate must be a targeted delegate");
+
+    if (pHandler)
+    {
+        forgetTouchBounds(pHandler);
+
+        pHandler->setHasTouchBounds(true);
+        m_pTouchBounds->setItemBounds(pHandler, bounds);
+        if (pHandler->getClaimedTouches()->count() > 0)
+        {
+            m_pTouchBoundsData->claimingHandlers.push_back(pHandler);
+        }
+        m_bDispatchOrderDirty = true;
+    }
+}
+
+void CCTouchDispatcher::setTouchBoundsNode(CCTouchDelegate *pDelegate, CCNode *pNode)
+{
+    CCAssert(pNode != NULL, "setTouchBoundsNode: the node should not be null");
+    CCTargetedTouchHandler *pHandler = findTargetedHandler(pDelegate);
+    CCAssert(pHandler != NULL, "setTouchBoundsNode: the delegate must be a targeted delegate");
+
+    if (pHandler && pNode)
+    {
+        forgetTouchBounds(pHandler);
+
+        // the bounds are read from the node before the next touch begins,
+        // observing it right away tells if it is deleted before that
+        pHandler->setHasTouchBounds(true);
+        pHandler->setBoundsNode(pNode);
+        observeBoundsNode(pHandler, pNode);
+        markTouchBoundsDirty(pHandler);
+        if (pHandler->getClaimedTouches()->count() > 0)
+        {
+            m_pTouchBoundsData->claimingHandlers.push_back(pHandler);
+        }
+        m_bDispatchOrderDirty = true;
+    }
+}
+
+void CCTouchDispatcher::removeTouchBounds(CCTouchDelegate *pDelegate)
+{
+    CCTargetedTouchHandler *pHandler = findTargetedHandler(pDelegate);
+    if (pHandler)
+    {
+        forgetTouchBounds(pHandler);
+    }
+}
+
+void CCTouchDispatcher::touchBoundsNodeDidChange(CCNode *pNode)
+{
+    std::map<CCNode*, std::vector<CCTargetedTouchHandler*> >::iterator it = m_pTouchBoundsData->observers.find(pNode);
+    if (it == m_pTouchBoundsData->observers.end())
+    {
+        return;
+    }
+
+    std::vector<CCTargetedTouchHandler*>& handlers = it->second;
+    for (unsigned int i = 0; i < handlers.size(); ++i)
+    {
+        markTouchBoundsDirty(handlers[i]);
+    }
+}
+
+void CCTouchDispatcher::touchBoundsNodeWillBeDeleted(CCNode *pNode)
+{
+    std::map<CCNode*, std::vector<CCTargetedTouchHandler*> >::iterator it = m_pTouchBoundsData->observers.find(pNode);
+    if (it == m_pTouchBoundsData->observers.end())
+    {
+        return;
+    }
+
+    std::vector<CCTargetedTouchHandler*> handlers;
+    handlers.swap(it->second);
+    m_pTouchBoundsData->observers.erase(it);
+    pNode->setTouchBoundsObserved(false);
+
+    for (unsigned int i = 0; i < handlers.size(); ++i)
+    {
+        CCTargetedTouchHandler *pHandler = handlers[i];
+        if (pHandler->getBoundsNode() == pNode)
+        {
+            // nothing to read the bounds from any more: the delegate is asked about every touch again
+            forgetTouchBounds(pHandler);
+        }
+        else
+        {
+            // an ancestor of the bounds node, which is being removed from it
+            markTouchBoundsDirty(pHandler);
+        }
+    }
+}
+
+void CCTouchDispatcher::markTouchBoundsDirty(CCTargetedTouchHandler *pHandler)
+{
+    if (! pHandler->isBoundsDirty())
+    {
+        pHandler->setBoundsDirty(true);
+        m_pTouchBoundsData->dirtyHandlers.push_back(pHandler);
+    }
+}
+
+void CCTouchDispatcher::observeBoundsNode(CCTargetedTouchHandler *pHandler, CCNode *pNode)
+{
+    m_pTouchBoundsData->observers[pNode].push_back(pHandler);
+    m_pTouchBoundsData->observedNodes[pHandler].push_back(pNode);
+    pNode->setTouchBoundsObserved(true);
+}
+
+void CCTouchDispatcher::unobserveBoundsNodes(CCTargetedTouchHandler *pHandler)
+{
+    std::map<CCTargetedTouchHandler*, std::vector<CCNode*> >::iterator it = m_pTouchBoundsData->observedNodes.find(pHandler);
+    if (it == m_pTouchBoundsData->observedNodes.end())
+    {
+        return;
+    }
+
+    // the nodes deleted since were already removed from observers
+    std::vector<CCNode*>& nodes = it->second;
+    for (unsigned int i = 0; i < nodes.size(); ++i)
+    {
+        std::map<CCNode*, std::vector<CCTargetedTouchHandler*> >::iterator observer = m_pTouchBoundsData->observers.find(nodes[i]);
+        if (observer != m_pTouchBoundsData->observers.end())
+        {
+            eraseValue(observer->second, pHandler);
+            if (observer->second.empty())
+            {
+                observer->first->setTouchBoundsObserved(false);
+                m_pTouchBoundsData->observers.erase(observer);
+            }
+        }
+    }
+
+    m_pTouchBoundsData->observedNodes.erase(it);
+}
+
+void CCTouchDispatcher::forgetTouchBounds(CCTargetedTouchHandler *pHandler)
+{
+    unobserveBoundsNodes(pHandler);
+    pHandler->setBoundsNode(NULL);
+    if (pHandler->isBoundsDirty())
+    {
+        pHandler->setBoundsDirty(false);
+        eraseValue(m_pTouchBoundsData->dirtyHandlers, pHandler);
+    }
+
+    if (pHandler->hasTouchBounds())
+    {
+        pHandler->setHasTouchBounds(false);
+        m_pTouchBounds->removeItem(pHandler);
+        eraseValue(m_pTouchBoundsData->claimingHandlers, pHandler);
+        m_bDispatchOrderDirty = true;
+    }
+}
+
+void CCTouchDispatcher::forgetAllTouchBounds(void)
+{
+    std::map<CCNode*, std::vector<CCTargetedTouchHandler*> >::iterator it;
+    for (it = m_pTouchBoundsData->observers.begin(); it != m_pTouchBoundsData->observers.end(); ++it)
+    {
+        it->first->setTouchBoundsObserved(false);
+    }
+    m_pTouchBoundsData->observers.clear();
+    m_pTouchBoundsData->observedNodes.clear();
+    m_pTouchBoundsData->dirtyHandlers.clear();
+    m_pTouchBoundsData->unboundedHandlers.clear();
+    m_pTouchBoundsData->claimingHandlers.clear();
+    m_pTouchBounds->removeAllItems();
+}
+
+void CCTouchDispatcher::updateTouchBounds(void)
+{
+    std::vector<CCTargetedTouchHandler*>& dirtyHandlers = m_pTouchBoundsData->dirtyHandlers;
+    for (unsigned int i = 0; i < dirtyHandlers.size(); ++i)
+    {
+        CCTargetedTouchHandler *pHandler = dirtyHandlers[i];
+        pHandler->setBoundsDirty(false);
+        unobserveBoundsNodes(pHandler);
+
+        CCNode *pNode = pHandler->getBoundsNode();
+        const CCSize& size = pNode->getContentSize();
+        m_pTouchBounds->setItemBounds(pHandler, CCRectApplyAffineTransform(CCRectMake(0, 0, size.width, size.height), pNode->nodeToWorldTransform()));
+
+        // the world bounds change with the node and with any of its ancestors
+        for (CCNode *pObserved = pNode; pObserved; pObserved = pObserved->getParent())
+        {
+            observeBoundsNode(pHandler, pObserved);
+        }
+    }
+    dirtyHandlers.clear();
+}
+
+void CCTouchDispatcher::updateDispatchOrder(void)
+{
+    if (! m_bDispatchOrderDirty)
+    {
+        return;
+    }
+
+    std::vector<CCTargetedTouchHandler*>& unboundedHandlers = m_pTouchBoundsData->unboundedHandlers;
+    unboundedHandlers.clear();
+    for (unsigned int i = 0; i < m_pTargetedHandlers->count(); ++i)
+    {
+        CCTargetedTouchHandler *pHandler = (CCTargetedTouchHandler*)m_pTargetedHandlers->objectAtIndex(i);
+        pHandler->setDispatchOrder(i);
+        if (! pHandler->hasTouchBounds())
+        {
+            unboundedHandlers.push_back(pHandler);
+        }
+    }
+    m_bDispatchOrderDirty = false;
+}
+
 void CCTouchDispatcher::rearrangeHandlers(CCArray *pArray)
 {
     std::sort(pArray->data->arr, pArray->data->arr + pArray->data->num, less);
@@ -310,7 +597,53 @@ void CCTouchDispatcher::setPriority(int nPriority, CCTouchDelegate *pDelegate)
         handler->setPriority(nPriority);
         this->rearrangeHandlers(m_pTargetedHandlers);
         this->rearrangeHandlers(m_pStandardHandlers);
+        m_bDispatchOrderDirty = true;
+    }
+}
+
+bool CCTouchDispatcher::dispatchTargetedTouch(CCTargetedTouchHandler *pHandler, CCTouch *pTouch, CCEvent *pEvent, unsigned int uIndex)
+{
+    CCSet *pClaimedTouches = pHandler->getClaimedTouches();
+    if (uIndex == CCTOUCHBEGAN)
+    {
+        if (! pHandler->getDelegate()->ccTouchBegan(pTouch, pEvent))
+        {
+            return false;
+        }
+
+        if (pHandler->hasTouchBounds() && pClaimedTouches->count() == 0)
+        {
+            m_pTouchBoundsData->claimingHandlers.push_back(pHandler);
+        }
+        pClaimedTouches->addObject(pTouch);
+        return true;
+    }
+
+    if (! pClaimedTouches->containsObject(pTouch))
+    {
+        return false;
+    }
+
+    // moved ended canceled
+    switch (uIndex)
+    {
+    case CCTOUCHMOVED:
+        pHandler->getDelegate()->ccTouchMoved(pTouch, pEvent);
+        return true;
+    case CCTOUCHENDED:
+        pHandler->getDelegate()->ccTouchEnded(pTouch, pEvent);
+        break;
+    case CCTOUCHCANCELLED:
+        pHandler->getDelegate()->ccTouchCancelled(pTouch, pEvent);
+        break;
     }
+
+    pClaimedTouches->removeObject(pTouch);
+    if (pHandler->hasTouchBounds() && pClaimedTouches->count() == 0)
+    {
+        eraseValue(m_pTouchBoundsData->claimingHandlers, pHandler);
+    }
+    return true;
 }
 
 //
@@ -323,12 +656,13 @@ void CCTouchDispatcher::touches(CCSet *pTouches, CCEvent *pEvent, unsigned int u
     CCSet *pMutableTouches;
     m_bLocked = true;
 
-    // optimization to prevent a mutable copy when it is not necessary
+    // optimization to prevent a mutable copy when it is not necessary:
+    // the touches are only copied once a targeted handler swallows one
      unsigned int uTargetedHandlersCount = m_pTargetedHandlers->count();
      unsigned int uStandardHandlersCount = m_pStandardHandlers->count();
-    bool bNeedsMutableSet = (uTargetedHandlersCount && uStandardHandlersCount);
+    bool bCopiedTouches = false;
 
-    pMutableTouches = (bNeedsMutableSet ? pTouches->mutableCopy() : pTouches);
+    pMutableTouches = pTouches;
 
     struct ccTouchHandlerHelperData sHelper = m_sHandlerHelperData[uIndex];
     //
@@ -336,58 +670,65 @@ void CCTouchDispatcher::touches(CCSet *pTouches, CCEvent *pEvent, unsigned int u
     //
     if (uTargetedHandlersCount > 0)
     {
+        if (uIndex == CCTOUCHBEGAN)
+        {
+            updateTouchBounds();
+        }
+        updateDispatchOrder();
+
+        // with bounds, only the handlers without bounds and the handlers whose bounds contain
+        // the touch (or which claimed it) are asked, in the order of m_pTargetedHandlers
+        const std::vector<CCTargetedTouchHandler*>& unboundedHandlers = m_pTouchBoundsData->unboundedHandlers;
+        bool bUseTouchBounds = unboundedHandlers.size() < uTargetedHandlersCount;
+        std::vector<CCTargetedTouchHandler*> handlers;
+        std::vector<void*> candidates;
+
         CCTouch *pTouch;
         CCSetIterator setIter;
         for (setIter = pTouches->begin(); setIter != pTouches->end(); ++setIter)
         {
             pTouch = (CCTouch *)(*setIter);
 
-            CCTargetedTouchHandler *pHandler = NULL;
-            CCObject* pObj = NULL;
-            CCARRAY_FOREACH(m_pTargetedHandlers, pObj)
+            unsigned int uCount = uTargetedHandlersCount;
+            if (bUseTouchBounds)
             {
-                pHandler = (CCTargetedTouchHandler *)(pObj);
-
-                if (! pHandler)
-                {
-                   break;
-                }
-
-                bool bClaimed = false;
+                handlers.assign(unboundedHandlers.begin(), unboundedHandlers.end());
                 if (uIndex == CCTOUCHBEGAN)
                 {
-                    bClaimed = pHandler->getDelegate()->ccTouchBegan(pTouch, pEvent);
-
-                    if (bClaimed)
+                    candidates.clear();
+                    m_pTouchBounds->itemsAtPoint(pTouch->getLocation(), candidates);
+                    for (unsigned int i = 0; i < candidates.size(); ++i)
                     {
-                        pHandler->getClaimedTouches()->addObject(pTouch);
+                        CCTargetedTouchHandler *pCandidate = (CCTargetedTouchHandler*)candidates[i];
+                        // skips the handlers added during this dispatch
+                        if (pCandidate->getDispatchOrder() != UINT_MAX)
+                        {
+                            handlers.push_back(pCandidate);
+                        }
                     }
-                } else
-                if (pHandler->getClaimedTouches()->containsObject(pTouch))
+                }
+                else
                 {
-                    // moved ended canceled
-                    bClaimed = true;
-
-                    switch (sHelper.m_type)
-                    {
-                    case CCTOUCHMOVED:
-                        pHandler->getDelegate()->ccTouchMoved(pTouch, pEvent);
-                        break;
-                    case CCTOUCHENDED:
-                        pHandler->getDelegate()->ccTouchEnded(pTouch, pEvent);
-                        pHandler->getClaimedTouches()->removeObject(pTouch);
-                        break;
-                    case CCTOUCHCANCELLED:
-                        pHandler->getDelegate()->ccTouchCancelled(pTouch, pEvent);
-                        pHandler->getClaimedTouches()->removeObject(pTouch);
-                        break;
-                    }
+                    handlers.insert(handlers.end(), m_pTouchBoundsData->claimingHandlers.begin(), m_pTouchBoundsData->claimingHandlers.end());
                 }
+                std::sort(handlers.begin(), handlers.end(), lessDispatchOrder);
+                uCount = handlers.size();
+            }
+
+            for (unsigned int i = 0; i < uCount; ++i)
+            {
+                CCTargetedTouchHandler *pHandler = bUseTouchBounds ? handlers[i] : (CCTargetedTouchHandler*)m_pTargetedHandlers->data->arr[i];
 
+                bool bClaimed = dispatchTargetedTouch(pHandler, pTouch, pEvent, sHelper.m_type);
                 if (bClaimed && pHandler->isSwallowsTouches())
                 {
-                    if (bNeedsMutableSet)
+                    if (uStandardHandlersCount)
                     {
+                        if (! bCopiedTouches)
+                        {
+                            pMutableTouches = pTouches->mutableCopy();
+                            bCopiedTouches = true;
+                        }
                         pMutableTouches->removeObject(pTouch);
                     }
 
@@ -431,7 +772,7 @@ void CCTouchDispatcher::touches(CCSet *pTouches, CCEvent *pEvent, unsigned int u
         }
     }
 
-    if (bNeedsMutableSet)
+    if (bCopiedTouches)
     {
         pMutableTouches->release();
     }
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "CCTouchDelegateProtocol.h"
 #include "cocoa/CCObject.h"
 #include "cocoa/CCArray.h"
+#include "cocoa/CCGeometry.h"
 
 NS_CC_BEGIN
 
@@ -94,8 +95,13 @@ public:
     virtual ~EGLTouchDelegate() {}
 };
 
+class CCNode;
+class CCTouch;
 class CCTouchHandler;
+class CCTargetedTouchHandler;
+class CCSpatialGrid;
 struct _ccCArray;
+struct _ccTouchBoundsData;
 /** @brief CCTouchDispatcher.
  Singleton that handles all the touch events.
  The dispatcher dispatches events to the registered TouchHandlers.
@@ -132,7 +138,9 @@ public:
         , m_pStandardHandlers(NULL)
         , m_pHandlersToAdd(NULL)
         , m_pHandlersToRemove(NULL)
-        
+        , m_pTouchBounds(NULL)
+        , m_pTouchBoundsData(NULL)
+        , m_bDispatchOrderDirty(true)
     {}
 
 public:
@@ -170,6 +178,42 @@ public:
      * @lua NA
      */
     void setPriority(int nPriority, CCTouchDelegate *pDelegate);
+
+    /** Tells the dispatcher that a targeted delegate never claims touches beginning
+     * outside bounds, in the coordinates of CCTouch::getLocation(). ccTouchBegan()
+     * is then only called for the touches beginning inside bounds, which are looked
+     * up in a grid instead of asking every delegate. Call it again when the delegate moves,
+     * or use setTouchBoundsNode() for a delegate that is a node.
+     * @since v2.2
+     * @lua NA
+     */
+    void setTouchBounds(CCTouchDelegate *pDelegate, const CCRect& bounds);
+
+    /** Like setTouchBounds(), with the bounding box of pNode in world coordinates as bounds.
+     * The bounds follow the node: they are read again before the next touch begins once
+     * the node or one of its ancestors is moved, scaled, rotated, resized or reparented.
+     * The node is not retained; its bounds are forgotten when it is deleted.
+     * @since v2.2
+     * @lua NA
+     */
+    void setTouchBoundsNode(CCTouchDelegate *pDelegate, CCNode *pNode);
+
+    /** Forgets the bounds of a delegate: it is asked about every touch again.
+     * @since v2.2
+     * @lua NA
+     */
+    void removeTouchBounds(CCTouchDelegate *pDelegate);
+
+    /** Called by CCNode when the transform or the parent of a node that touch bounds
+     * depend on changes, see setTouchBoundsNode().
+     * @lua NA
+     */
+    void touchBoundsNodeDidChange(CCNode *pNode);
+
+    /** Called by CCNode when a node that touch bounds depend on is deleted.
+     * @lua NA
+     */
+    void touchBoundsNodeWillBeDeleted(CCNode *pNode);
     /**
      * @lua NA
      */
@@ -202,6 +246,15 @@ protected:
     void forceRemoveAllDelegates(void);
     void rearrangeHandlers(CCArray* pArray);
     CCTouchHandler* findHandler(CCArray* pArray, CCTouchDelegate *pDelegate);
+    CCTargetedTouchHandler* findTargetedHandler(CCTouchDelegate *pDelegate);
+    bool dispatchTargetedTouch(CCTargetedTouchHandler *pHandler, CCTouch *pTouch, CCEvent *pEvent, unsigned int uIndex);
+    void updateDispatchOrder(void);
+    void updateTouchBounds(void);
+    void markTouchBoundsDirty(CCTargetedTouchHandler *pHandler);
+    void observeBoundsNode(CCTargetedTouchHandler *pHandler, CCNode *pNode);
+    void unobserveBoundsNodes(CCTargetedTouchHandler *pHandler);
+    void forgetTouchBounds(CCTargetedTouchHandler *pHandler);
+    void forgetAllTouchBounds(void);
 
 protected:
      CCArray* m_pTargetedHandlers;
@@ -215,6 +268,13 @@ protected:
     bool m_bToQuit;
     bool m_bDispatchEvents;
 
+    // bounds of the targeted handlers, see setTouchBounds()
+    CCSpatialGrid *m_pTouchBounds;
+    // bounds nodes, handlers without bounds and handlers with claimed touches
+    struct _ccTouchBoundsData *m_pTouchBoundsData;
+    // true when the dispatch order of the targeted handlers must be updated
+    bool m_bDispatchOrderDirty;
+
     // 4, 1 for each type of event
     struct ccTouchHandlerHelperData m_sHandlerHelperData[ccTouchMax];
 };
@@ -25,6 +25,7 @@ THE SOFTWARE.
 
 #include "CCTouchHandler.h"
 #include "ccMacros.h"
+#include <limits.h>
 
 NS_CC_BEGIN
 
@@ -156,6 +157,46 @@ CCSet* CCTargetedTouchHandler::getClaimedTouches(void)
     return m_pClaimedTouches;
 }
 
+bool CCTargetedTouchHandler::hasTouchBounds(void)
+{
+    return m_bHasTouchBounds;
+}
+
+void CCTargetedTouchHandler::setHasTouchBounds(bool bHasTouchBounds)
+{
+    m_bHasTouchBounds = bHasTouchBounds;
+}
+
+CCNode* CCTargetedTouchHandler::getBoundsNode(void)
+{
+    return m_pBoundsNode;
+}
+
+void CCTargetedTouchHandler::setBoundsNode(CCNode *pNode)
+{
+    m_pBoundsNode = pNode;
+}
+
+bool CCTargetedTouchHandler::isBoundsDirty(void)
+{
+    return m_bBoundsDirty;
+}
+
+void CCTargetedTouchHandler::setBoundsDirty(bool bBoundsDirty)
+{
+    m_bBoundsDirty = bBoundsDirty;
+}
+
+unsigned int CCTargetedTouchHandler::getDispatchOrder(void)
+{
+    return m_uDispatchOrder;
+}
+
+void CCTargetedTouchHandler::setDispatchOrder(unsigned int uDispatchOrder)
+{
+    m_uDispatchOrder = uDispatchOrder;
+}
+
 CCTargetedTouchHandler* CCTargetedTouchHandler::handlerWithDelegate(CCTouchDelegate *pDelegate, int nPriority, bool bSwallow)
 {
     CCTargetedTouchHandler *pHandler = new CCTargetedTouchHandler();
@@ -180,6 +221,10 @@ bool CCTargetedTouchHandler::initWithDelegate(CCTouchDelegate *pDelegate, int nP
     {
         m_pClaimedTouches = new CCSet();
         m_bSwallowsTouches = bSwallow;
+        m_bHasTouchBounds = false;
+        m_bBoundsDirty = false;
+        m_pBoundsNode = NULL;
+        m_uDispatchOrder = UINT_MAX;
 
         return true;
     }
@@ -109,6 +109,22 @@ public:
     /** MutableSet that contains the claimed touches */
     CCSet* getClaimedTouches(void);
 
+    /** whether or not the dispatcher knows the bounds of the delegate, see CCTouchDispatcher::setTouchBounds() */
+    bool hasTouchBounds(void);
+    void setHasTouchBounds(bool bHasTouchBounds);
+
+    /** node the bounds are read from, see CCTouchDispatcher::setTouchBoundsNode(). Weak reference */
+    CCNode* getBoundsNode(void);
+    void setBoundsNode(CCNode *pNode);
+
+    /** whether or not the bounds must be read again from the bounds node */
+    bool isBoundsDirty(void);
+    void setBoundsDirty(bool bBoundsDirty);
+
+    /** index in the targeted handlers of the dispatcher, UINT_MAX until the dispatcher sets it */
+    unsigned int getDispatchOrder(void);
+    void setDispatchOrder(unsigned int uDispatchOrder);
+
     /** initializes a TargetedTouchHandler with a delegate, a priority and whether or not it swallows touches or not */
     bool initWithDelegate(CCTouchDelegate *pDelegate, int nPriority, bool bSwallow);
 
@@ -118,6 +134,10 @@ public:
 
 protected:
     bool m_bSwallowsTouches;
+    bool m_bHasTouchBounds;
+    bool m_bBoundsDirty;
+    CCNode *m_pBoundsNode;
+    unsigned int m_uDispatchOrder;
     CCSet *m_pClaimedTouches;
 };
 
@@ -144,6 +144,7 @@ spine/SlotData.cpp \
 spine/extension.cpp \
 spine/CCSkeletonAnimation.cpp \
 spine/CCSkeleton.cpp \
+spine/CCSkeletonDataCache.cpp \
 spine/spine-cocos2dx.cpp \
 
 LOCAL_WHOLE_STATIC_LIBRARIES := cocos2dx_static
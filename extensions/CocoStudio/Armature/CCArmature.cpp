@@ -28,6 +28,11 @@ THE SOFTWARE.
 #include "utils/CCDataReaderHelper.h"
 #include "datas/CCDatas.h"
 #include "display/CCSkin.h"
+#include "display/CCDisplayFactory.h"
+#include "utils/CCTransformHelp.h"
+#include "utils/CCUtilMath.h"
+#include "support/CCJobPool.h"
+#include <climits>
 
 #if ENABLE_PHYSICS_BOX2D_DETECT
 #include "Box2D/Box2D.h"
@@ -40,6 +45,22 @@ NS_CC_EXT_BEGIN
 
 std::map<int, CCArmature *> CCArmature::m_sArmatureIndexDic;
 
+void CCBoneTransformArrays::resize(unsigned int size)
+{
+    x.resize(size);
+    y.resize(size);
+    scaleX.resize(size);
+    scaleY.resize(size);
+    skewX.resize(size);
+    skewY.resize(size);
+    a.resize(size);
+    b.resize(size);
+    c.resize(size);
+    d.resize(size);
+    tx.resize(size);
+    ty.resize(size);
+}
+
 CCArmature *CCArmature::create()
 {
     CCArmature *armature = new CCArmature();
@@ -87,6 +108,9 @@ CCArmature::CCArmature()
     , m_pTopBoneList(NULL)
     , m_pAnimation(NULL)
     , m_pTextureAtlasDic(NULL)
+    , m_bBoneOrderDirty(true)
+    , m_bPendingParallelUpdate(false)
+    , m_fPendingDelta(0)
 {
 }
 
@@ -278,6 +302,8 @@ void CCArmature::addBone(CCBone *bone, const char *parentName)
 
     m_pBoneDic->setObject(bone, bone->getName());
     addChild(bone);
+
+    m_bBoneOrderDirty = true;
 }
 
 
@@ -294,6 +320,8 @@ void CCArmature::removeBone(CCBone *bone, bool recursion)
     }
     m_pBoneDic->removeObjectForKey(bone->getName());
     removeChild(bone, true);
+
+    m_bBoneOrderDirty = true;
 }
 
 
@@ -330,6 +358,8 @@ void CCArmature::changeBoneParent(CCBone *bone, const char *parentName)
             m_pTopBoneList->addObject(bone);
         }
     }
+
+    m_bBoneOrderDirty = true;
 }
 
 CCDictionary *CCArmature::getBoneDic()
@@ -451,17 +481,384 @@ CCArmatureAnimation *CCArmature::getAnimation()
     return m_pAnimation;
 }
 
+// Armature - Parallel update
+
+static bool s_bParallelUpdateEnabled = false;
+
+/** Collects the armatures updated during a scheduler tick, animates them on the job pool
+ once every other target has been updated, then finishes them on the main thread in the
+ order they were collected.
+ It is purged with the director, which unschedules it, and scheduled again by the next
+ armature update.
+ */
+class CCArmatureUpdater : public CCObject
+{
+public:
+    static CCArmatureUpdater* sharedUpdater();
+    static void purgeSharedUpdater();
+
+    CCArmatureUpdater() : m_bFinishing(false) {}
+
+    //! EVENT_DIRECTOR_PURGE observer
+    void directorWillPurge(CCObject *pObject);
+
+    //! true while the armatures are finished, when armatures are updated right away
+    static bool isFinishing();
+
+    void addArmature(CCArmature *armature, float dt);
+    virtual void update(float dt);
+
+private:
+    static void stepArmature(void *pContext, unsigned int uIndex);
+
+    std::vector<CCArmature*> m_obArmatures;
+    bool m_bFinishing;
+};
+
+static CCArmatureUpdater *s_pSharedUpdater = NULL;
+
+CCArmatureUpdater* CCArmatureUpdater::sharedUpdater()
+{
+    if (! s_pSharedUpdater)
+    {
+        s_pSharedUpdater = new CCArmatureUpdater();
+        // run after every other target of each tick. Scheduled once: scheduling it from an armature's
+        // update would append it to the list the scheduler is walking, and it would miss some ticks
+        CCDirector::sharedDirector()->getScheduler()->scheduleUpdateForTarget(s_pSharedUpdater, INT_MAX, false);
+        CCNotificationCenter::sharedNotificationCenter()->addObserver(s_pSharedUpdater, callfuncO_selector(CCArmatureUpdater::directorWillPurge), EVENT_DIRECTOR_PURGE, NULL);
+    }
+    return s_pSharedUpdater;
+}
+
+void CCArmatureUpdater::purgeSharedUpdater()
+{
+    if (s_pSharedUpdater)
+    {
+        // update what is still pending, so that no armature is left retained
+        s_pSharedUpdater->update(0);
+        CCDirector::sharedDirector()->getScheduler()->unscheduleUpdateForTarget(s_pSharedUpdater);
+        CCNotificationCenter::sharedNotificationCenter()->removeObserver(s_pSharedUpdater, EVENT_DIRECTOR_PURGE);
+        CC_SAFE_RELEASE_NULL(s_pSharedUpdater);
+    }
+}
+
+void CCArmatureUpdater::directorWillPurge(CCObject *pObject)
+{
+    CC_UNUSED_PARAM(pObject);
+    purgeSharedUpdater();
+}
+
+bool CCArmatureUpdater::isFinishing()
+{
+    return s_pSharedUpdater && s_pSharedUpdater->m_bFinishing;
+}
+
+void CCArmatureUpdater::addArmature(CCArmature *armature, float dt)
+{
+    if (armature->m_bPendingParallelUpdate)
+    {
+        armature->m_fPendingDelta += dt;
+        return;
+    }
+
+    armature->retain();
+    armature->m_bPendingParallelUpdate = true;
+    armature->m_fPendingDelta = dt;
+    m_obArmatures.push_back(armature);
+}
+
+void CCArmatureUpdater::stepArmature(void *pContext, unsigned int uIndex)
+{
+    CCArmature *armature = ((CCArmatureUpdater*)pContext)->m_obArmatures[uIndex];
+    armature->m_pAnimation->advance(armature->m_fPendingDelta);
+    armature->updateBoneTransforms();
+}
+
+void CCArmatureUpdater::update(float dt)
+{
+    CC_UNUSED_PARAM(dt);
+
+    if (m_obArmatures.empty())
+    {
+        return;
+    }
+
+    CCJobPool::sharedJobPool()->dispatchApply((unsigned int)m_obArmatures.size(), &CCArmatureUpdater::stepArmature, this);
+
+    // armatures updated by the events are updated right away,
+    // armatures updated after this tick are animated on the next one
+    std::vector<CCArmature*> armatures;
+    armatures.swap(m_obArmatures);
+    m_bFinishing = true;
+    for (unsigned int i = 0; i < armatures.size(); ++i)
+    {
+        CCArmature *armature = armatures[i];
+        float delta = armature->m_fPendingDelta;
+        armature->m_bPendingParallelUpdate = false;
+        armature->m_fPendingDelta = 0;
+
+        armature->m_pAnimation->finishAdvance();
+        armature->updateBoneDisplays(delta);
+        armature->m_bArmatureTransformDirty = false;
+        armature->release();
+    }
+    m_bFinishing = false;
+}
+
+void CCArmature::setParallelUpdateEnabled(bool bEnabled)
+{
+    if (s_bParallelUpdateEnabled && ! bEnabled)
+    {
+        CCArmatureUpdater::purgeSharedUpdater();
+    }
+    else if (! s_bParallelUpdateEnabled && bEnabled)
+    {
+        // schedule the updater before the armatures get updated
+        CCArmatureUpdater::sharedUpdater();
+    }
+    s_bParallelUpdateEnabled = bEnabled;
+}
+
+bool CCArmature::isParallelUpdateEnabled()
+{
+    return s_bParallelUpdateEnabled;
+}
+
 void CCArmature::update(float dt)
 {
+    if (s_bParallelUpdateEnabled && m_pParentBone == NULL && !CCArmatureUpdater::isFinishing())
+    {
+        CCArmatureUpdater::sharedUpdater()->addArmature(this, dt);
+        return;
+    }
+
     m_pAnimation->update(dt);
 
+    updateBones(dt);
+
+    m_bArmatureTransformDirty = false;
+}
+
+void CCArmature::sortBones()
+{
+    m_sortedBones.clear();
+    m_boneParentIndices.clear();
+
     CCObject *object = NULL;
     CCARRAY_FOREACH(m_pTopBoneList, object)
     {
-        ((CCBone *)object)->update(dt);
+        sortBone((CCBone *)object, -1);
     }
 
-    m_bArmatureTransformDirty = false;
+    // starts from the transforms the bones have now
+    unsigned int count = m_sortedBones.size();
+    m_boneDirtyFlags.resize(count);
+    m_tBoneTransforms.resize(count);
+    CCBoneTransformArrays &t = m_tBoneTransforms;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        CCBone *bone = m_sortedBones[i];
+        const CCBaseData *info = bone->m_tWorldInfo;
+        const CCAffineTransform &matrix = bone->m_tWorldTransform;
+        t.x[i] = info->x;
+        t.y[i] = info->y;
+        t.scaleX[i] = info->scaleX;
+        t.scaleY[i] = info->scaleY;
+        t.skewX[i] = info->skewX;
+        t.skewY[i] = info->skewY;
+        t.a[i] = matrix.a;
+        t.b[i] = matrix.b;
+        t.c[i] = matrix.c;
+        t.d[i] = matrix.d;
+        t.tx[i] = matrix.tx;
+        t.ty[i] = matrix.ty;
+    }
+
+    m_bBoneOrderDirty = false;
+}
+
+void CCArmature::sortBone(CCBone *bone, int parentIndex)
+{
+    int index = m_sortedBones.size();
+    m_sortedBones.push_back(bone);
+    m_boneParentIndices.push_back(parentIndex);
+
+    CCObject *object = NULL;
+    CCARRAY_FOREACH(bone->getChildren(), object)
+    {
+        sortBone((CCBone *)object, index);
+    }
+}
+
+void CCArmature::updateBones(float dt)
+{
+    updateBoneTransforms();
+    updateBoneDisplays(dt);
+}
+
+void CCArmature::updateBoneTransforms()
+{
+    if (m_bBoneOrderDirty || m_sortedBones.size() != m_pBoneDic->count())
+    {
+        sortBones();
+    }
+
+    int count = m_sortedBones.size();
+    CCBoneTransformArrays &t = m_tBoneTransforms;
+    m_dirtyBoneIndices.clear();
+
+    // Same steps as CCBone::update, split so that each one runs over all the bones.
+    // A parent comes before its children, a bone that didn't move keeps last frame's values.
+
+    // dirty flags, then position, scale and skew: the position is still relative to the parent
+    for (int i = 0; i < count; ++i)
+    {
+        CCBone *bone = m_sortedBones[i];
+        int parent = m_boneParentIndices[i];
+        CCBone *armatureParentBone = bone->m_pArmatureParentBone;
+
+        bool dirty = bone->m_bBoneTransformDirty || (parent >= 0 && m_boneDirtyFlags[parent]);
+        if (armatureParentBone && !dirty)
+        {
+            dirty = armatureParentBone->isTransformDirty();
+        }
+        // nested armatures look at the flag of their parent bone
+        bone->m_bBoneTransformDirty = dirty;
+        m_boneDirtyFlags[i] = dirty;
+        if (!dirty)
+        {
+            continue;
+        }
+        m_dirtyBoneIndices.push_back(i);
+
+        CCFrameData *tweenData = bone->m_pTweenData;
+        if (bone->m_fDataVersion >= VERSION_COMBINED)
+        {
+            CCTransformHelp::nodeConcat(*tweenData, *bone->m_pBoneData);
+            tweenData->scaleX -= 1;
+            tweenData->scaleY -= 1;
+        }
+
+        t.x[i] = tweenData->x + bone->m_obPosition.x;
+        t.y[i] = tweenData->y + bone->m_obPosition.y;
+        t.scaleX[i] = tweenData->scaleX * bone->m_fScaleX;
+        t.scaleY[i] = tweenData->scaleY * bone->m_fScaleY;
+        t.skewX[i] = tweenData->skewX + bone->m_fSkewX + bone->m_fRotationX;
+        t.skewY[i] = tweenData->skewY + bone->m_fSkewY - bone->m_fRotationY;
+
+        if (parent >= 0)
+        {
+            t.scaleX[i] *= t.scaleX[parent];
+            t.scaleY[i] *= t.scaleY[parent];
+            t.skewX[i] += t.skewX[parent];
+            t.skewY[i] += t.skewY[parent];
+        }
+        else if (armatureParentBone)
+        {
+            const CCBaseData *parentInfo = armatureParentBone->m_tWorldInfo;
+            t.scaleX[i] *= parentInfo->scaleX;
+            t.scaleY[i] *= parentInfo->scaleY;
+            t.skewX[i] += parentInfo->skewX;
+            t.skewY[i] += parentInfo->skewY;
+        }
+    }
+
+    int dirtyCount = m_dirtyBoneIndices.size();
+    if (dirtyCount > 0)
+    {
+        // sines and cosines of both skews of all the dirty bones in one call
+        m_boneAngles.resize(dirtyCount * 2);
+        m_boneSines.resize(dirtyCount * 2);
+        m_boneCosines.resize(dirtyCount * 2);
+        for (int k = 0; k < dirtyCount; ++k)
+        {
+            int i = m_dirtyBoneIndices[k];
+            m_boneAngles[k] = t.skewX[i];
+            m_boneAngles[dirtyCount + k] = t.skewY[i];
+        }
+        sinCosArray(&m_boneAngles[0], &m_boneSines[0], &m_boneCosines[0], dirtyCount * 2);
+
+        // the matrices, as CCTransformHelp::nodeToMatrix
+        for (int k = 0; k < dirtyCount; ++k)
+        {
+            int i = m_dirtyBoneIndices[k];
+            t.a[i] = t.scaleX[i] * m_boneCosines[dirtyCount + k];
+            t.b[i] = t.scaleX[i] * m_boneSines[dirtyCount + k];
+            t.c[i] = t.scaleY[i] * m_boneSines[k];
+            t.d[i] = t.scaleY[i] * m_boneCosines[k];
+        }
+
+        // the positions, which need the final matrix of the parent
+        bool armatureTransformKnown = false;
+        CCAffineTransform armatureTransform;
+        for (int k = 0; k < dirtyCount; ++k)
+        {
+            int i = m_dirtyBoneIndices[k];
+            int parent = m_boneParentIndices[i];
+            CCBone *bone = m_sortedBones[i];
+            CCBone *armatureParentBone = bone->m_pArmatureParentBone;
+
+            float x = t.x[i];
+            float y = t.y[i];
+            if (parent >= 0)
+            {
+                t.x[i] = x * t.a[parent] + y * t.c[parent] + t.x[parent];
+                t.y[i] = x * t.b[parent] + y * t.d[parent] + t.y[parent];
+            }
+            else if (armatureParentBone)
+            {
+                const CCAffineTransform &parentMatrix = armatureParentBone->m_tWorldTransform;
+                t.x[i] = x * parentMatrix.a + y * parentMatrix.c + armatureParentBone->m_tWorldInfo->x;
+                t.y[i] = x * parentMatrix.b + y * parentMatrix.d + armatureParentBone->m_tWorldInfo->y;
+            }
+            t.tx[i] = t.x[i];
+            t.ty[i] = t.y[i];
+
+            if (armatureParentBone)
+            {
+                if (!armatureTransformKnown)
+                {
+                    armatureTransform = bone->m_pArmature->nodeToParentTransform();
+                    armatureTransformKnown = true;
+                }
+                CCAffineTransform matrix = CCAffineTransformConcat(
+                    CCAffineTransformMake(t.a[i], t.b[i], t.c[i], t.d[i], t.tx[i], t.ty[i]), armatureTransform);
+                t.a[i] = matrix.a;
+                t.b[i] = matrix.b;
+                t.c[i] = matrix.c;
+                t.d[i] = matrix.d;
+                t.tx[i] = matrix.tx;
+                t.ty[i] = matrix.ty;
+            }
+
+            CCBaseData *info = bone->m_tWorldInfo;
+            info->x = t.x[i];
+            info->y = t.y[i];
+            info->scaleX = t.scaleX[i];
+            info->scaleY = t.scaleY[i];
+            info->skewX = t.skewX[i];
+            info->skewY = t.skewY[i];
+            bone->m_tWorldTransform = CCAffineTransformMake(t.a[i], t.b[i], t.c[i], t.d[i], t.tx[i], t.ty[i]);
+        }
+    }
+
+}
+
+void CCArmature::updateBoneDisplays(float dt)
+{
+    int count = m_sortedBones.size();
+
+    // the displays of all the bones, in the order CCBone::update visits them
+    for (int i = 0; i < count; ++i)
+    {
+        CCBone *bone = m_sortedBones[i];
+        CCDisplayFactory::updateDisplay(bone, dt, m_boneDirtyFlags[i] || m_bArmatureTransformDirty);
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        m_sortedBones[i]->m_bBoneTransformDirty = false;
+    }
 }
 
 void CCArmature::draw()
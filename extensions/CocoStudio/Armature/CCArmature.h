@@ -35,6 +35,25 @@ class b2Body;
 struct cpBody;
 
 NS_CC_EXT_BEGIN
+
+class CCArmatureUpdater;
+
+/**
+ *  @brief The transforms of the bones of an armature, one array per component,
+ *  indexed like the bones in update order. Kept between frames for the bones that don't move.
+ *  @js NA
+ *  @lua NA
+ */
+struct CCBoneTransformArrays
+{
+    //! Position, scale and skew in armature space, like CCBone::getWorldInfo()
+    std::vector<float> x, y, scaleX, scaleY, skewX, skewY;
+    //! Matrix, like CCBone::nodeToArmatureTransform()
+    std::vector<float> a, b, c, d, tx, ty;
+
+    void resize(unsigned int size);
+};
+
 /**
  *  @lua NA
  */
@@ -145,6 +164,27 @@ public:
         return m_sBlendFunc;
     }
 
+    /**
+     * The bones are updated in a list sorted once, where every bone comes after its parent.
+     * Bones added, removed or moved through CCArmature or CCBone resort it. Call this after
+     * changing the bone hierarchy in another way.
+     * @since v2.2
+     */
+    inline void setBoneOrderDirty() { m_bBoneOrderDirty = true; }
+
+    /**
+     * Enables or disables the parallel update of armatures.
+     * When enabled, the armatures updated during a scheduler tick are animated in parallel
+     * on the CCJobPool at the end of the tick: their tweens and bone transforms are computed
+     * on the worker threads. Then, on the main thread and in the order the armatures were
+     * updated, key frames change displays, movement and frame events are dispatched and
+     * the displays and quads are updated. Armatures displayed by a bone are still updated
+     * by their parent. Disabled by default.
+     * @since v2.2
+     */
+    static void setParallelUpdateEnabled(bool bEnabled);
+    static bool isParallelUpdateEnabled();
+
     virtual void setAnimation(CCArmatureAnimation *animation);
     virtual CCArmatureAnimation *getAnimation();
 
@@ -176,6 +216,19 @@ protected:
      */
     CCBone *createBone(const char *boneName );
 
+    //! Rebuilds m_sortedBones, depth first from the top bones
+    void sortBones();
+    void sortBone(CCBone *bone, int parentIndex);
+
+    //! Updates the transforms of the bones which, or which parent, changed, then their displays
+    void updateBones(float dt);
+    //! The transforms part of updateBones, which doesn't change any node but the bones
+    void updateBoneTransforms();
+    //! The displays part of updateBones
+    void updateBoneDisplays(float dt);
+
+    friend class CCArmatureUpdater;
+
     CC_SYNTHESIZE(CCArmatureData *, m_pArmatureData, ArmatureData);
 
     CC_SYNTHESIZE(CCBatchNode *, m_pBatchNode, BatchNode);
@@ -204,6 +257,24 @@ protected:
 
     CCDictionary *m_pTextureAtlasDic;
 
+    //! All the bones, parents first. Weak references: the bones are retained by m_pBoneDic
+    std::vector<CCBone *> m_sortedBones;
+    //! Index of the parent of each bone in m_sortedBones, -1 for the top bones
+    std::vector<int> m_boneParentIndices;
+    std::vector<unsigned char> m_boneDirtyFlags;
+    std::vector<int> m_dirtyBoneIndices;
+    CCBoneTransformArrays m_tBoneTransforms;
+    //! Skews of the dirty bones and their sines and cosines, computed together
+    std::vector<float> m_boneAngles;
+    std::vector<float> m_boneSines;
+    std::vector<float> m_boneCosines;
+    bool m_bBoneOrderDirty;
+
+    //! true while the armature waits for the parallel updater, see setParallelUpdateEnabled()
+    bool m_bPendingParallelUpdate;
+    //! time accumulated while waiting for the parallel updater
+    float m_fPendingDelta;
+
 #if ENABLE_PHYSICS_BOX2D_DETECT
     CC_PROPERTY(b2Body *, m_pBody, Body);
 #elif ENABLE_PHYSICS_CHIPMUNK_DETECT
@@ -313,6 +313,11 @@ void CCBone::addChildBone(CCBone *child)
     {
         m_pChildren->addObject(child);
         child->setParentBone(this);
+
+        if (m_pArmature)
+        {
+            m_pArmature->setBoneOrderDirty();
+        }
     }
 }
 
@@ -336,6 +341,12 @@ void CCBone::removeChildBone(CCBone *bone, bool recursion)
         bone->getDisplayManager()->setCurrentDecorativeDisplay(NULL);
 
         m_pChildren->removeObject(bone);
+        invalidateChildIndices(0);
+
+        if (m_pArmature)
+        {
+            m_pArmature->setBoneOrderDirty();
+        }
     }
 }
 
@@ -39,6 +39,8 @@ class CCArmature;
  */
 class CC_EX_DLL CCBone : public CCNodeRGBA
 {
+    //! CCArmature updates the transforms of all its bones in one pass
+    friend class CCArmature;
 public:
     /**
      * Allocates and initializes a bone.
@@ -135,6 +137,12 @@ public:
      */
     void removeChildBone(CCBone *bone, bool recursion);
 
+    /**
+     * Updates the transform and the display of a bone which isn't in an armature.
+     * The bones of a CCArmature are updated together by the armature, which computes their
+     * transforms without calling this function: overriding it in a CCBone subclass has no
+     * effect on the bones of an armature.
+     */
     void update(float delta);
 
     void updateDisplayedColor(const ccColor3B &parentColor);
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "../utils/CCArmatureDefine.h"
 #include "../utils/CCUtilMath.h"
 #include "../datas/CCDatas.h"
+#include "../utils/CCArmatureDataManager.h"
 
 
 NS_CC_EXT_BEGIN
@@ -49,6 +50,7 @@ CCArmatureAnimation::CCArmatureAnimation()
     : m_pAnimationData(NULL)
     , m_fSpeedScale(1)
     , m_pMovementData(NULL)
+    , m_pBakedMovementData(NULL)
     , m_pArmature(NULL)
     , m_strMovementID("")
     , m_iToIndex(0)
@@ -58,6 +60,8 @@ CCArmatureAnimation::CCArmatureAnimation()
     , m_bMovementListLoop(false)
     , m_iMovementListDurationTo(-1)
     , m_pUserObject(NULL)
+    , m_bDeferNodeChanges(false)
+    , m_bMovementListPending(false)
 
     , m_sMovementEventCallFunc(NULL)
     , m_sFrameEventCallFunc(NULL)
@@ -71,6 +75,7 @@ CCArmatureAnimation::~CCArmatureAnimation(void)
 {
     CC_SAFE_RELEASE_NULL(m_pTweenList);
     CC_SAFE_RELEASE_NULL(m_pAnimationData);
+    CC_SAFE_RELEASE_NULL(m_pBakedMovementData);
 
     CC_SAFE_RELEASE_NULL(m_pUserObject);
 }
@@ -191,6 +196,11 @@ void CCArmatureAnimation::play(const char *animationName, int durationTo, int du
 
     m_bOnMovementList = false;
 
+    // what the previous movement queued while it was advanced doesn't apply anymore
+    m_sDeferredKeyFrames.clear();
+    m_sDeferredColors.clear();
+    m_bMovementListPending = false;
+
     CCProcessBase::play(durationTo, durationTween, loop, tweenEasing);
 
 
@@ -211,6 +221,11 @@ void CCArmatureAnimation::play(const char *animationName, int durationTo, int du
         m_iDurationTween = durationTween;
     }
 
+    CCBakedMovementData *bakedMovementData = CCArmatureDataManager::sharedArmatureDataManager()->getBakedMovementData(m_pAnimationData->name.c_str(), m_pMovementData, tweenEasing);
+    CC_SAFE_RETAIN(bakedMovementData);
+    CC_SAFE_RELEASE(m_pBakedMovementData);
+    m_pBakedMovementData = bakedMovementData;
+
     CCMovementBoneData *movementBoneData = NULL;
     m_pTweenList->removeAllObjects();
 
@@ -228,6 +243,7 @@ void CCArmatureAnimation::play(const char *animationName, int durationTo, int du
             m_pTweenList->addObject(tween);
             movementBoneData->duration = m_pMovementData->duration;
             tween->play(movementBoneData, durationTo, durationTween, loop, tweenEasing);
+            tween->setBakedFrames(m_pBakedMovementData ? m_pBakedMovementData->getBoneFrames(bone->getName().c_str()) : NULL);
 
             tween->setProcessScale(m_fProcessScale);
 
@@ -363,6 +379,12 @@ int CCArmatureAnimation::getMovementCount()
 }
 
 void CCArmatureAnimation::update(float dt)
+{
+    updateTweens(dt);
+    dispatchEvents();
+}
+
+void CCArmatureAnimation::updateTweens(float dt)
 {
     CCProcessBase::update(dt);
     CCObject *object = NULL;
@@ -370,7 +392,51 @@ void CCArmatureAnimation::update(float dt)
     {
         ((CCTween *)object)->update(dt);
     }
+}
+
+void CCArmatureAnimation::advance(float dt)
+{
+    m_bDeferNodeChanges = true;
+    updateTweens(dt);
+    m_bDeferNodeChanges = false;
+}
 
+void CCArmatureAnimation::finishAdvance()
+{
+    // a movement played meanwhile already cleared what its tweens queued
+    for (unsigned int i = 0; i < m_sDeferredKeyFrames.size(); ++i)
+    {
+        m_sDeferredKeyFrames[i].first->arriveKeyFrame(m_sDeferredKeyFrames[i].second);
+    }
+    m_sDeferredKeyFrames.clear();
+
+    for (unsigned int i = 0; i < m_sDeferredColors.size(); ++i)
+    {
+        m_sDeferredColors[i]->m_pBone->updateColor();
+    }
+    m_sDeferredColors.clear();
+
+    if (m_bMovementListPending)
+    {
+        m_bMovementListPending = false;
+        updateMovementList();
+    }
+
+    dispatchEvents();
+}
+
+void CCArmatureAnimation::deferKeyFrame(CCTween *tween, CCFrameData *keyFrameData)
+{
+    m_sDeferredKeyFrames.push_back(std::make_pair(tween, keyFrameData));
+}
+
+void CCArmatureAnimation::deferColor(CCTween *tween)
+{
+    m_sDeferredColors.push_back(tween);
+}
+
+void CCArmatureAnimation::dispatchEvents()
+{
     while (m_sFrameEventQueue.size() > 0)
     {
         CCFrameEvent *event = m_sFrameEventQueue.front();
@@ -434,7 +500,14 @@ void CCArmatureAnimation::updateHandler()
                 movementEvent(m_pArmature, COMPLETE, m_strMovementID.c_str());
             }
 
-            updateMovementList();
+            if (m_bDeferNodeChanges)
+            {
+                m_bMovementListPending = true;
+            }
+            else
+            {
+                updateMovementList();
+            }
         }
         break;
         case ANIMATION_TO_LOOP_FRONT:
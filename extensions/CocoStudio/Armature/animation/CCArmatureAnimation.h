@@ -42,6 +42,7 @@ enum MovementEventType
 
 class CCArmature;
 class CCBone;
+class CCTween;
 
 typedef void (CCObject::*SEL_MovementEventCallFunc)(CCArmature *, MovementEventType, const char *);
 typedef void (CCObject::*SEL_FrameEventCallFunc)(CCBone *, const char *, int, int);
@@ -265,7 +266,27 @@ protected:
 
     inline bool isIgnoreFrameEvent() { return m_bIgnoreFrameEvent; }
 
+    //! Updates the animation and its tweens, without dispatching the events
+    void updateTweens(float dt);
+
+    //! Calls the frame and movement event listeners with the queued events
+    void dispatchEvents();
+
+    /**
+     * Like update(), but from a worker thread: the work which changes nodes is queued
+     * until finishAdvance() is called on the main thread
+     * @js NA
+     */
+    void advance(float dt);
+    void finishAdvance();
+
+    //! While advancing, the tweens queue their key frames and colors instead of applying them
+    inline bool isDeferringNodeChanges() { return m_bDeferNodeChanges; }
+    void deferKeyFrame(CCTween *tween, CCFrameData *keyFrameData);
+    void deferColor(CCTween *tween);
+
     friend class CCTween;
+    friend class CCArmatureUpdater;
 protected:
     //! CCAnimationData save all MovementDatas this animation used.
     CC_SYNTHESIZE_RETAIN(CCAnimationData *, m_pAnimationData, AnimationData);
@@ -275,6 +296,8 @@ protected:
 
     CCMovementData *m_pMovementData;            //! CCMovementData save all MovementFrameDatas this animation used.
 
+    CCBakedMovementData *m_pBakedMovementData;  //! The samples of m_pMovementData when animation is baked, retained
+
     CCArmature *m_pArmature;                    //! A weak reference of armature
 
     std::string m_strMovementID;                //! Current movment's name
@@ -296,6 +319,12 @@ protected:
 	int m_iMovementListDurationTo;
 
     CCObject *m_pUserObject;
+
+    bool m_bDeferNodeChanges;
+    bool m_bMovementListPending;
+    //! Key frames and colors queued by advance(), in the order the tweens reached them
+    std::vector<std::pair<CCTween *, CCFrameData *> > m_sDeferredKeyFrames;
+    std::vector<CCTween *> m_sDeferredColors;
 protected:
     /**
      * MovementEvent CallFunc.
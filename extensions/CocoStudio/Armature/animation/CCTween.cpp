@@ -62,6 +62,7 @@ CCTween::CCTween()
     , m_iToIndex(0)
     , m_pAnimation(NULL)
     , m_bPassLastFrame(false)
+    , m_pBakedFrames(NULL)
 {
 
 }
@@ -112,6 +113,7 @@ void CCTween::play(CCMovementBoneData *movementBoneData, int durationTo, int dur
     m_iTotalDuration = 0;
     m_iBetweenDuration = 0;
     m_iFromIndex = m_iToIndex = 0;
+    m_pBakedFrames = NULL;
 
     bool difMovement = movementBoneData != m_pMovementBoneData;
 
@@ -282,6 +284,11 @@ void CCTween::updateHandler()
 
     if (m_eLoopType > ANIMATION_TO_LOOP_BACK)
     {
+        if (m_pBakedFrames)
+        {
+            updateBakedFrame(percent);
+            return;
+        }
         percent = updateFrameData(percent);
     }
 
@@ -325,6 +332,13 @@ void CCTween::setBetween(CCFrameData *from, CCFrameData *to, bool limit)
 
 void CCTween::arriveKeyFrame(CCFrameData *keyFrameData)
 {
+    if (keyFrameData && m_pAnimation && m_pAnimation->isDeferringNodeChanges())
+    {
+        //! Displays and child armatures are changed on the main thread
+        m_pAnimation->deferKeyFrame(this, keyFrameData);
+        return;
+    }
+
     if(keyFrameData)
     {
         CCDisplayManager *displayManager = m_pBone->getDisplayManager();
@@ -388,6 +402,74 @@ void CCTween::tweenColorTo(float percent, CCFrameData *node)
     node->r = m_pFrom->r + percent * m_pBetween->r;
     node->g = m_pFrom->g + percent * m_pBetween->g;
     node->b = m_pFrom->b + percent * m_pBetween->b;
+    updateBoneColor();
+}
+
+void CCTween::updateBakedFrame(float currentPercent)
+{
+    if (currentPercent > 1 && m_pMovementBoneData->delay != 0)
+    {
+        currentPercent = fmodf(currentPercent, 1);
+    }
+
+    float playedTime = (float)(m_iRawDuration - 1) * currentPercent;
+
+    //! Key frames still change the display, the z order and fire frame events
+    if (playedTime < m_iTotalDuration || playedTime >= m_iTotalDuration + m_iBetweenDuration)
+    {
+        updateFrameData(currentPercent);
+    }
+
+    if (m_eFrameTweenEasing == TWEEN_EASING_MAX)
+    {
+        return;
+    }
+
+    const CCBakedBoneFrames *frames = m_pBakedFrames;
+    float position = playedTime * frames->samplesPerFrame;
+    if (position < 0)
+    {
+        position = 0;
+    }
+
+    int index = (int)position;
+    if (index >= frames->sampleCount - 1)
+    {
+        index = frames->sampleCount - 1;
+        position = (float)index;
+    }
+    int nextIndex = index < frames->sampleCount - 1 ? index + 1 : index;
+    float percent = position - index;
+
+    const float *from = &frames->samples[index * frames->channelCount];
+    const float *to = &frames->samples[nextIndex * frames->channelCount];
+
+    m_pTweenData->x = from[0] + percent * (to[0] - from[0]);
+    m_pTweenData->y = from[1] + percent * (to[1] - from[1]);
+    m_pTweenData->scaleX = from[2] + percent * (to[2] - from[2]);
+    m_pTweenData->scaleY = from[3] + percent * (to[3] - from[3]);
+    m_pTweenData->skewX = from[4] + percent * (to[4] - from[4]);
+    m_pTweenData->skewY = from[5] + percent * (to[5] - from[5]);
+
+    m_pBone->setTransformDirty(true);
+
+    if (frames->hasColor && m_pBetween->isUseColorInfo)
+    {
+        m_pTweenData->a = from[6] + percent * (to[6] - from[6]);
+        m_pTweenData->r = from[7] + percent * (to[7] - from[7]);
+        m_pTweenData->g = from[8] + percent * (to[8] - from[8]);
+        m_pTweenData->b = from[9] + percent * (to[9] - from[9]);
+        updateBoneColor();
+    }
+}
+
+void CCTween::updateBoneColor()
+{
+    if (m_pAnimation && m_pAnimation->isDeferringNodeChanges())
+    {
+        m_pAnimation->deferColor(this);
+        return;
+    }
     m_pBone->updateColor();
 }
 
@@ -85,6 +85,12 @@ public:
 
     inline void setAnimation(CCArmatureAnimation *animation) { m_pAnimation = animation; }
     inline CCArmatureAnimation *getAnimation() const { return m_pAnimation; }
+
+    /**
+     * Plays the current movement from baked samples instead of tweening its key frames, NULL to tween them.
+     * The samples belong to a CCBakedMovementData retained by the CCArmatureAnimation.
+     */
+    inline void setBakedFrames(const CCBakedBoneFrames *frames) { m_pBakedFrames = frames; }
 protected:
 
     /**
@@ -97,6 +103,11 @@ protected:
      */
     virtual float updateFrameData(float currentPercent);
 
+    /**
+     * Like updateFrameData and tweenNodeTo, reading the bone's values from the baked samples
+     */
+    virtual void updateBakedFrame(float currentPercent);
+
     /**
      * Calculate the between value of _from and _to, and give it to between frame data
      */
@@ -112,6 +123,11 @@ protected:
      */
     virtual void tweenColorTo(float percent, CCFrameData *node);
 
+    /**
+     * Applies the tween color to the bone's display, later if the animation is advanced on a worker thread
+     */
+    virtual void updateBoneColor();
+
     /**
      * Update display index and process the key frame event when arrived a key frame
      */
@@ -140,6 +156,10 @@ protected:
     CCArmatureAnimation *m_pAnimation;
 
     bool m_bPassLastFrame;
+
+    const CCBakedBoneFrames *m_pBakedFrames;    //! Samples of the current movement when it is baked, a weak reference
+
+    friend class CCArmatureAnimation;
 };
 
 NS_CC_EXT_END
@@ -25,6 +25,7 @@ THE SOFTWARE.
 #include "CCDatas.h"
 #include "../utils/CCUtilMath.h"
 #include "../utils/CCTransformHelp.h"
+#include "../utils/CCTweenFunction.h"
 
 NS_CC_EXT_BEGIN
 
@@ -299,16 +300,62 @@ void CCFrameData::copy(const CCBaseData *node)
 	}
 }
 
+CCFrameDataBlock *CCFrameDataBlock::create(unsigned int count)
+{
+    CCFrameDataBlock *pBlock = new CCFrameDataBlock();
+    if (pBlock && pBlock->init(count))
+    {
+        pBlock->autorelease();
+        return pBlock;
+    }
+    CC_SAFE_DELETE(pBlock);
+    return NULL;
+}
+
+CCFrameDataBlock::CCFrameDataBlock()
+    : frames(NULL)
+    , count(0)
+{
+}
+
+CCFrameDataBlock::~CCFrameDataBlock(void)
+{
+    CC_SAFE_DELETE_ARRAY(frames);
+}
+
+bool CCFrameDataBlock::init(unsigned int count)
+{
+    CC_SAFE_DELETE_ARRAY(frames);
+    frames = count > 0 ? new CCFrameData[count] : NULL;
+    this->count = count;
+    return true;
+}
+
+
 CCMovementBoneData::CCMovementBoneData()
     : delay(0.0f)
     , scale(1.0f)
     , duration(0)
     , name("")
+    , frameDataBlock(NULL)
 {
 }
 
 CCMovementBoneData::~CCMovementBoneData(void)
 {
+    if (frameDataBlock)
+    {
+        // the frames have to be released before their block is deleted
+        frameList.removeAllObjects();
+        frameDataBlock->release();
+    }
+}
+
+void CCMovementBoneData::setFrameDataBlock(CCFrameDataBlock *block)
+{
+    CC_SAFE_RETAIN(block);
+    CC_SAFE_RELEASE(frameDataBlock);
+    frameDataBlock = block;
 }
 
 bool CCMovementBoneData::init()
@@ -380,6 +427,201 @@ int CCAnimationData::getMovementCount()
 }
 
 
+CCBakedMovementData *CCBakedMovementData::create(CCMovementData *movementData, int tweenEasing, float samplesPerFrame)
+{
+    CCBakedMovementData *pBakedMovementData = new CCBakedMovementData();
+    if (pBakedMovementData && pBakedMovementData->init(movementData, tweenEasing, samplesPerFrame))
+    {
+        pBakedMovementData->autorelease();
+        return pBakedMovementData;
+    }
+    CC_SAFE_DELETE(pBakedMovementData);
+    return NULL;
+}
+
+CCBakedMovementData::CCBakedMovementData(void)
+    : movementData(NULL)
+    , tweenEasing(Linear)
+    , samplesPerFrame(1)
+{
+}
+
+CCBakedMovementData::~CCBakedMovementData(void)
+{
+    CC_SAFE_RELEASE_NULL(movementData);
+}
+
+static int bakedSampleCount(CCMovementData *movementData, float samplesPerFrame)
+{
+    // the played time goes from 0 to duration - 1, the last sample is at or after it
+    int lastFrame = movementData->duration > 1 ? movementData->duration - 1 : 0;
+    return (int)ceilf(lastFrame * samplesPerFrame) + 1;
+}
+
+static bool movementBoneDataUsesColor(CCMovementBoneData *movementBoneData)
+{
+    CCArray *frameList = &movementBoneData->frameList;
+    CCObject *object = NULL;
+    CCARRAY_FOREACH(frameList, object)
+    {
+        if (static_cast<CCFrameData *>(object)->isUseColorInfo)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Computes what CCTween gives the bone at playedTime, once the movement plays:
+ * the key frames around playedTime, CCTween::setBetween, the easing of CCTween::updateFrameData
+ * and CCTween::tweenNodeTo.
+ */
+static void sampleMovementBoneData(CCMovementBoneData *movementBoneData, int tweenEasing, float playedTime, float *sample, bool hasColor)
+{
+    int length = movementBoneData->frameList.count();
+    CCFrameData **frames = (CCFrameData **)movementBoneData->frameList.data->arr;
+
+    CCFrameData *from = frames[0];
+    CCFrameData *to = frames[0];
+    float percent = 0;
+
+    if (playedTime >= frames[length - 1]->frameID)
+    {
+        from = to = frames[length - 1];
+    }
+    else if (playedTime >= frames[0]->frameID)
+    {
+        int index = 0;
+        while (index + 1 < length && frames[index + 1]->frameID <= playedTime)
+        {
+            ++index;
+        }
+        from = frames[index];
+        to = frames[index + 1];
+
+        int betweenDuration = to->frameID - from->frameID;
+        percent = betweenDuration == 0 ? 0 : (playedTime - from->frameID) / betweenDuration;
+    }
+
+    // a hidden key frame doesn't move the bone, but keeps the tweenRotate of the frame tweened to
+    CCFrameData *start = from;
+    CCBaseData between;
+    if (from->displayIndex < 0 && to->displayIndex >= 0)
+    {
+        start = to;
+        between.subtract(to, to, false);
+    }
+    else if (to->displayIndex < 0 && from->displayIndex >= 0)
+    {
+        between.subtract(to, to, false);
+    }
+    else
+    {
+        between.subtract(from, to, false);
+    }
+
+    CCTweenType frameTweenEasing = from->tweenEasing;
+    CCTweenType tweenType = (frameTweenEasing != Linear) ? frameTweenEasing : (CCTweenType)tweenEasing;
+    if (from == to || frameTweenEasing == TWEEN_EASING_MAX || !start->isTween)
+    {
+        percent = 0;
+    }
+    else if (tweenType != TWEEN_EASING_MAX && tweenType != Linear)
+    {
+        percent = CCTweenFunction::tweenTo(percent, tweenType, start->easingParams);
+    }
+
+    sample[0] = start->x + percent * between.x;
+    sample[1] = start->y + percent * between.y;
+    sample[2] = start->scaleX + percent * between.scaleX;
+    sample[3] = start->scaleY + percent * between.scaleY;
+    sample[4] = start->skewX + percent * between.skewX;
+    sample[5] = start->skewY + percent * between.skewY;
+    if (hasColor)
+    {
+        sample[6] = start->a + percent * between.a;
+        sample[7] = start->r + percent * between.r;
+        sample[8] = start->g + percent * between.g;
+        sample[9] = start->b + percent * between.b;
+    }
+}
+
+bool CCBakedMovementData::init(CCMovementData *movementData, int tweenEasing, float samplesPerFrame)
+{
+    CCAssert(movementData && samplesPerFrame > 0, "CCBakedMovementData: invalid movement data or sample rate");
+
+    CC_SAFE_RETAIN(movementData);
+    CC_SAFE_RELEASE(this->movementData);
+    this->movementData = movementData;
+    this->tweenEasing = tweenEasing;
+    this->samplesPerFrame = samplesPerFrame;
+    boneFrames.clear();
+
+    int sampleCount = bakedSampleCount(movementData, samplesPerFrame);
+
+    CCDictionary *movBoneDataDic = &movementData->movBoneDataDic;
+    CCDictElement *element = NULL;
+    CCDICT_FOREACH(movBoneDataDic, element)
+    {
+        CCMovementBoneData *movementBoneData = static_cast<CCMovementBoneData *>(element->getObject());
+        if (movementBoneData->frameList.count() == 0)
+        {
+            continue;
+        }
+
+        CCBakedBoneFrames &frames = boneFrames[element->getStrKey()];
+        frames.samplesPerFrame = samplesPerFrame;
+        frames.sampleCount = sampleCount;
+        frames.hasColor = movementBoneDataUsesColor(movementBoneData);
+        frames.channelCount = frames.hasColor ? 10 : 6;
+        frames.samples.resize(sampleCount * frames.channelCount);
+
+        for (int i = 0; i < sampleCount; ++i)
+        {
+            sampleMovementBoneData(movementBoneData, tweenEasing, i / samplesPerFrame, &frames.samples[i * frames.channelCount], frames.hasColor);
+        }
+    }
+
+    return true;
+}
+
+const CCBakedBoneFrames *CCBakedMovementData::getBoneFrames(const char *boneName) const
+{
+    std::map<std::string, CCBakedBoneFrames>::const_iterator it = boneFrames.find(boneName);
+    return it != boneFrames.end() ? &it->second : NULL;
+}
+
+unsigned int CCBakedMovementData::getMemorySize() const
+{
+    unsigned int size = 0;
+    std::map<std::string, CCBakedBoneFrames>::const_iterator it;
+    for (it = boneFrames.begin(); it != boneFrames.end(); ++it)
+    {
+        size += it->second.samples.size() * sizeof(float);
+    }
+    return size;
+}
+
+unsigned int CCBakedMovementData::memorySizeFor(CCMovementData *movementData, float samplesPerFrame)
+{
+    unsigned int sampleCount = bakedSampleCount(movementData, samplesPerFrame);
+    unsigned int size = 0;
+
+    CCDictionary *movBoneDataDic = &movementData->movBoneDataDic;
+    CCDictElement *element = NULL;
+    CCDICT_FOREACH(movBoneDataDic, element)
+    {
+        CCMovementBoneData *movementBoneData = static_cast<CCMovementBoneData *>(element->getObject());
+        if (movementBoneData->frameList.count() > 0)
+        {
+            size += sampleCount * (movementBoneDataUsesColor(movementBoneData) ? 10 : 6) * sizeof(float);
+        }
+    }
+    return size;
+}
+
+
 
 CCContourData::CCContourData()
 {
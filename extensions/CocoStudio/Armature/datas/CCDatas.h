@@ -301,6 +301,26 @@ public:
     std::string strSoundEffect;
 };
 
+/**
+*  CCFrameDataBlock owns CCFrameData allocated in one array, shared by the CCMovementBoneData which hold them.
+*  The frames are only released by their frame lists, and are deleted together with the block.
+*  @js NA
+*  @lua NA
+*/
+class  CC_EX_DLL CCFrameDataBlock : public CCObject
+{
+public:
+    static CCFrameDataBlock *create(unsigned int count);
+public:
+    CCFrameDataBlock();
+    ~CCFrameDataBlock(void);
+
+    virtual bool init(unsigned int count);
+public:
+    CCFrameData *frames;
+    unsigned int count;
+};
+
 /**
 * @js NA
 * @lua NA
@@ -317,6 +337,11 @@ public:
 
     void addFrameData(CCFrameData *frameData);
     CCFrameData *getFrameData(int index);
+
+    /**
+     * Keeps the block of the frames in frameList alive as long as this data
+     */
+    void setFrameDataBlock(CCFrameDataBlock *block);
 public:
     float delay;             //! movement delay percent, this value can produce a delay effect
     float scale;             //! scale this movement
@@ -324,6 +349,8 @@ public:
     std::string name;    //! bone name
 
     CCArray frameList;
+
+    CCFrameDataBlock *frameDataBlock;    //! The block the frames are allocated in, or NULL
 };
 
 /**
@@ -402,6 +429,58 @@ public:
     std::vector<std::string> movementNames;
 };
 
+/**
+*  The tween data of a bone over a whole movement, sampled at a fixed rate.
+*  Each sample is x, y, scaleX, scaleY, skewX, skewY, then a, r, g, b when hasColor is true.
+*  @js NA
+*  @lua NA
+*/
+struct CC_EX_DLL CCBakedBoneFrames
+{
+    float samplesPerFrame;
+    int sampleCount;
+    int channelCount;
+    bool hasColor;
+    std::vector<float> samples;
+};
+
+/**
+*  CCBakedMovementData is a CCMovementData whose key frames were interpolated once, for every bone,
+*  at a fixed rate. Armatures playing the movement read the samples instead of tweening.
+*  It is made and shared by CCArmatureDataManager, see CCArmatureDataManager::setBakedAnimationEnabled.
+*  @js NA
+*  @lua NA
+*/
+class  CC_EX_DLL CCBakedMovementData : public CCObject
+{
+public:
+    /**
+     * @param tweenEasing the easing the movement is played with, used between key frames which have no easing
+     * @param samplesPerFrame samples per frame of the movement
+     */
+    static CCBakedMovementData *create(CCMovementData *movementData, int tweenEasing, float samplesPerFrame);
+public:
+    CCBakedMovementData(void);
+    ~CCBakedMovementData(void);
+
+    virtual bool init(CCMovementData *movementData, int tweenEasing, float samplesPerFrame);
+
+    //! Returns the samples of a bone, or NULL if the bone isn't in the movement
+    const CCBakedBoneFrames *getBoneFrames(const char *boneName) const;
+
+    //! Memory used by the samples, in bytes
+    unsigned int getMemorySize() const;
+
+    //! Memory init() would use for movementData, in bytes
+    static unsigned int memorySizeFor(CCMovementData *movementData, float samplesPerFrame);
+public:
+    //! The movement which was sampled, retained
+    CCMovementData *movementData;
+    int tweenEasing;
+    float samplesPerFrame;
+    std::map<std::string, CCBakedBoneFrames> boneFrames;
+};
+
 
 struct CC_EX_DLL CCContourVertex2 : public CCObject
 {
@@ -59,6 +59,11 @@ CCArmatureDataManager::CCArmatureDataManager(void)
     m_pAnimationDatas = NULL;
     m_pTextureDatas = NULL;
     m_bAutoLoadSpriteFile = false;
+    m_pBakedMovementDatas = NULL;
+    m_bBakedAnimationEnabled = false;
+    m_fBakeSampleRate = 60;
+    m_uBakeMemoryBudget = 8 * 1024 * 1024;
+    m_uBakedMemorySize = 0;
 }
 
 
@@ -80,6 +85,7 @@ CCArmatureDataManager::~CCArmatureDataManager(void)
 
     m_sRelativeDatas.clear();
 
+    CC_SAFE_RELEASE_NULL(m_pBakedMovementDatas);
     CC_SAFE_DELETE(m_pAnimationDatas);
     CC_SAFE_DELETE(m_pArmarureDatas);
     CC_SAFE_DELETE(m_pTextureDatas);
@@ -103,6 +109,10 @@ bool CCArmatureDataManager::init()
         CCAssert(m_pTextureDatas, "create CCArmatureDataManager::m_pTextureDatas fail!");
         m_pTextureDatas->retain();
 
+        m_pBakedMovementDatas = CCDictionary::create();
+        CCAssert(m_pBakedMovementDatas, "create CCArmatureDataManager::m_pBakedMovementDatas fail!");
+        m_pBakedMovementDatas->retain();
+
         bRet = true;
     }
     while (0);
@@ -200,6 +210,31 @@ void CCArmatureDataManager::removeAnimationData(const char *id)
     {
         m_pAnimationDatas->removeObjectForKey(id);
     }
+
+    if (m_pBakedMovementDatas && m_pBakedMovementDatas->count() > 0)
+    {
+        std::string prefix = std::string(id) + "/";
+        std::vector<std::string> keys;
+
+        CCDictElement *element = NULL;
+        CCDICT_FOREACH(m_pBakedMovementDatas, element)
+        {
+            if (strncmp(element->getStrKey(), prefix.c_str(), prefix.length()) == 0)
+            {
+                keys.push_back(element->getStrKey());
+            }
+        }
+
+        for (std::vector<std::string>::iterator i = keys.begin(); i != keys.end(); i++)
+        {
+            CCBakedMovementData *bakedMovementData = (CCBakedMovementData *)m_pBakedMovementDatas->objectForKey(*i);
+            m_uBakedMemorySize -= bakedMovementData->getMemorySize();
+            m_pBakedMovementDatas->removeObjectForKey(*i);
+        }
+    }
+
+    // the memory freed may fit them now
+    m_sOverBudgetMovements.clear();
 }
 
 void CCArmatureDataManager::addTextureData(const char *id, CCTextureData *textureData, const char *configFilePath)
@@ -297,6 +332,123 @@ CCDictionary *CCArmatureDataManager::getTextureDatas() const
     return m_pTextureDatas;
 }
 
+void CCArmatureDataManager::setBakedAnimationEnabled(bool enabled)
+{
+    m_bBakedAnimationEnabled = enabled;
+}
+
+bool CCArmatureDataManager::isBakedAnimationEnabled() const
+{
+    return m_bBakedAnimationEnabled;
+}
+
+void CCArmatureDataManager::setBakeSampleRate(float samplesPerSecond)
+{
+    CCAssert(samplesPerSecond > 0, "the bake sample rate must be positive");
+    if (samplesPerSecond != m_fBakeSampleRate)
+    {
+        m_fBakeSampleRate = samplesPerSecond;
+        removeAllBakedMovementDatas();
+    }
+}
+
+float CCArmatureDataManager::getBakeSampleRate() const
+{
+    return m_fBakeSampleRate;
+}
+
+void CCArmatureDataManager::setBakeMemoryBudget(unsigned int bytes)
+{
+    m_uBakeMemoryBudget = bytes;
+    m_sOverBudgetMovements.clear();
+}
+
+unsigned int CCArmatureDataManager::getBakeMemoryBudget() const
+{
+    return m_uBakeMemoryBudget;
+}
+
+unsigned int CCArmatureDataManager::getBakedMemorySize() const
+{
+    return m_uBakedMemorySize;
+}
+
+void CCArmatureDataManager::bakeAnimationData(const char *id)
+{
+    CCAnimationData *animationData = getAnimationData(id);
+    if (!animationData)
+    {
+        return;
+    }
+
+    for (std::vector<std::string>::iterator i = animationData->movementNames.begin(); i != animationData->movementNames.end(); i++)
+    {
+        CCMovementData *movementData = animationData->getMovement(i->c_str());
+        getBakedMovementData(id, movementData, movementData->tweenEasing);
+    }
+}
+
+CCBakedMovementData *CCArmatureDataManager::getBakedMovementData(const char *animationId, CCMovementData *movementData, int tweenEasing)
+{
+    if (!m_bBakedAnimationEnabled || !m_pBakedMovementDatas || !movementData)
+    {
+        return NULL;
+    }
+
+    char easing[16];
+    sprintf(easing, "/%d", tweenEasing);
+    std::string key = std::string(animationId) + "/" + movementData->name + easing;
+
+    CCBakedMovementData *bakedMovementData = (CCBakedMovementData *)m_pBakedMovementDatas->objectForKey(key);
+    if (bakedMovementData)
+    {
+        if (bakedMovementData->movementData == movementData)
+        {
+            return bakedMovementData;
+        }
+
+        // the animation data was replaced since it was baked
+        m_uBakedMemorySize -= bakedMovementData->getMemorySize();
+        m_pBakedMovementDatas->removeObjectForKey(key);
+        m_sOverBudgetMovements.clear();
+    }
+
+    // rejected once already, until memory is freed
+    std::map<std::string, CCMovementData *>::iterator overBudget = m_sOverBudgetMovements.find(key);
+    if (overBudget != m_sOverBudgetMovements.end() && overBudget->second == movementData)
+    {
+        return NULL;
+    }
+
+    // the key frames are played at 60 frames per second, see CCProcessBase::m_fAnimationInternal
+    float samplesPerFrame = m_fBakeSampleRate / 60;
+    unsigned int size = CCBakedMovementData::memorySizeFor(movementData, samplesPerFrame);
+    if (m_uBakedMemorySize + size > m_uBakeMemoryBudget)
+    {
+        CCLOG("CCArmatureDataManager: no memory left to bake %s, it is tweened", key.c_str());
+        m_sOverBudgetMovements[key] = movementData;
+        return NULL;
+    }
+
+    bakedMovementData = CCBakedMovementData::create(movementData, tweenEasing, samplesPerFrame);
+    if (bakedMovementData)
+    {
+        m_pBakedMovementDatas->setObject(bakedMovementData, key);
+        m_uBakedMemorySize += bakedMovementData->getMemorySize();
+    }
+    return bakedMovementData;
+}
+
+void CCArmatureDataManager::removeAllBakedMovementDatas()
+{
+    if (m_pBakedMovementDatas)
+    {
+        m_pBakedMovementDatas->removeAllObjects();
+    }
+    m_uBakedMemorySize = 0;
+    m_sOverBudgetMovements.clear();
+}
+
 void CCArmatureDataManager::addRelativeData(const char *configFilePath)
 {
     if (m_sRelativeDatas.find(configFilePath) == m_sRelativeDatas.end())
@@ -167,6 +167,58 @@ public:
     CCDictionary *getAnimationDatas() const;
     CCDictionary *getTextureDatas() const;
 
+    /**
+     *	@brief	Enables baked animation, disabled by default.
+     *			When enabled, a movement is sampled once for every bone at the bake sample rate,
+     *			the first time it is played or when bakeAnimationData() is called. Every armature
+     *			playing it then reads the shared samples instead of tweening its key frames.
+     *  @since v2.2
+     */
+    void setBakedAnimationEnabled(bool enabled);
+    bool isBakedAnimationEnabled() const;
+
+    /**
+     *	@brief	Samples per second of animation time of baked movements, 60 by default.
+     *			The key frames of the movements are 1/60 s apart (see CCProcessBase), so 60 takes
+     *			one sample per key frame, 120 two. This is unrelated to the animation interval
+     *			of the director. Changing it removes the baked movements.
+     *  @since v2.2
+     */
+    void setBakeSampleRate(float samplesPerSecond);
+    float getBakeSampleRate() const;
+
+    /**
+     *	@brief	Memory the baked movements may use, in bytes, 8 MB by default.
+     *			A movement which doesn't fit isn't baked, and plays as usual.
+     *  @since v2.2
+     */
+    void setBakeMemoryBudget(unsigned int bytes);
+    unsigned int getBakeMemoryBudget() const;
+
+    //! Memory used by the baked movements, in bytes
+    unsigned int getBakedMemorySize() const;
+
+    /**
+     *	@brief	Bakes every movement of an animation data, with the easing of each movement,
+     *			instead of baking them when they are first played
+     *  @since v2.2
+     */
+    void bakeAnimationData(const char *id);
+
+    /**
+     *	@brief	Returns the baked movement of an animation data, baking it if needed.
+     *			Returns NULL if baked animation is disabled, or if the budget is used.
+     *	@param 	tweenEasing the easing the movement is played with
+     *  @since v2.2
+     */
+    CCBakedMovementData *getBakedMovementData(const char *animationId, CCMovementData *movementData, int tweenEasing);
+
+    /**
+     *	@brief	Removes every baked movement, the armatures playing them keep them until their next movement
+     *  @since v2.2
+     */
+    void removeAllBakedMovementDatas();
+
 protected:
     void addRelativeData(const char* configFilePath);
     CCRelativeData *getRelativeData(const char* configFilePath);
@@ -194,6 +246,25 @@ private:
 
     bool m_bAutoLoadSpriteFile;
 
+    /**
+     *	@brief	save baked movement datas
+     *  @key	animation id/movement name/tween easing
+     *  @value	CCBakedMovementData *
+     */
+    CCDictionary *m_pBakedMovementDatas;
+
+    bool m_bBakedAnimationEnabled;
+    float m_fBakeSampleRate;
+    unsigned int m_uBakeMemoryBudget;
+    unsigned int m_uBakedMemorySize;
+
+    /**
+     *	@brief	movements which didn't fit in the bake budget, tried again once memory is freed
+     *  @key	animation id/movement name/tween easing, like m_pBakedMovementDatas
+     *  @value	the CCMovementData which didn't fit
+     */
+    std::map<std::string, CCMovementData *> m_sOverBudgetMovements;
+
     std::map<std::string, CCRelativeData> m_sRelativeDatas;
 };
 
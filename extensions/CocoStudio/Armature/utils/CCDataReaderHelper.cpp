@@ -28,7 +28,6 @@ THE SOFTWARE.
 #include "CCTransformHelp.h"
 #include "CCUtilMath.h"
 #include "CCArmatureDefine.h"
-#include "CCBReader/CCData.h"
 #include "../datas/CCDatas.h"
 #include <errno.h>
 #include <stack>
@@ -36,6 +35,9 @@ THE SOFTWARE.
 #include <cctype>
 #include <queue>
 #include <list>
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+#include "platform/android/CCFileUtilsAndroid.h"
+#endif
 #if (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT) && (CC_TARGET_PLATFORM != CC_PLATFORM_WP8)
 #include <pthread.h>
 #else
@@ -156,41 +158,65 @@ CCDataReaderHelper *CCDataReaderHelper::s_DataReaderHelper = NULL;
 enum ConfigType
 {
     DragonBone_XML,
-    CocoStudio_JSON
+    CocoStudio_JSON,
+    CocoStudio_Binary
 };
 
+static const char *BINARY_FILE_EXTENSION = ".ExportBinary";
+
 
 //! Async load
 
 typedef struct _AsyncStruct
 {
     std::string    filename;
+    std::string    fullPath;
     std::string    fileContent;
     ConfigType     configType;
     std::string    baseFilePath;
     CCObject       *target;
     SEL_SCHEDULE   selector;
     bool           autoLoadSpriteFile;
+    float          positionReadScale;
     
     std::string    imagePath;
     std::string    plistPath;
 } AsyncStruct;
 
+//! The datas decoded by CCDataReaderHelper::convertToBinary, instead of being added to CCArmatureDataManager
+typedef struct _ExportedDatas
+{
+    std::vector<CCArmatureData *> armatureDatas;
+    std::vector<CCAnimationData *> animationDatas;
+    std::vector<CCTextureData *> textureDatas;
+    std::vector<std::string> configFiles;
+} ExportedDatas;
+
 typedef struct _DataInfo
 {
+    _DataInfo() : asyncStruct(NULL), contentScale(1), positionReadScale(s_PositionReadScale), flashToolVersion(0), cocoStudioVersion(0), exportedDatas(NULL), spriteSheetCount(0), loadedSpriteSheetCount(0) {}
+
     AsyncStruct *asyncStruct;
     std::queue<std::string>      configFileQueue;
     float contentScale;
+    //! The scale of the positions read, CCDataReaderHelper::setPositionReadScale when the load started
+    float positionReadScale;
     std::string    filename;
     std::string    baseFilePath;
     float flashToolVersion;
     float cocoStudioVersion;
+    ExportedDatas *exportedDatas;
+    //! The sprite sheets of an async load, whose textures are loaded by CCTextureCache::addImageAsync
+    unsigned int spriteSheetCount;
+    unsigned int loadedSpriteSheetCount;
 } DataInfo;
 
 
-static pthread_t s_loadingThread;
+static std::vector<pthread_t> s_loadingThreads;
+static unsigned int s_uLoadingThreadCount = 1;
+static unsigned int s_uRunningLoadingThreads = 0;
 
-static pthread_mutex_t		s_SleepMutex;
+//! Signaled, with s_asyncStructQueueMutex, when a file is queued
 static pthread_cond_t		s_SleepCondition;
 
 static pthread_mutex_t      s_asyncStructQueueMutex;
@@ -199,35 +225,144 @@ static pthread_mutex_t      s_DataInfoMutex;
 static pthread_mutex_t      s_addDataMutex;
 static pthread_mutex_t      s_ReadFileMutex;
 
-static pthread_mutex_t      s_GetFileDataMutex;
-
 #ifdef EMSCRIPTEN
 // Hack to get ASM.JS validation (no undefined symbols allowed).
 #define pthread_cond_signal(_)
+#define pthread_cond_broadcast(_)
 #endif // EMSCRIPTEN
 
 static unsigned long s_nAsyncRefCount = 0;
 static unsigned long s_nAsyncRefTotalCount = 0;
+//! The sum of the progress of the files of s_nAsyncRefTotalCount, each between 0 and 1
+static float s_fAsyncLoadedWork = 0;
+
+static CCObject *s_pAsyncProgressTarget = NULL;
+static SEL_SCHEDULE s_pAsyncProgressSelector = NULL;
 
 static bool need_quit = false;
 
 static std::queue<AsyncStruct *> *s_pAsyncStructQueue = NULL;
 static std::queue<DataInfo *>   *s_pDataQueue = NULL;
 
+static void addArmatureData(CCArmatureData *armatureData, DataInfo *dataInfo)
+{
+    if (dataInfo->exportedDatas)
+    {
+        dataInfo->exportedDatas->armatureDatas.push_back(armatureData);
+        return;
+    }
+
+    if (dataInfo->asyncStruct)
+    {
+        pthread_mutex_lock(&s_addDataMutex);
+    }
+    CCArmatureDataManager::sharedArmatureDataManager()->addArmatureData(armatureData->name.c_str(), armatureData, dataInfo->filename.c_str());
+    armatureData->release();
+    if (dataInfo->asyncStruct)
+    {
+        pthread_mutex_unlock(&s_addDataMutex);
+    }
+}
+
+static void addAnimationData(CCAnimationData *animationData, DataInfo *dataInfo)
+{
+    if (dataInfo->exportedDatas)
+    {
+        dataInfo->exportedDatas->animationDatas.push_back(animationData);
+        return;
+    }
+
+    if (dataInfo->asyncStruct)
+    {
+        pthread_mutex_lock(&s_addDataMutex);
+    }
+    CCArmatureDataManager::sharedArmatureDataManager()->addAnimationData(animationData->name.c_str(), animationData, dataInfo->filename.c_str());
+    animationData->release();
+    if (dataInfo->asyncStruct)
+    {
+        pthread_mutex_unlock(&s_addDataMutex);
+    }
+}
+
+static void addTextureData(CCTextureData *textureData, DataInfo *dataInfo)
+{
+    if (dataInfo->exportedDatas)
+    {
+        dataInfo->exportedDatas->textureDatas.push_back(textureData);
+        return;
+    }
+
+    if (dataInfo->asyncStruct)
+    {
+        pthread_mutex_lock(&s_addDataMutex);
+    }
+    CCArmatureDataManager::sharedArmatureDataManager()->addTextureData(textureData->name.c_str(), textureData, dataInfo->filename.c_str());
+    textureData->release();
+    if (dataInfo->asyncStruct)
+    {
+        pthread_mutex_unlock(&s_addDataMutex);
+    }
+}
+
+static CCArmatureData *getArmatureData(const char *name, DataInfo *dataInfo)
+{
+    if (dataInfo->exportedDatas)
+    {
+        std::vector<CCArmatureData *> &armatureDatas = dataInfo->exportedDatas->armatureDatas;
+        for (unsigned int i = 0; i < armatureDatas.size(); ++i)
+        {
+            if (armatureDatas[i]->name == name)
+            {
+                return armatureDatas[i];
+            }
+        }
+        return NULL;
+    }
+
+    if (dataInfo->asyncStruct)
+    {
+        pthread_mutex_lock(&s_addDataMutex);
+    }
+    CCArmatureData *armatureData = CCArmatureDataManager::sharedArmatureDataManager()->getArmatureData(name);
+    if (dataInfo->asyncStruct)
+    {
+        pthread_mutex_unlock(&s_addDataMutex);
+    }
+    return armatureData;
+}
+
+/*
+ * Reads a file from a loading thread. The full path is resolved by the main thread,
+ * CCFileUtils::fullPathForFilename() isn't thread safe.
+ */
+static unsigned char *getFileDataThreadSafe(const std::string &fullPath, const char *mode, unsigned long *size)
+{
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+    // the loading threads share one handle on the apk
+    pthread_mutex_lock(&s_ReadFileMutex);
+    CCFileUtilsAndroid *fileUtils = (CCFileUtilsAndroid *)CCFileUtils::sharedFileUtils();
+    unsigned char *pBytes = fileUtils->getFileDataForAsync(fullPath.c_str(), mode, size);
+    pthread_mutex_unlock(&s_ReadFileMutex);
+    return pBytes;
+#else
+    return CCFileUtils::sharedFileUtils()->getFileData(fullPath.c_str(), mode, size);
+#endif
+}
+
 static void addData(AsyncStruct *pAsyncStruct)
 {
-    std::string fullPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(pAsyncStruct->filename.c_str());
-    unsigned long size;
-    pthread_mutex_lock(&s_GetFileDataMutex);
-	unsigned char *pBytes = CCFileUtils::sharedFileUtils()->getFileData(fullPath.c_str() , "r", &size);
-	CCData data(pBytes, size);
+    unsigned long size = 0;
+    unsigned char *pBytes = getFileDataThreadSafe(pAsyncStruct->fullPath, pAsyncStruct->configType == CocoStudio_Binary ? "rb" : "r", &size);
+    if (pBytes)
+    {
+        pAsyncStruct->fileContent.assign((const char *)pBytes, size);
+    }
     CC_SAFE_DELETE_ARRAY(pBytes);
-	pAsyncStruct->fileContent = std::string((const char*)data.getBytes(), data.getSize());
-    pthread_mutex_unlock(&s_GetFileDataMutex);
 
     // generate data info
     DataInfo *pDataInfo = new DataInfo();
     pDataInfo->asyncStruct = pAsyncStruct;
+    pDataInfo->positionReadScale = pAsyncStruct->positionReadScale;
     pDataInfo->filename = pAsyncStruct->filename;
     pDataInfo->baseFilePath = pAsyncStruct->baseFilePath;
 
@@ -239,6 +374,10 @@ static void addData(AsyncStruct *pAsyncStruct)
     {
         CCDataReaderHelper::addDataFromJsonCache(pAsyncStruct->fileContent.c_str(), pDataInfo);
     }
+    else if(pAsyncStruct->configType == CocoStudio_Binary)
+    {
+        CCDataReaderHelper::addDataFromBinaryCache((const unsigned char *)pAsyncStruct->fileContent.data(), pAsyncStruct->fileContent.size(), pDataInfo);
+    }
 
     // put the image info into the queue
     pthread_mutex_lock(&s_DataInfoMutex);
@@ -248,6 +387,8 @@ static void addData(AsyncStruct *pAsyncStruct)
 
 static void *loadData(void *)
 {
+    CC_TRACE_THREAD_NAME("CCDataReaderHelper loader");
+
     while (true)
     {
         // create autorelease pool for iOS
@@ -258,14 +399,15 @@ static void *loadData(void *)
         pthread_mutex_lock(&s_asyncStructQueueMutex);// get async struct from queue
         if (pQueue->empty())
         {
-            pthread_mutex_unlock(&s_asyncStructQueueMutex);
             if (need_quit)
             {
+                pthread_mutex_unlock(&s_asyncStructQueueMutex);
                 break;
             }
             else
             {
-                pthread_cond_wait(&s_SleepCondition, &s_SleepMutex);
+                pthread_cond_wait(&s_SleepCondition, &s_asyncStructQueueMutex);
+                pthread_mutex_unlock(&s_asyncStructQueueMutex);
                 continue;
             }
         }
@@ -274,29 +416,112 @@ static void *loadData(void *)
             AsyncStruct *pAsyncStruct = pQueue->front();
             pQueue->pop();
             pthread_mutex_unlock(&s_asyncStructQueueMutex);
+
+            CC_TRACE_SCOPE("CCDataReaderHelper::addData");
             addData(pAsyncStruct);
        }
     }
 
-    if( s_pAsyncStructQueue != NULL )
+    // the last loading thread to quit cleans up
+    pthread_mutex_lock(&s_asyncStructQueueMutex);
+    bool isLastThread = --s_uRunningLoadingThreads == 0;
+    pthread_mutex_unlock(&s_asyncStructQueueMutex);
+
+    if( isLastThread && s_pAsyncStructQueue != NULL )
     {
         delete s_pAsyncStructQueue;
         s_pAsyncStructQueue = NULL;
         delete s_pDataQueue;
         s_pDataQueue = NULL;
+        s_loadingThreads.clear();
 
         pthread_mutex_destroy(&s_asyncStructQueueMutex);
         pthread_mutex_destroy(&s_DataInfoMutex);
-        pthread_mutex_destroy(&s_SleepMutex);
         pthread_mutex_destroy(&s_addDataMutex);
         pthread_mutex_destroy(&s_ReadFileMutex);
-        pthread_mutex_destroy(&s_GetFileDataMutex);
         pthread_cond_destroy(&s_SleepCondition);
     }
 
     return NULL;
 }
 
+static void startLoadingThreads()
+{
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT) && (CC_TARGET_PLATFORM != CC_PLATFORM_WP8)
+    // the JSON decoders use it, its lazy init isn't thread safe
+    DictionaryHelper::shareHelper();
+
+    pthread_mutex_lock(&s_asyncStructQueueMutex);
+    while (s_loadingThreads.size() < s_uLoadingThreadCount)
+    {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, loadData, NULL) != 0)
+        {
+            break;
+        }
+        s_loadingThreads.push_back(thread);
+        ++s_uRunningLoadingThreads;
+    }
+    pthread_mutex_unlock(&s_asyncStructQueueMutex);
+#endif
+}
+
+static void notifyAsyncProgress()
+{
+    if (s_pAsyncProgressTarget && s_pAsyncProgressSelector)
+    {
+        float progress = s_nAsyncRefTotalCount == 0 ? 1 : s_fAsyncLoadedWork / s_nAsyncRefTotalCount;
+        (s_pAsyncProgressTarget->*s_pAsyncProgressSelector)(MIN(progress, 1.0f));
+    }
+}
+
+/*
+ * A sprite sheet of an async load. Its texture is decoded in the CCTextureCache loading thread,
+ * then its frames are added on the main thread.
+ */
+class CCAsyncSpriteSheet : public CCObject
+{
+public:
+    CCAsyncSpriteSheet(DataInfo *pDataInfo, const std::string &plistPath, const std::string &imagePath)
+        : m_pDataInfo(pDataInfo)
+        , m_strPlistPath(plistPath)
+        , m_strImagePath(imagePath)
+    {
+    }
+
+    void load()
+    {
+        CCTextureCache::sharedTextureCache()->addImageAsync(m_strImagePath.c_str(), this, callfuncO_selector(CCAsyncSpriteSheet::textureLoaded), true);
+    }
+
+    void textureLoaded(CCObject *texture)
+    {
+        if (texture)
+        {
+            // the texture is in the cache now, so it isn't loaded again
+            CCArmatureDataManager::sharedArmatureDataManager()->addSpriteFrameFromFile(m_strPlistPath.c_str(), m_strImagePath.c_str(), m_pDataInfo->filename.c_str());
+        }
+        else
+        {
+            // still counted as loaded, the file finishes without this sprite sheet
+            CCLOG("CCDataReaderHelper: can't load the sprite sheet %s of %s", m_strImagePath.c_str(), m_pDataInfo->filename.c_str());
+        }
+
+        s_fAsyncLoadedWork += 1.0f / (1 + m_pDataInfo->spriteSheetCount);
+        notifyAsyncProgress();
+
+        if (++m_pDataInfo->loadedSpriteSheetCount == m_pDataInfo->spriteSheetCount)
+        {
+            CCDataReaderHelper::sharedDataReaderHelper()->finishAsyncData(m_pDataInfo);
+        }
+    }
+
+private:
+    DataInfo *m_pDataInfo;
+    std::string m_strPlistPath;
+    std::string m_strImagePath;
+};
+
 
 CCDataReaderHelper *CCDataReaderHelper::sharedDataReaderHelper()
 {
@@ -326,10 +551,40 @@ void CCDataReaderHelper::purge()
 }
 
 
+void CCDataReaderHelper::setAsyncLoadingThreadCount(unsigned int count)
+{
+    s_uLoadingThreadCount = MAX(count, 1);
+    if (s_pAsyncStructQueue != NULL)
+    {
+        startLoadingThreads();
+    }
+}
+
+unsigned int CCDataReaderHelper::getAsyncLoadingThreadCount()
+{
+    return s_uLoadingThreadCount;
+}
+
+void CCDataReaderHelper::setAsyncProgressCallback(CCObject *target, SEL_SCHEDULE selector)
+{
+    CC_SAFE_RETAIN(target);
+    CC_SAFE_RELEASE(s_pAsyncProgressTarget);
+    s_pAsyncProgressTarget = target;
+    s_pAsyncProgressSelector = selector;
+}
+
 CCDataReaderHelper::~CCDataReaderHelper()
 {
+    CC_SAFE_RELEASE_NULL(s_pAsyncProgressTarget);
+    s_pAsyncProgressSelector = NULL;
+
     need_quit = true;
-    pthread_cond_signal(&s_SleepCondition);
+    if (s_pAsyncStructQueue != NULL)
+    {
+        pthread_mutex_lock(&s_asyncStructQueueMutex);
+        pthread_cond_broadcast(&s_SleepCondition);
+        pthread_mutex_unlock(&s_asyncStructQueueMutex);
+    }
 }
 
 void CCDataReaderHelper::addDataFromFile(const char *filePath)
@@ -364,15 +619,24 @@ void CCDataReaderHelper::addDataFromFile(const char *filePath)
     size_t startPos = filePathStr.find_last_of(".");
     std::string str = &filePathStr[startPos];
 
+    bool isBinary = str.compare(BINARY_FILE_EXTENSION) == 0;
+
     unsigned long size;
     std::string fullPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(filePath);
-    unsigned char *pBytes = CCFileUtils::sharedFileUtils()->getFileData(fullPath.c_str() , "r", &size);
+    unsigned char *pBytes = CCFileUtils::sharedFileUtils()->getFileData(fullPath.c_str() , isBinary ? "rb" : "r", &size);
 
     DataInfo dataInfo;
     dataInfo.filename = filePathStr;
     dataInfo.asyncStruct = NULL;
     dataInfo.baseFilePath = basefilePath;
 
+    if (isBinary)
+    {
+        CCDataReaderHelper::addDataFromBinaryCache(pBytes, size, &dataInfo);
+        CC_SAFE_DELETE_ARRAY(pBytes);
+        return;
+    }
+
 	std::string load_str = std::string((const char*)pBytes, size);
     if (str.compare(".xml") == 0)
     {
@@ -436,15 +700,12 @@ void CCDataReaderHelper::addDataFromFileAsync(const char *imagePath, const char
 
         pthread_mutex_init(&s_asyncStructQueueMutex, NULL);
         pthread_mutex_init(&s_DataInfoMutex, NULL);
-        pthread_mutex_init(&s_SleepMutex, NULL);
         pthread_mutex_init(&s_addDataMutex, NULL);
         pthread_mutex_init(&s_ReadFileMutex, NULL);
-        pthread_mutex_init(&s_GetFileDataMutex, NULL);
         pthread_cond_init(&s_SleepCondition, NULL);
- #if (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT) && (CC_TARGET_PLATFORM != CC_PLATFORM_WP8)
-        pthread_create(&s_loadingThread, NULL, loadData, NULL);
-#endif
         need_quit = false;
+
+        startLoadingThreads();
     }
 
     if (0 == s_nAsyncRefCount)
@@ -463,10 +724,12 @@ void CCDataReaderHelper::addDataFromFileAsync(const char *imagePath, const char
     // generate async struct
     AsyncStruct *data = new AsyncStruct();
     data->filename = filePath;
+    data->fullPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(filePath);
     data->baseFilePath = basefilePath;
     data->target = target;
     data->selector = selector;
     data->autoLoadSpriteFile = CCArmatureDataManager::sharedArmatureDataManager()->isAutoLoadSpriteFile();
+    data->positionReadScale = s_PositionReadScale;
 
     data->imagePath = imagePath;
     data->plistPath = plistPath;
@@ -483,14 +746,17 @@ void CCDataReaderHelper::addDataFromFileAsync(const char *imagePath, const char
     {
         data->configType = CocoStudio_JSON;
     }
+    else if(str.compare(BINARY_FILE_EXTENSION) == 0)
+    {
+        data->configType = CocoStudio_Binary;
+    }
 
 #if (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT) && (CC_TARGET_PLATFORM != CC_PLATFORM_WP8)
     // add async struct into queue
     pthread_mutex_lock(&s_asyncStructQueueMutex);
     s_pAsyncStructQueue->push(data);
-    pthread_mutex_unlock(&s_asyncStructQueueMutex);
-
     pthread_cond_signal(&s_SleepCondition);
+    pthread_mutex_unlock(&s_asyncStructQueueMutex);
 #else
     // WinRT uses an Async Task to load the image since the ThreadPool has a limited number of threads
     create_task([this, data] {
@@ -503,59 +769,77 @@ void CCDataReaderHelper::addDataFromFileAsync(const char *imagePath, const char
 
 void CCDataReaderHelper::addDataAsyncCallBack(float dt)
 {
-    // the data is generated in loading thread
+    // the data is generated in loading threads
     std::queue<DataInfo *> *dataQueue = s_pDataQueue;
 
-    pthread_mutex_lock(&s_DataInfoMutex);
-    if (dataQueue->empty())
-    {
-        pthread_mutex_unlock(&s_DataInfoMutex);
-    }
-    else
+    while (true)
     {
+        pthread_mutex_lock(&s_DataInfoMutex);
+        if (dataQueue->empty())
+        {
+            pthread_mutex_unlock(&s_DataInfoMutex);
+            break;
+        }
         DataInfo *pDataInfo = dataQueue->front();
         dataQueue->pop();
         pthread_mutex_unlock(&s_DataInfoMutex);
 
         AsyncStruct *pAsyncStruct = pDataInfo->asyncStruct;
 
+        std::vector<CCAsyncSpriteSheet *> spriteSheets;
         if (pAsyncStruct->imagePath != "" && pAsyncStruct->plistPath != "")
         {
-            pthread_mutex_lock(&s_GetFileDataMutex);
-            CCArmatureDataManager::sharedArmatureDataManager()->addSpriteFrameFromFile(pAsyncStruct->plistPath.c_str(), pAsyncStruct->imagePath.c_str());
-            pthread_mutex_unlock(&s_GetFileDataMutex);
+            spriteSheets.push_back(new CCAsyncSpriteSheet(pDataInfo, pAsyncStruct->plistPath, pAsyncStruct->imagePath));
         }
 
         while (!pDataInfo->configFileQueue.empty())
         {
             std::string configPath = pDataInfo->configFileQueue.front();
-            pthread_mutex_lock(&s_GetFileDataMutex);
-            CCArmatureDataManager::sharedArmatureDataManager()->addSpriteFrameFromFile((pAsyncStruct->baseFilePath + configPath + ".plist").c_str(), (pAsyncStruct->baseFilePath + configPath + ".png").c_str());
-            pthread_mutex_unlock(&s_GetFileDataMutex);
+            spriteSheets.push_back(new CCAsyncSpriteSheet(pDataInfo, pAsyncStruct->baseFilePath + configPath + ".plist", pAsyncStruct->baseFilePath + configPath + ".png"));
             pDataInfo->configFileQueue.pop();
         }
 
+        // the datas count for one part of the file, each sprite sheet for another
+        pDataInfo->spriteSheetCount = spriteSheets.size();
+        s_fAsyncLoadedWork += 1.0f / (1 + spriteSheets.size());
+        notifyAsyncProgress();
 
-        CCObject *target = pAsyncStruct->target;
-        SEL_SCHEDULE selector = pAsyncStruct->selector;
-
-        --s_nAsyncRefCount;
+        if (spriteSheets.empty())
+        {
+            finishAsyncData(pDataInfo);
+        }
 
-        if (target && selector)
+        // a cached texture is returned at once, finishing the file on the last one
+        for (unsigned int i = 0; i < spriteSheets.size(); ++i)
         {
-            (target->*selector)((s_nAsyncRefTotalCount - s_nAsyncRefCount) / (float)s_nAsyncRefTotalCount);
-            target->release();
+            spriteSheets[i]->load();
+            spriteSheets[i]->release();
         }
+    }
+}
 
+void CCDataReaderHelper::finishAsyncData(DataInfo *pDataInfo)
+{
+    AsyncStruct *pAsyncStruct = pDataInfo->asyncStruct;
+    CCObject *target = pAsyncStruct->target;
+    SEL_SCHEDULE selector = pAsyncStruct->selector;
 
-        delete pAsyncStruct;
-        delete pDataInfo;
+    --s_nAsyncRefCount;
 
-        if (0 == s_nAsyncRefCount)
-        {
-            s_nAsyncRefTotalCount = 0;
-            CCDirector::sharedDirector()->getScheduler()->unscheduleSelector(schedule_selector(CCDataReaderHelper::addDataAsyncCallBack), this);
-        }
+    if (target && selector)
+    {
+        (target->*selector)((s_nAsyncRefTotalCount - s_nAsyncRefCount) / (float)s_nAsyncRefTotalCount);
+    }
+    CC_SAFE_RELEASE(target);
+
+    delete pAsyncStruct;
+    delete pDataInfo;
+
+    if (0 == s_nAsyncRefCount)
+    {
+        s_nAsyncRefTotalCount = 0;
+        s_fAsyncLoadedWork = 0;
+        CCDirector::sharedDirector()->getScheduler()->unscheduleSelector(schedule_selector(CCDataReaderHelper::addDataAsyncCallBack), this);
     }
 }
 
@@ -599,16 +883,7 @@ void CCDataReaderHelper::addDataFromCache(const char *pFileContent, DataInfo *da
     {
         CCArmatureData *armatureData = CCDataReaderHelper::decodeArmature(armatureXML, dataInfo);
 
-        if (dataInfo->asyncStruct)
-        {
-            pthread_mutex_lock(&s_addDataMutex);
-        }
-        CCArmatureDataManager::sharedArmatureDataManager()->addArmatureData(armatureData->name.c_str(), armatureData, dataInfo->filename.c_str());
-        armatureData->release();
-        if (dataInfo->asyncStruct)
-        {
-            pthread_mutex_unlock(&s_addDataMutex);
-        }
+        addArmatureData(armatureData, dataInfo);
 
         armatureXML = armatureXML->NextSiblingElement(ARMATURE);
     }
@@ -622,16 +897,7 @@ void CCDataReaderHelper::addDataFromCache(const char *pFileContent, DataInfo *da
     while(animationXML)
     {
         CCAnimationData *animationData = CCDataReaderHelper::decodeAnimation(animationXML, dataInfo);
-        if (dataInfo->asyncStruct)
-        {
-            pthread_mutex_lock(&s_addDataMutex);
-        }
-        CCArmatureDataManager::sharedArmatureDataManager()->addAnimationData(animationData->name.c_str(), animationData, dataInfo->filename.c_str());
-        animationData->release();
-        if (dataInfo->asyncStruct)
-        {
-            pthread_mutex_unlock(&s_addDataMutex);
-        }
+        addAnimationData(animationData, dataInfo);
         animationXML = animationXML->NextSiblingElement(ANIMATION);
     }
 
@@ -645,16 +911,7 @@ void CCDataReaderHelper::addDataFromCache(const char *pFileContent, DataInfo *da
     {
         CCTextureData *textureData = CCDataReaderHelper::decodeTexture(textureXML, dataInfo);
 
-        if (dataInfo->asyncStruct)
-        {
-            pthread_mutex_lock(&s_addDataMutex);
-        }
-        CCArmatureDataManager::sharedArmatureDataManager()->addTextureData(textureData->name.c_str(), textureData, dataInfo->filename.c_str());
-        textureData->release();
-        if (dataInfo->asyncStruct)
-        {
-            pthread_mutex_unlock(&s_addDataMutex);
-        }
+        addTextureData(textureData, dataInfo);
         textureXML = textureXML->NextSiblingElement(SUB_TEXTURE);
     }
 }
@@ -778,7 +1035,7 @@ CCAnimationData *CCDataReaderHelper::decodeAnimation(tinyxml2::XMLElement *anima
 
     const char	*name = animationXML->Attribute(A_NAME);
 
-    CCArmatureData *armatureData = CCArmatureDataManager::sharedArmatureDataManager()->getArmatureData(name);
+    CCArmatureData *armatureData = getArmatureData(name, dataInfo);
 
     aniData->name = name;
 
@@ -1038,12 +1295,12 @@ CCFrameData *CCDataReaderHelper::decodeFrame(tinyxml2::XMLElement *frameXML,  ti
         if(frameXML->QueryFloatAttribute(A_COCOS2DX_X, &x) == tinyxml2::XML_SUCCESS)
         {
             frameData->x = x;
-            frameData->x *= s_PositionReadScale;
+            frameData->x *= dataInfo->positionReadScale;
         }
         if(frameXML->QueryFloatAttribute(A_COCOS2DX_Y, &y) == tinyxml2::XML_SUCCESS)
         {
             frameData->y = -y;
-            frameData->y *= s_PositionReadScale;
+            frameData->y *= dataInfo->positionReadScale;
         }
     }
     else
@@ -1051,12 +1308,12 @@ CCFrameData *CCDataReaderHelper::decodeFrame(tinyxml2::XMLElement *frameXML,  ti
         if(frameXML->QueryFloatAttribute(A_X, &x) == tinyxml2::XML_SUCCESS)
         {
             frameData->x = x;
-            frameData->x *= s_PositionReadScale;
+            frameData->x *= dataInfo->positionReadScale;
         }
         if(frameXML->QueryFloatAttribute(A_Y, &y) == tinyxml2::XML_SUCCESS)
         {
             frameData->y = -y;
-            frameData->y *= s_PositionReadScale;
+            frameData->y *= dataInfo->positionReadScale;
         }
     }
 
@@ -1290,16 +1547,7 @@ void CCDataReaderHelper::addDataFromJsonCache(const char *fileContent, DataInfo
 		const rapidjson::Value &armatureDic = DICTOOL->getSubDictionary_json(json, ARMATURE_DATA, i); //json[ARMATURE_DATA][i];
         CCArmatureData *armatureData = decodeArmature(armatureDic, dataInfo);
 
-        if (dataInfo->asyncStruct)
-        {
-            pthread_mutex_lock(&s_addDataMutex);
-        }
-        CCArmatureDataManager::sharedArmatureDataManager()->addArmatureData(armatureData->name.c_str(), armatureData, dataInfo->filename.c_str());
-        armatureData->release();
-        if (dataInfo->asyncStruct)
-        {
-            pthread_mutex_unlock(&s_addDataMutex);
-        }
+        addArmatureData(armatureData, dataInfo);
         //delete armatureDic;
     }
 
@@ -1310,16 +1558,7 @@ void CCDataReaderHelper::addDataFromJsonCache(const char *fileContent, DataInfo
 		const rapidjson::Value &animationDic = DICTOOL->getSubDictionary_json(json, ANIMATION_DATA, i);
         CCAnimationData *animationData = decodeAnimation(animationDic, dataInfo);
 
-        if (dataInfo->asyncStruct)
-        {
-            pthread_mutex_lock(&s_addDataMutex);
-        }
-        CCArmatureDataManager::sharedArmatureDataManager()->addAnimationData(animationData->name.c_str(), animationData, dataInfo->filename.c_str());
-        animationData->release();
-        if (dataInfo->asyncStruct)
-        {
-            pthread_mutex_unlock(&s_addDataMutex);
-        }
+        addAnimationData(animationData, dataInfo);
     }
 
     // Decode textures
@@ -1329,22 +1568,13 @@ void CCDataReaderHelper::addDataFromJsonCache(const char *fileContent, DataInfo
         const rapidjson::Value &textureDic =  DICTOOL->getSubDictionary_json(json, TEXTURE_DATA, i); // json[TEXTURE_DATA][i];
         CCTextureData *textureData = decodeTexture(textureDic);
 
-        if (dataInfo->asyncStruct)
-        {
-            pthread_mutex_lock(&s_addDataMutex);
-        }
-        CCArmatureDataManager::sharedArmatureDataManager()->addTextureData(textureData->name.c_str(), textureData, dataInfo->filename.c_str());
-        textureData->release();
-        if (dataInfo->asyncStruct)
-        {
-            pthread_mutex_unlock(&s_addDataMutex);
-        }
+        addTextureData(textureData, dataInfo);
         //delete textureDic;
     }
 
     // Auto load sprite file
     bool autoLoad = dataInfo->asyncStruct == NULL ? CCArmatureDataManager::sharedArmatureDataManager()->isAutoLoadSpriteFile() : dataInfo->asyncStruct->autoLoadSpriteFile;
-    if (autoLoad)
+    if (autoLoad || dataInfo->exportedDatas)
     {
         length =  DICTOOL->getArrayCount_json(json, CONFIG_FILE_PATH); // json[CONFIG_FILE_PATH].IsNull() ? 0 : json[CONFIG_FILE_PATH].Size();
         for (int i = 0; i < length; i++)
@@ -1359,7 +1589,11 @@ void CCDataReaderHelper::addDataFromJsonCache(const char *fileContent, DataInfo
             std::string filePath = path;
             filePath = filePath.erase(filePath.find_last_of("."));
 
-            if (dataInfo->asyncStruct)
+            if (dataInfo->exportedDatas)
+            {
+                dataInfo->exportedDatas->configFiles.push_back(filePath);
+            }
+            else if (dataInfo->asyncStruct)
             {
                 dataInfo->configFileQueue.push(filePath);
             }
@@ -1459,8 +1693,8 @@ CCDisplayData *CCDataReaderHelper::decodeBoneDisplay(const rapidjson::Value &jso
 			if (!dic.IsNull())
 			{
 				CCSpriteDisplayData *sdd = (CCSpriteDisplayData *)displayData;
-				sdd->skinData.x = DICTOOL->getFloatValue_json(dic, A_X) * s_PositionReadScale;
-				sdd->skinData.y = DICTOOL->getFloatValue_json(dic, A_Y) * s_PositionReadScale;
+				sdd->skinData.x = DICTOOL->getFloatValue_json(dic, A_X) * dataInfo->positionReadScale;
+				sdd->skinData.y = DICTOOL->getFloatValue_json(dic, A_Y) * dataInfo->positionReadScale;
 				sdd->skinData.scaleX = DICTOOL->getFloatValue_json(dic, A_SCALE_X, 1.0f);
 				sdd->skinData.scaleY = DICTOOL->getFloatValue_json(dic, A_SCALE_Y, 1.0f);
 				sdd->skinData.skewX = DICTOOL->getFloatValue_json(dic, A_SKEW_X, 1.0f);
@@ -1673,6 +1907,7 @@ CCFrameData *CCDataReaderHelper::decodeFrame(const rapidjson::Value &json, DataI
     int length = DICTOOL->getArrayCount_json(json, A_EASING_PARAM);
     if (length != 0)
     {
+        frameData->easingParamNumber = length;
         frameData->easingParams = new float[length];
 
         for (int i = 0; i < length; i++)
@@ -1774,4 +2009,679 @@ void CCDataReaderHelper::decodeNode(CCBaseData *node, const rapidjson::Value &js
     }
 }
 
+/*
+ * Binary format, written by convertToBinary and read by addDataFromBinaryCache.
+ * Little endian, the byte order of every platform cocos2d-x runs on.
+ *
+ *   header:   "CSAB", u32 version, u8 source type (DragonBone_XML or CocoStudio_JSON),
+ *             u32 frame count, the total of the movement bones' frames
+ *   strings:  u32 count, then for each u32 length and the bytes. Strings are referenced by index
+ *   datas:    u32 count and armatures, u32 count and animations, u32 count and textures,
+ *             u32 count and config file paths
+ *
+ * The values are stored as decoded, with a position read scale of 1.
+ */
+static const char BINARY_MAGIC[4] = {'C', 'S', 'A', 'B'};
+static const unsigned int BINARY_VERSION = 1;
+
+class CCBinaryWriter
+{
+public:
+    void writeU8(unsigned char value) { m_data.push_back((char)value); }
+    void writeInt(int value) { m_data.append((const char *)&value, sizeof(value)); }
+    void writeUInt(unsigned int value) { m_data.append((const char *)&value, sizeof(value)); }
+    void writeFloat(float value) { m_data.append((const char *)&value, sizeof(value)); }
+
+    void writeString(const std::string &str)
+    {
+        std::map<std::string, unsigned int>::iterator it = m_stringIndices.find(str);
+        if (it == m_stringIndices.end())
+        {
+            it = m_stringIndices.insert(std::make_pair(str, (unsigned int)m_strings.size())).first;
+            m_strings.push_back(str);
+        }
+        writeUInt(it->second);
+    }
+
+    void writeBaseData(const CCBaseData *node)
+    {
+        writeFloat(node->x);
+        writeFloat(node->y);
+        writeInt(node->zOrder);
+        writeFloat(node->skewX);
+        writeFloat(node->skewY);
+        writeFloat(node->scaleX);
+        writeFloat(node->scaleY);
+        writeFloat(node->tweenRotate);
+        writeU8(node->isUseColorInfo);
+        if (node->isUseColorInfo)
+        {
+            writeInt(node->a);
+            writeInt(node->r);
+            writeInt(node->g);
+            writeInt(node->b);
+        }
+    }
+
+    //! The header and the string table, followed by the datas written so far
+    std::string getFile(unsigned char sourceType, unsigned int frameCount)
+    {
+        CCBinaryWriter header;
+        header.m_data.append(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        header.writeUInt(BINARY_VERSION);
+        header.writeU8(sourceType);
+        header.writeUInt(frameCount);
+        header.writeUInt(m_strings.size());
+        for (unsigned int i = 0; i < m_strings.size(); ++i)
+        {
+            header.writeUInt(m_strings[i].size());
+            header.m_data.append(m_strings[i]);
+        }
+        return header.m_data + m_data;
+    }
+
+private:
+    std::string m_data;
+    std::vector<std::string> m_strings;
+    std::map<std::string, unsigned int> m_stringIndices;
+};
+
+class CCBinaryReader
+{
+public:
+    CCBinaryReader(const unsigned char *data, unsigned long size)
+        : m_pCursor(data)
+        , m_pEnd(data + size)
+        , m_bError(false)
+    {
+    }
+
+    bool hasError() const { return m_bError; }
+    void setError() { m_bError = true; }
+
+    bool read(void *value, unsigned long size)
+    {
+        if (m_bError || (unsigned long)(m_pEnd - m_pCursor) < size)
+        {
+            m_bError = true;
+            memset(value, 0, size);
+            return false;
+        }
+        memcpy(value, m_pCursor, size);
+        m_pCursor += size;
+        return true;
+    }
+
+    unsigned char readU8() { unsigned char value; read(&value, sizeof(value)); return value; }
+    int readInt() { int value; read(&value, sizeof(value)); return value; }
+    unsigned int readUInt() { unsigned int value; read(&value, sizeof(value)); return value; }
+    float readFloat() { float value; read(&value, sizeof(value)); return value; }
+
+    //! Reads a count of items of at least itemSize bytes, 0 if the data is too short for them
+    unsigned int readCount(unsigned long itemSize)
+    {
+        unsigned int count = readUInt();
+        if (m_bError || (unsigned long)(m_pEnd - m_pCursor) / itemSize < count)
+        {
+            m_bError = true;
+            return 0;
+        }
+        return count;
+    }
+
+    bool readStrings()
+    {
+        unsigned int count = readCount(sizeof(unsigned int));
+        m_strings.resize(count);
+        for (unsigned int i = 0; i < count && !m_bError; ++i)
+        {
+            unsigned int length = readCount(1);
+            m_strings[i].assign((const char *)m_pCursor, length);
+            m_pCursor += length;
+        }
+        return !m_bError;
+    }
+
+    const std::string &readString()
+    {
+        unsigned int index = readUInt();
+        if (index >= m_strings.size())
+        {
+            m_bError = true;
+            return m_empty;
+        }
+        return m_strings[index];
+    }
+
+    void readBaseData(CCBaseData *node)
+    {
+        node->x = readFloat();
+        node->y = readFloat();
+        node->zOrder = readInt();
+        node->skewX = readFloat();
+        node->skewY = readFloat();
+        node->scaleX = readFloat();
+        node->scaleY = readFloat();
+        node->tweenRotate = readFloat();
+        node->isUseColorInfo = readU8() != 0;
+        if (node->isUseColorInfo)
+        {
+            node->a = readInt();
+            node->r = readInt();
+            node->g = readInt();
+            node->b = readInt();
+        }
+    }
+
+private:
+    const unsigned char *m_pCursor;
+    const unsigned char *m_pEnd;
+    bool m_bError;
+    std::vector<std::string> m_strings;
+    std::string m_empty;
+};
+
+static void writeArmatureData(CCBinaryWriter &writer, CCArmatureData *armatureData, const std::string &baseFilePath)
+{
+    writer.writeString(armatureData->name);
+    writer.writeFloat(armatureData->dataVersion);
+    writer.writeUInt(armatureData->boneDataDic.count());
+
+    CCDictionary *boneDataDic = &armatureData->boneDataDic;
+    CCDictElement *element = NULL;
+    CCDICT_FOREACH(boneDataDic, element)
+    {
+        CCBoneData *boneData = (CCBoneData *)element->getObject();
+        writer.writeBaseData(boneData);
+        writer.writeString(boneData->name);
+        writer.writeString(boneData->parentName);
+        writer.writeUInt(boneData->displayDataList.count());
+
+        CCArray *displayDataList = &boneData->displayDataList;
+        CCObject *object = NULL;
+        CCARRAY_FOREACH(displayDataList, object)
+        {
+            CCDisplayData *displayData = (CCDisplayData *)object;
+            writer.writeU8(displayData->displayType);
+
+            std::string displayName = displayData->displayName;
+            if (displayData->displayType == CS_DISPLAY_PARTICLE && displayName.compare(0, baseFilePath.length(), baseFilePath) == 0)
+            {
+                // the particle files are found next to the binary file
+                displayName = displayName.substr(baseFilePath.length());
+            }
+            writer.writeString(displayName);
+
+            if (displayData->displayType == CS_DISPLAY_SPRITE)
+            {
+                writer.writeBaseData(&((CCSpriteDisplayData *)displayData)->skinData);
+            }
+        }
+    }
+}
+
+static unsigned int writeAnimationData(CCBinaryWriter &writer, CCAnimationData *animationData)
+{
+    unsigned int frameCount = 0;
+
+    writer.writeString(animationData->name);
+    writer.writeUInt(animationData->movementNames.size());
+    for (unsigned int i = 0; i < animationData->movementNames.size(); ++i)
+    {
+        CCMovementData *movementData = animationData->getMovement(animationData->movementNames[i].c_str());
+        writer.writeString(movementData->name);
+        writer.writeInt(movementData->duration);
+        writer.writeFloat(movementData->scale);
+        writer.writeInt(movementData->durationTo);
+        writer.writeInt(movementData->durationTween);
+        writer.writeU8(movementData->loop);
+        writer.writeInt(movementData->tweenEasing);
+        writer.writeUInt(movementData->movBoneDataDic.count());
+
+        CCDictionary *movBoneDataDic = &movementData->movBoneDataDic;
+        CCDictElement *element = NULL;
+        CCDICT_FOREACH(movBoneDataDic, element)
+        {
+            CCMovementBoneData *movementBoneData = (CCMovementBoneData *)element->getObject();
+            writer.writeString(movementBoneData->name);
+            writer.writeFloat(movementBoneData->delay);
+            writer.writeFloat(movementBoneData->scale);
+            writer.writeFloat(movementBoneData->duration);
+            writer.writeUInt(movementBoneData->frameList.count());
+            frameCount += movementBoneData->frameList.count();
+
+            CCArray *frameList = &movementBoneData->frameList;
+            CCObject *object = NULL;
+            CCARRAY_FOREACH(frameList, object)
+            {
+                CCFrameData *frameData = (CCFrameData *)object;
+                writer.writeBaseData(frameData);
+                writer.writeInt(frameData->frameID);
+                writer.writeInt(frameData->duration);
+                writer.writeInt(frameData->tweenEasing);
+                writer.writeInt(frameData->displayIndex);
+                writer.writeUInt(frameData->blendFunc.src);
+                writer.writeUInt(frameData->blendFunc.dst);
+                writer.writeU8(frameData->isTween);
+
+                writer.writeU8(frameData->easingParamNumber);
+                for (int j = 0; j < frameData->easingParamNumber; ++j)
+                {
+                    writer.writeFloat(frameData->easingParams[j]);
+                }
+
+                writer.writeString(frameData->strEvent);
+                writer.writeString(frameData->strMovement);
+                writer.writeString(frameData->strSound);
+                writer.writeString(frameData->strSoundEffect);
+            }
+        }
+    }
+
+    return frameCount;
+}
+
+static void writeTextureData(CCBinaryWriter &writer, CCTextureData *textureData)
+{
+    writer.writeString(textureData->name);
+    writer.writeFloat(textureData->width);
+    writer.writeFloat(textureData->height);
+    writer.writeFloat(textureData->pivotX);
+    writer.writeFloat(textureData->pivotY);
+    writer.writeUInt(textureData->contourDataList.count());
+
+    CCArray *contourDataList = &textureData->contourDataList;
+    CCObject *object = NULL;
+    CCARRAY_FOREACH(contourDataList, object)
+    {
+        CCContourData *contourData = (CCContourData *)object;
+        writer.writeUInt(contourData->vertexList.count());
+
+        CCArray *vertexList = &contourData->vertexList;
+        CCObject *vertexObject = NULL;
+        CCARRAY_FOREACH(vertexList, vertexObject)
+        {
+            CCContourVertex2 *vertex = (CCContourVertex2 *)vertexObject;
+            writer.writeFloat(vertex->x);
+            writer.writeFloat(vertex->y);
+        }
+    }
+}
+
+bool CCDataReaderHelper::convertToBinary(const char *filePath, const char *binaryFilePath)
+{
+    std::string filePathStr = filePath;
+    size_t startPos = filePathStr.find_last_of(".");
+    std::string str = startPos != std::string::npos ? filePathStr.substr(startPos) : "";
+
+    ConfigType configType;
+    if (str.compare(".xml") == 0)
+    {
+        configType = DragonBone_XML;
+    }
+    else if (str.compare(".json") == 0 || str.compare(".ExportJson") == 0)
+    {
+        configType = CocoStudio_JSON;
+    }
+    else
+    {
+        CCLOG("CCDataReaderHelper: can't convert %s, it isn't a xml or json file", filePath);
+        return false;
+    }
+
+    unsigned long size = 0;
+    std::string fullPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(filePath);
+    unsigned char *pBytes = CCFileUtils::sharedFileUtils()->getFileData(fullPath.c_str(), "r", &size);
+    if (!pBytes)
+    {
+        return false;
+    }
+    std::string content((const char *)pBytes, size);
+    CC_SAFE_DELETE_ARRAY(pBytes);
+
+    size_t pos = filePathStr.find_last_of("/");
+    std::string baseFilePath = pos != std::string::npos ? filePathStr.substr(0, pos + 1) : "";
+
+    ExportedDatas exportedDatas;
+    DataInfo dataInfo;
+    dataInfo.filename = filePathStr;
+    dataInfo.baseFilePath = baseFilePath;
+    dataInfo.exportedDatas = &exportedDatas;
+    // the binary file keeps the positions of the file, the read scale is applied when it is loaded
+    dataInfo.positionReadScale = 1;
+
+    if (configType == DragonBone_XML)
+    {
+        addDataFromCache(content.c_str(), &dataInfo);
+    }
+    else
+    {
+        addDataFromJsonCache(content.c_str(), &dataInfo);
+    }
+
+    CCBinaryWriter writer;
+    unsigned int frameCount = 0;
+
+    writer.writeUInt(exportedDatas.armatureDatas.size());
+    for (unsigned int i = 0; i < exportedDatas.armatureDatas.size(); ++i)
+    {
+        writeArmatureData(writer, exportedDatas.armatureDatas[i], baseFilePath);
+        exportedDatas.armatureDatas[i]->release();
+    }
+
+    writer.writeUInt(exportedDatas.animationDatas.size());
+    for (unsigned int i = 0; i < exportedDatas.animationDatas.size(); ++i)
+    {
+        frameCount += writeAnimationData(writer, exportedDatas.animationDatas[i]);
+        exportedDatas.animationDatas[i]->release();
+    }
+
+    writer.writeUInt(exportedDatas.textureDatas.size());
+    for (unsigned int i = 0; i < exportedDatas.textureDatas.size(); ++i)
+    {
+        writeTextureData(writer, exportedDatas.textureDatas[i]);
+        exportedDatas.textureDatas[i]->release();
+    }
+
+    writer.writeUInt(exportedDatas.configFiles.size());
+    for (unsigned int i = 0; i < exportedDatas.configFiles.size(); ++i)
+    {
+        writer.writeString(exportedDatas.configFiles[i]);
+    }
+
+    std::string file = writer.getFile((unsigned char)configType, frameCount);
+
+    FILE *fp = fopen(binaryFilePath, "wb");
+    if (!fp)
+    {
+        CCLOG("CCDataReaderHelper: can't write %s", binaryFilePath);
+        return false;
+    }
+    bool written = fwrite(file.data(), 1, file.size(), fp) == file.size();
+    fclose(fp);
+    return written;
+}
+
+static CCArmatureData *readArmatureData(CCBinaryReader &reader, DataInfo *dataInfo, float positionReadScale)
+{
+    CCArmatureData *armatureData = new CCArmatureData();
+    armatureData->init();
+
+    armatureData->name = reader.readString();
+    armatureData->dataVersion = reader.readFloat();
+
+    unsigned int boneCount = reader.readCount(1);
+    for (unsigned int i = 0; i < boneCount && !reader.hasError(); ++i)
+    {
+        CCBoneData *boneData = new CCBoneData();
+        boneData->init();
+        reader.readBaseData(boneData);
+        boneData->name = reader.readString();
+        boneData->parentName = reader.readString();
+
+        unsigned int displayCount = reader.readCount(1);
+        for (unsigned int j = 0; j < displayCount && !reader.hasError(); ++j)
+        {
+            DisplayType displayType = (DisplayType)reader.readU8();
+            CCDisplayData *displayData = NULL;
+            switch (displayType)
+            {
+            case CS_DISPLAY_ARMATURE:
+                displayData = new CCArmatureDisplayData();
+                break;
+            case CS_DISPLAY_PARTICLE:
+                displayData = new CCParticleDisplayData();
+                break;
+            default:
+                displayData = new CCSpriteDisplayData();
+                break;
+            }
+            displayData->displayType = displayType;
+            displayData->displayName = reader.readString();
+
+            if (displayType == CS_DISPLAY_PARTICLE)
+            {
+                displayData->displayName = dataInfo->baseFilePath + displayData->displayName;
+            }
+            else if (displayType == CS_DISPLAY_SPRITE)
+            {
+                CCBaseData &skinData = ((CCSpriteDisplayData *)displayData)->skinData;
+                reader.readBaseData(&skinData);
+                skinData.x *= positionReadScale;
+                skinData.y *= positionReadScale;
+            }
+
+            boneData->addDisplayData(displayData);
+            displayData->release();
+        }
+
+        armatureData->addBoneData(boneData);
+        boneData->release();
+    }
+
+    return armatureData;
+}
+
+static CCAnimationData *readAnimationData(CCBinaryReader &reader, CCFrameDataBlock *frameDataBlock, unsigned int &frameIndex, float positionReadScale)
+{
+    CCAnimationData *animationData = new CCAnimationData();
+    animationData->name = reader.readString();
+
+    unsigned int movementCount = reader.readCount(1);
+    for (unsigned int i = 0; i < movementCount && !reader.hasError(); ++i)
+    {
+        CCMovementData *movementData = new CCMovementData();
+        movementData->name = reader.readString();
+        movementData->duration = reader.readInt();
+        movementData->scale = reader.readFloat();
+        movementData->durationTo = reader.readInt();
+        movementData->durationTween = reader.readInt();
+        movementData->loop = reader.readU8() != 0;
+        movementData->tweenEasing = (CCTweenType)reader.readInt();
+
+        unsigned int movementBoneCount = reader.readCount(1);
+        for (unsigned int j = 0; j < movementBoneCount && !reader.hasError(); ++j)
+        {
+            CCMovementBoneData *movementBoneData = new CCMovementBoneData();
+            movementBoneData->name = reader.readString();
+            movementBoneData->delay = reader.readFloat();
+            movementBoneData->scale = reader.readFloat();
+            movementBoneData->duration = reader.readFloat();
+
+            unsigned int frameCount = reader.readCount(1);
+            if (frameCount > frameDataBlock->count - frameIndex)
+            {
+                // more frames than the header said
+                frameCount = 0;
+                reader.setError();
+            }
+            movementBoneData->frameList.initWithCapacity(frameCount > 0 ? frameCount : 1);
+            movementBoneData->setFrameDataBlock(frameDataBlock);
+
+            for (unsigned int k = 0; k < frameCount && !reader.hasError(); ++k)
+            {
+                CCFrameData *frameData = &frameDataBlock->frames[frameIndex++];
+                reader.readBaseData(frameData);
+                frameData->x *= positionReadScale;
+                frameData->y *= positionReadScale;
+                frameData->frameID = reader.readInt();
+                frameData->duration = reader.readInt();
+                frameData->tweenEasing = (CCTweenType)reader.readInt();
+                frameData->displayIndex = reader.readInt();
+                frameData->blendFunc.src = (GLenum)reader.readUInt();
+                frameData->blendFunc.dst = (GLenum)reader.readUInt();
+                frameData->isTween = reader.readU8() != 0;
+
+                frameData->easingParamNumber = reader.readU8();
+                if (frameData->easingParamNumber > 0)
+                {
+                    frameData->easingParams = new float[frameData->easingParamNumber];
+                    for (int l = 0; l < frameData->easingParamNumber; ++l)
+                    {
+                        frameData->easingParams[l] = reader.readFloat();
+                    }
+                }
+
+                frameData->strEvent = reader.readString();
+                frameData->strMovement = reader.readString();
+                frameData->strSound = reader.readString();
+                frameData->strSoundEffect = reader.readString();
+
+                movementBoneData->addFrameData(frameData);
+            }
+
+            movementData->addMovementBoneData(movementBoneData);
+            movementBoneData->release();
+        }
+
+        animationData->addMovement(movementData);
+        movementData->release();
+    }
+
+    return animationData;
+}
+
+static CCTextureData *readTextureData(CCBinaryReader &reader)
+{
+    CCTextureData *textureData = new CCTextureData();
+    textureData->init();
+
+    textureData->name = reader.readString();
+    textureData->width = reader.readFloat();
+    textureData->height = reader.readFloat();
+    textureData->pivotX = reader.readFloat();
+    textureData->pivotY = reader.readFloat();
+
+    unsigned int contourCount = reader.readCount(sizeof(unsigned int));
+    for (unsigned int i = 0; i < contourCount && !reader.hasError(); ++i)
+    {
+        CCContourData *contourData = new CCContourData();
+        contourData->init();
+
+        unsigned int vertexCount = reader.readCount(2 * sizeof(float));
+        for (unsigned int j = 0; j < vertexCount; ++j)
+        {
+            CCContourVertex2 *vertex = new CCContourVertex2(0, 0);
+            vertex->x = reader.readFloat();
+            vertex->y = reader.readFloat();
+
+            contourData->vertexList.addObject(vertex);
+            vertex->release();
+        }
+
+        textureData->contourDataList.addObject(contourData);
+        contourData->release();
+    }
+
+    return textureData;
+}
+
+void CCDataReaderHelper::addDataFromBinaryCache(const unsigned char *fileContent, unsigned long size, DataInfo *dataInfo)
+{
+    CCBinaryReader reader(fileContent, size);
+
+    char magic[sizeof(BINARY_MAGIC)];
+    reader.read(magic, sizeof(magic));
+    unsigned int version = reader.readUInt();
+    if (reader.hasError() || memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0 || version != BINARY_VERSION)
+    {
+        CCLOG("CCDataReaderHelper: %s isn't an armature binary file of version %u", dataInfo->filename.c_str(), BINARY_VERSION);
+        return;
+    }
+
+    ConfigType sourceType = (ConfigType)reader.readU8();
+    unsigned int frameCount = reader.readCount(1);
+    if (!reader.readStrings())
+    {
+        CCLOG("CCDataReaderHelper: %s is truncated", dataInfo->filename.c_str());
+        return;
+    }
+
+    // the read scale is applied to what the source file reader applies it to
+    float frameReadScale = sourceType == DragonBone_XML ? dataInfo->positionReadScale : 1;
+    float skinReadScale = sourceType == CocoStudio_JSON ? dataInfo->positionReadScale : 1;
+
+    // all the frames of the file in one allocation. Not autoreleased, this may run in the loading thread
+    CCFrameDataBlock *frameDataBlock = new CCFrameDataBlock();
+    frameDataBlock->init(frameCount);
+    unsigned int frameIndex = 0;
+
+    // decoded completely before anything is added, a truncated file doesn't leave half of its datas in the manager
+    ExportedDatas datas;
+
+    unsigned int count = reader.readCount(1);
+    for (unsigned int i = 0; i < count && !reader.hasError(); ++i)
+    {
+        datas.armatureDatas.push_back(readArmatureData(reader, dataInfo, skinReadScale));
+    }
+
+    count = reader.readCount(1);
+    for (unsigned int i = 0; i < count && !reader.hasError(); ++i)
+    {
+        datas.animationDatas.push_back(readAnimationData(reader, frameDataBlock, frameIndex, frameReadScale));
+    }
+    frameDataBlock->release();
+
+    count = reader.readCount(1);
+    for (unsigned int i = 0; i < count && !reader.hasError(); ++i)
+    {
+        datas.textureDatas.push_back(readTextureData(reader));
+    }
+
+    count = reader.readCount(sizeof(unsigned int));
+    for (unsigned int i = 0; i < count && !reader.hasError(); ++i)
+    {
+        datas.configFiles.push_back(reader.readString());
+    }
+
+    if (reader.hasError())
+    {
+        CCLOG("CCDataReaderHelper: %s is truncated", dataInfo->filename.c_str());
+        for (unsigned int i = 0; i < datas.armatureDatas.size(); ++i)
+        {
+            datas.armatureDatas[i]->release();
+        }
+        for (unsigned int i = 0; i < datas.animationDatas.size(); ++i)
+        {
+            datas.animationDatas[i]->release();
+        }
+        for (unsigned int i = 0; i < datas.textureDatas.size(); ++i)
+        {
+            datas.textureDatas[i]->release();
+        }
+        return;
+    }
+
+    for (unsigned int i = 0; i < datas.armatureDatas.size(); ++i)
+    {
+        addArmatureData(datas.armatureDatas[i], dataInfo);
+    }
+    for (unsigned int i = 0; i < datas.animationDatas.size(); ++i)
+    {
+        addAnimationData(datas.animationDatas[i], dataInfo);
+    }
+    for (unsigned int i = 0; i < datas.textureDatas.size(); ++i)
+    {
+        addTextureData(datas.textureDatas[i], dataInfo);
+    }
+    const std::vector<std::string> &configFiles = datas.configFiles;
+
+    // Auto load sprite file
+    bool autoLoad = dataInfo->asyncStruct == NULL ? CCArmatureDataManager::sharedArmatureDataManager()->isAutoLoadSpriteFile() : dataInfo->asyncStruct->autoLoadSpriteFile;
+    if (autoLoad)
+    {
+        for (unsigned int i = 0; i < configFiles.size(); ++i)
+        {
+            if (dataInfo->asyncStruct)
+            {
+                dataInfo->configFileQueue.push(configFiles[i]);
+            }
+            else
+            {
+                CCArmatureDataManager::sharedArmatureDataManager()->addSpriteFrameFromFile((dataInfo->baseFilePath + configFiles[i] + ".plist").c_str(), (dataInfo->baseFilePath + configFiles[i] + ".png").c_str(), dataInfo->filename.c_str());
+            }
+        }
+    }
+}
+
 NS_CC_EXT_END
@@ -40,6 +40,7 @@ namespace tinyxml2
 NS_CC_EXT_BEGIN
 
 typedef struct _DataInfo DataInfo;
+class CCAsyncSpriteSheet;
 /**
 *   @js NA
 *   @lua NA
@@ -57,7 +58,31 @@ public:
     static float getPositionReadScale();
 
     static void purge();
-    
+
+    /**
+     * The number of threads decoding the files of addDataFromFileAsync() in parallel, 1 by default.
+     * Whatever the count, the files may finish loading in another order than they were added:
+     * a file finishes once the textures of its sprite sheets are loaded, so a file without sprite
+     * sheets to load can finish before an earlier one still waiting on its textures.
+     * Once the loading threads are started, only raising the count has an effect.
+     * With more than one thread the XML, JSON and binary decoders run concurrently: they must
+     * only write to their DataInfo and the datas they create, and reach CCArmatureDataManager
+     * through the locked add and get helpers of this file. Shared helpers they call, like
+     * CCTransformHelp::transformFromParent, must not use static scratch datas.
+     * @since v2.2
+     */
+    static void setAsyncLoadingThreadCount(unsigned int count);
+    static unsigned int getAsyncLoadingThreadCount();
+
+    /**
+     * Sets a callback reporting the progress, between 0 and 1, of all the files being loaded by
+     * addDataFromFileAsync(). It's called on the main thread when the datas of a file are decoded
+     * and when one of its sprite sheets is loaded, and with 1 when every file is loaded.
+     * The target is retained. Pass NULL to remove the callback.
+     * @since v2.2
+     */
+    static void setAsyncProgressCallback(CCObject *target, SEL_SCHEDULE selector);
+
 public:
     ~CCDataReaderHelper();
 
@@ -122,7 +147,32 @@ public:
 	static CCContourData *decodeContour(const rapidjson::Value &json);
 
 	static void decodeNode(CCBaseData *node, const rapidjson::Value &json, DataInfo *dataInfo);
+
+public:
+    /**
+     * Converts a xml or json file exported by the flash tool or CocoStudio to the binary
+     * format of the .ExportBinary files, which addDataFromFile() and addDataFromFileAsync()
+     * load without parsing text. The binary file is written next to the particle files and
+     * sprite sheets of the source file.
+     *
+     * @param filePath The xml or json file
+     * @param binaryFilePath The path of the binary file to write, ending with .ExportBinary
+     * @return false if filePath can't be read or binaryFilePath can't be written
+     * @since v2.2
+     */
+    static bool convertToBinary(const char *filePath, const char *binaryFilePath);
+
+    /**
+     * Translate a file written by convertToBinary() to datas, and save them.
+     * The frames of all the movements are allocated together.
+     */
+    static void addDataFromBinaryCache(const unsigned char *fileContent, unsigned long size, DataInfo *dataInfo);
 private:
+    //! Called on the main thread once the datas and the sprite sheets of a file are loaded
+    void finishAsyncData(DataInfo *dataInfo);
+
+    friend class CCAsyncSpriteSheet;
+
     static std::vector<std::string> s_arrConfigFileList;
 
     static CCDataReaderHelper *s_DataReaderHelper;
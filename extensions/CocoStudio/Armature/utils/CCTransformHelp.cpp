@@ -41,13 +41,16 @@ CCTransformHelp::CCTransformHelp()
 
 void CCTransformHelp::transformFromParent(CCBaseData &node, const CCBaseData &parentNode)
 {
-    nodeToMatrix(node, helpMatrix1);
-    nodeToMatrix(parentNode, helpMatrix2);
+    // local matrices, the armature loading threads call this concurrently
+    CCAffineTransform nodeMatrix;
+    CCAffineTransform parentMatrix;
+    nodeToMatrix(node, nodeMatrix);
+    nodeToMatrix(parentNode, parentMatrix);
 
-    helpMatrix2 = CCAffineTransformInvert(helpMatrix2);
-    helpMatrix1 = CCAffineTransformConcat(helpMatrix1, helpMatrix2);
+    parentMatrix = CCAffineTransformInvert(parentMatrix);
+    nodeMatrix = CCAffineTransformConcat(nodeMatrix, parentMatrix);
 
-    matrixToNode(helpMatrix1, node);
+    matrixToNode(nodeMatrix, node);
 }
 
 void CCTransformHelp::transformToParent(CCBaseData &node, const CCBaseData &parentNode)
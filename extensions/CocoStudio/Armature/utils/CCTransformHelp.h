@@ -40,6 +40,7 @@ class  CC_EX_DLL CCTransformHelp
 public:
     CCTransformHelp();
 
+    //! Thread safe, used by the loading threads of CCDataReaderHelper. The other transforms use the shared help datas
     static void transformFromParent(CCBaseData &node, const CCBaseData &parentNode);
     static void transformToParent(CCBaseData &node, const CCBaseData &parentNode);
 
@@ -24,6 +24,12 @@ THE SOFTWARE.
 
 #include "CCUtilMath.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
 
 NS_CC_EXT_BEGIN
 
@@ -75,4 +81,123 @@ CCPoint circleTo(float t, CCPoint &center, float radius, float fromRadian, float
     return p;
 }
 
+/*
+ * sinCosArray: the angle is reduced to r in [-pi/4, pi/4] and its quadrant q, with
+ * angle = q * pi/2 + r. pi/2 is split in three parts so that q * pi/2 is exact enough.
+ * Polynomials from the Cephes library.
+ */
+#define CC_SINCOS_TWO_OVER_PI   0.636619772367581f
+#define CC_SINCOS_HALF_PI_1     1.5703125f
+#define CC_SINCOS_HALF_PI_2     4.837512969970703125e-4f
+#define CC_SINCOS_HALF_PI_3     7.54978995489188216e-8f
+#define CC_SINCOS_SIN_1         -1.6666654611e-1f
+#define CC_SINCOS_SIN_2         8.3321608736e-3f
+#define CC_SINCOS_SIN_3         -1.9515295891e-4f
+#define CC_SINCOS_COS_1         4.166664568298827e-2f
+#define CC_SINCOS_COS_2         -1.388731625493765e-3f
+#define CC_SINCOS_COS_3         2.443315711809948e-5f
+
+static inline void sinCos(float radians, float *sine, float *cosine)
+{
+    float scaled = radians * CC_SINCOS_TWO_OVER_PI;
+    int quadrant = (int)(scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+    float q = (float)quadrant;
+    float r = radians - q * CC_SINCOS_HALF_PI_1 - q * CC_SINCOS_HALF_PI_2 - q * CC_SINCOS_HALF_PI_3;
+    float r2 = r * r;
+
+    float s = r + r * r2 * (CC_SINCOS_SIN_1 + r2 * (CC_SINCOS_SIN_2 + r2 * CC_SINCOS_SIN_3));
+    float c = 1.0f - 0.5f * r2 + r2 * r2 * (CC_SINCOS_COS_1 + r2 * (CC_SINCOS_COS_2 + r2 * CC_SINCOS_COS_3));
+
+    if (quadrant & 1)
+    {
+        float t = s;
+        s = c;
+        c = t;
+    }
+    *sine = (quadrant & 2) ? -s : s;
+    *cosine = ((quadrant + 1) & 2) ? -c : c;
+}
+
+void sinCosArray(const float *radians, float *sines, float *cosines, int count)
+{
+    int i = 0;
+
+#if defined(__SSE2__)
+    const __m128 twoOverPi = _mm_set1_ps(CC_SINCOS_TWO_OVER_PI);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i two = _mm_set1_epi32(2);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(radians + i);
+        // rounds to the nearest
+        __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, twoOverPi));
+        __m128 q = _mm_cvtepi32_ps(quadrant);
+        __m128 r = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(CC_SINCOS_HALF_PI_1)));
+        r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(CC_SINCOS_HALF_PI_2)));
+        r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(CC_SINCOS_HALF_PI_3)));
+        __m128 r2 = _mm_mul_ps(r, r);
+
+        __m128 s = _mm_add_ps(_mm_set1_ps(CC_SINCOS_SIN_2), _mm_mul_ps(r2, _mm_set1_ps(CC_SINCOS_SIN_3)));
+        s = _mm_add_ps(_mm_set1_ps(CC_SINCOS_SIN_1), _mm_mul_ps(r2, s));
+        s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), s));
+
+        __m128 c = _mm_add_ps(_mm_set1_ps(CC_SINCOS_COS_2), _mm_mul_ps(r2, _mm_set1_ps(CC_SINCOS_COS_3)));
+        c = _mm_add_ps(_mm_set1_ps(CC_SINCOS_COS_1), _mm_mul_ps(r2, c));
+        c = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), r2)), _mm_mul_ps(_mm_mul_ps(r2, r2), c));
+
+        __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+        __m128 sine = _mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s));
+        __m128 cosine = _mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c));
+
+        // bit 1 of the quadrant moved to the sign bit
+        __m128 sineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, two), 30));
+        __m128 cosineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), 30));
+        _mm_storeu_ps(sines + i, _mm_xor_ps(sine, sineSign));
+        _mm_storeu_ps(cosines + i, _mm_xor_ps(cosine, cosineSign));
+    }
+#elif defined(__ARM_NEON__)
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const uint32x4_t one = vdupq_n_u32(1);
+    const uint32x4_t two = vdupq_n_u32(2);
+    const uint32x4_t signMask = vdupq_n_u32(0x80000000);
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t x = vld1q_f32(radians + i);
+        float32x4_t scaled = vmulq_n_f32(x, CC_SINCOS_TWO_OVER_PI);
+        // the conversion truncates: rounds to the nearest by adding 0.5 with the sign of the angle
+        float32x4_t rounding = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(half), vandq_u32(vreinterpretq_u32_f32(scaled), signMask)));
+        int32x4_t quadrant = vcvtq_s32_f32(vaddq_f32(scaled, rounding));
+        float32x4_t q = vcvtq_f32_s32(quadrant);
+        float32x4_t r = vmlsq_n_f32(x, q, CC_SINCOS_HALF_PI_1);
+        r = vmlsq_n_f32(r, q, CC_SINCOS_HALF_PI_2);
+        r = vmlsq_n_f32(r, q, CC_SINCOS_HALF_PI_3);
+        float32x4_t r2 = vmulq_f32(r, r);
+
+        float32x4_t s = vmlaq_n_f32(vdupq_n_f32(CC_SINCOS_SIN_2), r2, CC_SINCOS_SIN_3);
+        s = vmlaq_f32(vdupq_n_f32(CC_SINCOS_SIN_1), r2, s);
+        s = vmlaq_f32(r, vmulq_f32(r, r2), s);
+
+        float32x4_t c = vmlaq_n_f32(vdupq_n_f32(CC_SINCOS_COS_2), r2, CC_SINCOS_COS_3);
+        c = vmlaq_f32(vdupq_n_f32(CC_SINCOS_COS_1), r2, c);
+        c = vmlaq_f32(vmlsq_f32(vdupq_n_f32(1.0f), half, r2), vmulq_f32(r2, r2), c);
+
+        uint32x4_t quadrantBits = vreinterpretq_u32_s32(quadrant);
+        uint32x4_t swap = vceqq_u32(vandq_u32(quadrantBits, one), one);
+        float32x4_t sine = vbslq_f32(swap, c, s);
+        float32x4_t cosine = vbslq_f32(swap, s, c);
+
+        // bit 1 of the quadrant moved to the sign bit
+        uint32x4_t sineSign = vshlq_n_u32(vandq_u32(quadrantBits, two), 30);
+        uint32x4_t cosineSign = vshlq_n_u32(vandq_u32(vaddq_u32(quadrantBits, one), two), 30);
+        vst1q_f32(sines + i, vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(sine), sineSign)));
+        vst1q_f32(cosines + i, vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(cosine), cosineSign)));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        sinCos(radians[i], &sines[i], &cosines[i]);
+    }
+}
+
 NS_CC_EXT_END
@@ -49,6 +49,13 @@ CC_EX_DLL CCPoint bezierTo(float t, CCPoint &point1, CCPoint &point2, CCPoint &p
 
 CC_EX_DLL CCPoint circleTo(float t, CCPoint &center, float radius, float fromRadian, float radianDif);
 
+/**
+ * Computes the sine and the cosine of count angles in radians, four at a time with SSE2 or NEON.
+ * The error is below 1e-6 for the angles of the bones, within a few turns of 0.
+ * @since v2.2
+ */
+CC_EX_DLL void sinCosArray(const float *radians, float *sines, float *cosines, int count);
+
 
 NS_CC_EXT_END
 
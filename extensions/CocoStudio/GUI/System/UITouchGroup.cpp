@@ -24,6 +24,7 @@
 
 #include "UITouchGroup.h"
 #include "UIHelper.h"
+#include "../Layouts/UILayout.h"
 
 NS_CC_BEGIN
 
@@ -98,6 +99,13 @@ bool TouchGroup::checkTouchEvent(Widget *root, CCTouch* touch, CCEvent* pEvent)
 {
     ccArray* arrayRootChildren = root->getChildren()->data;
     int length = arrayRootChildren->num;
+    // A clipping layout hides whatever lies outside of it, so none of its
+    // children can be hit when the touch misses it: skip them all at once.
+    Layout* layout = dynamic_cast<Layout*>(root);
+    if (length > 0 && layout && layout->isClippingEnabled() && !layout->hitTest(touch->getLocation()))
+    {
+        length = 0;
+    }
     for (int i=length-1; i >= 0; i--)
     {
         Widget* widget = (Widget*)(arrayRootChildren->arr[i]);
@@ -162,10 +162,9 @@ void TriggerMng::removeAll(void)
 {
     if(_eventTriggers != NULL)
     {
-        CCDictElement *pElement, *tmp;
-        HASH_ITER(hh, _eventTriggers->m_pElements, pElement, tmp)
+        CCDictElement *pElement = NULL;
+        CCDICT_FOREACH(_eventTriggers, pElement)
         {
-            HASH_DEL(_eventTriggers->m_pElements, pElement);
             CCObject* pObj = NULL;
             CCARRAY_FOREACH(((CCArray*)pElement->getObject()), pObj)
             {
@@ -175,8 +174,7 @@ void TriggerMng::removeAll(void)
                     triobj->removeAll();
                 }
             }
-            CC_SAFE_RELEASE(pElement->getObject());
-            CC_SAFE_DELETE(pElement);
+            _eventTriggers->removeObjectForElememt(pElement);
         }
     }
 }
@@ -25,6 +25,7 @@
 
 #include <spine/CCSkeleton.h>
 #include <spine/spine-cocos2dx.h>
+#include <spine/CCSkeletonDataCache.h>
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32 && _MSC_VER >= 1800) // Visual Studio 2013
 #include <algorithm>
 #endif
@@ -55,6 +56,7 @@ CCSkeleton* CCSkeleton::createWithFile (const char* skeletonDataFile, const char
 
 void CCSkeleton::initialize () {
 	atlas = 0;
+	cachedData = 0;
 	debugSlots = false;
 	debugBones = false;
 	timeScale = 1;
@@ -98,22 +100,19 @@ CCSkeleton::CCSkeleton (const char* skeletonDataFile, Atlas* atlas, float scale)
 CCSkeleton::CCSkeleton (const char* skeletonDataFile, const char* atlasFile, float scale) {
 	initialize();
 
-	atlas = Atlas_readAtlasFile(atlasFile);
-	CCAssert(atlas, "Error reading atlas file.");
+	// the copies of a skeleton share its data and atlas
+	cachedData = CCSkeletonDataCache::sharedSkeletonDataCache()->addSkeletonData(skeletonDataFile, atlasFile, scale);
+	CCAssert(cachedData, "Error reading skeleton data file.");
+	cachedData->retain();
 
-	SkeletonJson* json = SkeletonJson_create(atlas);
-	json->scale = scale;
-	SkeletonData* skeletonData = SkeletonJson_readSkeletonDataFile(json, skeletonDataFile);
-	CCAssert(skeletonData, json->error ? json->error : "Error reading skeleton data file.");
-	SkeletonJson_dispose(json);
-
-	setSkeletonData(skeletonData, true);
+	setSkeletonData(cachedData->skeletonData, false);
 }
 
 CCSkeleton::~CCSkeleton () {
 	if (ownsSkeletonData) SkeletonData_dispose(skeleton->data);
 	if (atlas) Atlas_dispose(atlas);
 	Skeleton_dispose(skeleton);
+	CC_SAFE_RELEASE(cachedData);
 }
 
 void CCSkeleton::update (float deltaTime) {
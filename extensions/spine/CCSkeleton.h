@@ -31,6 +31,8 @@
 
 namespace cocos2d { namespace extension {
 
+class CCSkeletonCachedData;
+
 /**
 Draws a skeleton.
 */
@@ -49,6 +51,7 @@ public:
 
 	CCSkeleton (SkeletonData* skeletonData, bool ownsSkeletonData = false);
 	CCSkeleton (const char* skeletonDataFile, Atlas* atlas, float scale = 1);
+	/* Shares the skeleton data and atlas of the files with the other skeletons, see CCSkeletonDataCache. */
 	CCSkeleton (const char* skeletonDataFile, const char* atlasFile, float scale = 1);
 
 	virtual ~CCSkeleton ();
@@ -92,6 +95,7 @@ protected:
 private:
 	bool ownsSkeletonData;
 	Atlas* atlas;
+	CCSkeletonCachedData* cachedData;
 	void initialize ();
 };
 
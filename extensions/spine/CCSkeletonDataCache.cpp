@@ -0,0 +1,251 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <spine/CCSkeletonDataCache.h>
+#include <spine/extension.h>
+#include <map>
+
+USING_NS_CC;
+
+namespace cocos2d { namespace extension {
+
+static CCSkeletonDataCache* sharedCache = 0;
+
+/* Counts the bytes the spine runtime allocates while reading and still holds once the read returns,
+ * see getMemorySize(). What is freed during the read, like the Json tree and the SkeletonJson, isn't
+ * counted. Strings aren't allocated through _malloc and aren't counted. */
+static void* (*previousMalloc) (size_t size) = 0;
+static void (*previousFree) (void* ptr) = 0;
+static std::map<void*, size_t> liveAllocations;
+static unsigned int allocatedSize = 0;
+
+static void* countingMalloc (size_t size) {
+	void* ptr = previousMalloc(size);
+	if (ptr) {
+		liveAllocations[ptr] = size;
+		allocatedSize += size;
+	}
+	return ptr;
+}
+
+static void countingFree (void* ptr) {
+	std::map<void*, size_t>::iterator allocation = liveAllocations.find(ptr);
+	if (allocation != liveAllocations.end()) {
+		allocatedSize -= allocation->second;
+		liveAllocations.erase(allocation);
+	}
+	previousFree(ptr);
+}
+
+static void startCountingAllocations () {
+	allocatedSize = 0;
+	previousMalloc = _getMalloc();
+	previousFree = _getFree();
+	_setMalloc(countingMalloc);
+	_setFree(countingFree);
+}
+
+static unsigned int stopCountingAllocations () {
+	_setMalloc(previousMalloc);
+	_setFree(previousFree);
+	liveAllocations.clear();
+	return allocatedSize;
+}
+
+static std::string skeletonDataKey (const std::string& skeletonDataPath, const std::string& atlasPath, float scale) {
+	char scaleString[32];
+	sprintf(scaleString, "%g", scale);
+	return skeletonDataPath + "|" + atlasPath + "|" + scaleString;
+}
+
+CCSkeletonCachedAtlas::CCSkeletonCachedAtlas (Atlas* atlas, unsigned int memorySize) :
+		atlas(atlas), memorySize(memorySize) {
+}
+
+CCSkeletonCachedAtlas::~CCSkeletonCachedAtlas () {
+	Atlas_dispose(atlas);
+}
+
+CCSkeletonCachedData::CCSkeletonCachedData (SkeletonData* skeletonData, CCSkeletonCachedAtlas* atlas, unsigned int memorySize) :
+		skeletonData(skeletonData), atlas(atlas), memorySize(memorySize) {
+	atlas->retain();
+}
+
+CCSkeletonCachedData::~CCSkeletonCachedData () {
+	SkeletonData_dispose(skeletonData);
+	// the attachments of the skeleton data reference the regions of the atlas
+	atlas->release();
+}
+
+CCSkeletonDataCache* CCSkeletonDataCache::sharedSkeletonDataCache () {
+	if (!sharedCache) {
+		sharedCache = new CCSkeletonDataCache();
+		CCNotificationCenter::sharedNotificationCenter()->addObserver(sharedCache,
+			callfuncO_selector(CCSkeletonDataCache::directorWillPurge), EVENT_DIRECTOR_PURGE, NULL);
+	}
+	return sharedCache;
+}
+
+void CCSkeletonDataCache::purgeSharedSkeletonDataCache () {
+	if (sharedCache) {
+		CCNotificationCenter::sharedNotificationCenter()->removeObserver(sharedCache, EVENT_DIRECTOR_PURGE);
+		CC_SAFE_RELEASE_NULL(sharedCache);
+	}
+}
+
+void CCSkeletonDataCache::directorWillPurge (CCObject* object) {
+	CC_UNUSED_PARAM(object);
+	purgeSharedSkeletonDataCache();
+}
+
+CCSkeletonDataCache::CCSkeletonDataCache () {
+	skeletonDatas = new CCDictionary();
+	atlases = new CCDictionary();
+}
+
+CCSkeletonDataCache::~CCSkeletonDataCache () {
+	CC_SAFE_RELEASE(skeletonDatas);
+	CC_SAFE_RELEASE(atlases);
+}
+
+CCSkeletonCachedAtlas* CCSkeletonDataCache::addAtlas (const char* atlasFile) {
+	std::string atlasPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(atlasFile);
+	CCSkeletonCachedAtlas* cachedAtlas = (CCSkeletonCachedAtlas*)atlases->objectForKey(atlasPath);
+	if (cachedAtlas) return cachedAtlas;
+
+	startCountingAllocations();
+	Atlas* atlas = Atlas_readAtlasFile(atlasFile);
+	unsigned int memorySize = stopCountingAllocations();
+	if (!atlas) return 0;
+
+	cachedAtlas = new CCSkeletonCachedAtlas(atlas, memorySize);
+	atlases->setObject(cachedAtlas, atlasPath);
+	cachedAtlas->release();
+	return cachedAtlas;
+}
+
+CCSkeletonCachedData* CCSkeletonDataCache::addSkeletonData (const char* skeletonDataFile, const char* atlasFile, float scale) {
+	CCFileUtils* fileUtils = CCFileUtils::sharedFileUtils();
+	std::string key = skeletonDataKey(fileUtils->fullPathForFilename(skeletonDataFile), fileUtils->fullPathForFilename(atlasFile), scale);
+	CCSkeletonCachedData* cachedData = (CCSkeletonCachedData*)skeletonDatas->objectForKey(key);
+	if (cachedData) return cachedData;
+
+	CCSkeletonCachedAtlas* cachedAtlas = addAtlas(atlasFile);
+	if (!cachedAtlas) {
+		CCLOG("Error reading atlas file %s.", atlasFile);
+		return 0;
+	}
+
+	startCountingAllocations();
+	SkeletonJson* json = SkeletonJson_create(cachedAtlas->atlas);
+	json->scale = scale;
+	SkeletonData* skeletonData = SkeletonJson_readSkeletonDataFile(json, skeletonDataFile);
+	if (!skeletonData) CCLOG("%s", json->error ? json->error : "Error reading skeleton data file.");
+	SkeletonJson_dispose(json);
+	unsigned int memorySize = stopCountingAllocations();
+	if (!skeletonData) return 0;
+
+	cachedData = new CCSkeletonCachedData(skeletonData, cachedAtlas, memorySize);
+	skeletonDatas->setObject(cachedData, key);
+	cachedData->release();
+	return cachedData;
+}
+
+CCSkeletonCachedData* CCSkeletonDataCache::skeletonDataForKey (const char* skeletonDataFile, const char* atlasFile, float scale) {
+	CCFileUtils* fileUtils = CCFileUtils::sharedFileUtils();
+	std::string key = skeletonDataKey(fileUtils->fullPathForFilename(skeletonDataFile), fileUtils->fullPathForFilename(atlasFile), scale);
+	return (CCSkeletonCachedData*)skeletonDatas->objectForKey(key);
+}
+
+void CCSkeletonDataCache::removeSkeletonData (const char* skeletonDataFile, const char* atlasFile, float scale) {
+	CCFileUtils* fileUtils = CCFileUtils::sharedFileUtils();
+	std::string atlasPath = fileUtils->fullPathForFilename(atlasFile);
+	skeletonDatas->removeObjectForKey(skeletonDataKey(fileUtils->fullPathForFilename(skeletonDataFile), atlasPath, scale));
+
+	// the atlas is only held by the cache once no skeleton data uses it
+	CCObject* atlas = atlases->objectForKey(atlasPath);
+	if (atlas && atlas->retainCount() == 1) atlases->removeObjectForKey(atlasPath);
+}
+
+void CCSkeletonDataCache::removeUnusedSkeletonData () {
+	CCDictElement* element = 0;
+	CCDICT_FOREACH(skeletonDatas, element) {
+		CCSkeletonCachedData* cachedData = (CCSkeletonCachedData*)element->getObject();
+		if (cachedData->retainCount() == 1) {
+			CCLOG("cocos2d: CCSkeletonDataCache: removing unused skeleton data: %s", element->getStrKey());
+			skeletonDatas->removeObjectForElememt(element);
+		}
+	}
+
+	// after the skeleton datas, which retain their atlas
+	CCDICT_FOREACH(atlases, element) {
+		if (element->getObject()->retainCount() == 1) {
+			CCLOG("cocos2d: CCSkeletonDataCache: removing unused atlas: %s", element->getStrKey());
+			atlases->removeObjectForElememt(element);
+		}
+	}
+}
+
+void CCSkeletonDataCache::removeAllSkeletonData () {
+	skeletonDatas->removeAllObjects();
+	atlases->removeAllObjects();
+}
+
+unsigned int CCSkeletonDataCache::getSkeletonDataCount () const {
+	return skeletonDatas->count();
+}
+
+unsigned int CCSkeletonDataCache::getAtlasCount () const {
+	return atlases->count();
+}
+
+unsigned int CCSkeletonDataCache::getMemorySize () const {
+	unsigned int memorySize = 0;
+	CCDictElement* element = 0;
+	CCDICT_FOREACH(skeletonDatas, element) {
+		memorySize += ((CCSkeletonCachedData*)element->getObject())->memorySize;
+	}
+	CCDICT_FOREACH(atlases, element) {
+		memorySize += ((CCSkeletonCachedAtlas*)element->getObject())->memorySize;
+	}
+	return memorySize;
+}
+
+void CCSkeletonDataCache::dumpCachedSkeletonDataInfo () const {
+#if COCOS2D_DEBUG > 0
+	CCDictElement* element = 0;
+	CCDICT_FOREACH(skeletonDatas, element) {
+		CCSkeletonCachedData* cachedData = (CCSkeletonCachedData*)element->getObject();
+		CCLOG("cocos2d: \"%s\" rc=%lu skeletons, %.2f KB", element->getStrKey(), (unsigned long)cachedData->retainCount() - 1, cachedData->memorySize / 1024.0f);
+	}
+	CCDICT_FOREACH(atlases, element) {
+		CCSkeletonCachedAtlas* cachedAtlas = (CCSkeletonCachedAtlas*)element->getObject();
+		CCLOG("cocos2d: \"%s\" rc=%lu, %.2f KB", element->getStrKey(), (unsigned long)cachedAtlas->retainCount(), cachedAtlas->memorySize / 1024.0f);
+	}
+#endif
+	CCLOG("cocos2d: CCSkeletonDataCache: %u skeleton datas, %u atlases, %.2f KB",
+		getSkeletonDataCount(), getAtlasCount(), getMemorySize() / 1024.0f);
+}
+
+}} // namespace cocos2d { namespace extension {
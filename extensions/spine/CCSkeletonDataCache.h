@@ -0,0 +1,119 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef SPINE_CCSKELETONDATACACHE_H_
+#define SPINE_CCSKELETONDATACACHE_H_
+
+#include <spine/spine.h>
+#include "cocos2d.h"
+
+namespace cocos2d { namespace extension {
+
+/**
+An atlas read by CCSkeletonDataCache, shared by the skeleton datas read with it.
+@js NA
+@lua NA
+*/
+class CC_EX_DLL CCSkeletonCachedAtlas: public cocos2d::CCObject {
+public:
+	Atlas* atlas;
+	/* Bytes allocated by the spine runtime to read the atlas, not counting the textures. */
+	unsigned int memorySize;
+
+	CCSkeletonCachedAtlas (Atlas* atlas, unsigned int memorySize);
+	virtual ~CCSkeletonCachedAtlas ();
+};
+
+/**
+A skeleton data read by CCSkeletonDataCache. The skeletons using it retain it, it's disposed once
+the last one is released and the cache doesn't hold it anymore.
+@js NA
+@lua NA
+*/
+class CC_EX_DLL CCSkeletonCachedData: public cocos2d::CCObject {
+public:
+	SkeletonData* skeletonData;
+	CCSkeletonCachedAtlas* atlas;
+	/* Bytes allocated by the spine runtime to read the skeleton data. */
+	unsigned int memorySize;
+
+	CCSkeletonCachedData (SkeletonData* skeletonData, CCSkeletonCachedAtlas* atlas, unsigned int memorySize);
+	virtual ~CCSkeletonCachedData ();
+};
+
+/**
+Singleton sharing the skeleton datas and atlases read from files between CCSkeleton instances.
+The skeleton datas are keyed by skeleton data file, atlas file and scale, the atlases by atlas file.
+CCSkeleton::createWithFile(const char*, const char*, float) and CCSkeletonAnimation use it, so the
+copies of a character parse its files once.
+@since v2.2
+@js NA
+@lua NA
+*/
+class CC_EX_DLL CCSkeletonDataCache: public cocos2d::CCObject {
+public:
+	static CCSkeletonDataCache* sharedSkeletonDataCache ();
+	/* Releases the shared cache. The skeletons still alive keep their datas until they are released.
+	 * Called when the director is purged: the cached atlases hold textures of the GL context. */
+	static void purgeSharedSkeletonDataCache ();
+
+	/* EVENT_DIRECTOR_PURGE observer. */
+	void directorWillPurge (CCObject* object);
+
+	virtual ~CCSkeletonDataCache ();
+
+	/* Returns the cached skeleton data for the files and scale, reading it first if it isn't cached.
+	 * The returned object isn't retained for the caller. Returns 0 if a file can't be read. */
+	CCSkeletonCachedData* addSkeletonData (const char* skeletonDataFile, const char* atlasFile, float scale = 1);
+	/* Returns 0 if the skeleton data isn't cached. */
+	CCSkeletonCachedData* skeletonDataForKey (const char* skeletonDataFile, const char* atlasFile, float scale = 1);
+
+	/* Stops caching a skeleton data. Its atlas stays cached while other skeleton datas use it. */
+	void removeSkeletonData (const char* skeletonDataFile, const char* atlasFile, float scale = 1);
+	/* Disposes the skeleton datas and atlases no skeleton uses. */
+	void removeUnusedSkeletonData ();
+	/* Stops caching every skeleton data and atlas. The ones in use are disposed with their last skeleton. */
+	void removeAllSkeletonData ();
+
+	unsigned int getSkeletonDataCount () const;
+	unsigned int getAtlasCount () const;
+	/* Bytes allocated by the spine runtime for the skeleton datas and atlases held by the cache.
+	 * The textures of the atlases are held by CCTextureCache and aren't counted. */
+	unsigned int getMemorySize () const;
+
+	/* Logs the cached skeleton datas and atlases, with their memory and use counts. */
+	void dumpCachedSkeletonDataInfo () const;
+
+protected:
+	CCSkeletonDataCache ();
+
+	CCSkeletonCachedAtlas* addAtlas (const char* atlasFile);
+
+	cocos2d::CCDictionary* skeletonDatas;
+	cocos2d::CCDictionary* atlases;
+};
+
+}} // namespace cocos2d { namespace extension {
+
+#endif /* SPINE_CCSKELETONDATACACHE_H_ */
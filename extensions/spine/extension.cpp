@@ -49,6 +49,12 @@ void _setMalloc (void* (*malloc) (size_t size)) {
 void _setFree (void (*free) (void* ptr)) {
 	freeFunc = free;
 }
+void* (*_getMalloc ()) (size_t size) {
+	return mallocFunc;
+}
+void (*_getFree ()) (void* ptr) {
+	return freeFunc;
+}
 
 char* _readFile (const char* path, int* length) {
 	char *data;
@@ -108,6 +108,10 @@ CC_EX_DLL void _free (void* ptr);
 
 CC_EX_DLL void _setMalloc (void* (*_malloc) (size_t size));
 CC_EX_DLL void _setFree (void (*_free) (void* ptr));
+/* Returns the function set by _setMalloc, malloc by default. */
+CC_EX_DLL void* (*_getMalloc ()) (size_t size);
+/* Returns the function set by _setFree, free by default. */
+CC_EX_DLL void (*_getFree ()) (void* ptr);
 
 CC_EX_DLL char* _readFile (const char* path, int* length);
 
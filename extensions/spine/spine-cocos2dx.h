@@ -30,6 +30,7 @@
 #include "cocos2d.h"
 #include <spine/CCSkeleton.h>
 #include <spine/CCSkeletonAnimation.h>
+#include <spine/CCSkeletonDataCache.h>
 
 namespace cocos2d { namespace extension {
 
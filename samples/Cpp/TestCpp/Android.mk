@@ -126,6 +126,8 @@ Classes/MutiTouchTest/MutiTouchTest.cpp \
 Classes/ParallaxTest/ParallaxTest.cpp \
 Classes/ParticleTest/ParticleTest.cpp \
 Classes/PerformanceTest/PerformanceAllocTest.cpp \
+Classes/PerformanceTest/PerformanceLabelTest.cpp \
+Classes/PerformanceTest/PerformanceBenchmark.cpp \
 Classes/PerformanceTest/PerformanceNodeChildrenTest.cpp \
 Classes/PerformanceTest/PerformanceParticleTest.cpp \
 Classes/PerformanceTest/PerformanceSpriteTest.cpp \
@@ -15,7 +15,7 @@ CCLayer* restartActionManagerAction();
 
 static int sceneIdx = -1; 
 
-#define MAX_LAYER    5
+#define MAX_LAYER    6
 
 CCLayer* createActionManagerLayer(int nIndex)
 {
@@ -26,6 +26,7 @@ CCLayer* createActionManagerLayer(int nIndex)
         case 2: return new PauseTest();
         case 3: return new RemoveTest();
         case 4: return new ResumeTest();
+        case 5: return new ThroughputTest();
     }
 
     return NULL;
@@ -326,6 +327,101 @@ void ResumeTest::resumeGrossini(float time)
     pDirector->getActionManager()->resumeTarget(pGrossini);
 }
 
+//------------------------------------------------------------------
+//
+// ThroughputTest
+//
+//------------------------------------------------------------------
+#define kThroughputNodes 20000
+
+ThroughputTest::ThroughputTest(void)
+: m_pScheduler(NULL)
+, m_pActionManager(NULL)
+, m_pLabel(NULL)
+, m_pMovers(NULL)
+, m_fUpdateTime(0)
+, m_nFrames(0)
+{
+}
+
+ThroughputTest::~ThroughputTest(void)
+{
+    CC_SAFE_RELEASE(m_pMovers);
+    CC_SAFE_RELEASE(m_pActionManager);
+    CC_SAFE_RELEASE(m_pScheduler);
+}
+
+std::string ThroughputTest::title()
+{
+    return "Action Throughput";
+}
+
+void ThroughputTest::onEnter()
+{
+    ActionManagerTest::onEnter();
+
+    m_pLabel = CCLabelTTF::create("", "Thonburi", 16);
+    addChild(m_pLabel);
+    m_pLabel->setPosition( ccp(VisibleRect::center().x, VisibleRect::top().y - 75) );
+
+    // a private scheduler and action manager so that only the action update is timed
+    m_pScheduler = new CCScheduler();
+    m_pActionManager = new CCActionManager();
+    m_pScheduler->scheduleUpdateForTarget(m_pActionManager, 0, false);
+
+    m_pMovers = CCArray::createWithCapacity(kThroughputNodes / 4);
+    m_pMovers->retain();
+
+    CCMoveBy *pMove = CCMoveBy::create(1, ccp(10, 0));
+    CCActionInterval *pLoop = CCRepeatForever::create(CCSequence::create(pMove, pMove->reverse(), NULL));
+
+    // the nodes are never drawn, only their actions are stepped
+    for (int i = 0; i < kThroughputNodes; ++i)
+    {
+        CCNode *pNode = CCNode::create();
+        pNode->setActionManager(m_pActionManager);
+        addChild(pNode);
+
+        pNode->runAction((CCAction*)pLoop->copy()->autorelease());
+        pNode->runAction(CCRotateBy::create(1000, 360));
+        if (i % 4 == 0)
+        {
+            m_pMovers->addObject(pNode);
+        }
+    }
+
+    schedule(schedule_selector(ThroughputTest::tick));
+    schedule(schedule_selector(ThroughputTest::restartMovers), 0.5f);
+}
+
+void ThroughputTest::restartMovers(float dt)
+{
+    // short lived actions, so that removals are part of the measure
+    CCObject *pObj = NULL;
+    CCARRAY_FOREACH(m_pMovers, pObj)
+    {
+        ((CCNode*)pObj)->runAction(CCScaleTo::create(0.25f, CCRANDOM_0_1() + 0.5f));
+    }
+}
+
+void ThroughputTest::tick(float dt)
+{
+    struct cc_timeval start, end;
+    CCTime::gettimeofdayCocos2d(&start, NULL);
+    m_pScheduler->update(dt);
+    CCTime::gettimeofdayCocos2d(&end, NULL);
+
+    m_fUpdateTime += (float)CCTime::timersubCocos2d(&start, &end);
+    if (++m_nFrames == 30)
+    {
+        char str[64];
+        sprintf(str, "%d nodes: %.3f ms per update", kThroughputNodes, m_fUpdateTime / m_nFrames);
+        m_pLabel->setString(str);
+        m_fUpdateTime = 0;
+        m_nFrames = 0;
+    }
+}
+
 //------------------------------------------------------------------
 //
 // ActionManagerTestScene
@@ -62,6 +62,25 @@ public:
     void resumeGrossini(float time);
 };
 
+class ThroughputTest : public ActionManagerTest
+{
+public:
+    ThroughputTest(void);
+    ~ThroughputTest(void);
+
+    virtual std::string title();
+    virtual void onEnter();
+    void tick(float dt);
+    void restartMovers(float dt);
+private:
+    CCScheduler     *m_pScheduler;
+    CCActionManager *m_pActionManager;
+    CCLabelTTF      *m_pLabel;
+    CCArray         *m_pMovers;
+    float           m_fUpdateTime;
+    int             m_nFrames;
+};
+
 class ActionManagerTestScene : public TestScene
 {
 public:
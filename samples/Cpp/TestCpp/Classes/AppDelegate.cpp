@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "controller.h"
 #include "SimpleAudioEngine.h"
 #include "cocos-ext.h"
+#include "PerformanceTest/PerformanceBenchmark.h"
 
 USING_NS_CC;
 using namespace CocosDenshion;
@@ -98,6 +99,12 @@ bool AppDelegate::applicationDidFinishLaunching()
 	CCEGLView::sharedOpenGLView()->setDesignResolutionSize(designSize.width, designSize.height, kResolutionNoBorder);
 #endif
 
+    if (PerformanceBenchmark::isRequested())
+    {
+        PerformanceBenchmark::start();
+        return true;
+    }
+
     CCScene * pScene = CCScene::create();
     CCLayer * pLayer = new TestController();
     pLayer->autorelease();
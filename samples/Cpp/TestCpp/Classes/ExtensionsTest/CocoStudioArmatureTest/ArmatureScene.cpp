@@ -1,5 +1,6 @@
 #include "ArmatureScene.h"
 #include "../../testResource.h"
+#include "CocoStudio/Armature/utils/CCUtilMath.h"
 
 using namespace cocos2d;
 using namespace cocos2d::extension;
@@ -22,6 +23,9 @@ CCLayer *CreateLayer(int index)
     case TEST_DIRECT_LOADING:
         pLayer = new TestDirectLoading();
         break;
+    case TEST_BINARY_LOADING:
+        pLayer = new TestBinaryLoading();
+        break;
     case TEST_DRAGON_BONES_2_0:
         pLayer = new TestDragonBones20();
         break;
@@ -34,6 +38,9 @@ CCLayer *CreateLayer(int index)
     case TEST_PERFORMANCE_BATCHNODE:
         pLayer = new TestPerformanceBatchNode();
         break;
+    case TEST_PERFORMANCE_PARALLEL:
+        pLayer = new TestPerformanceParallel();
+        break;
     case TEST_CHANGE_ZORDER:
         pLayer = new TestChangeZorder();
         break;
@@ -73,6 +80,15 @@ CCLayer *CreateLayer(int index)
     case TEST_CHANGE_ANIMATION_INTERNAL:
         pLayer = new TestChangeAnimationInternal();
         break;
+    case TEST_BAKED_ANIMATION:
+        pLayer = new TestBakedAnimation();
+        break;
+    case TEST_BAKED_TWEEN_ROTATE:
+        pLayer = new TestBakedTweenRotate();
+        break;
+    case TEST_SIN_COS_ARRAY:
+        pLayer = new TestSinCosArray();
+        break;
     default:
         break;
     }
@@ -243,6 +259,10 @@ void TestAsynchronousLoading::onEnter()
     label->setString(pszPercent);
 
 
+    //! decode the files in two threads, and show the progress of all of them
+    CCDataReaderHelper::setAsyncLoadingThreadCount(2);
+    CCDataReaderHelper::setAsyncProgressCallback(this, schedule_selector(TestAsynchronousLoading::progressChanged));
+
     //! create a new thread to load data
     CCArmatureDataManager::sharedArmatureDataManager()->addArmatureFileInfoAsync("armature/knight.png", "armature/knight.plist", "armature/knight.xml", this, schedule_selector(TestAsynchronousLoading::dataLoaded));
     CCArmatureDataManager::sharedArmatureDataManager()->addArmatureFileInfoAsync("armature/weapon.png", "armature/weapon.plist", "armature/weapon.xml", this, schedule_selector(TestAsynchronousLoading::dataLoaded));
@@ -257,6 +277,12 @@ void TestAsynchronousLoading::onEnter()
     CCArmatureDataManager::sharedArmatureDataManager()->addArmatureFileInfoAsync("armature/testEasing.ExportJson", this, schedule_selector(TestAsynchronousLoading::dataLoaded));
 }
 
+void TestAsynchronousLoading::onExit()
+{
+    CCDataReaderHelper::setAsyncProgressCallback(NULL, NULL);
+    ArmatureTestLayer::onExit();
+}
+
 std::string TestAsynchronousLoading::title()
 {
     return "Test Asynchronous Loading";
@@ -271,6 +297,16 @@ void TestAsynchronousLoading::restartCallback(CCObject* pSender)
     ArmatureTestLayer::restartCallback(pSender);
 }
 void TestAsynchronousLoading::dataLoaded(float percent)
+{
+    if (percent >= 1 && backItem && restartItem && nextItem)
+    {
+        backItem->setEnabled(true);
+        restartItem->setEnabled(true);
+        nextItem->setEnabled(true);
+    }
+}
+
+void TestAsynchronousLoading::progressChanged(float percent)
 {
     CCLabelTTF *label = (CCLabelTTF *)getChildByTag(10001);
     if (label)
@@ -279,13 +315,6 @@ void TestAsynchronousLoading::dataLoaded(float percent)
         sprintf(pszPercent, "%s %f", subtitle().c_str(), percent * 100);
         label->setString(pszPercent);
     }
-
-    if (percent >= 1 && backItem && restartItem && nextItem)
-    {
-        backItem->setEnabled(true);
-        restartItem->setEnabled(true);
-        nextItem->setEnabled(true);
-    }
 }
 
 
@@ -310,6 +339,51 @@ std::string TestDirectLoading::title()
 }
 
 
+void TestBinaryLoading::onEnter()
+{
+    // converted before the subtitle is shown
+    m_strBinaryFile = CCFileUtils::sharedFileUtils()->getWritablePath() + "bear.ExportBinary";
+    m_bConverted = CCDataReaderHelper::convertToBinary("armature/bear.ExportJson", m_strBinaryFile.c_str());
+
+    ArmatureTestLayer::onEnter();
+
+    if (!m_bConverted)
+    {
+        return;
+    }
+
+    CCArmatureDataManager::sharedArmatureDataManager()->removeArmatureFileInfo("armature/bear.ExportJson");
+
+    // the binary file isn't next to the sprite sheet, which is given explicitly
+    CCArmatureDataManager::sharedArmatureDataManager()->addArmatureFileInfo("armature/bear0.png", "armature/bear0.plist", m_strBinaryFile.c_str());
+
+    CCArmature *armature = CCArmature::create("bear");
+    armature->getAnimation()->playWithIndex(0);
+    armature->setPosition(ccp(VisibleRect::center().x, VisibleRect::center().y));
+    addChild(armature);
+}
+
+void TestBinaryLoading::onExit()
+{
+    if (m_bConverted)
+    {
+        CCArmatureDataManager::sharedArmatureDataManager()->removeArmatureFileInfo(m_strBinaryFile.c_str());
+        CCArmatureDataManager::sharedArmatureDataManager()->addArmatureFileInfo("armature/bear.ExportJson");
+    }
+    ArmatureTestLayer::onExit();
+}
+
+std::string TestBinaryLoading::title()
+{
+    return "Test Binary Loading";
+}
+
+std::string TestBinaryLoading::subtitle()
+{
+    return m_bConverted ? "bear.ExportJson converted to .ExportBinary and loaded" : "Can't write the .ExportBinary file";
+}
+
+
 
 void TestCSWithSkeleton::onEnter()
 {
@@ -460,6 +534,24 @@ void TestPerformanceBatchNode::removeArmatureFromParent(int tag)
 }
 
 
+void TestPerformanceParallel::onEnter()
+{
+    cocos2d::extension::CCArmature::setParallelUpdateEnabled(true);
+
+    TestPerformance::onEnter();
+}
+void TestPerformanceParallel::onExit()
+{
+    cocos2d::extension::CCArmature::setParallelUpdateEnabled(false);
+
+    TestPerformance::onExit();
+}
+std::string TestPerformanceParallel::title()
+{
+    return "Test Performance of parallel update";
+}
+
+
 
 
 void TestChangeZorder::onEnter()
@@ -1487,3 +1579,167 @@ void TestChangeAnimationInternal::registerWithTouchDispatcher()
     CCDirector::sharedDirector()->getTouchDispatcher()->addTargetedDelegate(this, kCCMenuHandlerPriority + 1, true);
 }
 
+
+
+
+void TestBakedAnimation::onEnter()
+{
+    ArmatureTestLayer::onEnter();
+    setTouchEnabled(true);
+
+    wasBakingEnabled = CCArmatureDataManager::sharedArmatureDataManager()->isBakedAnimationEnabled();
+    animationID = 0;
+
+    bakedArmature = cocos2d::extension::CCArmature::create("Cowboy");
+    bakedArmature->setScale(0.2f);
+    bakedArmature->setPosition(ccp(VisibleRect::center().x - 120, VisibleRect::center().y));
+    addChild(bakedArmature);
+
+    tweenedArmature = cocos2d::extension::CCArmature::create("Cowboy");
+    tweenedArmature->setScale(0.2f);
+    tweenedArmature->setPosition(ccp(VisibleRect::center().x + 120, VisibleRect::center().y));
+    addChild(tweenedArmature);
+
+    playMovement(animationID);
+}
+void TestBakedAnimation::onExit()
+{
+    CCDirector::sharedDirector()->getTouchDispatcher()->removeDelegate(this);
+    CCArmatureDataManager::sharedArmatureDataManager()->setBakedAnimationEnabled(wasBakingEnabled);
+    if (!wasBakingEnabled)
+    {
+        CCArmatureDataManager::sharedArmatureDataManager()->removeAllBakedMovementDatas();
+    }
+    ArmatureTestLayer::onExit();
+}
+std::string TestBakedAnimation::title()
+{
+    return "Test baked animation";
+}
+std::string TestBakedAnimation::subtitle()
+{
+    return "Left baked, right tweened. Touch to play the next movement";
+}
+void TestBakedAnimation::playMovement(int index)
+{
+    // whether a movement is baked is decided when it starts playing
+    CCArmatureDataManager *manager = CCArmatureDataManager::sharedArmatureDataManager();
+    manager->setBakedAnimationEnabled(true);
+    bakedArmature->getAnimation()->playWithIndex(index);
+    manager->setBakedAnimationEnabled(false);
+    tweenedArmature->getAnimation()->playWithIndex(index);
+}
+bool TestBakedAnimation::ccTouchBegan(CCTouch *pTouch, CCEvent *pEvent)
+{
+    animationID++;
+    animationID = animationID % bakedArmature->getAnimation()->getMovementCount();
+    playMovement(animationID);
+    return false;
+}
+void TestBakedAnimation::registerWithTouchDispatcher()
+{
+    CCDirector::sharedDirector()->getTouchDispatcher()->addTargetedDelegate(this, kCCMenuHandlerPriority + 1, true);
+}
+
+
+
+
+void TestBakedTweenRotate::onEnter()
+{
+    // weaponSpin.xml turns its bones with twR, which the bake has to follow.
+    // It stays loaded like the other armatures: removing it would drop the sprite frames weapon.xml shares
+    CCArmatureDataManager *manager = CCArmatureDataManager::sharedArmatureDataManager();
+    manager->addArmatureFileInfo("armature/weapon.png", "armature/weapon.plist", "armature/weaponSpin.xml");
+
+    wasBakingEnabled = manager->isBakedAnimationEnabled();
+
+    // play every movement baked and tweened with the key frame step, and compare the bones
+    maxError = 0;
+    CCArmature *baked = CCArmature::create("weaponSpin");
+    CCArmature *tweened = CCArmature::create("weaponSpin");
+    float dt = 1 / manager->getBakeSampleRate();
+    for (int i = 0; i < baked->getAnimation()->getMovementCount(); ++i)
+    {
+        manager->setBakedAnimationEnabled(true);
+        baked->getAnimation()->playWithIndex(i, 0);
+        manager->setBakedAnimationEnabled(false);
+        tweened->getAnimation()->playWithIndex(i, 0);
+
+        for (int step = 0; step < 100; ++step)
+        {
+            baked->getAnimation()->update(dt);
+            tweened->getAnimation()->update(dt);
+
+            CCDictionary *boneDic = tweened->getBoneDic();
+            CCDictElement *element = NULL;
+            CCDICT_FOREACH(boneDic, element)
+            {
+                CCFrameData *tweenData = static_cast<CCBone *>(element->getObject())->getTweenData();
+                CCFrameData *bakedData = baked->getBone(element->getStrKey())->getTweenData();
+                maxError = MAX(maxError, fabsf(bakedData->skewX - tweenData->skewX));
+                maxError = MAX(maxError, fabsf(bakedData->skewY - tweenData->skewY));
+            }
+        }
+    }
+
+    ArmatureTestLayer::onEnter();
+    setTouchEnabled(true);
+
+    animationID = 0;
+
+    bakedArmature = CCArmature::create("weaponSpin");
+    bakedArmature->setScale(0.6f);
+    bakedArmature->setPosition(ccp(VisibleRect::center().x - 120, VisibleRect::center().y));
+    addChild(bakedArmature);
+
+    tweenedArmature = CCArmature::create("weaponSpin");
+    tweenedArmature->setScale(0.6f);
+    tweenedArmature->setPosition(ccp(VisibleRect::center().x + 120, VisibleRect::center().y));
+    addChild(tweenedArmature);
+
+    playMovement(animationID);
+}
+std::string TestBakedTweenRotate::title()
+{
+    return "Test baked animation with twR";
+}
+std::string TestBakedTweenRotate::subtitle()
+{
+    return CCString::createWithFormat("Left baked, right tweened. Largest skew difference: %g, %s",
+                                      maxError, maxError < 1e-3f ? "OK" : "FAILED")->getCString();
+}
+
+
+
+void TestSinCosArray::onEnter()
+{
+    // the bone transforms use sinCosArray instead of sinf and cosf
+    const int count = 10003;
+    std::vector<float> radians(count);
+    std::vector<float> sines(count);
+    std::vector<float> cosines(count);
+    for (int i = 0; i < count; ++i)
+    {
+        radians[i] = -8 * (float)M_PI + 16 * (float)M_PI * i / (count - 1);
+    }
+    // an odd count checks both the four at a time and the one at a time paths
+    sinCosArray(&radians[0], &sines[0], &cosines[0], count);
+
+    maxError = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        maxError = MAX(maxError, fabsf(sines[i] - sinf(radians[i])));
+        maxError = MAX(maxError, fabsf(cosines[i] - cosf(radians[i])));
+    }
+
+    ArmatureTestLayer::onEnter();
+}
+std::string TestSinCosArray::title()
+{
+    return "Test sinCosArray accuracy";
+}
+std::string TestSinCosArray::subtitle()
+{
+    return CCString::createWithFormat("Largest error against sinf/cosf in [-8 pi, 8 pi]: %g, %s",
+                                      maxError, maxError < 1e-6f ? "OK" : "FAILED")->getCString();
+}
@@ -27,10 +27,12 @@ public:
 enum {
 	TEST_ASYNCHRONOUS_LOADING = 0,
     TEST_DIRECT_LOADING,
+    TEST_BINARY_LOADING,
 	TEST_COCOSTUDIO_WITH_SKELETON,
 	TEST_DRAGON_BONES_2_0,
 	TEST_PERFORMANCE,
     TEST_PERFORMANCE_BATCHNODE,
+    TEST_PERFORMANCE_PARALLEL,
 	TEST_CHANGE_ZORDER,
 	TEST_ANIMATION_EVENT,
     TEST_FRAME_EVENT,
@@ -44,6 +46,9 @@ enum {
     TEST_PLAY_SEVERAL_MOVEMENT,
     TEST_EASING,
     TEST_CHANGE_ANIMATION_INTERNAL,
+    TEST_BAKED_ANIMATION,
+    TEST_BAKED_TWEEN_ROTATE,
+    TEST_SIN_COS_ARRAY,
 
 	TEST_LAYER_COUNT
 };
@@ -74,11 +79,13 @@ class TestAsynchronousLoading : public ArmatureTestLayer
 {
 public:
 	virtual void onEnter();
+    virtual void onExit();
 	virtual std::string title();
 	virtual std::string subtitle();
     virtual void restartCallback(CCObject* pSender);
 
 	void dataLoaded(float percent);
+    void progressChanged(float percent);
 };
 
 class TestDirectLoading : public ArmatureTestLayer
@@ -88,6 +95,18 @@ public:
     virtual std::string title();
 };
 
+class TestBinaryLoading : public ArmatureTestLayer
+{
+public:
+    virtual void onEnter();
+    virtual void onExit();
+    virtual std::string title();
+    virtual std::string subtitle();
+private:
+    std::string m_strBinaryFile;
+    bool m_bConverted;
+};
+
 class TestCSWithSkeleton : public ArmatureTestLayer
 {
 	virtual void onEnter();
@@ -136,6 +155,13 @@ class TestPerformanceBatchNode : public TestPerformance
     cocos2d::extension::CCBatchNode *batchNode;
 };
 
+class TestPerformanceParallel : public TestPerformance
+{
+    virtual void onEnter();
+    virtual void onExit();
+    virtual std::string title();
+};
+
 
 class TestChangeZorder : public ArmatureTestLayer
 {
@@ -392,4 +418,43 @@ public:
     virtual bool ccTouchBegan(CCTouch *pTouch, CCEvent *pEvent);
     virtual void registerWithTouchDispatcher();
 };
+
+class TestBakedAnimation : public ArmatureTestLayer
+{
+public:
+    virtual void onEnter();
+    virtual void onExit();
+    virtual std::string title();
+    virtual std::string subtitle();
+
+    virtual bool ccTouchBegan(CCTouch *pTouch, CCEvent *pEvent);
+    virtual void registerWithTouchDispatcher();
+
+    virtual void playMovement(int index);
+
+    cocos2d::extension::CCArmature *bakedArmature;
+    cocos2d::extension::CCArmature *tweenedArmature;
+    int animationID;
+    bool wasBakingEnabled;
+};
+
+class TestBakedTweenRotate : public TestBakedAnimation
+{
+public:
+    virtual void onEnter();
+    virtual std::string title();
+    virtual std::string subtitle();
+
+    float maxError;
+};
+
+class TestSinCosArray : public ArmatureTestLayer
+{
+public:
+    virtual void onEnter();
+    virtual std::string title();
+    virtual std::string subtitle();
+
+    float maxError;
+};
 #endif  // __HELLOWORLD_SCENE_H__
\ No newline at end of file
@@ -40,7 +40,7 @@ CCLayer* restartAtlasAction();
 
 static int sceneIdx = -1; 
 
-#define MAX_LAYER    29
+#define MAX_LAYER    31
 
 CCLayer* createAtlasLayer(int nIndex)
 {
@@ -77,6 +77,8 @@ CCLayer* createAtlasLayer(int nIndex)
         case 26: return new LabelBMFontBounds();
         case 27: return new TTFFontShadowAndStroke();
         case 28: return new LabelBMFontCrashTest();
+        case 29: return new LabelTTFGlyphAtlas();
+        case 30: return new BMFontBinaryAndDiskCache();
     }
 
     return NULL;
@@ -1698,4 +1700,131 @@ std::string LabelBMFontCrashTest::subtitle()
     return "Should not crash.";
 }
 
+/// LabelTTFGlyphAtlas
+LabelTTFGlyphAtlas::LabelTTFGlyphAtlas()
+: m_time(0)
+{
+    CCSize s = CCDirector::sharedDirector()->getWinSize();
+
+    m_pTextureLabel = CCLabelTTF::create("", "Marker Felt", 32);
+    addChild(m_pTextureLabel);
+    m_pTextureLabel->setPosition(ccp(s.width/2, s.height/3*2));
+
+    m_pAtlasLabel = CCLabelTTF::create("", "Marker Felt", 32);
+    m_pAtlasLabel->setGlyphAtlasEnabled(true);
+    m_pAtlasLabel->setColor(ccYELLOW);
+    addChild(m_pAtlasLabel);
+    m_pAtlasLabel->setPosition(ccp(s.width/2, s.height/3));
+
+    schedule(schedule_selector(LabelTTFGlyphAtlas::step));
+}
+
+void LabelTTFGlyphAtlas::step(float dt)
+{
+    m_time += dt;
+    char string[32] = {0};
+    sprintf(string, "texture %2.3f", m_time);
+    m_pTextureLabel->setString(string);
+    sprintf(string, "glyph atlas %2.3f", m_time);
+    m_pAtlasLabel->setString(string);
+}
+
+std::string LabelTTFGlyphAtlas::title()
+{
+    return "CCLabelTTF with a glyph atlas";
+}
+
+std::string LabelTTFGlyphAtlas::subtitle()
+{
+    return CCGlyphAtlas::isSupported() ? "Both labels update every frame, the yellow one from shared glyphs"
+                                       : "Glyph atlas not supported on this platform, both labels use textures";
+}
+
+//------------------------------------------------------------------
+//
+// BMFontBinaryAndDiskCache
+//
+//------------------------------------------------------------------
+static bool haveSameLayout(CCLabelBMFont *pLabel1, CCLabelBMFont *pLabel2)
+{
+    if (! pLabel1->getContentSize().equals(pLabel2->getContentSize())
+        || pLabel1->getChildrenCount() != pLabel2->getChildrenCount())
+    {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < pLabel1->getChildrenCount(); ++i)
+    {
+        CCSprite *pChar1 = (CCSprite*)pLabel1->getChildren()->objectAtIndex(i);
+        CCSprite *pChar2 = (CCSprite*)pLabel2->getChildren()->objectAtIndex(i);
+        if (pChar1->isVisible() != pChar2->isVisible())
+        {
+            return false;
+        }
+        if (pChar1->isVisible()
+            && (! pChar1->getPosition().equals(pChar2->getPosition())
+                || ! pChar1->getTextureRect().equals(pChar2->getTextureRect())))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+BMFontBinaryAndDiskCache::BMFontBinaryAndDiskCache()
+{
+    CCSize s = CCDirector::sharedDirector()->getWinSize();
+    // with kerning pairs
+    const char *text = "BALD DATA, AZ?";
+    bool bDiskCacheEnabled = FNTConfigIsDiskCacheEnabled();
+
+    // parsed from the text file
+    CCLabelBMFont::purgeCachedData();
+    FNTConfigSetDiskCacheEnabled(false);
+    CCLabelBMFont *pText = CCLabelBMFont::create(text, "fonts/futura-48.fnt");
+
+    // the same font in the binary format of the AngelCode editor
+    CCLabelBMFont *pBinary = CCLabelBMFont::create(text, "fonts/futura-48-binary.fnt");
+    pBinary->setColor(ccYELLOW);
 
+    // the first load parses the text file and writes the cache, the second one reads the cache
+    FNTConfigSetDiskCacheEnabled(true);
+    std::string cachePath = FNTConfigGetDiskCachePath("fonts/futura-48.fnt");
+    remove(cachePath.c_str());
+    CCLabelBMFont::purgeCachedData();
+    CCLabelBMFont::create(text, "fonts/futura-48.fnt");
+
+    unsigned long size = 0;
+    unsigned char *pCache = CCFileUtils::sharedFileUtils()->getFileData(cachePath.c_str(), "rb", &size);
+    m_bCacheWritten = pCache && size > 4 && memcmp(pCache, "CCFN", 4) == 0;
+    CC_SAFE_DELETE_ARRAY(pCache);
+
+    CCLabelBMFont::purgeCachedData();
+    CCLabelBMFont *pCached = CCLabelBMFont::create(text, "fonts/futura-48.fnt");
+    pCached->setColor(ccGREEN);
+
+    FNTConfigSetDiskCacheEnabled(bDiskCacheEnabled);
+
+    m_bBinaryMatches = haveSameLayout(pText, pBinary);
+    m_bCacheMatches = haveSameLayout(pText, pCached);
+
+    addChild(pText);
+    pText->setPosition(ccp(s.width/2, s.height*3/4));
+    addChild(pBinary);
+    pBinary->setPosition(ccp(s.width/2, s.height/2));
+    addChild(pCached);
+    pCached->setPosition(ccp(s.width/2, s.height/4));
+}
+
+std::string BMFontBinaryAndDiskCache::title()
+{
+    return "Binary FNT and FNT disk cache";
+}
+
+std::string BMFontBinaryAndDiskCache::subtitle()
+{
+    const char *binary = m_bBinaryMatches ? "binary (yellow) OK" : "binary (yellow) FAILED";
+    const char *cache = ! m_bCacheWritten ? "cache not written" : (m_bCacheMatches ? "cached (green) OK" : "cached (green) FAILED");
+    return std::string("Same layout as the text file: ") + binary + ", " + cache;
+}
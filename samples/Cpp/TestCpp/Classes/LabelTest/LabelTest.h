@@ -322,6 +322,33 @@ public:
     virtual std::string subtitle();
 };
 
+class LabelTTFGlyphAtlas : public AtlasDemo
+{
+public:
+    LabelTTFGlyphAtlas();
+
+    virtual void step(float dt);
+    virtual std::string title();
+    virtual std::string subtitle();
+private:
+    float m_time;
+    CCLabelTTF *m_pTextureLabel;
+    CCLabelTTF *m_pAtlasLabel;
+};
+
+class BMFontBinaryAndDiskCache : public AtlasDemo
+{
+public:
+    BMFontBinaryAndDiskCache();
+
+    virtual std::string title();
+    virtual std::string subtitle();
+private:
+    bool m_bBinaryMatches;
+    bool m_bCacheWritten;
+    bool m_bCacheMatches;
+};
+
 // we don't support linebreak mode
 
 #endif
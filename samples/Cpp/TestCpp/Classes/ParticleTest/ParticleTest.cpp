@@ -969,7 +969,7 @@ enum
 
 static int sceneIdx = -1; 
 
-#define MAX_LAYER    44
+#define MAX_LAYER    47
 
 CCLayer* createParticleLayer(int nIndex)
 {
@@ -1020,6 +1020,9 @@ CCLayer* createParticleLayer(int nIndex)
         case 41: return new ReorderParticleSystems();
         case 42: return new PremultipliedAlphaTest();
         case 43: return new PremultipliedAlphaTest2();
+        case 44: return new ParallelParticleSystems();
+        case 45: return new PrewarmParticleSystems();
+        case 46: return new ParallelLoneParticleSystem();
         default:
             break;
     }
@@ -1923,6 +1926,198 @@ std::string PremultipliedAlphaTest2::subtitle()
     return "Arrows should be faded";
 }
 
+// ParallelParticleSystems
+
+void ParallelParticleSystems::onEnter()
+{
+    ParticleDemo::onEnter();
+
+    setColor(ccBLACK);
+    removeChild(m_background, true);
+    m_background = NULL;
+
+    CCParticleSystem::setParallelUpdateEnabled(true);
+
+    m_pBatchNode = CCParticleBatchNode::createWithTexture((CCTexture2D*)NULL, 16000);
+    addChild(m_pBatchNode, 1, 2);
+
+    CCSize s = CCDirector::sharedDirector()->getWinSize();
+
+    for (int i = 0; i < 40; i++)
+    {
+        CCParticleSystemQuad *particleSystem = CCParticleSystemQuad::create("Particles/SpinningPeas.plist");
+        m_pBatchNode->setTexture(particleSystem->getTexture());
+
+        particleSystem->setTotalParticles(300);
+        particleSystem->setPositionType(i % 2 ? kCCPositionTypeFree : kCCPositionTypeGrouped);
+        particleSystem->setPosition(ccp((i % 8 + 0.5f) * s.width / 8, (i / 8 + 0.5f) * s.height / 5));
+        // same seed: emitters of the same type look the same whatever the thread that simulates them
+        particleSystem->setRandomSeed(i % 2);
+
+        m_pBatchNode->addChild(particleSystem);
+    }
+
+    m_emitter = NULL;
+}
+
+void ParallelParticleSystems::onExit()
+{
+    CCParticleSystem::setParallelUpdateEnabled(false);
+    ParticleDemo::onExit();
+}
+
+void ParallelParticleSystems::update(float dt)
+{
+    CCLabelAtlas *atlas = (CCLabelAtlas*) getChildByTag(kTagParticleCount);
+
+    unsigned int count = 0;
+
+    CCObject* pObj = NULL;
+    CCARRAY_FOREACH(m_pBatchNode->getChildren(), pObj)
+    {
+        CCParticleSystem* item = dynamic_cast<CCParticleSystem*>(pObj);
+        if (item != NULL)
+        {
+            count += item->getParticleCount();
+        }
+    }
+    char str[100] = {0};
+    sprintf(str, "%4d", count);
+    atlas->setString(str);
+}
+
+std::string ParallelParticleSystems::title()
+{
+    return "Parallel particle update";
+}
+
+std::string ParallelParticleSystems::subtitle()
+{
+    return "40 batched systems simulated on the job pool";
+}
+
+// ParallelLoneParticleSystem
+
+// exposes the elapsed time, which only moves when the system gets stepped
+class ElapsedParticleSystem : public CCParticleSystemQuad
+{
+public:
+    static ElapsedParticleSystem* create(const char *plistFile)
+    {
+        ElapsedParticleSystem *pRet = new ElapsedParticleSystem();
+        if (pRet->initWithFile(plistFile))
+        {
+            pRet->autorelease();
+            return pRet;
+        }
+        CC_SAFE_DELETE(pRet);
+        return NULL;
+    }
+
+    float getElapsed() { return m_fElapsed; }
+};
+
+void ParallelLoneParticleSystem::onEnter()
+{
+    ParticleDemo::onEnter();
+
+    CCParticleSystem::setParallelUpdateEnabled(true);
+
+    ElapsedParticleSystem *pSystem = ElapsedParticleSystem::create("Particles/SpinningPeas.plist");
+    pSystem->setDuration(kCCParticleDurationInfinity);
+    m_emitter = pSystem;
+    m_emitter->retain();
+    m_background->addChild(m_emitter, 10);
+
+    CCSize s = CCDirector::sharedDirector()->getWinSize();
+    m_pResult = CCLabelTTF::create("", "Arial", 20);
+    addChild(m_pResult, 100);
+    m_pResult->setPosition(ccp(s.width/2, s.height-120));
+
+    m_fLastElapsed = -1;
+    m_nFrames = 0;
+    m_nSteppedFrames = 0;
+}
+
+void ParallelLoneParticleSystem::onExit()
+{
+    CCParticleSystem::setParallelUpdateEnabled(false);
+    ParticleDemo::onExit();
+}
+
+void ParallelLoneParticleSystem::update(float dt)
+{
+    ParticleDemo::update(dt);
+
+    // this layer is updated before the system, so the elapsed time read here is the one of the previous tick
+    float elapsed = ((ElapsedParticleSystem*)m_emitter)->getElapsed();
+    if (m_fLastElapsed >= 0)
+    {
+        m_nFrames++;
+        if (elapsed > m_fLastElapsed)
+        {
+            m_nSteppedFrames++;
+        }
+        else
+        {
+            CCLOG("ParallelLoneParticleSystem: the system was not stepped on frame %d", m_nFrames);
+        }
+    }
+    m_fLastElapsed = elapsed;
+
+    char str[64] = {0};
+    sprintf(str, "%s: stepped %d of %d frames", m_nSteppedFrames == m_nFrames ? "OK" : "FAILED", m_nSteppedFrames, m_nFrames);
+    m_pResult->setString(str);
+}
+
+std::string ParallelLoneParticleSystem::title()
+{
+    return "Parallel update of a lone system";
+}
+
+std::string ParallelLoneParticleSystem::subtitle()
+{
+    return "The system must be stepped on every frame";
+}
+
+// PrewarmParticleSystems
+
+void PrewarmParticleSystems::onEnter()
+{
+    ParticleDemo::onEnter();
+
+    CCSize s = CCDirector::sharedDirector()->getWinSize();
+    CCArray *pSystems = CCArray::createWithCapacity(8);
+
+    for (int i = 0; i < 8; i++)
+    {
+        CCParticleSystem *particleSystem = CCParticleSmoke::create();
+        particleSystem->setTexture( CCTextureCache::sharedTextureCache()->addImage(s_fire) );
+        particleSystem->setPosition( ccp((i + 0.5f) * s.width / 8, 60) );
+        m_background->addChild(particleSystem, 10);
+
+        // left half starts empty, right half starts as if it had been running for 5 seconds
+        if (i >= 4)
+        {
+            pSystems->addObject(particleSystem);
+        }
+    }
+
+    CCParticleSystem::prewarm(pSystems, 5.0f);
+
+    m_emitter = NULL;
+}
+
+std::string PrewarmParticleSystems::title()
+{
+    return "Prewarmed particle systems";
+}
+
+std::string PrewarmParticleSystems::subtitle()
+{
+    return "Right smokes should start full";
+}
+
 void ParticleTestScene::runThisTest()
 {
     addChild(nextParticleAction());
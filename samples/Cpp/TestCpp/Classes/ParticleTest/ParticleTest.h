@@ -299,4 +299,39 @@ public:
     virtual std::string subtitle();
 };
 
+class ParallelParticleSystems : public ParticleDemo
+{
+public:
+    virtual void onEnter();
+    virtual void onExit();
+    virtual void update(float dt);
+    virtual std::string title();
+    virtual std::string subtitle();
+private:
+    CCParticleBatchNode* m_pBatchNode;
+};
+
+class PrewarmParticleSystems : public ParticleDemo
+{
+public:
+    virtual void onEnter();
+    virtual std::string title();
+    virtual std::string subtitle();
+};
+
+class ParallelLoneParticleSystem : public ParticleDemo
+{
+public:
+    virtual void onEnter();
+    virtual void onExit();
+    virtual void update(float dt);
+    virtual std::string title();
+    virtual std::string subtitle();
+private:
+    CCLabelTTF* m_pResult;
+    float m_fLastElapsed;
+    int m_nFrames;
+    int m_nSteppedFrames;
+};
+
 #endif
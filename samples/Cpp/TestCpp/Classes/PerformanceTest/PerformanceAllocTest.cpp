@@ -32,7 +32,7 @@
 #undef CC_PROFILER_RESET_INSTANCE
 #define CC_PROFILER_RESET_INSTANCE(__id__, __name__) do{ CCProfilingResetTimingBlock( CCString::createWithFormat("%08X - %s", __id__, __name__)->getCString() ); } while(0)
 
-#define MAX_LAYER  5
+#define MAX_LAYER  11
 
 enum {
     kTagInfoLayer = 1,
@@ -77,6 +77,24 @@ void AllocBasicLayer::showCurrentTest()
         case 4:
             scene = new SpriteDeallocTest;
             break;
+        case 5:
+            scene = new ActionCreateTest;
+            break;
+        case 6:
+            scene = new PooledActionCreateTest;
+            break;
+        case 7:
+            scene = new DictionaryCreateTest;
+            break;
+        case 8:
+            scene = new DictionaryLookupTest;
+            break;
+        case 9:
+            scene = new AutoreleaseDrainTest;
+            break;
+        case 10:
+            scene = new NotificationPostTest;
+            break;
         default:
             scene = NULL;
     }
@@ -490,6 +508,377 @@ const char*  SpriteDeallocTest::testName()
     return "Sprite::~Sprite()";
 }
 
+////////////////////////////////////////////////////////
+//
+// ActionCreateTest
+//
+////////////////////////////////////////////////////////
+void ActionCreateTest::updateQuantityOfNodes()
+{
+    currentQuantityOfNodes = quantityOfNodes;
+}
+
+void ActionCreateTest::initWithQuantityOfNodes(unsigned int nNodes)
+{
+    PerformceAllocScene::initWithQuantityOfNodes(nNodes);
+
+    printf("Size of Sequence: %d\n", static_cast<int>(sizeof(CCSequence)));
+
+    scheduleUpdate();
+}
+
+void ActionCreateTest::update(float dt)
+{
+    // a typical gameplay sequence: 4 actions + 3 nested sequences, released at the end of the frame
+    CC_PROFILER_START(this->profilerName());
+    for( int i=0; i<quantityOfNodes; ++i)
+    {
+        CCSequence::create(CCMoveTo::create(0.5f, ccp(i, 0)),
+                           CCDelayTime::create(0.25f),
+                           CCCallFunc::create(this, callfunc_selector(ActionCreateTest::actionDone)),
+                           CCMoveTo::create(0.5f, ccp(0, i)),
+                           NULL);
+    }
+    CC_PROFILER_STOP(this->profilerName());
+}
+
+void ActionCreateTest::actionDone()
+{
+}
+
+std::string ActionCreateTest::title()
+{
+    return "Action Create Perf test.";
+}
+
+std::string ActionCreateTest::subtitle()
+{
+    return "Sequence of MoveTo, DelayTime, CallFunc. See console";
+}
+
+const char*  ActionCreateTest::testName()
+{
+    return "Sequence::create()";
+}
+
+////////////////////////////////////////////////////////
+//
+// PooledActionCreateTest
+//
+////////////////////////////////////////////////////////
+void PooledActionCreateTest::initWithQuantityOfNodes(unsigned int nNodes)
+{
+    CCActionPool* pools[] = {
+        CCSequence::sharedActionPool(),
+        CCMoveTo::sharedActionPool(),
+        CCDelayTime::sharedActionPool(),
+        CCCallFunc::sharedActionPool(),
+    };
+
+    // every action of a frame is released at the end of that frame: keep them all
+    for (unsigned int i = 0; i < sizeof(pools) / sizeof(pools[0]); ++i)
+    {
+        pools[i]->setCapacity(kMaxNodes * 3);
+        pools[i]->setEnabled(true);
+    }
+
+    ActionCreateTest::initWithQuantityOfNodes(nNodes);
+
+    schedule(schedule_selector(PooledActionCreateTest::dumpPools), 2);
+}
+
+void PooledActionCreateTest::onExitTransitionDidStart()
+{
+    ActionCreateTest::onExitTransitionDidStart();
+
+    CCActionPool::setAllPoolsEnabled(false);
+}
+
+void PooledActionCreateTest::dumpPools(float dt)
+{
+    CCActionPool::dumpAllPools();
+}
+
+std::string PooledActionCreateTest::title()
+{
+    return "Pooled Action Create Perf test.";
+}
+
+std::string PooledActionCreateTest::subtitle()
+{
+    return "Same actions with CCActionPool enabled. See console";
+}
+
+const char*  PooledActionCreateTest::testName()
+{
+    return "Sequence::create() pooled";
+}
+
+////////////////////////////////////////////////////////
+//
+// DictionaryCreateTest
+//
+////////////////////////////////////////////////////////
+static void dictionaryKeyForIndex(char *pszKey, int index)
+{
+    // looks like the frame names of a sprite sheet
+    sprintf(pszKey, "characters/hero_run_%05d.png", index);
+}
+
+void DictionaryCreateTest::updateQuantityOfNodes()
+{
+    currentQuantityOfNodes = quantityOfNodes;
+}
+
+void DictionaryCreateTest::initWithQuantityOfNodes(unsigned int nNodes)
+{
+    PerformceAllocScene::initWithQuantityOfNodes(nNodes);
+
+    printf("Size of DictElement: %d\n", static_cast<int>(sizeof(CCDictElement)));
+
+    scheduleUpdate();
+}
+
+void DictionaryCreateTest::update(float dt)
+{
+    char key[64];
+    CCDictionary *pDict = new CCDictionary();
+
+    CC_PROFILER_START(this->profilerName());
+    for( int i=0; i<quantityOfNodes; ++i)
+    {
+        dictionaryKeyForIndex(key, i);
+        pDict->setObject(this, key);
+    }
+    pDict->release();
+    CC_PROFILER_STOP(this->profilerName());
+}
+
+std::string DictionaryCreateTest::title()
+{
+    return "Dictionary Create Perf test.";
+}
+
+std::string DictionaryCreateTest::subtitle()
+{
+    return "Fill and release a dictionary with string keys. See console";
+}
+
+const char*  DictionaryCreateTest::testName()
+{
+    return "Dictionary::setObject()";
+}
+
+////////////////////////////////////////////////////////
+//
+// DictionaryLookupTest
+//
+////////////////////////////////////////////////////////
+DictionaryLookupTest::DictionaryLookupTest()
+: m_pDictionary(NULL)
+{
+}
+
+DictionaryLookupTest::~DictionaryLookupTest()
+{
+    CC_SAFE_RELEASE(m_pDictionary);
+}
+
+void DictionaryLookupTest::updateQuantityOfNodes()
+{
+    char key[64];
+
+    CC_SAFE_RELEASE(m_pDictionary);
+    m_pDictionary = new CCDictionary();
+    for( int i=0; i<quantityOfNodes; ++i)
+    {
+        dictionaryKeyForIndex(key, i);
+        m_pDictionary->setObject(this, key);
+    }
+    currentQuantityOfNodes = quantityOfNodes;
+}
+
+void DictionaryLookupTest::initWithQuantityOfNodes(unsigned int nNodes)
+{
+    PerformceAllocScene::initWithQuantityOfNodes(nNodes);
+
+    scheduleUpdate();
+}
+
+void DictionaryLookupTest::update(float dt)
+{
+    char key[64];
+    std::string strKey;
+    int found = 0;
+
+    CC_PROFILER_START(this->profilerName());
+    for( int i=0; i<quantityOfNodes; ++i)
+    {
+        // scattered lookups, as done when building sprites from frame names
+        dictionaryKeyForIndex(key, (i * 7919) % quantityOfNodes);
+        strKey = key;
+        if (m_pDictionary->objectForKey(strKey))
+        {
+            ++found;
+        }
+    }
+    CC_PROFILER_STOP(this->profilerName());
+
+    CCAssert(found == quantityOfNodes, "key not found");
+}
+
+std::string DictionaryLookupTest::title()
+{
+    return "Dictionary Lookup Perf test.";
+}
+
+std::string DictionaryLookupTest::subtitle()
+{
+    return "objectForKey() on every key. See console";
+}
+
+const char*  DictionaryLookupTest::testName()
+{
+    return "Dictionary::objectForKey()";
+}
+
+////////////////////////////////////////////////////////
+//
+// AutoreleaseDrainTest
+//
+////////////////////////////////////////////////////////
+void AutoreleaseDrainTest::updateQuantityOfNodes()
+{
+    currentQuantityOfNodes = quantityOfNodes;
+}
+
+void AutoreleaseDrainTest::initWithQuantityOfNodes(unsigned int nNodes)
+{
+    PerformceAllocScene::initWithQuantityOfNodes(nNodes);
+
+    scheduleUpdate();
+}
+
+void AutoreleaseDrainTest::update(float dt)
+{
+    CCPoolManager *pPoolManager = CCPoolManager::sharedPoolManager();
+
+    // temporary objects in a pool of their own, drained right away
+    CC_PROFILER_START(this->profilerName());
+    pPoolManager->push();
+    for( int i=0; i<quantityOfNodes; ++i)
+    {
+        CCInteger::create(i);
+    }
+    pPoolManager->pop();
+    CC_PROFILER_STOP(this->profilerName());
+}
+
+std::string AutoreleaseDrainTest::title()
+{
+    return "Autorelease Perf test.";
+}
+
+std::string AutoreleaseDrainTest::subtitle()
+{
+    return "Autorelease temporary objects and drain the pool. See console";
+}
+
+const char*  AutoreleaseDrainTest::testName()
+{
+    return "autorelease() + pop()";
+}
+
+////////////////////////////////////////////////////////
+//
+// NotificationPostTest
+//
+////////////////////////////////////////////////////////
+#define kNotificationNames 32
+
+class NotificationCounter : public CCObject
+{
+public:
+    NotificationCounter() : m_nCount(0) {}
+    void onNotification(CCObject *pObject) { ++m_nCount; }
+
+    int m_nCount;
+};
+
+static void notificationNameForIndex(char *pszName, int index)
+{
+    sprintf(pszName, "PerformanceTest_Notification_%02d", index % kNotificationNames);
+}
+
+NotificationPostTest::NotificationPostTest()
+: m_pNotificationCenter(NULL)
+, m_pObservers(NULL)
+{
+}
+
+NotificationPostTest::~NotificationPostTest()
+{
+    CC_SAFE_RELEASE(m_pNotificationCenter);
+    CC_SAFE_RELEASE(m_pObservers);
+}
+
+void NotificationPostTest::updateQuantityOfNodes()
+{
+    char name[64];
+
+    // a center of our own, so the observers of the engine don't get in the way
+    CC_SAFE_RELEASE(m_pNotificationCenter);
+    CC_SAFE_RELEASE(m_pObservers);
+    m_pNotificationCenter = new CCNotificationCenter();
+    m_pObservers = CCArray::createWithCapacity(quantityOfNodes);
+    m_pObservers->retain();
+    for( int i=0; i<quantityOfNodes; ++i)
+    {
+        NotificationCounter *pCounter = new NotificationCounter();
+        m_pObservers->addObject(pCounter);
+        pCounter->release();
+
+        notificationNameForIndex(name, i);
+        m_pNotificationCenter->addObserver(pCounter, callfuncO_selector(NotificationCounter::onNotification), name, NULL);
+    }
+    currentQuantityOfNodes = quantityOfNodes;
+}
+
+void NotificationPostTest::initWithQuantityOfNodes(unsigned int nNodes)
+{
+    PerformceAllocScene::initWithQuantityOfNodes(nNodes);
+
+    scheduleUpdate();
+}
+
+void NotificationPostTest::update(float dt)
+{
+    char name[64];
+
+    CC_PROFILER_START(this->profilerName());
+    for( int i=0; i<kNotificationNames; ++i)
+    {
+        notificationNameForIndex(name, i);
+        m_pNotificationCenter->postNotification(name);
+    }
+    CC_PROFILER_STOP(this->profilerName());
+}
+
+std::string NotificationPostTest::title()
+{
+    return "Notification Perf test.";
+}
+
+std::string NotificationPostTest::subtitle()
+{
+    return "Observers spread over 32 names, each name posted once. See console";
+}
+
+const char*  NotificationPostTest::testName()
+{
+    return "CCNotificationCenter::postNotification()";
+}
+
 ///----------------------------------------
 void runAllocPerformanceTest()
 {
@@ -112,6 +112,90 @@ public:
     std::string subtitle();
 };
 
+class ActionCreateTest : public PerformceAllocScene
+{
+public:
+    virtual void updateQuantityOfNodes();
+    virtual void initWithQuantityOfNodes(unsigned int nNodes);
+    virtual void update(float dt);
+    virtual const char* testName();
+
+    std::string title();
+    std::string subtitle();
+
+    void actionDone();
+};
+
+class PooledActionCreateTest : public ActionCreateTest
+{
+public:
+    virtual void initWithQuantityOfNodes(unsigned int nNodes);
+    virtual void onExitTransitionDidStart();
+    virtual const char* testName();
+
+    std::string title();
+    std::string subtitle();
+
+    void dumpPools(float dt);
+};
+class DictionaryCreateTest : public PerformceAllocScene
+{
+public:
+    virtual void updateQuantityOfNodes();
+    virtual void initWithQuantityOfNodes(unsigned int nNodes);
+    virtual void update(float dt);
+    virtual const char* testName();
+
+    std::string title();
+    std::string subtitle();
+};
+
+class DictionaryLookupTest : public PerformceAllocScene
+{
+public:
+    DictionaryLookupTest();
+    ~DictionaryLookupTest();
+
+    virtual void updateQuantityOfNodes();
+    virtual void initWithQuantityOfNodes(unsigned int nNodes);
+    virtual void update(float dt);
+    virtual const char* testName();
+
+    std::string title();
+    std::string subtitle();
+private:
+    CCDictionary *m_pDictionary;
+};
+
+class AutoreleaseDrainTest : public PerformceAllocScene
+{
+public:
+    virtual void updateQuantityOfNodes();
+    virtual void initWithQuantityOfNodes(unsigned int nNodes);
+    virtual void update(float dt);
+    virtual const char* testName();
+
+    std::string title();
+    std::string subtitle();
+};
+
+class NotificationPostTest : public PerformceAllocScene
+{
+public:
+    NotificationPostTest();
+    ~NotificationPostTest();
+
+    virtual void updateQuantityOfNodes();
+    virtual void initWithQuantityOfNodes(unsigned int nNodes);
+    virtual void update(float dt);
+    virtual const char* testName();
+
+    std::string title();
+    std::string subtitle();
+private:
+    CCNotificationCenter *m_pNotificationCenter;
+    CCArray *m_pObservers;
+};
 
 void runAllocPerformanceTest();
 
@@ -0,0 +1,407 @@
+#include "PerformanceBenchmark.h"
+#include "PerformanceNodeChildrenTest.h"
+#include "PerformanceParticleTest.h"
+#include "PerformanceSpriteTest.h"
+#include "PerformanceAllocTest.h"
+#include "PerformanceLabelTest.h"
+#include "cocos-ext.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum
+{
+    kDefaultFrames = 300,
+    kDefaultWarmupFrames = 30,
+    kRandomSeed = 0,
+};
+
+// timings under this many milliseconds apart are noise, not regressions
+static const float kMinRegression = 0.01f;
+
+static const char* s_phaseNames[kCCFramePhaseCount] =
+{
+    "frame",
+    "update",
+    "visit",
+    "swap",
+};
+
+typedef CCScene* (*BENCHMARK_CREATE_FUNC)();
+
+struct BenchmarkCase
+{
+    const char* name;
+    BENCHMARK_CREATE_FUNC create;
+};
+
+template <class T, unsigned int NODES>
+static CCScene* createQuantityScene()
+{
+    T* pScene = new T();
+    pScene->initWithQuantityOfNodes(NODES);
+    pScene->autorelease();
+    return pScene;
+}
+
+template <class T, int SUBTEST, int NODES>
+static CCScene* createSubTestScene()
+{
+    T* pScene = new T();
+    pScene->initWithSubTest(SUBTEST, NODES);
+    pScene->autorelease();
+    return pScene;
+}
+
+static const BenchmarkCase s_benchmarkCases[] =
+{
+    { "NodeChildren/IterateSpriteSheetCArray", createQuantityScene<IterateSpriteSheetCArray, 1000> },
+    { "NodeChildren/CallFuncsSpriteSheetCMacro", createQuantityScene<CallFuncsSpriteSheetCMacro, 1000> },
+    { "NodeChildren/AddSprite", createQuantityScene<AddSprite, 1000> },
+    { "NodeChildren/AddSpriteSheet", createQuantityScene<AddSpriteSheet, 1000> },
+    { "NodeChildren/GetSpriteSheet", createQuantityScene<GetSpriteSheet, 1000> },
+    { "NodeChildren/GetSpriteSheetIndexed", createQuantityScene<GetSpriteSheetIndexed, 1000> },
+    { "NodeChildren/RemoveSprite", createQuantityScene<RemoveSprite, 1000> },
+    { "NodeChildren/RemoveSpriteFront", createQuantityScene<RemoveSpriteFront, 1000> },
+    { "NodeChildren/RemoveSpriteSheet", createQuantityScene<RemoveSpriteSheet, 1000> },
+    { "NodeChildren/ReorderSpriteSheet", createQuantityScene<ReorderSpriteSheet, 1000> },
+    { "NodeChildren/SortAllChildrenSpriteSheet", createQuantityScene<SortAllChildrenSpriteSheet, 1000> },
+    { "NodeChildren/VisitSceneGraph", createQuantityScene<VisitSceneGraph, 1000> },
+
+    { "Particle/PerformTest1", createSubTestScene<ParticlePerformTest1, 1, 1000> },
+    { "Particle/PerformTest2", createSubTestScene<ParticlePerformTest2, 1, 1000> },
+    { "Particle/PerformTest3", createSubTestScene<ParticlePerformTest3, 1, 1000> },
+    { "Particle/PerformTest4", createSubTestScene<ParticlePerformTest4, 1, 1000> },
+
+    { "Sprite/PerformTest1/Sprites", createSubTestScene<SpritePerformTest1, 1, 500> },
+    { "Sprite/PerformTest1/BatchNode", createSubTestScene<SpritePerformTest1, 3, 500> },
+    { "Sprite/PerformTest1/AtlasBatchNode", createSubTestScene<SpritePerformTest1, 7, 500> },
+    { "Sprite/PerformTest5/BatchNode", createSubTestScene<SpritePerformTest5, 3, 500> },
+    { "Sprite/PerformTest7/BatchNode", createSubTestScene<SpritePerformTest7, 3, 500> },
+
+    { "Alloc/NodeCreate", createQuantityScene<NodeCreateTest, 500> },
+    { "Alloc/NodeDealloc", createQuantityScene<NodeDeallocTest, 500> },
+    { "Alloc/SpriteCreateEmpty", createQuantityScene<SpriteCreateEmptyTest, 500> },
+    { "Alloc/SpriteCreate", createQuantityScene<SpriteCreateTest, 500> },
+    { "Alloc/SpriteDealloc", createQuantityScene<SpriteDeallocTest, 500> },
+    { "Alloc/ActionCreate", createQuantityScene<ActionCreateTest, 500> },
+    { "Alloc/PooledActionCreate", createQuantityScene<PooledActionCreateTest, 500> },
+    { "Alloc/DictionaryCreate", createQuantityScene<DictionaryCreateTest, 500> },
+    { "Alloc/DictionaryLookup", createQuantityScene<DictionaryLookupTest, 500> },
+    { "Alloc/AutoreleaseDrain", createQuantityScene<AutoreleaseDrainTest, 500> },
+    { "Alloc/NotificationPost", createQuantityScene<NotificationPostTest, 500> },
+
+    { "Label/BMFontCounter", createQuantityScene<LabelBMFontCounterTest, 500> },
+    { "Label/BMFontRewrite", createQuantityScene<LabelBMFontRewriteTest, 500> },
+    { "Label/TTFGlyphAtlasCounter", createQuantityScene<LabelTTFGlyphAtlasCounterTest, 500> },
+};
+
+static const unsigned int s_benchmarkCaseCount = sizeof(s_benchmarkCases) / sizeof(s_benchmarkCases[0]);
+
+struct BenchmarkOptions
+{
+    bool requested;
+    unsigned int frames;
+    unsigned int warmupFrames;
+    std::string filter;
+    std::string output;
+    std::string baseline;
+    float tolerance;
+};
+
+static BenchmarkOptions s_options = { false, kDefaultFrames, kDefaultWarmupFrames, "", "benchmark.json", "", 10.0f };
+
+static unsigned int nextObjectID()
+{
+    // every CCObject takes the next id, a temporary one tells how many were created
+    CCObject probe;
+    return probe.m_uID;
+}
+
+bool PerformanceBenchmark::parseCommandLine(int argc, char **argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* pszArg = argv[i];
+        const char* pszValue = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (strcmp(pszArg, "--benchmark") == 0)
+        {
+            s_options.requested = true;
+            continue;
+        }
+
+        if (! pszValue)
+        {
+            CCLog("benchmark: missing value for %s", pszArg);
+            break;
+        }
+
+        if (strcmp(pszArg, "--frames") == 0)
+        {
+            s_options.frames = MAX(atoi(pszValue), 1);
+        }
+        else if (strcmp(pszArg, "--warmup") == 0)
+        {
+            s_options.warmupFrames = MAX(atoi(pszValue), 1);
+        }
+        else if (strcmp(pszArg, "--filter") == 0)
+        {
+            s_options.filter = pszValue;
+        }
+        else if (strcmp(pszArg, "--output") == 0)
+        {
+            s_options.output = pszValue;
+        }
+        else if (strcmp(pszArg, "--baseline") == 0)
+        {
+            s_options.baseline = pszValue;
+        }
+        else if (strcmp(pszArg, "--tolerance") == 0)
+        {
+            s_options.tolerance = (float)atof(pszValue);
+        }
+        else
+        {
+            CCLog("benchmark: unknown option %s", pszArg);
+            continue;
+        }
+        ++i;
+    }
+
+    return s_options.requested;
+}
+
+bool PerformanceBenchmark::isRequested()
+{
+    return s_options.requested;
+}
+
+void PerformanceBenchmark::start()
+{
+    CCDirector *pDirector = CCDirector::sharedDirector();
+    pDirector->setFixedDeltaTime(1.0f / 60);
+    // don't wait for the next frame, the scenes are timed, not the frame rate
+    pDirector->setAnimationInterval(1.0 / 1000);
+    pDirector->setDisplayStats(false);
+    pDirector->getFrameTimeStats()->setWindowSize(s_options.frames);
+    pDirector->runWithScene(CCScene::create());
+
+    PerformanceBenchmark *pBenchmark = new PerformanceBenchmark();
+    pDirector->getScheduler()->scheduleSelector(schedule_selector(PerformanceBenchmark::tick), pBenchmark, 0, false);
+    // retained by the scheduler
+    pBenchmark->release();
+}
+
+PerformanceBenchmark::PerformanceBenchmark()
+: m_uCase(0)
+, m_uFrame(0)
+, m_uFirstObjectID(0)
+{
+    for (unsigned int i = 0; i < s_benchmarkCaseCount; ++i)
+    {
+        if (strstr(s_benchmarkCases[i].name, s_options.filter.c_str()))
+        {
+            m_cases.push_back(i);
+        }
+    }
+}
+
+PerformanceBenchmark::~PerformanceBenchmark()
+{
+}
+
+void PerformanceBenchmark::tick(float dt)
+{
+    if (m_uCase == m_cases.size())
+    {
+        finish();
+        return;
+    }
+
+    if (m_uFrame == 0)
+    {
+        startCase();
+    }
+
+    ++m_uFrame;
+    if (m_uFrame == s_options.warmupFrames)
+    {
+        CCDirector::sharedDirector()->getFrameTimeStats()->reset();
+        m_uFirstObjectID = nextObjectID();
+    }
+    else if (m_uFrame == s_options.warmupFrames + s_options.frames)
+    {
+        finishCase();
+        m_uFrame = 0;
+        ++m_uCase;
+    }
+}
+
+void PerformanceBenchmark::startCase()
+{
+    const BenchmarkCase &benchmarkCase = s_benchmarkCases[m_cases[m_uCase]];
+    CCLog("benchmark: %s", benchmarkCase.name);
+
+    srand(kRandomSeed);
+    CCDirector::sharedDirector()->replaceScene(benchmarkCase.create());
+}
+
+void PerformanceBenchmark::finishCase()
+{
+    CaseResult result;
+    result.name = s_benchmarkCases[m_cases[m_uCase]].name;
+
+    CCFrameTimeStats *pStats = CCDirector::sharedDirector()->getFrameTimeStats();
+    for (unsigned int i = 0; i < kCCFramePhaseCount; ++i)
+    {
+        ccFrameTimeSummary summary = pStats->getSummary((ccFramePhase)i);
+        PhaseResult &phase = result.phases[i];
+        phase.average = summary.average * 1000;
+        phase.p50 = summary.p50 * 1000;
+        phase.p95 = summary.p95 * 1000;
+        phase.p99 = summary.p99 * 1000;
+        phase.max = summary.max * 1000;
+    }
+
+    // minus the probe of the last frame
+    result.objectsPerFrame = (float)(nextObjectID() - m_uFirstObjectID - 1) / s_options.frames;
+
+    m_results.push_back(result);
+}
+
+void PerformanceBenchmark::finish()
+{
+    CCDirector::sharedDirector()->getScheduler()->unscheduleAllForTarget(this);
+
+    int nStatus = writeResults(s_options.output) ? 0 : 1;
+    if (nStatus == 0 && ! s_options.baseline.empty())
+    {
+        int nRegressions = compareWithBaseline(s_options.baseline);
+        if (nRegressions != 0)
+        {
+            CCLog("benchmark: %d regression(s) over %.1f%%", nRegressions, s_options.tolerance);
+            nStatus = 1;
+        }
+        else
+        {
+            CCLog("benchmark: no regression over %.1f%%", s_options.tolerance);
+        }
+    }
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX) || (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC)
+    // the exit status is the result of the run
+    exit(nStatus);
+#else
+    CCDirector::sharedDirector()->end();
+#endif
+}
+
+bool PerformanceBenchmark::writeResults(const std::string& path)
+{
+    FILE *fp = fopen(path.c_str(), "w");
+    if (! fp)
+    {
+        CCLog("benchmark: can't write %s", path.c_str());
+        return false;
+    }
+
+    fprintf(fp, "{\n  \"frames\": %u,\n  \"warmupFrames\": %u,\n  \"unit\": \"ms\",\n  \"cases\": {\n",
+        s_options.frames, s_options.warmupFrames);
+    for (unsigned int i = 0; i < m_results.size(); ++i)
+    {
+        const CaseResult &result = m_results[i];
+        fprintf(fp, "    \"%s\": {\n", result.name.c_str());
+        for (unsigned int j = 0; j < kCCFramePhaseCount; ++j)
+        {
+            const PhaseResult &phase = result.phases[j];
+            fprintf(fp, "      \"%s\": { \"average\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f },\n",
+                s_phaseNames[j], phase.average, phase.p50, phase.p95, phase.p99, phase.max);
+        }
+        fprintf(fp, "      \"objectsPerFrame\": %.2f\n    }%s\n", result.objectsPerFrame, i + 1 < m_results.size() ? "," : "");
+    }
+    fprintf(fp, "  }\n}\n");
+
+    bool bSuccess = ferror(fp) == 0;
+    fclose(fp);
+    CCLog("benchmark: wrote %s", path.c_str());
+    return bSuccess;
+}
+
+static bool isRegression(float fCurrent, float fBaseline, float fMinDifference)
+{
+    return fCurrent > fBaseline * (1 + s_options.tolerance / 100) && fCurrent - fBaseline > fMinDifference;
+}
+
+int PerformanceBenchmark::compareWithBaseline(const std::string& path)
+{
+    // paths given on the command line are relative to the working directory, not to the resources
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (! fp)
+    {
+        CCLog("benchmark: can't read %s", path.c_str());
+        return -1;
+    }
+
+    std::string json;
+    char buffer[4096];
+    size_t uRead;
+    while ((uRead = fread(buffer, 1, sizeof(buffer), fp)) > 0)
+    {
+        json.append(buffer, uRead);
+    }
+    fclose(fp);
+
+    rapidjson::Document baseline;
+    baseline.Parse<0>(json.c_str());
+    if (baseline.HasParseError() || ! baseline.IsObject() || ! baseline.HasMember("cases"))
+    {
+        CCLog("benchmark: %s is not a benchmark result", path.c_str());
+        return -1;
+    }
+
+    const rapidjson::Value &cases = baseline["cases"];
+    int nRegressions = 0;
+    for (unsigned int i = 0; i < m_results.size(); ++i)
+    {
+        const CaseResult &result = m_results[i];
+        if (! cases.HasMember(result.name.c_str()))
+        {
+            CCLog("benchmark: %s is not in the baseline", result.name.c_str());
+            continue;
+        }
+        const rapidjson::Value &baselineCase = cases[result.name.c_str()];
+
+        // the frame and swap phases depend on the driver and the display, the others on the engine
+        const ccFramePhase comparedPhases[] = { kCCFramePhaseUpdate, kCCFramePhaseVisit };
+        for (unsigned int j = 0; j < sizeof(comparedPhases) / sizeof(comparedPhases[0]); ++j)
+        {
+            const char *pszPhase = s_phaseNames[comparedPhases[j]];
+            if (! baselineCase.HasMember(pszPhase) || ! baselineCase[pszPhase].HasMember("p50"))
+            {
+                continue;
+            }
+
+            float fBaseline = (float)baselineCase[pszPhase]["p50"].GetDouble();
+            float fCurrent = result.phases[comparedPhases[j]].p50;
+            if (isRegression(fCurrent, fBaseline, kMinRegression))
+            {
+                CCLog("benchmark: REGRESSION %s %s p50 %.3f ms, was %.3f ms", result.name.c_str(), pszPhase, fCurrent, fBaseline);
+                ++nRegressions;
+            }
+        }
+
+        if (baselineCase.HasMember("objectsPerFrame"))
+        {
+            float fBaseline = (float)baselineCase["objectsPerFrame"].GetDouble();
+            if (isRegression(result.objectsPerFrame, fBaseline, 0.5f))
+            {
+                CCLog("benchmark: REGRESSION %s creates %.2f objects per frame, was %.2f",
+                    result.name.c_str(), result.objectsPerFrame, fBaseline);
+                ++nRegressions;
+            }
+        }
+    }
+
+    return nRegressions;
+}
@@ -0,0 +1,69 @@
+#ifndef __PERFORMANCE_BENCHMARK_H__
+#define __PERFORMANCE_BENCHMARK_H__
+
+#include "cocos2d.h"
+#include <string>
+#include <vector>
+
+USING_NS_CC;
+
+/*
+ * Runs performance test scenes one after the other, without user input, and writes
+ * their timings as JSON. Started from the command line:
+ *
+ *   TestCpp --benchmark [--frames N] [--warmup N] [--filter TEXT]
+ *           [--output FILE] [--baseline FILE] [--tolerance PERCENT]
+ *
+ * Every scene is ticked with a fixed delta time and random seed, and drawn as fast as
+ * possible. When a baseline written by a previous run is given, the run fails if a
+ * scene got slower than the tolerance allows, so that it can gate a merge.
+ */
+class PerformanceBenchmark : public CCObject
+{
+public:
+    /** Reads the options, returns true if --benchmark is one of them */
+    static bool parseCommandLine(int argc, char **argv);
+
+    static bool isRequested();
+
+    /** Runs the benchmark, instead of the test menu */
+    static void start();
+
+    PerformanceBenchmark();
+    virtual ~PerformanceBenchmark();
+
+    void tick(float dt);
+
+private:
+    struct PhaseResult
+    {
+        float average;
+        float p50;
+        float p95;
+        float p99;
+        float max;
+    };
+
+    struct CaseResult
+    {
+        std::string name;
+        PhaseResult phases[kCCFramePhaseCount];
+        float objectsPerFrame;
+    };
+
+    void startCase();
+    void finishCase();
+    void finish();
+
+    bool writeResults(const std::string& path);
+    // returns the number of regressions, or -1 if the baseline can't be read
+    int compareWithBaseline(const std::string& path);
+
+    unsigned int m_uCase;
+    unsigned int m_uFrame;
+    unsigned int m_uFirstObjectID;
+    std::vector<unsigned int> m_cases;
+    std::vector<CaseResult> m_results;
+};
+
+#endif
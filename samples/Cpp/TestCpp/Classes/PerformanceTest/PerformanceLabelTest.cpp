@@ -0,0 +1,371 @@
+/*
+ *
+ */
+#include "PerformanceLabelTest.h"
+
+// Enable profiles for this file
+#undef CC_PROFILER_DISPLAY_TIMERS
+#define CC_PROFILER_DISPLAY_TIMERS() CCProfiler::sharedProfiler()->displayTimers()
+#undef CC_PROFILER_PURGE_ALL
+#define CC_PROFILER_PURGE_ALL() CCProfiler::sharedProfiler()->releaseAllTimers()
+
+#undef CC_PROFILER_START
+#define CC_PROFILER_START(__name__) CCProfilingBeginTimingBlock(__name__)
+#undef CC_PROFILER_STOP
+#define CC_PROFILER_STOP(__name__) CCProfilingEndTimingBlock(__name__)
+#undef CC_PROFILER_RESET
+#define CC_PROFILER_RESET(__name__) CCProfilingResetTimingBlock(__name__)
+
+#undef CC_PROFILER_START_CATEGORY
+#define CC_PROFILER_START_CATEGORY(__cat__, __name__) do{ if(__cat__) CCProfilingBeginTimingBlock(__name__); } while(0)
+#undef CC_PROFILER_STOP_CATEGORY
+#define CC_PROFILER_STOP_CATEGORY(__cat__, __name__) do{ if(__cat__) CCProfilingEndTimingBlock(__name__); } while(0)
+#undef CC_PROFILER_RESET_CATEGORY
+#define CC_PROFILER_RESET_CATEGORY(__cat__, __name__) do{ if(__cat__) CCProfilingResetTimingBlock(__name__); } while(0)
+
+#undef CC_PROFILER_START_INSTANCE
+#define CC_PROFILER_START_INSTANCE(__id__, __name__) do{ CCProfilingBeginTimingBlock( CCString::createWithFormat("%08X - %s", __id__, __name__)->getCString() ); } while(0)
+#undef CC_PROFILER_STOP_INSTANCE
+#define CC_PROFILER_STOP_INSTANCE(__id__, __name__) do{ CCProfilingEndTimingBlock(    CCString::createWithFormat("%08X - %s", __id__, __name__)->getCString() ); } while(0)
+#undef CC_PROFILER_RESET_INSTANCE
+#define CC_PROFILER_RESET_INSTANCE(__id__, __name__) do{ CCProfilingResetTimingBlock( CCString::createWithFormat("%08X - %s", __id__, __name__)->getCString() ); } while(0)
+
+#define MAX_LAYER  3
+
+enum {
+    kTagInfoLayer = 1,
+};
+
+enum {
+    kMaxNodes = 3000,
+    kNodesIncrease = 250,
+    kDefaultNodes = 500,
+};
+
+static int s_nCurCase = 0;
+
+////////////////////////////////////////////////////////
+//
+// LabelBasicLayer
+//
+////////////////////////////////////////////////////////
+
+LabelBasicLayer::LabelBasicLayer(bool bControlMenuVisible, int nMaxCases, int nCurCase)
+: PerformBasicLayer(bControlMenuVisible, nMaxCases, nCurCase)
+{
+}
+
+void LabelBasicLayer::showCurrentTest()
+{
+    PerformceLabelScene* scene = NULL;
+    switch (m_nCurCase) {
+        case 0:
+            scene = new LabelBMFontCounterTest;
+            break;
+        case 1:
+            scene = new LabelBMFontRewriteTest;
+            break;
+        case 2:
+            scene = new LabelTTFGlyphAtlasCounterTest;
+            break;
+        default:
+            scene = NULL;
+    }
+
+    s_nCurCase = m_nCurCase;
+
+    int nodes = ((PerformceLabelScene*)getParent())->getQuantityOfNodes();
+
+    if (scene)
+    {
+        scene->initWithQuantityOfNodes(nodes);
+
+        CCDirector::sharedDirector()->replaceScene(scene);
+        scene->release();
+    }
+}
+
+////////////////////////////////////////////////////////
+//
+// PerformceLabelScene
+//
+////////////////////////////////////////////////////////
+void PerformceLabelScene::initWithQuantityOfNodes(unsigned int nNodes)
+{
+    CCSize s = CCDirector::sharedDirector()->getWinSize();
+
+    // Title
+    CCLabelTTF* label = CCLabelTTF::create(title().c_str(), "Arial", 40);
+    addChild(label, 1);
+    label->setPosition(CCPoint(s.width/2, s.height-32));
+    label->setColor(ccc3(255,255,40));
+
+    // Subtitle
+    std::string strSubTitle = subtitle();
+    if(strSubTitle.length())
+    {
+        CCLabelTTF* l = CCLabelTTF::create(strSubTitle.c_str(), "Thonburi", 16);
+        addChild(l, 1);
+        l->setPosition(CCPoint(s.width/2, s.height-80));
+    }
+
+    lastRenderedCount = 0;
+    quantityOfNodes = nNodes;
+    frame = 0;
+
+    labels = CCNode::create();
+    addChild(labels);
+
+    CCMenuItemFont::setFontSize(65);
+    CCMenuItem* decrease = CCMenuItemFont::create(" - ", this, menu_selector(PerformceLabelScene::onDecrease));
+    decrease->setColor(ccc3(0,200,20));
+    CCMenuItem* increase = CCMenuItemFont::create(" + ", this, menu_selector(PerformceLabelScene::onIncrease));
+    increase->setColor(ccc3(0,200,20));
+
+    CCMenu* menu = CCMenu::create(decrease, increase, NULL);
+    menu->alignItemsHorizontally();
+    menu->setPosition(CCPoint(s.width/2, s.height/2+15));
+    addChild(menu, 1);
+
+    CCLabelTTF* infoLabel = CCLabelTTF::create("0 nodes", "Marker Felt", 30);
+    infoLabel->setColor(ccc3(0,200,20));
+    infoLabel->setPosition(CCPoint(s.width/2, s.height/2-15));
+    addChild(infoLabel, 1, kTagInfoLayer);
+
+    LabelBasicLayer* menuLayer = new LabelBasicLayer(true, MAX_LAYER, s_nCurCase);
+    addChild(menuLayer);
+    menuLayer->release();
+
+    updateQuantityLabel();
+    updateQuantityOfNodes();
+    updateProfilerName();
+
+    scheduleUpdate();
+}
+
+std::string PerformceLabelScene::title()
+{
+    return "No title";
+}
+
+std::string PerformceLabelScene::subtitle()
+{
+    return "";
+}
+
+void PerformceLabelScene::onDecrease(CCObject* pSender)
+{
+    quantityOfNodes -= kNodesIncrease;
+    if( quantityOfNodes < 0 )
+        quantityOfNodes = 0;
+
+    updateQuantityLabel();
+    updateQuantityOfNodes();
+    updateProfilerName();
+
+    CC_PROFILER_PURGE_ALL();
+}
+
+void PerformceLabelScene::onIncrease(CCObject* pSender)
+{
+    quantityOfNodes += kNodesIncrease;
+    if( quantityOfNodes > kMaxNodes )
+        quantityOfNodes = kMaxNodes;
+
+    updateQuantityLabel();
+    updateQuantityOfNodes();
+    updateProfilerName();
+
+    CC_PROFILER_PURGE_ALL();
+}
+
+void PerformceLabelScene::updateQuantityLabel()
+{
+    if( quantityOfNodes != lastRenderedCount )
+    {
+        CCLabelTTF* infoLabel = static_cast<CCLabelTTF*>( getChildByTag(kTagInfoLayer) );
+        char str[20] = {0};
+        sprintf(str, "%u nodes", quantityOfNodes);
+        infoLabel->setString(str);
+
+        lastRenderedCount = quantityOfNodes;
+    }
+}
+
+void PerformceLabelScene::updateQuantityOfNodes()
+{
+    CCSize s = CCDirector::sharedDirector()->getWinSize();
+
+    labels->removeAllChildrenWithCleanup(true);
+
+    srand(0);
+    for (int i = 0; i < quantityOfNodes; ++i)
+    {
+        CCNode* pLabel = createLabel();
+        pLabel->setPosition(ccp(CCRANDOM_0_1() * s.width, CCRANDOM_0_1() * s.height));
+        labels->addChild(pLabel);
+        updateLabel(pLabel, i, frame);
+    }
+}
+
+const char * PerformceLabelScene::profilerName()
+{
+    return _profilerName;
+}
+
+void PerformceLabelScene::updateProfilerName()
+{
+    snprintf(_profilerName, sizeof(_profilerName)-1, "%s(%d)", testName(), quantityOfNodes);
+}
+
+void PerformceLabelScene::update(float dt)
+{
+    ++frame;
+
+    CCArray* children = labels->getChildren();
+    unsigned int count = children ? children->count() : 0;
+
+    CC_PROFILER_START(this->profilerName());
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        updateLabel((CCNode*)children->objectAtIndex(i), i, frame);
+    }
+    CC_PROFILER_STOP(this->profilerName());
+}
+
+void PerformceLabelScene::onExitTransitionDidStart()
+{
+    CCScene::onExitTransitionDidStart();
+
+    CCDirector* director = CCDirector::sharedDirector();
+    CCScheduler* sched = director->getScheduler();
+
+    sched->unscheduleSelector(SEL_SCHEDULE(&PerformceLabelScene::dumpProfilerInfo), this);
+}
+
+void PerformceLabelScene::onEnterTransitionDidFinish()
+{
+    CCScene::onEnterTransitionDidFinish();
+
+    CCDirector* director = CCDirector::sharedDirector();
+    CCScheduler* sched = director->getScheduler();
+
+    CC_PROFILER_PURGE_ALL();
+    sched->scheduleSelector(SEL_SCHEDULE(&PerformceLabelScene::dumpProfilerInfo), this, 2, false);
+}
+
+void PerformceLabelScene::dumpProfilerInfo(float dt)
+{
+    CC_PROFILER_DISPLAY_TIMERS();
+}
+
+////////////////////////////////////////////////////////
+//
+// LabelBMFontCounterTest
+//
+////////////////////////////////////////////////////////
+CCNode* LabelBMFontCounterTest::createLabel()
+{
+    return CCLabelBMFont::create("", "fonts/arial16.fnt");
+}
+
+void LabelBMFontCounterTest::updateLabel(CCNode* pLabel, int nIndex, unsigned int nFrame)
+{
+    // only the last digits change from one frame to the next
+    char str[32] = {0};
+    sprintf(str, "Score: %07u", nIndex * 1000 + nFrame);
+    ((CCLabelBMFont*)pLabel)->setString(str);
+}
+
+std::string LabelBMFontCounterTest::title()
+{
+    return "CCLabelBMFont counters";
+}
+
+std::string LabelBMFontCounterTest::subtitle()
+{
+    return "setString every frame, the last digits change. See console";
+}
+
+const char* LabelBMFontCounterTest::testName()
+{
+    return "CCLabelBMFont::setString(counter)";
+}
+
+////////////////////////////////////////////////////////
+//
+// LabelBMFontRewriteTest
+//
+////////////////////////////////////////////////////////
+CCNode* LabelBMFontRewriteTest::createLabel()
+{
+    return CCLabelBMFont::create("", "fonts/arial16.fnt");
+}
+
+void LabelBMFontRewriteTest::updateLabel(CCNode* pLabel, int nIndex, unsigned int nFrame)
+{
+    // every character changes
+    static const char* s_pszWords[] = { "Lorem ipsum", "dolor sit", "amet, consectetur" };
+    char str[32] = {0};
+    sprintf(str, "%u %s", nFrame, s_pszWords[(nIndex + nFrame) % 3]);
+    ((CCLabelBMFont*)pLabel)->setString(str);
+}
+
+std::string LabelBMFontRewriteTest::title()
+{
+    return "CCLabelBMFont rewrites";
+}
+
+std::string LabelBMFontRewriteTest::subtitle()
+{
+    return "setString every frame, the whole string changes. See console";
+}
+
+const char* LabelBMFontRewriteTest::testName()
+{
+    return "CCLabelBMFont::setString(rewrite)";
+}
+
+////////////////////////////////////////////////////////
+//
+// LabelTTFGlyphAtlasCounterTest
+//
+////////////////////////////////////////////////////////
+CCNode* LabelTTFGlyphAtlasCounterTest::createLabel()
+{
+    CCLabelTTF* pLabel = CCLabelTTF::create("", "Arial", 16);
+    pLabel->setGlyphAtlasEnabled(true);
+    return pLabel;
+}
+
+void LabelTTFGlyphAtlasCounterTest::updateLabel(CCNode* pLabel, int nIndex, unsigned int nFrame)
+{
+    char str[32] = {0};
+    sprintf(str, "Score: %07u", nIndex * 1000 + nFrame);
+    ((CCLabelTTF*)pLabel)->setString(str);
+}
+
+std::string LabelTTFGlyphAtlasCounterTest::title()
+{
+    return "CCLabelTTF glyph atlas counters";
+}
+
+std::string LabelTTFGlyphAtlasCounterTest::subtitle()
+{
+    return CCGlyphAtlas::isSupported() ? "setString every frame. See console"
+                                       : "Glyph atlas not supported, labels use textures. See console";
+}
+
+const char* LabelTTFGlyphAtlasCounterTest::testName()
+{
+    return "CCLabelTTF::setString(glyph atlas)";
+}
+
+void runLabelPerformanceTest()
+{
+    PerformceLabelScene* scene = new LabelBMFontCounterTest;
+    scene->initWithQuantityOfNodes(kDefaultNodes);
+
+    CCDirector::sharedDirector()->replaceScene(scene);
+    scene->release();
+}
@@ -0,0 +1,98 @@
+/*
+ *
+ */
+#ifndef __PERFORMANCE_LABEL_TEST_H__
+#define __PERFORMANCE_LABEL_TEST_H__
+
+#include <string>
+
+#include "PerformanceTest.h"
+#include "support/CCProfiling.h"
+
+
+class LabelBasicLayer : public PerformBasicLayer
+{
+public:
+    LabelBasicLayer(bool bControlMenuVisible, int nMaxCases = 0, int nCurCase = 0);
+
+    virtual void showCurrentTest();
+};
+
+/** Labels whose string changes every frame, like score counters */
+class PerformceLabelScene : public CCScene
+{
+public:
+    virtual void initWithQuantityOfNodes(unsigned int nNodes);
+    virtual std::string title();
+    virtual std::string subtitle();
+
+    /** creates one of the labels */
+    virtual CCNode* createLabel() = 0;
+    /** sets the string of the label of index nIndex for frame nFrame */
+    virtual void updateLabel(CCNode* pLabel, int nIndex, unsigned int nFrame) = 0;
+
+    const char* profilerName();
+    void updateProfilerName();
+
+    void onDecrease(CCObject* pSender);
+    void onIncrease(CCObject* pSender);
+
+    // for the profiler
+    virtual const char* testName() = 0;
+
+    void updateQuantityLabel();
+    void updateQuantityOfNodes();
+
+    int getQuantityOfNodes() { return quantityOfNodes; }
+
+    virtual void update(float dt);
+    void dumpProfilerInfo(float dt);
+
+    // overrides
+    virtual void onExitTransitionDidStart();
+    virtual void onEnterTransitionDidFinish();
+
+protected:
+    char   _profilerName[256];
+    int    lastRenderedCount;
+    int    quantityOfNodes;
+    unsigned int frame;
+    CCNode *labels;
+};
+
+class LabelBMFontCounterTest : public PerformceLabelScene
+{
+public:
+    virtual CCNode* createLabel();
+    virtual void updateLabel(CCNode* pLabel, int nIndex, unsigned int nFrame);
+    virtual const char* testName();
+
+    std::string title();
+    std::string subtitle();
+};
+
+class LabelBMFontRewriteTest : public PerformceLabelScene
+{
+public:
+    virtual CCNode* createLabel();
+    virtual void updateLabel(CCNode* pLabel, int nIndex, unsigned int nFrame);
+    virtual const char* testName();
+
+    std::string title();
+    std::string subtitle();
+};
+
+class LabelTTFGlyphAtlasCounterTest : public PerformceLabelScene
+{
+public:
+    virtual CCNode* createLabel();
+    virtual void updateLabel(CCNode* pLabel, int nIndex, unsigned int nFrame);
+    virtual const char* testName();
+
+    std::string title();
+    std::string subtitle();
+};
+
+void runLabelPerformanceTest();
+
+#endif // __PERFORMANCE_LABEL_TEST_H__
@@ -37,7 +37,7 @@ enum {
 
     kTagBase = 20000,
 
-    TEST_COUNT = 10,
+    TEST_COUNT = 12,
 };
 
 enum {
@@ -120,6 +120,12 @@ void NodeChildrenMenuLayer::showCurrentTest()
         case 9:
             pScene = new VisitSceneGraph();
             break;
+        case 10:
+            pScene = new GetSpriteSheetIndexed();
+            break;
+        case 11:
+            pScene = new RemoveSpriteFront();
+            break;
     }
     s_nCurCase = m_nCurCase;
 
@@ -534,6 +540,33 @@ const char*  GetSpriteSheet::testName()
     return "SpriteBatchNode::getChildByTag()";
 }
 
+////////////////////////////////////////////////////////
+//
+// GetSpriteSheetIndexed
+//
+////////////////////////////////////////////////////////
+void GetSpriteSheetIndexed::initWithQuantityOfNodes(unsigned int nNodes)
+{
+    GetSpriteSheet::initWithQuantityOfNodes(nNodes);
+
+    batchNode->setChildTagIndexEnabled(true);
+}
+
+std::string GetSpriteSheetIndexed::title()
+{
+    return "getChildByTag() with a tag index";
+}
+
+std::string GetSpriteSheetIndexed::subtitle()
+{
+    return "Get sprites using an indexed getChildByTag(). See console";
+}
+
+const char*  GetSpriteSheetIndexed::testName()
+{
+    return "SpriteBatchNode::getChildByTag() indexed";
+}
+
 ////////////////////////////////////////////////////////
 //
 // AddSprite
@@ -713,6 +746,60 @@ const char*  RemoveSprite::testName()
     return "Node::removeChild()";
 }
 
+////////////////////////////////////////////////////////
+//
+// RemoveSpriteFront
+//
+////////////////////////////////////////////////////////
+void RemoveSpriteFront::update(float dt)
+{
+    // 100 percent
+    int totalToAdd = currentQuantityOfNodes * 1;
+
+    if( totalToAdd > 0 )
+    {
+        CCSprite **sprites = new CCSprite*[totalToAdd];
+
+        // Don't include the sprite creation time as part of the profiling
+        for(int i=0;i<totalToAdd;i++)
+        {
+            sprites[i] = CCSprite::createWithTexture(batchNode->getTexture(), CCRect(0,0,32,32));
+        }
+
+        // same z, like bullets: the oldest child is always the first one
+        for( int i=0; i < totalToAdd;i++ )
+        {
+            this->addChild( sprites[i], 0, kTagBase+i);
+        }
+        this->sortAllChildren();
+
+        // remove them, oldest first
+        CC_PROFILER_START( this->profilerName() );
+        for( int i=0;i <  totalToAdd;i++)
+        {
+            this->removeChild( sprites[i], true);
+        }
+        CC_PROFILER_STOP( this->profilerName() );
+
+        delete [] sprites;
+    }
+}
+
+std::string RemoveSpriteFront::title()
+{
+    return "Node::removeChild() oldest first";
+}
+
+std::string RemoveSpriteFront::subtitle()
+{
+    return "Removes the first child each time. See console";
+}
+
+const char*  RemoveSpriteFront::testName()
+{
+    return "Node::removeChild() oldest first";
+}
+
 ////////////////////////////////////////////////////////
 //
 // RemoveSpriteSheet
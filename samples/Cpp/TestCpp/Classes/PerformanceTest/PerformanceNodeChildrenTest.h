@@ -110,6 +110,16 @@ public:
     virtual const char* testName();
 };
 
+class GetSpriteSheetIndexed : public GetSpriteSheet
+{
+public:
+    virtual void initWithQuantityOfNodes(unsigned int nNodes);
+
+    virtual std::string title();
+    virtual std::string subtitle();
+    virtual const char* testName();
+};
+
 class AddSprite : public AddRemoveSpriteSheet
 {
 public:
@@ -140,6 +150,16 @@ public:
     virtual const char* testName();
 };
 
+class RemoveSpriteFront : public AddRemoveSpriteSheet
+{
+public:
+    virtual void update(float dt);
+
+    virtual std::string title();
+    virtual std::string subtitle();
+    virtual const char* testName();
+};
+
 class RemoveSpriteSheet : public AddRemoveSpriteSheet
 {
 public:
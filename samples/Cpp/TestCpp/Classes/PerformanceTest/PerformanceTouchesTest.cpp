@@ -2,7 +2,14 @@
 
 enum
 {
-    TEST_COUNT = 2,
+    TEST_COUNT = 4,
+};
+
+enum
+{
+    kHitTestColumns = 50,
+    kHitTestRows = 40,
+    kSyntheticTouchesPerFrame = 100,
 };
 
 static int s_nTouchCurCase = 0;
@@ -23,6 +30,12 @@ void TouchesMainScene::showCurrentTest()
     case 1:
         pLayer = new TouchesPerformTest2(true, TEST_COUNT, m_nCurCase);
         break;
+    case 2:
+        pLayer = new TouchesPerformTest3(true, TEST_COUNT, m_nCurCase);
+        break;
+    case 3:
+        pLayer = new TouchesPerformTest4(true, TEST_COUNT, m_nCurCase);
+        break;
     }
     s_nTouchCurCase = m_nCurCase;
 
@@ -165,6 +178,191 @@ void TouchesPerformTest2::ccTouchesCancelled(CCSet* touches, CCEvent* event)
     numberOfTouchesC += touches->count();
 }
 
+////////////////////////////////////////////////////////
+//
+// TouchesHitTestScene
+//
+////////////////////////////////////////////////////////
+TouchesHitTestScene::TouchesHitTestScene(bool bControlMenuVisible, int nMaxCases, int nCurCase)
+: TouchesMainScene(bControlMenuVisible, nMaxCases, nCurCase)
+, m_pTouch(NULL)
+, m_pTouches(NULL)
+, m_bIndexEnabled(false)
+, m_fDispatchTime(0)
+, m_nFrames(0)
+{
+}
+
+TouchesHitTestScene::~TouchesHitTestScene()
+{
+    CC_SAFE_RELEASE(m_pTouch);
+    CC_SAFE_RELEASE(m_pTouches);
+}
+
+void TouchesHitTestScene::onEnter()
+{
+    TouchesMainScene::onEnter();
+
+    CCSize s = CCDirector::sharedDirector()->getWinSize();
+
+    CCMenuItemToggle *pToggle = CCMenuItemToggle::createWithTarget(this, menu_selector(TouchesHitTestScene::toggleIndex),
+        CCMenuItemFont::create("Spatial index: Off"),
+        CCMenuItemFont::create("Spatial index: On"),
+        NULL);
+    CCMenu *pMenu = CCMenu::create(pToggle, NULL);
+    pMenu->setPosition(ccp(s.width/2, s.height-90));
+    addChild(pMenu, 1);
+
+    // keep the synthetic touches away from the menus
+    m_obArea = CCRectMake(0, 100, s.width, s.height - 220);
+    createTargets(m_obArea);
+
+    m_pTouch = new CCTouch();
+    m_pTouches = new CCSet();
+    m_pTouches->addObject(m_pTouch);
+
+    m_plabel->setString("");
+    m_plabel->setPosition(ccp(s.width/2, s.height-120));
+    m_plabel->setZOrder(1);
+}
+
+void TouchesHitTestScene::toggleIndex(CCObject* pSender)
+{
+    m_bIndexEnabled = !m_bIndexEnabled;
+    setIndexEnabled(m_bIndexEnabled);
+}
+
+void TouchesHitTestScene::update(float dt)
+{
+    CCDirector *pDirector = CCDirector::sharedDirector();
+    CCTouchDispatcher *pDispatcher = pDirector->getTouchDispatcher();
+
+    struct cc_timeval start, end;
+    CCTime::gettimeofdayCocos2d(&start, NULL);
+    for (int i = 0; i < kSyntheticTouchesPerFrame; ++i)
+    {
+        CCPoint location = ccp(m_obArea.origin.x + CCRANDOM_0_1() * m_obArea.size.width,
+                               m_obArea.origin.y + CCRANDOM_0_1() * m_obArea.size.height);
+        CCPoint view = pDirector->convertToUI(location);
+        m_pTouch->setTouchInfo(0, view.x, view.y);
+
+        pDispatcher->touchesBegan(m_pTouches, NULL);
+        pDispatcher->touchesEnded(m_pTouches, NULL);
+    }
+    CCTime::gettimeofdayCocos2d(&end, NULL);
+
+    m_fDispatchTime += (float)CCTime::timersubCocos2d(&start, &end);
+    if (++m_nFrames == 30)
+    {
+        char str[64];
+        sprintf(str, "%.2f us per touch", m_fDispatchTime * 1000 / (m_nFrames * kSyntheticTouchesPerFrame));
+        m_plabel->setString(str);
+        m_fDispatchTime = 0;
+        m_nFrames = 0;
+    }
+}
+
+////////////////////////////////////////////////////////
+//
+// TouchesPerformTest3
+//
+////////////////////////////////////////////////////////
+class TouchTarget : public CCNode, public CCTargetedTouchDelegate
+{
+public:
+    virtual void onEnter()
+    {
+        CCNode::onEnter();
+        CCDirector::sharedDirector()->getTouchDispatcher()->addTargetedDelegate(this, 0, true);
+    }
+
+    virtual void onExit()
+    {
+        CCDirector::sharedDirector()->getTouchDispatcher()->removeDelegate(this);
+        CCNode::onExit();
+    }
+
+    virtual bool ccTouchBegan(CCTouch* touch, CCEvent* event)
+    {
+        CCPoint local = convertToNodeSpace(touch->getLocation());
+        CCRect r = CCRectMake(0, 0, m_obContentSize.width, m_obContentSize.height);
+        return r.containsPoint(local);
+    }
+};
+
+std::string TouchesPerformTest3::title()
+{
+    return "2000 targeted delegates";
+}
+
+void TouchesPerformTest3::createTargets(const CCRect& area)
+{
+    float w = area.size.width / kHitTestColumns;
+    float h = area.size.height / kHitTestRows;
+    for (int i = 0; i < kHitTestColumns * kHitTestRows; ++i)
+    {
+        TouchTarget *pTarget = new TouchTarget();
+        pTarget->setContentSize(CCSizeMake(w - 2, h - 2));
+        pTarget->setPosition(ccp(area.origin.x + (i % kHitTestColumns) * w + 1, area.origin.y + (i / kHitTestColumns) * h + 1));
+        addChild(pTarget);
+        pTarget->release();
+    }
+}
+
+void TouchesPerformTest3::setIndexEnabled(bool bEnabled)
+{
+    CCTouchDispatcher *pDispatcher = CCDirector::sharedDirector()->getTouchDispatcher();
+
+    CCObject *pObj = NULL;
+    CCARRAY_FOREACH(m_pChildren, pObj)
+    {
+        TouchTarget *pTarget = dynamic_cast<TouchTarget*>(pObj);
+        if (!pTarget)
+            continue;
+
+        if (bEnabled)
+        {
+            pDispatcher->setTouchBoundsNode(pTarget, pTarget);
+        }
+        else
+        {
+            pDispatcher->removeTouchBounds(pTarget);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////
+//
+// TouchesPerformTest4
+//
+////////////////////////////////////////////////////////
+std::string TouchesPerformTest4::title()
+{
+    return "CCMenu with 2000 items";
+}
+
+void TouchesPerformTest4::createTargets(const CCRect& area)
+{
+    m_pMenu = CCMenu::create();
+    m_pMenu->setPosition(CCPointZero);
+    addChild(m_pMenu);
+
+    float w = area.size.width / kHitTestColumns;
+    float h = area.size.height / kHitTestRows;
+    for (int i = 0; i < kHitTestColumns * kHitTestRows; ++i)
+    {
+        CCMenuItem *pItem = CCMenuItem::create();
+        pItem->setContentSize(CCSizeMake(w - 2, h - 2));
+        pItem->setPosition(ccp(area.origin.x + (i % kHitTestColumns + 0.5f) * w, area.origin.y + (i / kHitTestColumns + 0.5f) * h));
+        m_pMenu->addChild(pItem);
+    }
+}
+
+void TouchesPerformTest4::setIndexEnabled(bool bEnabled)
+{
+    m_pMenu->setSpatialIndexEnabled(bEnabled);
+}
+
 void runTouchesTest()
 {
     s_nTouchCurCase = 0;
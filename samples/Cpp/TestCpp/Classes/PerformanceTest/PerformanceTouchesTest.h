@@ -61,6 +61,60 @@ public:
     virtual void ccTouchesCancelled(CCSet* touches, CCEvent* event);
 };
 
+// Sends synthetic touches over thousands of touch targets and times their dispatch
+class TouchesHitTestScene : public TouchesMainScene
+{
+public:
+    TouchesHitTestScene(bool bControlMenuVisible, int nMaxCases = 0, int nCurCase = 0);
+    ~TouchesHitTestScene();
+
+    virtual void onEnter();
+    virtual void update(float dt);
+
+    virtual void createTargets(const CCRect& area) = 0;
+    virtual void setIndexEnabled(bool bEnabled) = 0;
+
+    void toggleIndex(CCObject* pSender);
+
+protected:
+    CCTouch *m_pTouch;
+    CCSet   *m_pTouches;
+    CCRect  m_obArea;
+    bool    m_bIndexEnabled;
+    float   m_fDispatchTime;
+    int     m_nFrames;
+};
+
+class TouchesPerformTest3 : public TouchesHitTestScene
+{
+public:
+    TouchesPerformTest3(bool bControlMenuVisible, int nMaxCases = 0, int nCurCase = 0)
+        : TouchesHitTestScene(bControlMenuVisible, nMaxCases, nCurCase)
+    {
+    }
+
+    virtual std::string title();
+    virtual void createTargets(const CCRect& area);
+    virtual void setIndexEnabled(bool bEnabled);
+};
+
+class TouchesPerformTest4 : public TouchesHitTestScene
+{
+public:
+    TouchesPerformTest4(bool bControlMenuVisible, int nMaxCases = 0, int nCurCase = 0)
+        : TouchesHitTestScene(bControlMenuVisible, nMaxCases, nCurCase)
+        , m_pMenu(NULL)
+    {
+    }
+
+    virtual std::string title();
+    virtual void createTargets(const CCRect& area);
+    virtual void setIndexEnabled(bool bEnabled);
+
+protected:
+    CCMenu *m_pMenu;
+};
+
 void runTouchesTest();
 
 #endif
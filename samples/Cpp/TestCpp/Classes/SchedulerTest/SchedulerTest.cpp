@@ -27,6 +27,7 @@ TESTLAYER_CREATE_FUNC(SchedulerUpdateFromCustom)
 TESTLAYER_CREATE_FUNC(RescheduleSelector)
 TESTLAYER_CREATE_FUNC(SchedulerDelayAndRepeat)
 TESTLAYER_CREATE_FUNC(SchedulerIssue2268)
+TESTLAYER_CREATE_FUNC(SchedulerManyTimers)
 
 static NEWTESTFUNC createFunctions[] = {
     CF(SchedulerTimeScale),
@@ -44,7 +45,8 @@ static NEWTESTFUNC createFunctions[] = {
     CF(SchedulerUpdateFromCustom),
     CF(RescheduleSelector),
     CF(SchedulerDelayAndRepeat),
-    CF(SchedulerIssue2268)
+    CF(SchedulerIssue2268),
+    CF(SchedulerManyTimers)
 };
 
 #define MAX_LAYER (sizeof(createFunctions) / sizeof(createFunctions[0]))
@@ -1173,6 +1175,62 @@ std::string SchedulerIssue2268::subtitle()
 {
     return "Should not crash";
 }
+// SchedulerManyTimers
+
+#define kManyTimersCount 5000
+
+static int s_nManyTimersFired = 0;
+
+class ManyTimersNode : public CCNode
+{
+public:
+    void fired(float dt)
+    {
+        ++s_nManyTimersFired;
+    }
+};
+
+void SchedulerManyTimers::onEnter()
+{
+    SchedulerTestLayer::onEnter();
+
+    s_nManyTimersFired = 0;
+
+    CCSize s = CCDirector::sharedDirector()->getWinSize();
+    m_pLabel = CCLabelTTF::create("fired: 0", "Arial", 24);
+    m_pLabel->setPosition(ccp(s.width/2, s.height/2));
+    addChild(m_pLabel);
+
+    // many idle nodes with long intervals: only the due ones are visited each frame
+    for (int i = 0; i < kManyTimersCount; ++i)
+    {
+        ManyTimersNode *pNode = new ManyTimersNode();
+        pNode->init();
+        pNode->autorelease();
+        addChild(pNode);
+        pNode->schedule(schedule_selector(ManyTimersNode::fired), 5.0f + (i % 100) * 0.05f);
+    }
+
+    schedule(schedule_selector(SchedulerManyTimers::tick), 0.5f);
+}
+
+void SchedulerManyTimers::tick(float dt)
+{
+    char str[32];
+    sprintf(str, "fired: %d", s_nManyTimersFired);
+    m_pLabel->setString(str);
+}
+
+std::string SchedulerManyTimers::title()
+{
+    return "Many long interval timers";
+}
+
+std::string SchedulerManyTimers::subtitle()
+{
+    return "5000 timers every 5 to 10 seconds. Watch the FPS";
+}
+
 //------------------------------------------------------------------
 //
 // SchedulerTestScene
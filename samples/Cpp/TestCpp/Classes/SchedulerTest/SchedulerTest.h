@@ -262,6 +262,17 @@ class SchedulerIssue2268 : public SchedulerTestLayer
 		CCNode *testNode;
 };
 
+class SchedulerManyTimers : public SchedulerTestLayer
+{
+public:
+    virtual std::string title();
+    virtual std::string subtitle();
+    void onEnter();
+    void tick(float dt);
+private:
+    CCLabelTTF *m_pLabel;
+};
+
 class SchedulerTestScene : public TestScene
 {
 public:
@@ -65,6 +65,17 @@ bool SpineTestLayer::init () {
 	skeletonNode->setPosition(ccp(windowSize.width / 2, 20));
 	addChild(skeletonNode);
 
+	// copies of the same files share one skeleton data and atlas
+	for (int i = 0; i < 2; i++) {
+		CCSkeletonAnimation* copy = CCSkeletonAnimation::createWithFile("spine/spineboy.json", "spine/spineboy.atlas");
+		copy->setAnimation("walk", true);
+		copy->timeScale = 0.3f;
+		copy->setScale(0.5f);
+		copy->setPosition(ccp(windowSize.width * (i == 0 ? 0.15f : 0.85f), 20));
+		addChild(copy);
+	}
+	CCSkeletonDataCache::sharedSkeletonDataCache()->dumpCachedSkeletonDataInfo();
+
 	scheduleUpdate();
 
 	return true;
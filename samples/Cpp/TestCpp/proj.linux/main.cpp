@@ -1,4 +1,5 @@
 #include "../Classes/AppDelegate.h"
+#include "../Classes/PerformanceTest/PerformanceBenchmark.h"
 #include "cocos2d.h"
 #include "CCEGLView.h"
 
@@ -15,5 +16,7 @@ int main(int argc, char **argv)
     AppDelegate app;
     CCEGLView* eglView = CCEGLView::sharedOpenGLView();
     eglView->setFrameSize(800, 480);
+    // TestCpp --benchmark runs the performance scenes and exits, see PerformanceBenchmark.h
+    PerformanceBenchmark::parseCommandLine(argc, argv);
     return CCApplication::sharedApplication()->run();
 }